@@ -11,55 +11,193 @@
  ***************************************************************************** */ 
 
 #include "App.h"
-#include <algorithm>  // For std::remove
+#include <algorithm>  // For std::sort
 #include <iostream>   // For console output (optional, not used in current code)
+#include <utility>    // For std::move
 
 /******************************************************************************
  *                  Constructor: App
  *                  Description: Initializes the App object with a name
- *                  Arguments: const std::string& name - Name of the application
+ *                  Arguments: std::string_view name - Name of the application
  *                  Returns: None
  *****************************************************************************/
-App::App(const std::string& name) : appName(name) {}
+App::App(std::string_view name) : appName(name) {}
 
 /******************************************************************************
  *                  Name: addPermission
- *                  Description: Adds a new permission to the permissions list
- *                  Arguments: const std::string& permission - Permission to be added
- *                  Returns: None
+ *                  Description: Interns the permission and sets its bit; assigning a
+ *                               permission the app already holds is a no-op
+ *                  Arguments: std::string_view permission - Permission to be added
+ *                  Returns: bool - True if the app did not already hold the permission
+ *****************************************************************************/
+bool App::addPermission(std::string_view permission) {
+    return addPermission(PermissionRegistry::instance().intern(permission));
+}
+
+/******************************************************************************
+ *                  Name: addPermission
+ *                  Description: Sets the bit of an already interned permission
+ *                  Arguments: PermissionId id - ID of the permission to be added
+ *                  Returns: bool - True if the app did not already hold the permission
  *****************************************************************************/
-void App::addPermission(const std::string& permission) {
-    permissions.push_back(permission);
+bool App::addPermission(PermissionId id) {
+    return permissions.insert(id);
 }
 
 /******************************************************************************
  *                  Name: removePermission
- *                  Description: Removes a specific permission from the list
- *                  Arguments: const std::string& permission - Permission to be removed
- *                  Returns: None
+ *                  Description: Clears the permission's bit. Names that were never
+ *                               interned cannot be held, so they are not interned here.
+ *                  Arguments: std::string_view permission - Permission to be removed
+ *                  Returns: bool - True if the app held the permission
+ *****************************************************************************/
+bool App::removePermission(std::string_view permission) {
+    PermissionId id;
+    if (!PermissionRegistry::instance().find(permission, id)) {
+        return false;
+    }
+    return removePermission(id);
+}
+
+/******************************************************************************
+ *                  Name: removePermission
+ *                  Description: Clears the bit of an already interned permission
+ *                  Arguments: PermissionId id - ID of the permission to be removed
+ *                  Returns: bool - True if the app held the permission
+ *****************************************************************************/
+bool App::removePermission(PermissionId id) {
+    return permissions.erase(id);
+}
+
+/******************************************************************************
+ *                  Name: hasPermission
+ *                  Description: Checks whether the app holds a permission
+ *                  Arguments: std::string_view permission - Permission to check
+ *                  Returns: bool - True if the permission is assigned
  *****************************************************************************/
-void App::removePermission(const std::string& permission) {
-    permissions.erase(std::remove(permissions.begin(), permissions.end(), permission), permissions.end());
+bool App::hasPermission(std::string_view permission) const {
+    PermissionId id;
+    return PermissionRegistry::instance().find(permission, id) && permissions.contains(id);
 }
 
 /******************************************************************************
  *                  Name: getPermissions
- *                  Description: Returns the list of permissions assigned to the app
+ *                  Description: Resolves the interned permission IDs back to names and
+ *                               sorts them. ID order is the order in which the
+ *                               process first interned each name, which differs
+ *                               from run to run, so it is not exposed.
  *                  Arguments: None
- *                  Returns: std::vector<std::string> - List of permissions
+ *                  Returns: std::vector<std::string> - List of permissions, sorted
  *****************************************************************************/
 std::vector<std::string> App::getPermissions() const {
-    return permissions;
+    const PermissionRegistry& registry = PermissionRegistry::instance();
+    std::vector<std::string> names;
+    names.reserve(permissions.size());
+    permissions.forEach([&](PermissionId id) { names.push_back(registry.name(id)); });
+    std::sort(names.begin(), names.end());
+    return names;
 }
 
 /******************************************************************************
  *                  Name: getAppName
  *                  Description: Returns the name of the application
  *                  Arguments: None
- *                  Returns: std::string - Application name
+ *                  Returns: const std::string& - Application name
  *****************************************************************************/
-std::string App::getAppName() const {
+const std::string& App::getAppName() const {
     return appName;
 }
 
+/******************************************************************************
+ *                  Name: getPermissionSet
+ *                  Description: Returns the interned permission set without copying
+ *                  Arguments: None
+ *                  Returns: const PermissionSet& - Permissions assigned to the app
+ *****************************************************************************/
+const PermissionSet& App::getPermissionSet() const {
+    return permissions;
+}
+
+/******************************************************************************
+ *                  Name: getGroupSet
+ *                  Description: Returns the app's group set
+ *                  Arguments: None
+ *                  Returns: GroupSetId - Group set id
+ *****************************************************************************/
+GroupSetId App::getGroupSet() const {
+    return groupSet;
+}
+
+/******************************************************************************
+ *                  Name: setGroupSet
+ *                  Description: Replaces the app's group set
+ *                  Arguments: GroupSetId set - New group set
+ *                  Returns: None
+ *****************************************************************************/
+void App::setGroupSet(GroupSetId set) {
+    groupSet = set;
+}
+
+/******************************************************************************
+ *                  Name: takePermissions
+ *                  Description: Moves the permission set out, leaving an empty one
+ *                  Arguments: None
+ *                  Returns: PermissionSet - The app's permissions
+ *****************************************************************************/
+PermissionSet App::takePermissions() {
+    PermissionSet taken = std::move(permissions);
+    permissions = PermissionSet();
+    return taken;
+}
+
+/******************************************************************************
+ *                  Name: restorePermissions
+ *                  Description: Replaces the permission set
+ *                  Arguments: PermissionSet set - Permissions to restore
+ *                  Returns: None
+ *****************************************************************************/
+void App::restorePermissions(PermissionSet set) {
+    permissions = std::move(set);
+}
+
+/******************************************************************************
+ *                  Name: getLastAccess
+ *                  Description: Returns the app's access-clock tick
+ *                  Arguments: None
+ *                  Returns: std::uint32_t - Tick, or kEvicted
+ *****************************************************************************/
+std::uint32_t App::getLastAccess() const {
+    return lastAccess;
+}
+
+/******************************************************************************
+ *                  Name: setLastAccess
+ *                  Description: Stamps the app with an access-clock tick
+ *                  Arguments: std::uint32_t tick - Tick, or kEvicted
+ *                  Returns: None
+ *****************************************************************************/
+void App::setLastAccess(std::uint32_t tick) {
+    lastAccess = tick;
+}
+
+/******************************************************************************
+ *                  Name: getAppId
+ *                  Description: Returns the app's dense id
+ *                  Arguments: None
+ *                  Returns: std::uint32_t - Id
+ *****************************************************************************/
+std::uint32_t App::getAppId() const {
+    return appId;
+}
+
+/******************************************************************************
+ *                  Name: setAppId
+ *                  Description: Sets the app's dense id
+ *                  Arguments: std::uint32_t id - Id handed out by the manager
+ *                  Returns: None
+ *****************************************************************************/
+void App::setAppId(std::uint32_t id) {
+    appId = id;
+}
+
 /******************************** End of File ********************************/
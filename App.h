@@ -13,12 +13,18 @@
 #ifndef __APP_H__
 #define __APP_H__
 
+#include "PermissionGroups.h"
+#include "PermissionSet.h"
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 /******************************************************************************
  *                  Class Definition: App
- *                  Description: Represents an application with a name and a set of permissions
+ *                  Description: Represents an application with a name and a set of permissions.
+ *                               Permissions are interned through PermissionRegistry and
+ *                               held as a PermissionSet, so duplicates are ignored.
  *****************************************************************************/
 
 class App {
@@ -26,46 +32,171 @@ public:
     /******************************************************************************
      *                  Name: App
      *                  Description: Constructor to initialize the application name
-     *                  Arguments: const std::string& name - Name of the application
+     *                  Arguments: std::string_view name - Name of the application
      *                  Returns: None
      *****************************************************************************/
-    App(const std::string& name);
+    explicit App(std::string_view name);
 
     /******************************************************************************
      *                  Name: addPermission
      *                  Description: Adds a permission to the app
-     *                  Arguments: const std::string& permission - Permission to be added
-     *                  Returns: None
+     *                  Arguments: std::string_view permission - Permission to be added
+     *                  Returns: bool - True if the app did not already hold the permission
      *****************************************************************************/
-    void addPermission(const std::string& permission);
+    bool addPermission(std::string_view permission);
+
+    /******************************************************************************
+     *                  Name: addPermission
+     *                  Description: Adds an already interned permission to the app
+     *                  Arguments: PermissionId id - ID of the permission to be added
+     *                  Returns: bool - True if the app did not already hold the permission
+     *****************************************************************************/
+    bool addPermission(PermissionId id);
 
     /******************************************************************************
      *                  Name: removePermission
      *                  Description: Removes a permission from the app
-     *                  Arguments: const std::string& permission - Permission to be removed
-     *                  Returns: None
+     *                  Arguments: std::string_view permission - Permission to be removed
+     *                  Returns: bool - True if the app held the permission
+     *****************************************************************************/
+    bool removePermission(std::string_view permission);
+
+    /******************************************************************************
+     *                  Name: removePermission
+     *                  Description: Removes an already interned permission from the app
+     *                  Arguments: PermissionId id - ID of the permission to be removed
+     *                  Returns: bool - True if the app held the permission
      *****************************************************************************/
-    void removePermission(const std::string& permission);
+    bool removePermission(PermissionId id);
+
+    /******************************************************************************
+     *                  Name: hasPermission
+     *                  Description: Checks whether the app holds a permission
+     *                  Arguments: std::string_view permission - Permission to check
+     *                  Returns: bool - True if the permission is assigned
+     *****************************************************************************/
+    bool hasPermission(std::string_view permission) const;
 
     /******************************************************************************
      *                  Name: getPermissions
-     *                  Description: Retrieves the list of permissions
+     *                  Description: Retrieves the list of permissions sorted by name, so
+     *                               the result does not depend on the order in which
+     *                               the process first interned each name
      *                  Arguments: None
-     *                  Returns: std::vector<std::string> - List of permissions
+     *                  Returns: std::vector<std::string> - List of permissions, sorted
      *****************************************************************************/
     std::vector<std::string> getPermissions() const;
 
+    /******************************************************************************
+     *                  Name: forEachPermission
+     *                  Description: Calls fn(std::string_view) with the name of every
+     *                               permission, in interning order, without copying.
+     *                               The names live in PermissionRegistry for the life
+     *                               of the process.
+     *                  Arguments: Fn fn - Callback invoked per permission name
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEachPermission(Fn fn) const {
+        const PermissionRegistry& registry = PermissionRegistry::instance();
+        permissions.forEach([&](PermissionId id) { fn(std::string_view(registry.name(id))); });
+    }
+
     /******************************************************************************
      *                  Name: getAppName
      *                  Description: Retrieves the name of the application
      *                  Arguments: None
-     *                  Returns: std::string - Application name
+     *                  Returns: const std::string& - Application name
+     *****************************************************************************/
+    const std::string& getAppName() const;
+
+    /******************************************************************************
+     *                  Name: getPermissionSet
+     *                  Description: Retrieves the interned permission set without copying
+     *                  Arguments: None
+     *                  Returns: const PermissionSet& - Permissions assigned to the app
+     *****************************************************************************/
+    const PermissionSet& getPermissionSet() const;
+
+    /******************************************************************************
+     *                  Name: getGroupSet
+     *                  Description: Retrieves the interned combination of permission
+     *                               groups assigned to the app
+     *                  Arguments: None
+     *                  Returns: GroupSetId - Set id in the manager's PermissionGroups;
+     *                           PermissionGroups::kNoGroups if none
+     *****************************************************************************/
+    GroupSetId getGroupSet() const;
+
+    /******************************************************************************
+     *                  Name: setGroupSet
+     *                  Description: Replaces the app's group set; the caller manages
+     *                               the set references
+     *                  Arguments: GroupSetId set - New group set
+     *                  Returns: None
+     *****************************************************************************/
+    void setGroupSet(GroupSetId set);
+
+    /******************************************************************************
+     *                  Name: takePermissions
+     *                  Description: Moves the permission set out, leaving the app with
+     *                               none; used to evict the app's permissions
+     *                  Arguments: None
+     *                  Returns: PermissionSet - The app's permissions
+     *****************************************************************************/
+    PermissionSet takePermissions();
+
+    /******************************************************************************
+     *                  Name: restorePermissions
+     *                  Description: Puts back a permission set taken by takePermissions
+     *                  Arguments: PermissionSet set - Permissions to restore
+     *                  Returns: None
+     *****************************************************************************/
+    void restorePermissions(PermissionSet set);
+
+    /******************************************************************************
+     *                  Name: getLastAccess
+     *                  Description: Retrieves the access-clock tick the manager last
+     *                               stamped the app with, for picking cold apps
+     *                  Arguments: None
+     *                  Returns: std::uint32_t - Tick; App::kEvicted while the
+     *                           permissions are spilled to disk
      *****************************************************************************/
-    std::string getAppName() const;
+    std::uint32_t getLastAccess() const;
+
+    /******************************************************************************
+     *                  Name: setLastAccess
+     *                  Description: Stamps the app with an access-clock tick
+     *                  Arguments: std::uint32_t tick - Tick, or App::kEvicted
+     *                  Returns: None
+     *****************************************************************************/
+    void setLastAccess(std::uint32_t tick);
+
+    /******************************************************************************
+     *                  Name: getAppId
+     *                  Description: Retrieves the dense id the manager's reverse
+     *                               indexes know the app by
+     *                  Arguments: None
+     *                  Returns: std::uint32_t - Id, unique among installed apps
+     *****************************************************************************/
+    std::uint32_t getAppId() const;
+
+    /******************************************************************************
+     *                  Name: setAppId
+     *                  Description: Sets the app's dense id
+     *                  Arguments: std::uint32_t id - Id handed out by the manager
+     *                  Returns: None
+     *****************************************************************************/
+    void setAppId(std::uint32_t id);
+
+    static constexpr std::uint32_t kEvicted = 0;   // Access tick of an app whose permissions are on disk
 
 private:
     std::string appName;                      // Name of the application
-    std::vector<std::string> permissions;     // List of permissions assigned to the app
+    PermissionSet permissions;                // Interned permissions assigned to the app
+    GroupSetId groupSet = PermissionGroups::kNoGroups;   // Permission groups assigned to the app
+    std::uint32_t lastAccess = 1;             // Access-clock tick; kEvicted while spilled
+    std::uint32_t appId = 0;                  // Dense id used by the reverse indexes
 };
 
 #endif
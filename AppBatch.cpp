@@ -0,0 +1,101 @@
+
+/******************************************************************************
+ *                    File Name: AppBatch.cpp
+ *                    Description: Implementation file for the AppBatch builder
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "AppBatch.h"
+
+/******************************************************************************
+ *                  Name: install
+ *                  Description: Records an app installation
+ *                  Arguments: const std::string& appName - Name of the application
+ *                  Returns: AppBatch& - This batch, for chaining
+ *****************************************************************************/
+AppBatch& AppBatch::install(const std::string& appName) {
+    ops.push_back({BatchOpType::Install, appName, std::string()});
+    return *this;
+}
+
+/******************************************************************************
+ *                  Name: uninstall
+ *                  Description: Records an app removal
+ *                  Arguments: const std::string& appName - Name of the application
+ *                  Returns: AppBatch& - This batch, for chaining
+ *****************************************************************************/
+AppBatch& AppBatch::uninstall(const std::string& appName) {
+    ops.push_back({BatchOpType::Uninstall, appName, std::string()});
+    return *this;
+}
+
+/******************************************************************************
+ *                  Name: grant
+ *                  Description: Records a permission assignment
+ *                  Arguments: const std::string& appName - Name of the application
+ *                             const std::string& permission - Permission to assign
+ *                  Returns: AppBatch& - This batch, for chaining
+ *****************************************************************************/
+AppBatch& AppBatch::grant(const std::string& appName, const std::string& permission) {
+    ops.push_back({BatchOpType::Grant, appName, permission});
+    return *this;
+}
+
+/******************************************************************************
+ *                  Name: revoke
+ *                  Description: Records a permission removal
+ *                  Arguments: const std::string& appName - Name of the application
+ *                             const std::string& permission - Permission to revoke
+ *                  Returns: AppBatch& - This batch, for chaining
+ *****************************************************************************/
+AppBatch& AppBatch::revoke(const std::string& appName, const std::string& permission) {
+    ops.push_back({BatchOpType::Revoke, appName, permission});
+    return *this;
+}
+
+/******************************************************************************
+ *                  Name: reserve
+ *                  Description: Pre-allocates room for a known number of operations
+ *                  Arguments: std::size_t count - Expected number of operations
+ *                  Returns: None
+ *****************************************************************************/
+void AppBatch::reserve(std::size_t count) {
+    ops.reserve(count);
+}
+
+/******************************************************************************
+ *                  Name: clear
+ *                  Description: Removes all recorded operations
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void AppBatch::clear() {
+    ops.clear();
+}
+
+/******************************************************************************
+ *                  Name: size
+ *                  Description: Returns the number of recorded operations
+ *                  Arguments: None
+ *                  Returns: std::size_t - Operation count
+ *****************************************************************************/
+std::size_t AppBatch::size() const {
+    return ops.size();
+}
+
+/******************************************************************************
+ *                  Name: operations
+ *                  Description: Returns the recorded operations in insertion order
+ *                  Arguments: None
+ *                  Returns: const std::vector<BatchOp>& - Recorded operations
+ *****************************************************************************/
+const std::vector<BatchOp>& AppBatch::operations() const {
+    return ops;
+}
+
+/******************************** End of File ********************************/
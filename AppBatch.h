@@ -0,0 +1,126 @@
+
+/******************************************************************************
+ *                    File Name: AppBatch.h
+ *                    Description: Header file for AppBatch, a builder that collects
+ *                                 install/uninstall/grant/revoke operations to be
+ *                                 applied to a MobileAppManager in one pass
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __APP_BATCH_H__
+#define __APP_BATCH_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/******************************************************************************
+ *                  Enum Definition: BatchOpType
+ *                  Description: Kind of operation recorded in a batch
+ *****************************************************************************/
+
+enum class BatchOpType : std::uint8_t {
+    Install,
+    Uninstall,
+    Grant,
+    Revoke
+};
+
+/******************************************************************************
+ *                  Structure Definition: BatchOp
+ *                  Description: One recorded operation. permission is empty for
+ *                               Install and Uninstall.
+ *****************************************************************************/
+
+struct BatchOp {
+    BatchOpType type;         // What to do
+    std::string appName;      // Target application
+    std::string permission;   // Permission for Grant/Revoke
+};
+
+/******************************************************************************
+ *                  Class Definition: AppBatch
+ *                  Description: Ordered list of operations built with chained calls,
+ *                               e.g. batch.install("Maps").grant("Maps", "Location")
+ *****************************************************************************/
+
+class AppBatch {
+public:
+    /******************************************************************************
+     *                  Name: install
+     *                  Description: Records an app installation
+     *                  Arguments: const std::string& appName - Name of the application
+     *                  Returns: AppBatch& - This batch, for chaining
+     *****************************************************************************/
+    AppBatch& install(const std::string& appName);
+
+    /******************************************************************************
+     *                  Name: uninstall
+     *                  Description: Records an app removal
+     *                  Arguments: const std::string& appName - Name of the application
+     *                  Returns: AppBatch& - This batch, for chaining
+     *****************************************************************************/
+    AppBatch& uninstall(const std::string& appName);
+
+    /******************************************************************************
+     *                  Name: grant
+     *                  Description: Records a permission assignment
+     *                  Arguments: const std::string& appName - Name of the application
+     *                             const std::string& permission - Permission to assign
+     *                  Returns: AppBatch& - This batch, for chaining
+     *****************************************************************************/
+    AppBatch& grant(const std::string& appName, const std::string& permission);
+
+    /******************************************************************************
+     *                  Name: revoke
+     *                  Description: Records a permission removal
+     *                  Arguments: const std::string& appName - Name of the application
+     *                             const std::string& permission - Permission to revoke
+     *                  Returns: AppBatch& - This batch, for chaining
+     *****************************************************************************/
+    AppBatch& revoke(const std::string& appName, const std::string& permission);
+
+    /******************************************************************************
+     *                  Name: reserve
+     *                  Description: Pre-allocates room for a known number of operations
+     *                  Arguments: std::size_t count - Expected number of operations
+     *                  Returns: None
+     *****************************************************************************/
+    void reserve(std::size_t count);
+
+    /******************************************************************************
+     *                  Name: clear
+     *                  Description: Removes all recorded operations
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void clear();
+
+    /******************************************************************************
+     *                  Name: size
+     *                  Description: Returns the number of recorded operations
+     *                  Arguments: None
+     *                  Returns: std::size_t - Operation count
+     *****************************************************************************/
+    std::size_t size() const;
+
+    /******************************************************************************
+     *                  Name: operations
+     *                  Description: Returns the recorded operations in insertion order
+     *                  Arguments: None
+     *                  Returns: const std::vector<BatchOp>& - Recorded operations
+     *****************************************************************************/
+    const std::vector<BatchOp>& operations() const;
+
+private:
+    std::vector<BatchOp> ops;  // Operations in the order they were recorded
+};
+
+#endif
+
+/******************************** End of File ********************************/
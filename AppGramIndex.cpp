@@ -0,0 +1,154 @@
+
+/******************************************************************************
+ *                    File Name: AppGramIndex.cpp
+ *                    Description: Implementation file for the app name trigram index
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "AppGramIndex.h"
+#include <algorithm>  // For std::sort, std::unique
+
+namespace {
+
+constexpr std::size_t kMinCompaction = 1024;   // Tombstones tolerated regardless of size
+
+}  // namespace
+
+/******************************************************************************
+ *                  Name: gramAt
+ *                  Description: Packs the trigram starting at a position
+ *                  Arguments: std::string_view text - Text holding the trigram
+ *                             std::size_t pos - Offset of its first byte
+ *                  Returns: std::uint32_t - The three bytes as one key
+ *****************************************************************************/
+std::uint32_t AppGramIndex::gramAt(std::string_view text, std::size_t pos) {
+    return (std::uint32_t(static_cast<unsigned char>(text[pos])) << 16) |
+           (std::uint32_t(static_cast<unsigned char>(text[pos + 1])) << 8) |
+           std::uint32_t(static_cast<unsigned char>(text[pos + 2]));
+}
+
+/******************************************************************************
+ *                  Name: insert
+ *                  Description: Gives the app the next id and appends it to the
+ *                               posting list of each distinct trigram
+ *                  Arguments: App* app - App to index
+ *                  Returns: None
+ *****************************************************************************/
+void AppGramIndex::insert(App* app) {
+    std::uint32_t id = static_cast<std::uint32_t>(apps.size());
+    apps.push_back(app);
+    ids.emplace(app, id);
+
+    std::string_view name = app->getAppName();
+    if (name.size() < kGram) {
+        return;
+    }
+    std::vector<std::uint32_t> grams;
+    grams.reserve(name.size() - kGram + 1);
+    for (std::size_t pos = 0; pos + kGram <= name.size(); ++pos) {
+        grams.push_back(gramAt(name, pos));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    for (std::uint32_t gram : grams) {
+        postings[gram].push_back(id);
+    }
+}
+
+/******************************************************************************
+ *                  Name: erase
+ *                  Description: Tombstones an app, compacting when tombstones
+ *                               outnumber live apps
+ *                  Arguments: const App* app - App to remove
+ *                  Returns: None
+ *****************************************************************************/
+void AppGramIndex::erase(const App* app) {
+    auto it = ids.find(app);
+    if (it == ids.end()) {
+        return;
+    }
+    apps[it->second] = nullptr;
+    ids.erase(it);
+    std::size_t tombstones = apps.size() - ids.size();
+    if (tombstones > kMinCompaction && tombstones > ids.size()) {
+        compact();
+    }
+}
+
+/******************************************************************************
+ *                  Name: clear
+ *                  Description: Removes every entry
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void AppGramIndex::clear() {
+    apps.clear();
+    ids.clear();
+    postings.clear();
+}
+
+/******************************************************************************
+ *                  Name: candidates
+ *                  Description: Looks up each trigram of the pattern and keeps the
+ *                               shortest list
+ *                  Arguments: std::string_view pattern - At least kGram bytes
+ *                  Returns: const std::vector<std::uint32_t>* - App ids, or nullptr
+ *****************************************************************************/
+const std::vector<std::uint32_t>* AppGramIndex::candidates(std::string_view pattern) const {
+    const std::vector<std::uint32_t>* best = nullptr;
+    for (std::size_t pos = 0; pos + kGram <= pattern.size(); ++pos) {
+        auto it = postings.find(gramAt(pattern, pos));
+        if (it == postings.end()) {
+            return nullptr;
+        }
+        if (best == nullptr || it->second.size() < best->size()) {
+            best = &it->second;
+        }
+    }
+    return best;
+}
+
+/******************************************************************************
+ *                  Name: memoryUsage
+ *                  Description: Sums the id array, the hash nodes and buckets of both
+ *                               maps and the posting list buffers
+ *                  Arguments: None
+ *                  Returns: std::size_t - Bytes
+ *****************************************************************************/
+std::size_t AppGramIndex::memoryUsage() const {
+    std::size_t bytes = apps.capacity() * sizeof(App*) + ids.bucket_count() * sizeof(void*) +
+                        ids.size() * (sizeof(void*) + sizeof(const App*) + sizeof(std::uint32_t)) +
+                        postings.bucket_count() * sizeof(void*);
+    for (const auto& entry : postings) {
+        bytes += sizeof(void*) + sizeof(entry) + entry.second.capacity() * sizeof(std::uint32_t);
+    }
+    return bytes;
+}
+
+/******************************************************************************
+ *                  Name: compact
+ *                  Description: Re-indexes the live apps under fresh, dense ids
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void AppGramIndex::compact() {
+    std::vector<App*> live;
+    live.reserve(ids.size());
+    for (App* app : apps) {
+        if (app != nullptr) {
+            live.push_back(app);
+        }
+    }
+    clear();
+    apps.reserve(live.size());
+    for (App* app : live) {
+        insert(app);
+    }
+}
+
+/******************************** End of File ********************************/
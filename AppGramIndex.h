@@ -0,0 +1,104 @@
+
+/******************************************************************************
+ *                    File Name: AppGramIndex.h
+ *                    Description: Header file for AppGramIndex, a trigram index
+ *                                 for substring search over app names
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __APP_GRAM_INDEX_H__
+#define __APP_GRAM_INDEX_H__
+
+#include "App.h"
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/******************************************************************************
+ *                  Class Definition: AppGramIndex
+ *                  Description: Maps every three-byte substring (trigram) of an
+ *                               app name to the apps containing it. Apps get
+ *                               increasing ids, so posting lists stay sorted by
+ *                               plain appends. Uninstalled apps leave a null
+ *                               tombstone that is skipped on read; the lists are
+ *                               rebuilt once tombstones outnumber live apps, which
+ *                               keeps removal amortised O(1).
+ *****************************************************************************/
+
+class AppGramIndex {
+public:
+    static constexpr std::size_t kGram = 3;   // Bytes per indexed substring
+
+    /******************************************************************************
+     *                  Name: insert
+     *                  Description: Indexes every distinct trigram of an app's name
+     *                  Arguments: App* app - App to index
+     *                  Returns: None
+     *****************************************************************************/
+    void insert(App* app);
+
+    /******************************************************************************
+     *                  Name: erase
+     *                  Description: Tombstones an app, compacting when tombstones
+     *                               outnumber live apps
+     *                  Arguments: const App* app - App to remove
+     *                  Returns: None
+     *****************************************************************************/
+    void erase(const App* app);
+
+    /******************************************************************************
+     *                  Name: clear
+     *                  Description: Removes every entry
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void clear();
+
+    /******************************************************************************
+     *                  Name: candidates
+     *                  Description: Returns the shortest posting list among the
+     *                               pattern's trigrams. Every app containing the
+     *                               pattern is on it; callers confirm the match.
+     *                  Arguments: std::string_view pattern - At least kGram bytes
+     *                  Returns: const std::vector<std::uint32_t>* - App ids, or nullptr
+     *                           if some trigram occurs in no name (no app matches)
+     *****************************************************************************/
+    const std::vector<std::uint32_t>* candidates(std::string_view pattern) const;
+
+    /******************************************************************************
+     *                  Name: memoryUsage
+     *                  Description: Returns the heap bytes of the id tables and the
+     *                               posting lists
+     *                  Arguments: None
+     *                  Returns: std::size_t - Bytes
+     *****************************************************************************/
+    std::size_t memoryUsage() const;
+
+    /******************************************************************************
+     *                  Name: app
+     *                  Description: Returns the app with an id from a posting list
+     *                  Arguments: std::uint32_t id - App id
+     *                  Returns: const App* - The app, or nullptr if it was removed
+     *****************************************************************************/
+    const App* app(std::uint32_t id) const {
+        return apps[id];
+    }
+
+private:
+    static std::uint32_t gramAt(std::string_view text, std::size_t pos);
+    void compact();
+
+    std::vector<App*> apps;                                             // Id -> app, nullptr once removed
+    std::unordered_map<const App*, std::uint32_t> ids;                  // App -> id
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> postings;  // Trigram -> ascending ids
+};
+
+#endif
+
+/******************************** End of File ********************************/
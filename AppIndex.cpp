@@ -0,0 +1,198 @@
+
+/******************************************************************************
+ *                    File Name: AppIndex.cpp
+ *                    Description: Implementation file for the flat app name index
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "AppIndex.h"
+#include <functional>  // For std::hash
+
+namespace {
+
+constexpr std::size_t kMinCapacity = 16;
+
+/******************************************************************************
+ *                  Name: mix
+ *                  Description: Spreads the hash so its low bits, which pick the slot,
+ *                               depend on every input bit
+ *                  Arguments: std::uint64_t value - Hash to mix
+ *                  Returns: std::uint64_t - Mixed hash
+ *****************************************************************************/
+std::uint64_t mix(std::uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    return value;
+}
+
+}  // namespace
+
+/******************************************************************************
+ *                  Name: hash
+ *                  Description: Hashes an app name
+ *                  Arguments: std::string_view appName - Name to hash
+ *                  Returns: std::uint64_t - Hash value
+ *****************************************************************************/
+std::uint64_t AppIndex::hash(std::string_view appName) {
+    return mix(std::hash<std::string_view>{}(appName));
+}
+
+/******************************************************************************
+ *                  Name: probe
+ *                  Description: Walks the probe sequence of a key
+ *                  Arguments: std::string_view appName - Name to look for
+ *                             std::uint64_t keyHash - hash(appName)
+ *                  Returns: std::size_t - Slot holding the key, or the empty slot
+ *                           that ends its probe sequence
+ *****************************************************************************/
+std::size_t AppIndex::probe(std::string_view appName, std::uint64_t keyHash) const {
+    std::size_t mask = slots.size() - 1;
+    for (std::size_t i = keyHash & mask;; i = (i + 1) & mask) {
+        const Slot& slot = slots[i];
+        if (slot.app == nullptr || (slot.hash == keyHash && slot.app->getAppName() == appName)) {
+            return i;
+        }
+    }
+}
+
+/******************************************************************************
+ *                  Name: find
+ *                  Description: Looks up an app by name
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: App* - The app, or nullptr if not present
+ *****************************************************************************/
+App* AppIndex::find(std::string_view appName) const {
+    if (count == 0) {
+        return nullptr;
+    }
+    return slots[probe(appName, hash(appName))].app;
+}
+
+/******************************************************************************
+ *                  Name: insert
+ *                  Description: Adds an app, growing the table past 3/4 load
+ *                  Arguments: App* app - App to add
+ *                  Returns: bool - False if an app with that name is already present
+ *****************************************************************************/
+bool AppIndex::insert(App* app) {
+    if ((count + 1) * 4 > slots.size() * 3) {
+        rehash(slots.empty() ? kMinCapacity : slots.size() * 2);
+    }
+    std::uint64_t keyHash = hash(app->getAppName());
+    Slot& slot = slots[probe(app->getAppName(), keyHash)];
+    if (slot.app != nullptr) {
+        return false;
+    }
+    slot.hash = keyHash;
+    slot.app = app;
+    ++count;
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: erase
+ *                  Description: Removes an app and shifts back any later entry of the
+ *                               same cluster that would otherwise become unreachable
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: App* - The removed app, or nullptr if not present
+ *****************************************************************************/
+App* AppIndex::erase(std::string_view appName) {
+    if (count == 0) {
+        return nullptr;
+    }
+    std::size_t mask = slots.size() - 1;
+    std::size_t hole = probe(appName, hash(appName));
+    App* removed = slots[hole].app;
+    if (removed == nullptr) {
+        return nullptr;
+    }
+    for (std::size_t next = (hole + 1) & mask; slots[next].app != nullptr; next = (next + 1) & mask) {
+        std::size_t home = slots[next].hash & mask;
+        // Move next into the hole unless its home lies cyclically in (hole, next]
+        bool reachable = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+        if (!reachable) {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+    }
+    slots[hole] = Slot();
+    --count;
+    return removed;
+}
+
+/******************************************************************************
+ *                  Name: reserve
+ *                  Description: Grows the table so count apps fit under 3/4 load
+ *                  Arguments: std::size_t expected - Expected number of apps
+ *                  Returns: None
+ *****************************************************************************/
+void AppIndex::reserve(std::size_t expected) {
+    std::size_t capacity = slots.empty() ? kMinCapacity : slots.size();
+    while (expected * 4 > capacity * 3) {
+        capacity *= 2;
+    }
+    if (capacity != slots.size()) {
+        rehash(capacity);
+    }
+}
+
+/******************************************************************************
+ *                  Name: clear
+ *                  Description: Empties every slot, keeping the capacity
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void AppIndex::clear() {
+    slots.assign(slots.size(), Slot());
+    count = 0;
+}
+
+/******************************************************************************
+ *                  Name: size
+ *                  Description: Returns the number of apps in the index
+ *                  Arguments: None
+ *                  Returns: std::size_t - Entry count
+ *****************************************************************************/
+std::size_t AppIndex::size() const {
+    return count;
+}
+
+/******************************************************************************
+ *                  Name: memoryUsage
+ *                  Description: Returns the heap bytes of the slot table
+ *                  Arguments: None
+ *                  Returns: std::size_t - Bytes
+ *****************************************************************************/
+std::size_t AppIndex::memoryUsage() const {
+    return slots.capacity() * sizeof(Slot);
+}
+
+/******************************************************************************
+ *                  Name: rehash
+ *                  Description: Moves every entry into a table of the given size,
+ *                               reusing the cached hashes
+ *                  Arguments: std::size_t capacity - New power-of-two slot count
+ *                  Returns: None
+ *****************************************************************************/
+void AppIndex::rehash(std::size_t capacity) {
+    std::vector<Slot> old(capacity);
+    old.swap(slots);
+    std::size_t mask = capacity - 1;
+    for (const Slot& entry : old) {
+        if (entry.app != nullptr) {
+            std::size_t i = entry.hash & mask;
+            while (slots[i].app != nullptr) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = entry;
+        }
+    }
+}
+
+/******************************** End of File ********************************/
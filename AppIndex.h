@@ -0,0 +1,132 @@
+
+/******************************************************************************
+ *                    File Name: AppIndex.h
+ *                    Description: Header file for AppIndex, an open-addressing hash
+ *                                 table from app name to App object
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __APP_INDEX_H__
+#define __APP_INDEX_H__
+
+#include "App.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/******************************************************************************
+ *                  Class Definition: AppIndex
+ *                  Description: Flat, linearly probed hash table keyed by the name
+ *                               each App already stores, so names are not copied.
+ *                               Every slot caches the full hash of its key; probes
+ *                               compare hashes first and touch the App only on a
+ *                               match. Erase shifts later entries back instead of
+ *                               leaving tombstones. Lookups take std::string_view.
+ *****************************************************************************/
+
+class AppIndex {
+public:
+    /******************************************************************************
+     *                  Name: find
+     *                  Description: Looks up an app by name
+     *                  Arguments: std::string_view appName - Name of the application
+     *                  Returns: App* - The app, or nullptr if not present
+     *****************************************************************************/
+    App* find(std::string_view appName) const;
+
+    /******************************************************************************
+     *                  Name: insert
+     *                  Description: Adds an app under its own name
+     *                  Arguments: App* app - App to add
+     *                  Returns: bool - False if an app with that name is already present
+     *****************************************************************************/
+    bool insert(App* app);
+
+    /******************************************************************************
+     *                  Name: erase
+     *                  Description: Removes an app by name
+     *                  Arguments: std::string_view appName - Name of the application
+     *                  Returns: App* - The removed app, or nullptr if not present
+     *****************************************************************************/
+    App* erase(std::string_view appName);
+
+    /******************************************************************************
+     *                  Name: reserve
+     *                  Description: Grows the table so count apps fit without rehashing
+     *                  Arguments: std::size_t count - Expected number of apps
+     *                  Returns: None
+     *****************************************************************************/
+    void reserve(std::size_t count);
+
+    /******************************************************************************
+     *                  Name: clear
+     *                  Description: Removes every entry, keeping the table's capacity
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void clear();
+
+    /******************************************************************************
+     *                  Name: size
+     *                  Description: Returns the number of apps in the index
+     *                  Arguments: None
+     *                  Returns: std::size_t - Entry count
+     *****************************************************************************/
+    std::size_t size() const;
+
+    /******************************************************************************
+     *                  Name: memoryUsage
+     *                  Description: Returns the heap bytes of the slot table
+     *                  Arguments: None
+     *                  Returns: std::size_t - Bytes
+     *****************************************************************************/
+    std::size_t memoryUsage() const;
+
+    /******************************************************************************
+     *                  Name: forEach
+     *                  Description: Calls fn(App*) for every app, in table order
+     *                  Arguments: Fn fn - Callback invoked per app
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (const Slot& slot : slots) {
+            if (slot.app != nullptr) {
+                fn(slot.app);
+            }
+        }
+    }
+
+    /******************************************************************************
+     *                  Name: hash
+     *                  Description: Hash function used for app names
+     *                  Arguments: std::string_view appName - Name to hash
+     *                  Returns: std::uint64_t - Hash value
+     *****************************************************************************/
+    static std::uint64_t hash(std::string_view appName);
+
+private:
+    /******************************************************************************
+     *                  Structure Definition: Slot
+     *                  Description: One table cell; app is nullptr when empty
+     *****************************************************************************/
+    struct Slot {
+        std::uint64_t hash = 0;  // Cached hash of app's name
+        App* app = nullptr;      // Entry, or nullptr if the slot is empty
+    };
+
+    std::size_t probe(std::string_view appName, std::uint64_t keyHash) const;
+    void rehash(std::size_t capacity);
+
+    std::vector<Slot> slots;   // Power-of-two sized table
+    std::size_t count = 0;     // Occupied slots
+};
+
+#endif
+
+/******************************** End of File ********************************/
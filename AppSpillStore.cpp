@@ -0,0 +1,240 @@
+
+/******************************************************************************
+ *                    File Name: AppSpillStore.cpp
+ *                    Description: Implementation file for the evicted-app store
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "AppSpillStore.h"
+#include <cstdio>  // For std::remove, std::rename
+
+namespace {
+
+constexpr std::uint64_t kMinCompactBytes = 1 << 20;   // Dead bytes tolerated regardless of ratio
+
+}  // namespace
+
+/******************************************************************************
+ *                  Name: open
+ *                  Description: Creates or truncates the file for reading and writing
+ *                  Arguments: const std::string& storePath - File to use
+ *                  Returns: bool - False if the file could not be opened
+ *****************************************************************************/
+bool AppSpillStore::open(const std::string& storePath) {
+    if (file.is_open()) {
+        file.close();
+    }
+    path = storePath;
+    records.clear();
+    end = 0;
+    deadBytes = 0;
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    return file.is_open();
+}
+
+/******************************************************************************
+ *                  Name: put
+ *                  Description: Appends a record for the app, replacing any older one
+ *                  Arguments: const App* app - App being evicted
+ *                             const PermissionSet& permissions - Its permissions
+ *                  Returns: bool - False on a write error
+ *****************************************************************************/
+bool AppSpillStore::put(const App* app, const PermissionSet& permissions) {
+    buffer.clear();
+    buffer.push_back(0);
+    permissions.forEach([&](PermissionId id) { buffer.push_back(id); });
+    buffer[0] = static_cast<std::uint32_t>(buffer.size() - 1);
+
+    file.clear();
+    file.seekp(static_cast<std::streamoff>(end));
+    file.write(reinterpret_cast<const char*>(buffer.data()),
+               static_cast<std::streamsize>(buffer.size() * sizeof(std::uint32_t)));
+    if (!file) {
+        return false;
+    }
+    auto it = records.find(app);
+    if (it != records.end()) {
+        deadBytes += recordBytes(it->second.count);
+    }
+    records[app] = Record{end, buffer[0]};
+    end += recordBytes(buffer[0]);
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: read
+ *                  Description: Reads an app's record
+ *                  Arguments: const App* app - Evicted app
+ *                             PermissionSet& permissions - Receives the permissions
+ *                  Returns: bool - False if the app has no record or on a read error
+ *****************************************************************************/
+bool AppSpillStore::read(const App* app, PermissionSet& permissions) {
+    auto it = records.find(app);
+    return it != records.end() && readRecord(it->second, permissions);
+}
+
+/******************************************************************************
+ *                  Name: take
+ *                  Description: Reads an app's record and drops it, compacting the
+ *                               file once dead records outweigh live ones
+ *                  Arguments: const App* app - Evicted app
+ *                             PermissionSet& permissions - Receives the permissions
+ *                  Returns: bool - False if the app has no record or on a read error
+ *****************************************************************************/
+bool AppSpillStore::take(const App* app, PermissionSet& permissions) {
+    auto it = records.find(app);
+    if (it == records.end() || !readRecord(it->second, permissions)) {
+        return false;
+    }
+    deadBytes += recordBytes(it->second.count);
+    records.erase(it);
+    if (records.empty()) {
+        clear();
+    } else if (deadBytes > kMinCompactBytes && deadBytes > end - deadBytes) {
+        compact();
+    }
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: clear
+ *                  Description: Drops every record and truncates the file
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void AppSpillStore::clear() {
+    records.clear();
+    end = 0;
+    deadBytes = 0;
+    if (file.is_open()) {
+        file.close();
+        file.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    }
+}
+
+/******************************************************************************
+ *                  Name: size
+ *                  Description: Returns the number of records
+ *                  Arguments: None
+ *                  Returns: std::size_t - Record count
+ *****************************************************************************/
+std::size_t AppSpillStore::size() const {
+    return records.size();
+}
+
+/******************************************************************************
+ *                  Name: fileBytes
+ *                  Description: Returns the size of the file
+ *                  Arguments: None
+ *                  Returns: std::uint64_t - Bytes on disk
+ *****************************************************************************/
+std::uint64_t AppSpillStore::fileBytes() const {
+    return end;
+}
+
+/******************************************************************************
+ *                  Name: memoryUsage
+ *                  Description: Estimates the record table: one hash node per record
+ *                               plus the bucket array
+ *                  Arguments: None
+ *                  Returns: std::size_t - Approximate bytes
+ *****************************************************************************/
+std::size_t AppSpillStore::memoryUsage() const {
+    return records.size() * (sizeof(void*) + sizeof(const App*) + sizeof(Record)) +
+           records.bucket_count() * sizeof(void*) + buffer.capacity() * sizeof(std::uint32_t);
+}
+
+/******************************************************************************
+ *                  Name: recordBytes
+ *                  Description: Returns the on-disk size of a record
+ *                  Arguments: std::uint32_t count - Permission IDs in the record
+ *                  Returns: std::uint64_t - Bytes
+ *****************************************************************************/
+std::uint64_t AppSpillStore::recordBytes(std::uint32_t count) {
+    return (std::uint64_t(count) + 1) * sizeof(std::uint32_t);
+}
+
+/******************************************************************************
+ *                  Name: readRecord
+ *                  Description: Reads the IDs of one record into a set
+ *                  Arguments: const Record& record - Record to read
+ *                             PermissionSet& permissions - Receives the permissions
+ *                  Returns: bool - False on a read error
+ *****************************************************************************/
+bool AppSpillStore::readRecord(const Record& record, PermissionSet& permissions) {
+    buffer.resize(record.count);
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(record.offset + sizeof(std::uint32_t)));
+    file.read(reinterpret_cast<char*>(buffer.data()),
+              static_cast<std::streamsize>(buffer.size() * sizeof(std::uint32_t)));
+    if (!file) {
+        return false;
+    }
+    permissions.clear();
+    for (std::uint32_t id : buffer) {
+        permissions.insert(id);
+    }
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: compact
+ *                  Description: Rewrites the live records, in offset order, into a
+ *                               fresh file that replaces the current one
+ *                  Arguments: None
+ *                  Returns: bool - False if the rewrite failed; the old file stays
+ *****************************************************************************/
+bool AppSpillStore::compact() {
+    std::vector<std::pair<std::uint64_t, const App*>> byOffset;
+    byOffset.reserve(records.size());
+    for (const auto& entry : records) {
+        byOffset.emplace_back(entry.second.offset, entry.first);
+    }
+    std::sort(byOffset.begin(), byOffset.end());
+
+    std::string temporary = path + ".tmp";
+    std::vector<std::uint64_t> offsets;
+    offsets.reserve(byOffset.size());
+    std::uint64_t written = 0;
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        std::vector<char> bytes;
+        for (const auto& entry : byOffset) {
+            const Record& record = records[entry.second];
+            bytes.resize(recordBytes(record.count));
+            file.clear();
+            file.seekg(static_cast<std::streamoff>(record.offset));
+            file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            offsets.push_back(written);
+            written += bytes.size();
+        }
+        if (!file || !out.flush()) {
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    file.close();
+#ifdef _WIN32
+    std::remove(path.c_str());
+#endif
+    bool renamed = std::rename(temporary.c_str(), path.c_str()) == 0;
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    if (!renamed) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    for (std::size_t i = 0; i < byOffset.size(); ++i) {
+        records[byOffset[i].second].offset = offsets[i];
+    }
+    end = written;
+    deadBytes = 0;
+    return file.is_open();
+}
+
+/******************************** End of File ********************************/
@@ -0,0 +1,150 @@
+
+/******************************************************************************
+ *                    File Name: AppSpillStore.h
+ *                    Description: Header file for AppSpillStore, the local file
+ *                                 holding the permissions of evicted apps
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __APP_SPILL_STORE_H__
+#define __APP_SPILL_STORE_H__
+
+#include "App.h"
+#include "PermissionSet.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/******************************************************************************
+ *                  Class Definition: AppSpillStore
+ *                  Description: Scratch file of permission sets keyed by App. Each
+ *                               record is a count followed by the permission IDs;
+ *                               records are appended and the file is rewritten
+ *                               once dead records outweigh live ones. IDs are this
+ *                               process's interned IDs, so the file is truncated on
+ *                               open and is not meant to outlive the process. Not
+ *                               thread-safe.
+ *****************************************************************************/
+
+class AppSpillStore {
+public:
+    /******************************************************************************
+     *                  Name: open
+     *                  Description: Creates or truncates the store file
+     *                  Arguments: const std::string& path - File to use
+     *                  Returns: bool - False if the file could not be opened
+     *****************************************************************************/
+    bool open(const std::string& path);
+
+    /******************************************************************************
+     *                  Name: put
+     *                  Description: Appends an app's permissions
+     *                  Arguments: const App* app - App being evicted
+     *                             const PermissionSet& permissions - Its permissions
+     *                  Returns: bool - False on a write error
+     *****************************************************************************/
+    bool put(const App* app, const PermissionSet& permissions);
+
+    /******************************************************************************
+     *                  Name: read
+     *                  Description: Reads an app's permissions, leaving the record
+     *                  Arguments: const App* app - Evicted app
+     *                             PermissionSet& permissions - Receives the permissions
+     *                  Returns: bool - False if the app has no record or on a read error
+     *****************************************************************************/
+    bool read(const App* app, PermissionSet& permissions);
+
+    /******************************************************************************
+     *                  Name: take
+     *                  Description: Reads an app's permissions and drops the record
+     *                  Arguments: const App* app - Evicted app
+     *                             PermissionSet& permissions - Receives the permissions
+     *                  Returns: bool - False if the app has no record or on a read error
+     *****************************************************************************/
+    bool take(const App* app, PermissionSet& permissions);
+
+    /******************************************************************************
+     *                  Name: forEach
+     *                  Description: Calls fn(const App*, const PermissionSet&) for every
+     *                               record, reading the file in offset order
+     *                  Arguments: Fn fn - Callback invoked per record
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEach(Fn fn) {
+        std::vector<std::pair<std::uint64_t, const App*>> byOffset;
+        byOffset.reserve(records.size());
+        for (const auto& entry : records) {
+            byOffset.emplace_back(entry.second.offset, entry.first);
+        }
+        std::sort(byOffset.begin(), byOffset.end());
+        PermissionSet permissions;
+        for (const auto& entry : byOffset) {
+            if (readRecord(records[entry.second], permissions)) {
+                fn(entry.second, permissions);
+            }
+        }
+    }
+
+    /******************************************************************************
+     *                  Name: clear
+     *                  Description: Drops every record and truncates the file
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void clear();
+
+    /******************************************************************************
+     *                  Name: size
+     *                  Description: Returns the number of records
+     *                  Arguments: None
+     *                  Returns: std::size_t - Record count
+     *****************************************************************************/
+    std::size_t size() const;
+
+    /******************************************************************************
+     *                  Name: fileBytes
+     *                  Description: Returns the size of the file, dead records included
+     *                  Arguments: None
+     *                  Returns: std::uint64_t - Bytes on disk
+     *****************************************************************************/
+    std::uint64_t fileBytes() const;
+
+    /******************************************************************************
+     *                  Name: memoryUsage
+     *                  Description: Returns the heap bytes of the record table
+     *                  Arguments: None
+     *                  Returns: std::size_t - Approximate bytes
+     *****************************************************************************/
+    std::size_t memoryUsage() const;
+
+private:
+    struct Record {
+        std::uint64_t offset = 0;    // Start of the record in the file
+        std::uint32_t count = 0;     // Permission IDs in the record
+    };
+
+    static std::uint64_t recordBytes(std::uint32_t count);
+    bool readRecord(const Record& record, PermissionSet& permissions);
+    bool compact();
+
+    std::string path;                                    // Store file
+    std::fstream file;                                   // Open store file
+    std::uint64_t end = 0;                               // File size; next record goes here
+    std::uint64_t deadBytes = 0;                         // Bytes of dropped records
+    std::unordered_map<const App*, Record> records;      // Live records
+    std::vector<std::uint32_t> buffer;                   // Staging for record IO
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,271 @@
+
+/******************************************************************************
+ *                    File Name: AppTrie.cpp
+ *                    Description: Implementation file for the app name radix trie
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "AppTrie.h"
+#include "MemoryUsage.h"
+#include <utility>  // For std::pair
+
+/******************************************************************************
+ *                  Constructor: AppTrie
+ *                  Description: Creates an empty trie with its root node
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+AppTrie::AppTrie() : root(newNode(std::string_view(), nullptr)) {}
+
+/******************************************************************************
+ *                  Destructor: AppTrie
+ *                  Description: Returns every node to the pool
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+AppTrie::~AppTrie() {
+    destroySubtree(root);
+}
+
+/******************************************************************************
+ *                  Name: insert
+ *                  Description: Walks down the matching edges, splitting the edge
+ *                               where the name diverges from it
+ *                  Arguments: App* app - App to add
+ *                  Returns: bool - False if an app with that name is already present
+ *****************************************************************************/
+bool AppTrie::insert(App* app) {
+    std::string_view key = app->getAppName();
+    Node* node = root;
+    std::size_t pos = 0;
+    while (pos < key.size()) {
+        std::size_t slot = childSlot(node, key[pos]);
+        if (slot == node->children.size() || node->children[slot]->label[0] != key[pos]) {
+            attach(node, newNode(key.substr(pos), app));
+            ++count;
+            return true;
+        }
+        Node* child = node->children[slot];
+        std::size_t common = commonPrefix(child->label, key.substr(pos));
+        if (common < child->label.size()) {
+            // Split the edge: node -> middle (shared part) -> child (remainder)
+            Node* middle = newNode(std::string_view(child->label).substr(0, common), nullptr);
+            child->label.erase(0, common);
+            middle->children.push_back(child);
+            node->children[slot] = middle;
+            child = middle;
+        }
+        node = child;
+        pos += common;
+    }
+    if (node->app != nullptr) {
+        return false;
+    }
+    node->app = app;
+    ++count;
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: erase
+ *                  Description: Clears the name's node, then removes it if it has no
+ *                               children, or merges it into its only child; the
+ *                               parent is merged too if that leaves it with one
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: bool - False if the name was not present
+ *****************************************************************************/
+bool AppTrie::erase(std::string_view appName) {
+    std::vector<std::pair<Node*, std::size_t>> trail;   // (parent, slot of the next node in it)
+    Node* node = root;
+    std::size_t pos = 0;
+    while (pos < appName.size()) {
+        std::size_t slot = childSlot(node, appName[pos]);
+        if (slot == node->children.size()) {
+            return false;
+        }
+        Node* child = node->children[slot];
+        if (child->label[0] != appName[pos] || appName.compare(pos, child->label.size(), child->label) != 0) {
+            return false;
+        }
+        trail.emplace_back(node, slot);
+        node = child;
+        pos += child->label.size();
+    }
+    if (node->app == nullptr) {
+        return false;
+    }
+    node->app = nullptr;
+    --count;
+    if (trail.empty()) {
+        return true;
+    }
+
+    if (node->children.empty()) {
+        Node* parent = trail.back().first;
+        parent->children.erase(parent->children.begin() + trail.back().second);
+        nodes.destroy(node);
+        trail.pop_back();
+        if (trail.empty()) {
+            return true;   // The root is never merged
+        }
+        node = parent;     // It may now be an empty pass-through node
+    }
+    if (node->app == nullptr && node->children.size() == 1) {
+        Node* only = node->children[0];
+        only->label.insert(0, node->label);
+        trail.back().first->children[trail.back().second] = only;
+        node->children.clear();
+        nodes.destroy(node);
+    }
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: clear
+ *                  Description: Removes every entry and leaves an empty root
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void AppTrie::clear() {
+    destroySubtree(root);
+    root = newNode(std::string_view(), nullptr);
+    count = 0;
+}
+
+/******************************************************************************
+ *                  Name: size
+ *                  Description: Returns the number of apps in the trie
+ *                  Arguments: None
+ *                  Returns: std::size_t - Entry count
+ *****************************************************************************/
+std::size_t AppTrie::size() const {
+    return count;
+}
+
+/******************************************************************************
+ *                  Name: memoryUsage
+ *                  Description: Adds the heap blocks of the live nodes to the slabs
+ *                  Arguments: None
+ *                  Returns: std::size_t - Bytes
+ *****************************************************************************/
+std::size_t AppTrie::memoryUsage() const {
+    return nodes.stats().bytesReserved + subtreeBytes(root);
+}
+
+/******************************************************************************
+ *                  Name: subtreeBytes
+ *                  Description: Sums the heap labels and child arrays of a subtree
+ *                  Arguments: const Node* node - Subtree root
+ *                  Returns: std::size_t - Bytes
+ *****************************************************************************/
+std::size_t AppTrie::subtreeBytes(const Node* node) {
+    std::size_t bytes = stringHeapBytes(node->label) + node->children.capacity() * sizeof(Node*);
+    for (const Node* child : node->children) {
+        bytes += subtreeBytes(child);
+    }
+    return bytes;
+}
+
+/******************************************************************************
+ *                  Name: commonPrefix
+ *                  Description: Returns the length of the longest common prefix
+ *                  Arguments: std::string_view a - First string
+ *                             std::string_view b - Second string
+ *                  Returns: std::size_t - Shared leading characters
+ *****************************************************************************/
+std::size_t AppTrie::commonPrefix(std::string_view a, std::string_view b) {
+    std::size_t limit = a.size() < b.size() ? a.size() : b.size();
+    std::size_t i = 0;
+    while (i < limit && a[i] == b[i]) {
+        ++i;
+    }
+    return i;
+}
+
+/******************************************************************************
+ *                  Name: childSlot
+ *                  Description: Binary-searches the children for a first byte,
+ *                               comparing bytes as unsigned like std::string does
+ *                  Arguments: const Node* node - Parent node
+ *                             char first - First byte of the wanted label
+ *                  Returns: std::size_t - Index of the first child not ordered
+ *                           before first; may be children.size()
+ *****************************************************************************/
+std::size_t AppTrie::childSlot(const Node* node, char first) {
+    std::size_t low = 0;
+    std::size_t high = node->children.size();
+    unsigned char wanted = static_cast<unsigned char>(first);
+    while (low < high) {
+        std::size_t mid = (low + high) / 2;
+        if (static_cast<unsigned char>(node->children[mid]->label[0]) < wanted) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/******************************************************************************
+ *                  Name: findChild
+ *                  Description: Returns the child whose label starts with a byte
+ *                  Arguments: const Node* node - Parent node
+ *                             char first - First byte of the wanted label
+ *                  Returns: const Node* - The child, or nullptr
+ *****************************************************************************/
+const AppTrie::Node* AppTrie::findChild(const Node* node, char first) {
+    std::size_t slot = childSlot(node, first);
+    if (slot < node->children.size() && node->children[slot]->label[0] == first) {
+        return node->children[slot];
+    }
+    return nullptr;
+}
+
+/******************************************************************************
+ *                  Name: newNode
+ *                  Description: Creates a childless node in the pool
+ *                  Arguments: std::string_view label - Edge label
+ *                             App* app - App ending at the node, or nullptr
+ *                  Returns: Node* - The node
+ *****************************************************************************/
+AppTrie::Node* AppTrie::newNode(std::string_view label, App* app) {
+    Node* node = nodes.create();
+    node->label.assign(label.data(), label.size());
+    node->app = app;
+    return node;
+}
+
+/******************************************************************************
+ *                  Name: attach
+ *                  Description: Inserts a child at its sorted position
+ *                  Arguments: Node* parent - Parent node
+ *                             Node* child - New child; no sibling shares its first byte
+ *                  Returns: None
+ *****************************************************************************/
+void AppTrie::attach(Node* parent, Node* child) {
+    std::size_t slot = childSlot(parent, child->label[0]);
+    parent->children.insert(parent->children.begin() + slot, child);
+}
+
+/******************************************************************************
+ *                  Name: destroySubtree
+ *                  Description: Returns a node and all its descendants to the pool
+ *                  Arguments: Node* node - Subtree root
+ *                  Returns: None
+ *****************************************************************************/
+void AppTrie::destroySubtree(Node* node) {
+    std::vector<Node*> pending{node};
+    while (!pending.empty()) {
+        Node* current = pending.back();
+        pending.pop_back();
+        pending.insert(pending.end(), current->children.begin(), current->children.end());
+        nodes.destroy(current);
+    }
+}
+
+/******************************** End of File ********************************/
@@ -0,0 +1,187 @@
+
+/******************************************************************************
+ *                    File Name: AppTrie.h
+ *                    Description: Header file for AppTrie, a radix trie keeping
+ *                                 installed apps in name order
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __APP_TRIE_H__
+#define __APP_TRIE_H__
+
+#include "App.h"
+#include "ObjectPool.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+/******************************************************************************
+ *                  Class Definition: AppTrie
+ *                  Description: Path-compressed trie over app names. Each edge is
+ *                               labelled with a run of characters, children are
+ *                               kept sorted by their first byte, and a node that
+ *                               ends a name points at its App. An in-order walk
+ *                               therefore visits names in std::string order, and
+ *                               every name sharing a prefix lies in one subtree.
+ *                               Nodes come from an ObjectPool.
+ *****************************************************************************/
+
+class AppTrie {
+public:
+    AppTrie();
+    ~AppTrie();
+    AppTrie(const AppTrie&) = delete;
+    AppTrie& operator=(const AppTrie&) = delete;
+
+    /******************************************************************************
+     *                  Name: insert
+     *                  Description: Adds an app under its own name
+     *                  Arguments: App* app - App to add
+     *                  Returns: bool - False if an app with that name is already present
+     *****************************************************************************/
+    bool insert(App* app);
+
+    /******************************************************************************
+     *                  Name: erase
+     *                  Description: Removes an app by name, merging nodes left with a
+     *                               single child
+     *                  Arguments: std::string_view appName - Name of the application
+     *                  Returns: bool - False if the name was not present
+     *****************************************************************************/
+    bool erase(std::string_view appName);
+
+    /******************************************************************************
+     *                  Name: clear
+     *                  Description: Removes every entry
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void clear();
+
+    /******************************************************************************
+     *                  Name: size
+     *                  Description: Returns the number of apps in the trie
+     *                  Arguments: None
+     *                  Returns: std::size_t - Entry count
+     *****************************************************************************/
+    std::size_t size() const;
+
+    /******************************************************************************
+     *                  Name: memoryUsage
+     *                  Description: Returns the bytes of the node slabs plus the heap
+     *                               labels and child arrays of the live nodes
+     *                  Arguments: None
+     *                  Returns: std::size_t - Bytes
+     *****************************************************************************/
+    std::size_t memoryUsage() const;
+
+    /******************************************************************************
+     *                  Name: forEach
+     *                  Description: Calls fn(App*) in name order for every app whose
+     *                               name starts with prefix and sorts after after.
+     *                               Subtrees entirely before after are skipped
+     *                               without being visited.
+     *                  Arguments: std::string_view prefix - Required name prefix; empty
+     *                                                       matches every name
+     *                             std::string_view after - Names up to and including
+     *                                                      this are skipped
+     *                             Fn fn - Callback; returns false to stop the walk
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEach(std::string_view prefix, std::string_view after, Fn fn) const {
+        std::string path;
+        const Node* node = root;
+        // Descend to the subtree holding every name that starts with prefix
+        while (path.size() < prefix.size()) {
+            const Node* child = findChild(node, prefix[path.size()]);
+            if (child == nullptr) {
+                return;
+            }
+            std::string_view rest = prefix.substr(path.size());
+            std::size_t common = commonPrefix(child->label, rest);
+            if (common < rest.size() && common < child->label.size()) {
+                return;
+            }
+            path += child->label;
+            node = child;
+        }
+        bool bounded = after.compare(0, path.size(), path) == 0;
+        if (!bounded && std::string_view(path) < after) {
+            return;   // Every matching name sorts before after
+        }
+        visit(node, path, after, bounded, fn);
+    }
+
+private:
+    /******************************************************************************
+     *                  Structure Definition: Node
+     *                  Description: One trie node; app is set if a name ends here
+     *****************************************************************************/
+    struct Node {
+        std::string label;             // Characters on the edge into this node
+        App* app = nullptr;            // App whose name ends here, if any
+        std::vector<Node*> children;   // Sorted by first label byte
+    };
+
+    /******************************************************************************
+     *                  Name: visit
+     *                  Description: In-order walk of a subtree. While bounded, path
+     *                               is a prefix of after and names must still be
+     *                               compared against it.
+     *                  Arguments: const Node* node - Subtree root; path ends with its label
+     *                             std::string& path - Characters from the root to node
+     *                             std::string_view after - Exclusive lower bound
+     *                             bool bounded - Whether after still constrains the walk
+     *                             Fn& fn - Callback
+     *                  Returns: bool - False once fn asked to stop
+     *****************************************************************************/
+    template <typename Fn>
+    static bool visit(const Node* node, std::string& path, std::string_view after, bool bounded, Fn& fn) {
+        // While bounded, path is a prefix of after and so never sorts after it
+        if (node->app != nullptr && !bounded && !fn(node->app)) {
+            return false;
+        }
+        for (const Node* child : node->children) {
+            std::size_t mark = path.size();
+            path += child->label;
+            bool childBounded = false;
+            if (bounded) {
+                if (after.compare(0, path.size(), path) == 0) {
+                    childBounded = true;
+                } else if (std::string_view(path) < after) {
+                    path.resize(mark);
+                    continue;   // Every name below sorts before after
+                }
+            }
+            bool keepGoing = visit(child, path, after, childBounded, fn);
+            path.resize(mark);
+            if (!keepGoing) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static std::size_t subtreeBytes(const Node* node);
+    static std::size_t commonPrefix(std::string_view a, std::string_view b);
+    static const Node* findChild(const Node* node, char first);
+    static std::size_t childSlot(const Node* node, char first);
+
+    Node* newNode(std::string_view label, App* app);
+    void attach(Node* parent, Node* child);
+    void destroySubtree(Node* node);
+
+    ObjectPool<Node> nodes;   // Owns every node
+    Node* root;               // Empty-label root
+    std::size_t count = 0;    // Apps in the trie
+};
+
+#endif
+
+/******************************** End of File ********************************/
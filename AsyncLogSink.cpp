@@ -0,0 +1,157 @@
+
+/******************************************************************************
+ *                    File Name: AsyncLogSink.cpp
+ *                    Description: Implementation file for the asynchronous log sink
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "AsyncLogSink.h"
+#include <chrono>
+#include <cstring>  // For std::memcpy
+
+/******************************************************************************
+ *                  Constructor: AsyncLogSink
+ *                  Description: Allocates the ring buffer and starts the thread
+ *                  Arguments: std::shared_ptr<LogSink> target - Sink the thread writes to
+ *                             std::size_t capacity - Messages that can be queued
+ *                             LogLevel level - Lowest level that is queued
+ *                  Returns: None
+ *****************************************************************************/
+AsyncLogSink::AsyncLogSink(std::shared_ptr<LogSink> target, std::size_t capacity, LogLevel level)
+    : LogSink(level), target(std::move(target)), queue(capacity), worker([this]() { run(); }) {}
+
+/******************************************************************************
+ *                  Destructor: AsyncLogSink
+ *                  Description: Drains every queued message, then stops the thread
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+AsyncLogSink::~AsyncLogSink() {
+    stopping.store(true);
+    wake();
+    worker.join();
+    target->flush();
+}
+
+/******************************************************************************
+ *                  Name: write
+ *                  Description: Copies the message into a free slot; drops it if the
+ *                               buffer is full. The seq_cst fence pairs with the one
+ *                               in run(): either this thread sees idle set and wakes
+ *                               the drain thread, or that thread sees the new count
+ *                               and does not sleep.
+ *                  Arguments: LogLevel level - Severity of the message
+ *                             std::string_view message - Text without a newline
+ *                  Returns: None
+ *****************************************************************************/
+void AsyncLogSink::write(LogLevel level, std::string_view message) {
+    std::size_t length = message.size();
+    if (length > kMaxMessage) {
+        length = kMaxMessage;
+        truncatedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    bool pushed = queue.tryPushWith([&](Record& record) {
+        record.level = level;
+        record.length = static_cast<std::uint16_t>(length);
+        if (length > 0) {
+            std::memcpy(record.text, message.data(), length);
+        }
+    });
+    if (!pushed) {
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    queued.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (idle.load(std::memory_order_relaxed)) {
+        wake();
+    }
+}
+
+/******************************************************************************
+ *                  Name: flush
+ *                  Description: Waits until the thread has written everything queued
+ *                               before the call, then flushes the target
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void AsyncLogSink::flush() {
+    std::size_t goal = queued.load(std::memory_order_acquire);
+    while (written.load(std::memory_order_acquire) < goal) {
+        wake();
+        std::this_thread::yield();
+    }
+    target->flush();
+}
+
+/******************************************************************************
+ *                  Name: dropped
+ *                  Description: Returns how many messages were lost to a full buffer
+ *                  Arguments: None
+ *                  Returns: std::size_t - Dropped message count
+ *****************************************************************************/
+std::size_t AsyncLogSink::dropped() const {
+    return droppedCount.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************
+ *                  Name: truncated
+ *                  Description: Returns how many messages were cut to kMaxMessage
+ *                  Arguments: None
+ *                  Returns: std::size_t - Truncated message count
+ *****************************************************************************/
+std::size_t AsyncLogSink::truncated() const {
+    return truncatedCount.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************
+ *                  Name: run
+ *                  Description: Background loop: drain the buffer into the target,
+ *                               then sleep until woken. Setting idle, the seq_cst
+ *                               fence and the recheck of queued pair with write(),
+ *                               so a message queued while the thread goes to sleep
+ *                               always wakes it; the wait timeout is only a backstop.
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void AsyncLogSink::run() {
+    auto deliver = [this](Record& record) {
+        if (target->enabled(record.level)) {
+            target->write(record.level, std::string_view(record.text, record.length));
+        }
+    };
+    for (;;) {
+        while (queue.tryPopWith(deliver)) {
+            written.fetch_add(1, std::memory_order_release);
+        }
+        if (stopping.load()) {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        idle.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (written.load(std::memory_order_relaxed) >= queued.load(std::memory_order_relaxed) && !stopping.load()) {
+            wakeup.wait_for(lock, std::chrono::milliseconds(10));
+        }
+        idle.store(false, std::memory_order_relaxed);
+    }
+}
+
+/******************************************************************************
+ *                  Name: wake
+ *                  Description: Signals the background thread
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void AsyncLogSink::wake() {
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    wakeup.notify_one();
+}
+
+/******************************** End of File ********************************/
@@ -0,0 +1,123 @@
+
+/******************************************************************************
+ *                    File Name: AsyncLogSink.h
+ *                    Description: Header file for AsyncLogSink, which hands log
+ *                                 messages to a background thread through a
+ *                                 lock-free ring buffer
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __ASYNC_LOG_SINK_H__
+#define __ASYNC_LOG_SINK_H__
+
+#include "LogSink.h"
+#include "RingBuffer.h"
+#include <condition_variable>
+#include <cstdint>
+#include <thread>
+
+/******************************************************************************
+ *                  Class Definition: AsyncLogSink
+ *                  Description: Callers copy the message straight into a fixed-size
+ *                               RingBuffer slot, so queueing never allocates; a
+ *                               background thread drains the buffer into the
+ *                               target sink. Messages longer than kMaxMessage
+ *                               bytes are cut short and counted. When the buffer
+ *                               is full the message is dropped and counted rather
+ *                               than blocking the caller.
+ *****************************************************************************/
+
+class AsyncLogSink : public LogSink {
+public:
+    static constexpr std::size_t kDefaultCapacity = 8192;
+    static constexpr std::size_t kMaxMessage = 244;  // Bytes of text per slot
+
+    /******************************************************************************
+     *                  Name: AsyncLogSink
+     *                  Description: Constructor starting the background thread
+     *                  Arguments: std::shared_ptr<LogSink> target - Sink the thread writes to
+     *                             std::size_t capacity - Messages that can be queued
+     *                             LogLevel level - Lowest level that is queued
+     *                  Returns: None
+     *****************************************************************************/
+    explicit AsyncLogSink(std::shared_ptr<LogSink> target, std::size_t capacity = kDefaultCapacity,
+                          LogLevel level = LogLevel::Info);
+
+    /******************************************************************************
+     *                  Name: ~AsyncLogSink
+     *                  Description: Drains every queued message, then stops the thread
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    ~AsyncLogSink() override;
+
+    /******************************************************************************
+     *                  Name: write
+     *                  Description: Queues the message without blocking
+     *                  Arguments: LogLevel level - Severity of the message
+     *                             std::string_view message - Text without a newline
+     *                  Returns: None
+     *****************************************************************************/
+    void write(LogLevel level, std::string_view message) override;
+
+    /******************************************************************************
+     *                  Name: flush
+     *                  Description: Waits until every message queued so far has been
+     *                               written, then flushes the target
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void flush() override;
+
+    /******************************************************************************
+     *                  Name: dropped
+     *                  Description: Returns how many messages were lost to a full buffer
+     *                  Arguments: None
+     *                  Returns: std::size_t - Dropped message count
+     *****************************************************************************/
+    std::size_t dropped() const;
+
+    /******************************************************************************
+     *                  Name: truncated
+     *                  Description: Returns how many messages were cut to kMaxMessage
+     *                  Arguments: None
+     *                  Returns: std::size_t - Truncated message count
+     *****************************************************************************/
+    std::size_t truncated() const;
+
+private:
+    /******************************************************************************
+     *                  Structure Definition: Record
+     *                  Description: One queued message, sized so a slot with its
+     *                               sequence number stays a whole number of cache lines
+     *****************************************************************************/
+    struct Record {
+        LogLevel level = LogLevel::Info;  // Severity of the message
+        std::uint16_t length = 0;         // Bytes used in text
+        char text[kMaxMessage];           // Text without a newline, not terminated
+    };
+
+    void run();
+    void wake();
+
+    std::shared_ptr<LogSink> target;          // Sink the thread writes to
+    RingBuffer<Record> queue;                 // Pending messages
+    std::atomic<std::size_t> queued{0};       // Messages accepted into the queue
+    std::atomic<std::size_t> written{0};      // Messages handed to the target
+    std::atomic<std::size_t> droppedCount{0}; // Messages lost to a full queue
+    std::atomic<std::size_t> truncatedCount{0}; // Messages cut to kMaxMessage
+    std::atomic<bool> stopping{false};        // Set by the destructor
+    std::atomic<bool> idle{false};            // Thread is waiting for work
+    std::mutex wakeMutex;                     // Pairs with wakeup
+    std::condition_variable wakeup;           // Signals new work to the thread
+    std::thread worker;                       // Background drain thread
+};
+
+#endif
+
+/******************************** End of File ********************************/
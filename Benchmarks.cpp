@@ -0,0 +1,548 @@
+
+/******************************************************************************
+ *                    File Name: Benchmarks.cpp
+ *                    Description: Google Benchmark microbenchmarks for App,
+ *                                 MobileAppManager and ConcurrentAppManager at
+ *                                 1k, 100k and 1M installed apps, plus mixed
+ *                                 read/write workloads with Zipfian app popularity
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "ConcurrentAppManager.h"
+#include "MobileAppManager.h"
+#include "TimerWheel.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>   // For std::remove
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* const kPermissions[] = {"CAMERA", "MICROPHONE", "LOCATION", "CONTACTS",
+                                    "STORAGE", "SMS", "PHONE", "CALENDAR"};
+constexpr std::size_t kPermissionCount = sizeof(kPermissions) / sizeof(kPermissions[0]);
+constexpr std::size_t kKeyCount = 1 << 16;   // Pre-drawn keys per workload; a power of two
+
+/******************************************************************************
+ *                  Name: appName
+ *                  Description: Builds the name of the i-th benchmark app
+ *                  Arguments: std::size_t i - App number
+ *                  Returns: std::string - App name
+ *****************************************************************************/
+std::string appName(std::size_t i) {
+    return "com.bench.app" + std::to_string(i);
+}
+
+/******************************************************************************
+ *                  Class Definition: ZipfGenerator
+ *                  Description: Draws ranks in [0, n) with probability proportional
+ *                               to 1 / (rank + 1)^s by inverting the cumulative
+ *                               distribution with a binary search
+ *****************************************************************************/
+class ZipfGenerator {
+public:
+    ZipfGenerator(std::size_t n, double s) : cdf(n) {
+        double sum = 0;
+        for (std::size_t rank = 0; rank < n; ++rank) {
+            sum += 1.0 / std::pow(static_cast<double>(rank + 1), s);
+            cdf[rank] = sum;
+        }
+        for (double& value : cdf) {
+            value /= sum;
+        }
+    }
+
+    template <typename Rng>
+    std::size_t operator()(Rng& rng) {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        std::size_t rank = std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin();
+        return std::min(rank, cdf.size() - 1);
+    }
+
+private:
+    std::vector<double> cdf;   // Cumulative probability of ranks 0..i
+};
+
+/******************************************************************************
+ *                  Structure Definition: Population
+ *                  Description: App names of one benchmark size, with pre-drawn
+ *                               uniform and Zipfian key sequences
+ *****************************************************************************/
+struct Population {
+    std::vector<std::string> names;      // names[i] == appName(i)
+    std::vector<std::size_t> uniform;    // kKeyCount uniformly drawn app numbers
+    std::vector<std::size_t> zipf;       // kKeyCount Zipf(0.99) drawn app numbers
+};
+
+/******************************************************************************
+ *                  Name: population
+ *                  Description: Returns the cached population of a size, building it
+ *                               on first use
+ *                  Arguments: std::size_t size - Number of apps
+ *                  Returns: const Population& - Names and key sequences
+ *****************************************************************************/
+const Population& population(std::size_t size) {
+    static std::mutex mutex;
+    static std::map<std::size_t, std::unique_ptr<Population>> cache;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<Population>& entry = cache[size];
+    if (entry == nullptr) {
+        entry.reset(new Population());
+        entry->names.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            entry->names.push_back(appName(i));
+        }
+        std::mt19937_64 rng(size);
+        std::uniform_int_distribution<std::size_t> pick(0, size - 1);
+        ZipfGenerator zipf(size, 0.99);
+        for (std::size_t k = 0; k < kKeyCount; ++k) {
+            entry->uniform.push_back(pick(rng));
+            // Scatter popular ranks over the key space so they do not share a shard
+            entry->zipf.push_back((zipf(rng) * 2654435761u) % size);
+        }
+    }
+    return *entry;
+}
+
+/******************************************************************************
+ *                  Name: populate
+ *                  Description: Installs every app of a population and grants each
+ *                               two permissions
+ *                  Arguments: Manager& manager - MobileAppManager or ConcurrentAppManager
+ *                             const Population& apps - Apps to install
+ *                  Returns: None
+ *****************************************************************************/
+template <typename Manager>
+void populate(Manager& manager, const Population& apps) {
+    for (std::size_t i = 0; i < apps.names.size(); ++i) {
+        manager.installApp(apps.names[i]);
+        manager.assignPermission(apps.names[i], kPermissions[i % kPermissionCount]);
+        manager.assignPermission(apps.names[i], kPermissions[(i * 7 + 3) % kPermissionCount]);
+    }
+}
+
+/******************************************************************************
+ *                  Name: sharedManager
+ *                  Description: Returns the cached, populated manager of a size.
+ *                               Benchmarks that mutate it restore its state.
+ *                  Arguments: std::size_t size - Number of apps
+ *                  Returns: MobileAppManager& - Populated manager
+ *****************************************************************************/
+MobileAppManager& sharedManager(std::size_t size) {
+    static std::mutex mutex;
+    static std::map<std::size_t, std::unique_ptr<MobileAppManager>> cache;
+    const Population& apps = population(size);
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<MobileAppManager>& entry = cache[size];
+    if (entry == nullptr) {
+        entry.reset(new MobileAppManager(std::make_shared<NullLogSink>()));
+        populate(*entry, apps);
+    }
+    return *entry;
+}
+
+/******************************************************************************
+ *                  Name: sharedConcurrentManager
+ *                  Description: Returns the cached, populated sharded manager of a size
+ *                  Arguments: std::size_t size - Number of apps
+ *                  Returns: ConcurrentAppManager& - Populated manager
+ *****************************************************************************/
+ConcurrentAppManager& sharedConcurrentManager(std::size_t size) {
+    static std::mutex mutex;
+    static std::map<std::size_t, std::unique_ptr<ConcurrentAppManager>> cache;
+    const Population& apps = population(size);
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<ConcurrentAppManager>& entry = cache[size];
+    if (entry == nullptr) {
+        entry.reset(new ConcurrentAppManager(16, std::make_shared<NullLogSink>()));
+        populate(*entry, apps);
+    }
+    return *entry;
+}
+
+/******************************************************************************
+ *                  Name: sizes
+ *                  Description: Registers the 1k, 100k and 1M registry sizes
+ *                  Arguments: benchmark::internal::Benchmark* bench - Benchmark to configure
+ *                  Returns: None
+ *****************************************************************************/
+void sizes(benchmark::internal::Benchmark* bench) {
+    bench->Arg(1000)->Arg(100000)->Arg(1000000);
+}
+
+/******************************************************************************
+ *                  Name: mixedSizes
+ *                  Description: Registers each size with 95% and 50% read ratios
+ *                  Arguments: benchmark::internal::Benchmark* bench - Benchmark to configure
+ *                  Returns: None
+ *****************************************************************************/
+void mixedSizes(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"apps", "readPct"});
+    for (int64_t size : {1000, 100000, 1000000}) {
+        for (int64_t readPercent : {95, 50}) {
+            bench->Args({size, readPercent});
+        }
+    }
+}
+
+}  // namespace
+
+/******************************************************************************
+ *                  Benchmark: BM_InstallApps
+ *                  Description: Fills an empty manager with N apps
+ *****************************************************************************/
+static void BM_InstallApps(benchmark::State& state) {
+    const Population& apps = population(state.range(0));
+    for (auto _ : state) {
+        MobileAppManager manager(std::make_shared<NullLogSink>());
+        for (const std::string& name : apps.names) {
+            manager.installApp(name);
+        }
+        benchmark::DoNotOptimize(manager);
+    }
+    state.SetItemsProcessed(state.iterations() * apps.names.size());
+}
+BENCHMARK(BM_InstallApps)->Apply(sizes)->Unit(benchmark::kMillisecond);
+
+/******************************************************************************
+ *                  Benchmark: BM_InstallUninstall
+ *                  Description: Installs and uninstalls one extra app in a manager
+ *                               holding N apps
+ *****************************************************************************/
+static void BM_InstallUninstall(benchmark::State& state) {
+    MobileAppManager& manager = sharedManager(state.range(0));
+    std::vector<std::string> extras;
+    for (std::size_t i = 0; i < 1024; ++i) {
+        extras.push_back("com.bench.extra" + std::to_string(i));
+    }
+    std::size_t k = 0;
+    for (auto _ : state) {
+        const std::string& name = extras[k++ & 1023];
+        benchmark::DoNotOptimize(manager.installApp(name));
+        benchmark::DoNotOptimize(manager.uninstallApp(name));
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_InstallUninstall)->Apply(sizes);
+
+/******************************************************************************
+ *                  Benchmark: BM_HasPermission
+ *                  Description: Uniformly random permission checks
+ *****************************************************************************/
+static void BM_HasPermission(benchmark::State& state) {
+    const Population& apps = population(state.range(0));
+    MobileAppManager& manager = sharedManager(state.range(0));
+    std::size_t k = 0;
+    for (auto _ : state) {
+        std::size_t i = apps.uniform[k++ & (kKeyCount - 1)];
+        benchmark::DoNotOptimize(manager.hasPermission(apps.names[i], "CAMERA"));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HasPermission)->Apply(sizes);
+
+/******************************************************************************
+ *                  Benchmark: BM_AssignRevoke
+ *                  Description: Grants and revokes a permission on random apps
+ *****************************************************************************/
+static void BM_AssignRevoke(benchmark::State& state) {
+    const Population& apps = population(state.range(0));
+    MobileAppManager& manager = sharedManager(state.range(0));
+    std::size_t k = 0;
+    for (auto _ : state) {
+        const std::string& name = apps.names[apps.uniform[k++ & (kKeyCount - 1)]];
+        benchmark::DoNotOptimize(manager.assignPermission(name, "BENCH_TEMP"));
+        benchmark::DoNotOptimize(manager.revokePermission(name, "BENCH_TEMP"));
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_AssignRevoke)->Apply(sizes);
+
+/******************************************************************************
+ *                  Benchmark: BM_ListAppPermissions
+ *                  Description: Copies the permission list of random apps
+ *****************************************************************************/
+static void BM_ListAppPermissions(benchmark::State& state) {
+    const Population& apps = population(state.range(0));
+    MobileAppManager& manager = sharedManager(state.range(0));
+    std::size_t k = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.listAppPermissions(apps.names[apps.uniform[k++ & (kKeyCount - 1)]]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ListAppPermissions)->Apply(sizes);
+
+/******************************************************************************
+ *                  Benchmark: BM_ListInstalledApps
+ *                  Description: Copies the full sorted app list
+ *****************************************************************************/
+static void BM_ListInstalledApps(benchmark::State& state) {
+    MobileAppManager& manager = sharedManager(state.range(0));
+    manager.listInstalledApps("", 1);   // Rebuild the sorted view outside the timed loop
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.listInstalledApps());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ListInstalledApps)->Apply(sizes)->Unit(benchmark::kMicrosecond);
+
+/******************************************************************************
+ *                  Benchmark: BM_ListInstalledAppsPage
+ *                  Description: Reads one 100-name page at a random position
+ *****************************************************************************/
+static void BM_ListInstalledAppsPage(benchmark::State& state) {
+    const Population& apps = population(state.range(0));
+    MobileAppManager& manager = sharedManager(state.range(0));
+    manager.listInstalledApps("", 1);
+    std::size_t k = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.listInstalledApps(apps.names[apps.uniform[k++ & (kKeyCount - 1)]], 100));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ListInstalledAppsPage)->Apply(sizes);
+
+/******************************************************************************
+ *                  Benchmark: BM_AppsWithPermission
+ *                  Description: Reads the holders of a permission from the reverse index
+ *****************************************************************************/
+static void BM_AppsWithPermission(benchmark::State& state) {
+    MobileAppManager& manager = sharedManager(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.appsWithPermission("CAMERA"));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AppsWithPermission)->Apply(sizes)->Unit(benchmark::kMicrosecond);
+
+/******************************************************************************
+ *                  Benchmark: BM_FindApps
+ *                  Description: Reads a 100-name page of a random prefix
+ *****************************************************************************/
+static void BM_FindApps(benchmark::State& state) {
+    const Population& apps = population(state.range(0));
+    MobileAppManager& manager = sharedManager(state.range(0));
+    std::size_t k = 0;
+    for (auto _ : state) {
+        const std::string& name = apps.names[apps.uniform[k++ & (kKeyCount - 1)]];
+        benchmark::DoNotOptimize(manager.findApps(std::string_view(name).substr(0, name.size() - 1), "", 100));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FindApps)->Apply(sizes);
+
+/******************************************************************************
+ *                  Benchmark: BM_SearchApps
+ *                  Description: Reads a 100-name page of the names containing a
+ *                               rare substring, then of a very common one
+ *****************************************************************************/
+static void BM_SearchApps(benchmark::State& state) {
+    const Population& apps = population(state.range(0));
+    MobileAppManager& manager = sharedManager(state.range(0));
+    std::size_t k = 0;
+    for (auto _ : state) {
+        const std::string& name = apps.names[apps.uniform[k++ & (kKeyCount - 1)]];
+        benchmark::DoNotOptimize(manager.searchApps(std::string_view(name).substr(name.size() - 5), "", 100));
+        benchmark::DoNotOptimize(manager.searchApps("bench", "", 100));
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_SearchApps)->Apply(sizes);
+
+/******************************************************************************
+ *                  Benchmark: BM_SnapshotRoundTrip
+ *                  Description: Saves and reloads a binary snapshot of N apps
+ *****************************************************************************/
+static void BM_SnapshotRoundTrip(benchmark::State& state) {
+    MobileAppManager& source = sharedManager(state.range(0));
+    const std::string path = "bench_snapshot.bin";
+    MobileAppManager target(std::make_shared<NullLogSink>());
+    source.listInstalledApps("", 1);
+    for (auto _ : state) {
+        source.saveSnapshot(path);
+        benchmark::DoNotOptimize(target.loadSnapshot(path));
+    }
+    std::remove(path.c_str());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SnapshotRoundTrip)->Apply(sizes)->Unit(benchmark::kMillisecond);
+
+/******************************************************************************
+ *                  Benchmark: BM_SnapshotStartup
+ *                  Description: Loads a saved snapshot of N apps and answers one
+ *                               permission check, the work done before a
+ *                               restarted registry can serve
+ *****************************************************************************/
+static void BM_SnapshotStartup(benchmark::State& state) {
+    MobileAppManager& source = sharedManager(state.range(0));
+    const Population& apps = population(state.range(0));
+    const std::string path = "bench_startup.bin";
+    source.saveSnapshot(path);
+    MobileAppManager target(std::make_shared<NullLogSink>());
+    std::size_t k = 0;
+    for (auto _ : state) {
+        target.loadSnapshot(path);
+        benchmark::DoNotOptimize(target.hasPermission(apps.names[k++ % apps.names.size()], kPermissions[0]));
+    }
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_SnapshotStartup)->Apply(sizes);
+
+/******************************************************************************
+ *                  Benchmark: BM_RecordRoundTrip
+ *                  Description: Exports N apps as JSON Lines or CSV and imports them
+ *                               into an empty registry
+ *****************************************************************************/
+static void BM_RecordRoundTrip(benchmark::State& state) {
+    MobileAppManager& source = sharedManager(state.range(0));
+    RecordFormat format = state.range(1) == 0 ? RecordFormat::JsonLines : RecordFormat::Csv;
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        std::stringstream records;
+        source.exportTo(records, format);
+        bytes += records.str().size();
+        MobileAppManager target(std::make_shared<NullLogSink>());
+        benchmark::DoNotOptimize(target.importFrom(records, format));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+}
+BENCHMARK(BM_RecordRoundTrip)
+    ->ArgNames({"apps", "csv"})
+    ->Args({1000, 0})->Args({1000, 1})->Args({100000, 0})->Args({100000, 1})
+    ->Unit(benchmark::kMillisecond);
+
+/******************************************************************************
+ *                  Benchmark: BM_TimerWheelTick
+ *                  Description: Advances a wheel holding N far-off timers one tick
+ *                               at a time while scheduling and cancelling one timer,
+ *                               the steady state of a registry with many pending
+ *                               timed grants
+ *****************************************************************************/
+static void BM_TimerWheelTick(benchmark::State& state) {
+    TimerWheel<std::uint32_t> wheel;
+    std::mt19937_64 random(7);
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        wheel.schedule(3600000 + random() % 86400000, static_cast<std::uint32_t>(i));
+    }
+    std::uint64_t now = 0;
+    for (auto _ : state) {
+        TimerWheel<std::uint32_t>::TimerId id = wheel.schedule(now + 900000, 0);
+        benchmark::DoNotOptimize(wheel.advance(++now, [](std::uint32_t) {}));
+        wheel.cancel(id);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimerWheelTick)->Arg(1000)->Arg(1000000);
+
+/******************************************************************************
+ *                  Benchmark: BM_AppAddRemovePermission
+ *                  Description: Adds and removes a permission on a single App
+ *****************************************************************************/
+static void BM_AppAddRemovePermission(benchmark::State& state) {
+    App app("com.bench.single");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(app.addPermission("CAMERA"));
+        benchmark::DoNotOptimize(app.removePermission("CAMERA"));
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_AppAddRemovePermission);
+
+/******************************************************************************
+ *                  Benchmark: BM_AppHasPermission
+ *                  Description: Checks a permission on an App holding all of them
+ *****************************************************************************/
+static void BM_AppHasPermission(benchmark::State& state) {
+    App app("com.bench.single");
+    for (const char* permission : kPermissions) {
+        app.addPermission(permission);
+    }
+    std::size_t k = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(app.hasPermission(kPermissions[k++ % kPermissionCount]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AppHasPermission);
+
+/******************************************************************************
+ *                  Benchmark: BM_AppGetPermissions
+ *                  Description: Copies the permission list of an App holding all of them
+ *****************************************************************************/
+static void BM_AppGetPermissions(benchmark::State& state) {
+    App app("com.bench.single");
+    for (const char* permission : kPermissions) {
+        app.addPermission(permission);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(app.getPermissions());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AppGetPermissions);
+
+/******************************************************************************
+ *                  Benchmark: BM_MixedZipf
+ *                  Description: Zipf-distributed mix of permission checks and
+ *                               grant/revoke pairs on one manager
+ *****************************************************************************/
+static void BM_MixedZipf(benchmark::State& state) {
+    const Population& apps = population(state.range(0));
+    MobileAppManager& manager = sharedManager(state.range(0));
+    const std::size_t readPercent = state.range(1);
+    std::size_t k = 0;
+    for (auto _ : state) {
+        const std::string& name = apps.names[apps.zipf[k & (kKeyCount - 1)]];
+        if (k++ % 100 < readPercent) {
+            benchmark::DoNotOptimize(manager.hasPermission(name, "LOCATION"));
+        } else {
+            manager.assignPermission(name, "BENCH_TEMP");
+            manager.revokePermission(name, "BENCH_TEMP");
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MixedZipf)->Apply(mixedSizes);
+
+/******************************************************************************
+ *                  Benchmark: BM_ConcurrentMixedZipf
+ *                  Description: The Zipfian mix against the sharded manager from
+ *                               1 to 8 threads; each thread walks the key sequence
+ *                               from its own offset
+ *****************************************************************************/
+static void BM_ConcurrentMixedZipf(benchmark::State& state) {
+    const Population& apps = population(state.range(0));
+    ConcurrentAppManager& manager = sharedConcurrentManager(state.range(0));
+    const std::size_t readPercent = state.range(1);
+    const std::string permission = "BENCH_TEMP" + std::to_string(state.thread_index());
+    std::size_t k = state.thread_index() * (kKeyCount / 8);
+    for (auto _ : state) {
+        const std::string& name = apps.names[apps.zipf[k & (kKeyCount - 1)]];
+        if (k++ % 100 < readPercent) {
+            benchmark::DoNotOptimize(manager.hasPermission(name, "LOCATION"));
+        } else {
+            manager.assignPermission(name, permission);
+            manager.revokePermission(name, permission);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConcurrentMixedZipf)->Apply(mixedSizes)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
+
+/******************************** End of File ********************************/
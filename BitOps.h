@@ -0,0 +1,145 @@
+
+/******************************************************************************
+ *                    File Name: BitOps.h
+ *                    Description: Header file for portable bit scans and population
+ *                                 counts on 32- and 64-bit words
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __BIT_OPS_H__
+#define __BIT_OPS_H__
+
+#include <cstdint>
+
+#if __cplusplus >= 202002L && __has_include(<bit>)
+#include <bit>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// C++20 <bit> first, then the GCC/Clang builtins, then the MSVC intrinsics; the
+// plain loops only serve compilers with none of them
+#if defined(__cpp_lib_bitops)
+#define BIT_OPS_STD 1
+#elif defined(__GNUC__) || defined(__clang__)
+#define BIT_OPS_BUILTIN 1
+#elif defined(_MSC_VER)
+#define BIT_OPS_MSVC 1
+#endif
+
+/******************************************************************************
+ *                  Name: countTrailingZeros
+ *                  Description: Returns the index of the lowest set bit
+ *                  Arguments: std::uint64_t bits - Non-zero word
+ *                  Returns: unsigned - Bit index, 0 for the lowest bit
+ *****************************************************************************/
+inline unsigned countTrailingZeros(std::uint64_t bits) {
+#if defined(BIT_OPS_STD)
+    return static_cast<unsigned>(std::countr_zero(bits));
+#elif defined(BIT_OPS_BUILTIN)
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#elif defined(BIT_OPS_MSVC) && defined(_WIN64)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<unsigned>(index);
+#elif defined(BIT_OPS_MSVC)
+    unsigned long index;
+    if (_BitScanForward(&index, static_cast<unsigned long>(bits))) {
+        return static_cast<unsigned>(index);
+    }
+    _BitScanForward(&index, static_cast<unsigned long>(bits >> 32));
+    return static_cast<unsigned>(index) + 32;
+#else
+    unsigned index = 0;
+    while ((bits & 1) == 0) {
+        bits >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+/******************************************************************************
+ *                  Name: countTrailingZeros32
+ *                  Description: Returns the index of the lowest set bit of a 32-bit
+ *                               word; a separate name keeps integer arguments from
+ *                               being ambiguous between the two widths
+ *                  Arguments: std::uint32_t bits - Non-zero word
+ *                  Returns: unsigned - Bit index, 0 for the lowest bit
+ *****************************************************************************/
+inline unsigned countTrailingZeros32(std::uint32_t bits) {
+#if defined(BIT_OPS_STD)
+    return static_cast<unsigned>(std::countr_zero(bits));
+#elif defined(BIT_OPS_BUILTIN)
+    return static_cast<unsigned>(__builtin_ctz(bits));
+#elif defined(BIT_OPS_MSVC)
+    unsigned long index;
+    _BitScanForward(&index, bits);
+    return static_cast<unsigned>(index);
+#else
+    return countTrailingZeros(static_cast<std::uint64_t>(bits));
+#endif
+}
+
+/******************************************************************************
+ *                  Name: highestSetBit
+ *                  Description: Returns the index of the highest set bit
+ *                  Arguments: std::uint64_t bits - Non-zero word
+ *                  Returns: unsigned - Bit index, 0 for the lowest bit
+ *****************************************************************************/
+inline unsigned highestSetBit(std::uint64_t bits) {
+#if defined(BIT_OPS_STD)
+    return static_cast<unsigned>(63 - std::countl_zero(bits));
+#elif defined(BIT_OPS_BUILTIN)
+    return static_cast<unsigned>(63 - __builtin_clzll(bits));
+#elif defined(BIT_OPS_MSVC) && defined(_WIN64)
+    unsigned long index;
+    _BitScanReverse64(&index, bits);
+    return static_cast<unsigned>(index);
+#elif defined(BIT_OPS_MSVC)
+    unsigned long index;
+    if (_BitScanReverse(&index, static_cast<unsigned long>(bits >> 32))) {
+        return static_cast<unsigned>(index) + 32;
+    }
+    _BitScanReverse(&index, static_cast<unsigned long>(bits));
+    return static_cast<unsigned>(index);
+#else
+    unsigned index = 0;
+    while (bits >>= 1) {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+/******************************************************************************
+ *                  Name: popCount
+ *                  Description: Counts the set bits of a word
+ *                  Arguments: std::uint64_t bits - Word to count
+ *                  Returns: unsigned - Set bits
+ *****************************************************************************/
+inline unsigned popCount(std::uint64_t bits) {
+#if defined(BIT_OPS_STD)
+    return static_cast<unsigned>(std::popcount(bits));
+#elif defined(BIT_OPS_BUILTIN)
+    return static_cast<unsigned>(__builtin_popcountll(bits));
+#elif defined(BIT_OPS_MSVC) && defined(_WIN64)
+    return static_cast<unsigned>(__popcnt64(bits));
+#else
+    bits = bits - ((bits >> 1) & 0x5555555555555555ULL);
+    bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+    bits = (bits + (bits >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return static_cast<unsigned>((bits * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+#endif
+
+/******************************** End of File ********************************/
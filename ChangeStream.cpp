@@ -0,0 +1,281 @@
+
+/******************************************************************************
+ *                    File Name: ChangeStream.cpp
+ *                    Description: Implementation file for the change event stream
+ *                                 and its subscriptions
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "ChangeStream.h"
+#include <algorithm>  // For std::max, std::min
+#include <thread>     // For std::this_thread::yield
+#include <utility>
+
+namespace {
+
+constexpr std::size_t kTextWords = ChangeStream::kMaxText / sizeof(std::uint64_t);
+
+/******************************************************************************
+ *                  Name: readyStamp
+ *                  Description: Returns the stamp of a slot holding a sequence
+ *                  Arguments: std::uint64_t sequence - Event sequence
+ *                  Returns: std::uint64_t - Stamp; sequence * 2 + 1 marks a write
+ *                           in progress and 0 a slot never written
+ *****************************************************************************/
+std::uint64_t readyStamp(std::uint64_t sequence) {
+    return sequence * 2 + 2;
+}
+
+}  // namespace
+
+/******************************************************************************
+ *                  Structure Definition: Slot
+ *                  Description: One event. Fields are atomics so a reader can copy
+ *                               a slot while it is being overwritten; the stamp
+ *                               read before and after the copy tells whether the
+ *                               copy is whole.
+ *****************************************************************************/
+struct alignas(64) ChangeStream::Slot {
+    std::atomic<std::uint64_t> stamp{0};            // readyStamp() of the event held
+    std::atomic<std::uint64_t> header{0};           // type | truncated << 8 | app length << 16
+                                                    // | permission length << 32
+    std::atomic<std::uint64_t> text[kTextWords];    // App name, then permission
+
+    Slot() {
+        for (std::atomic<std::uint64_t>& word : text) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+/******************************************************************************
+ *                  Constructor: ChangeStream
+ *                  Description: Allocates a power-of-two number of slots
+ *                  Arguments: std::size_t capacity - Minimum number of slots
+ *                  Returns: None
+ *****************************************************************************/
+ChangeStream::ChangeStream(std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity) {
+        size *= 2;
+    }
+    slots.reset(new Slot[size]);
+    mask = size - 1;
+}
+
+/******************************************************************************
+ *                  Destructor: ChangeStream
+ *                  Description: Releases the slots
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+ChangeStream::~ChangeStream() = default;
+
+/******************************************************************************
+ *                  Name: publish
+ *                  Description: Claims a sequence, waits only for a writer still
+ *                               copying the same slot one lap earlier, then writes
+ *                               the event between an odd and a ready stamp
+ *                  Arguments: ChangeType type - Kind of change
+ *                             std::string_view appName - Affected app
+ *                             std::string_view permission - Affected permission, if any
+ *                  Returns: std::uint64_t - Sequence number of the event
+ *****************************************************************************/
+std::uint64_t ChangeStream::publish(ChangeType type, std::string_view appName, std::string_view permission) {
+    bool truncated = appName.size() + permission.size() > kMaxText;
+    if (truncated) {
+        permission = permission.substr(0, std::min(permission.size(), kMaxText / 2));
+        appName = appName.substr(0, kMaxText - permission.size());
+    }
+    std::uint64_t words[kTextWords] = {};
+    appName.copy(reinterpret_cast<char*>(words), appName.size());
+    permission.copy(reinterpret_cast<char*>(words) + appName.size(), permission.size());
+    std::size_t used = (appName.size() + permission.size() + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    std::uint64_t sequence = next.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots[sequence & mask];
+    std::uint64_t previous = sequence > mask ? readyStamp(sequence - (mask + 1)) : 0;
+    while (slot.stamp.load(std::memory_order_acquire) != previous) {
+        std::this_thread::yield();
+    }
+
+    slot.stamp.store(readyStamp(sequence) - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.header.store(static_cast<std::uint64_t>(type) | (std::uint64_t(truncated) << 8) |
+                          (std::uint64_t(appName.size()) << 16) | (std::uint64_t(permission.size()) << 32),
+                      std::memory_order_relaxed);
+    for (std::size_t i = 0; i < used; ++i) {
+        slot.text[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.stamp.store(readyStamp(sequence), std::memory_order_release);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(waitMutex);
+        wakeup.notify_all();
+    }
+    return sequence;
+}
+
+/******************************************************************************
+ *                  Name: head
+ *                  Description: Returns the sequence the next event will get
+ *                  Arguments: None
+ *                  Returns: std::uint64_t - Number of events claimed so far
+ *****************************************************************************/
+std::uint64_t ChangeStream::head() const {
+    return next.load(std::memory_order_acquire);
+}
+
+/******************************************************************************
+ *                  Name: capacity
+ *                  Description: Returns the number of slots
+ *                  Arguments: None
+ *                  Returns: std::size_t - Slot count
+ *****************************************************************************/
+std::size_t ChangeStream::capacity() const {
+    return mask + 1;
+}
+
+/******************************************************************************
+ *                  Name: read
+ *                  Description: Copies one event out of its slot, checking the stamp
+ *                               before and after the copy
+ *                  Arguments: std::uint64_t sequence - Event to read
+ *                             ChangeEvent& event - Receives the event when Ready
+ *                  Returns: ReadResult - Ready, Pending (not written yet) or
+ *                           Overwritten (a later lap reused the slot)
+ *****************************************************************************/
+ChangeStream::ReadResult ChangeStream::read(std::uint64_t sequence, ChangeEvent& event) const {
+    const Slot& slot = slots[sequence & mask];
+    std::uint64_t wanted = readyStamp(sequence);
+    std::uint64_t before = slot.stamp.load(std::memory_order_acquire);
+    if (before != wanted) {
+        return before < wanted ? ReadResult::Pending : ReadResult::Overwritten;
+    }
+
+    std::uint64_t header = slot.header.load(std::memory_order_relaxed);
+    std::size_t appLength = std::min<std::size_t>((header >> 16) & 0xffff, kMaxText);
+    std::size_t permissionLength = std::min<std::size_t>((header >> 32) & 0xffff, kMaxText - appLength);
+    std::size_t used = (appLength + permissionLength + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+    std::uint64_t words[kTextWords];
+    for (std::size_t i = 0; i < used; ++i) {
+        words[i] = slot.text[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.stamp.load(std::memory_order_relaxed) != wanted) {
+        return ReadResult::Overwritten;
+    }
+
+    const char* text = reinterpret_cast<const char*>(words);
+    event.sequence = sequence;
+    event.type = static_cast<ChangeType>(header & 0xff);
+    event.truncated = ((header >> 8) & 0xff) != 0;
+    event.appName.assign(text, appLength);
+    event.permission.assign(text + appLength, permissionLength);
+    return ReadResult::Ready;
+}
+
+/******************************************************************************
+ *                  Name: waitPast
+ *                  Description: Sleeps until the slot of a sequence is written (or
+ *                               already overwritten) or the timeout passes
+ *                  Arguments: std::uint64_t sequence - Event waited for
+ *                             std::chrono::milliseconds timeout - Longest wait
+ *                  Returns: bool - False on timeout
+ *****************************************************************************/
+bool ChangeStream::waitPast(std::uint64_t sequence, std::chrono::milliseconds timeout) const {
+    const Slot& slot = slots[sequence & mask];
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+    bool written;
+    {
+        std::unique_lock<std::mutex> lock(waitMutex);
+        written = wakeup.wait_for(lock, timeout, [&] {
+            return slot.stamp.load(std::memory_order_seq_cst) >= readyStamp(sequence);
+        });
+    }
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+    return written;
+}
+
+/******************************************************************************
+ *                  Constructor: ChangeSubscription
+ *                  Description: Starts following a stream at its current head
+ *                  Arguments: std::shared_ptr<ChangeStream> stream - Stream to follow
+ *                  Returns: None
+ *****************************************************************************/
+ChangeSubscription::ChangeSubscription(std::shared_ptr<ChangeStream> source)
+    : stream(std::move(source)), cursor(stream->head()) {}
+
+/******************************************************************************
+ *                  Name: poll
+ *                  Description: Reads the event at the cursor. If it was overwritten,
+ *                               jumps to the oldest event the ring still holds and
+ *                               counts the skipped ones.
+ *                  Arguments: ChangeEvent& event - Receives the event
+ *                  Returns: bool - False if no new event has been published
+ *****************************************************************************/
+bool ChangeSubscription::poll(ChangeEvent& event) {
+    for (;;) {
+        switch (stream->read(cursor, event)) {
+        case ChangeStream::ReadResult::Ready:
+            ++cursor;
+            return true;
+        case ChangeStream::ReadResult::Pending:
+            return false;
+        case ChangeStream::ReadResult::Overwritten: {
+            std::uint64_t head = stream->head();
+            std::uint64_t oldest = head > stream->capacity() ? head - stream->capacity() : 0;
+            std::uint64_t resume = std::max(oldest, cursor + 1);
+            skipped += resume - cursor;
+            cursor = resume;
+            break;
+        }
+        }
+    }
+}
+
+/******************************************************************************
+ *                  Name: wait
+ *                  Description: Polls, sleeping on the stream between attempts
+ *                  Arguments: ChangeEvent& event - Receives the event
+ *                             std::chrono::milliseconds timeout - Longest wait
+ *                  Returns: bool - False on timeout
+ *****************************************************************************/
+bool ChangeSubscription::wait(ChangeEvent& event, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!poll(event)) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0 || !stream->waitPast(cursor, remaining)) {
+            return poll(event);
+        }
+    }
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: position
+ *                  Description: Returns the sequence of the next event to deliver
+ *                  Arguments: None
+ *                  Returns: std::uint64_t - Cursor
+ *****************************************************************************/
+std::uint64_t ChangeSubscription::position() const {
+    return cursor;
+}
+
+/******************************************************************************
+ *                  Name: missed
+ *                  Description: Returns how many events were overwritten unread
+ *                  Arguments: None
+ *                  Returns: std::uint64_t - Events skipped over all gaps
+ *****************************************************************************/
+std::uint64_t ChangeSubscription::missed() const {
+    return skipped;
+}
+
+/******************************** End of File ********************************/
@@ -0,0 +1,197 @@
+
+/******************************************************************************
+ *                    File Name: ChangeStream.h
+ *                    Description: Header file for ChangeStream, a bounded broadcast
+ *                                 ring of registry change events, and its
+ *                                 subscriptions
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __CHANGE_STREAM_H__
+#define __CHANGE_STREAM_H__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+/******************************************************************************
+ *                  Enum Definition: ChangeType
+ *                  Description: Kind of state change an event reports
+ *****************************************************************************/
+
+enum class ChangeType : std::uint8_t {
+    Installed,          // App installed
+    Uninstalled,        // App uninstalled, with all its permissions
+    PermissionGranted,  // App gained a permission it did not hold
+    PermissionRevoked,  // App lost a permission it held
+    Reset,              // State replaced wholesale (snapshot load, recovery); resync
+    GroupAssigned,      // App gained a permission group; permission holds the group name
+    GroupRevoked        // App lost a permission group; permission holds the group name
+};
+
+/******************************************************************************
+ *                  Structure Definition: ChangeEvent
+ *                  Description: One change as delivered to a subscriber
+ *****************************************************************************/
+
+struct ChangeEvent {
+    std::uint64_t sequence = 0;          // Position in the stream, from 0 with no gaps
+    ChangeType type = ChangeType::Reset; // What changed
+    std::string appName;                 // Affected app; empty for Reset
+    std::string permission;              // Affected permission, if any
+    bool truncated = false;              // Names exceeded the slot and were cut short
+};
+
+/******************************************************************************
+ *                  Class Definition: ChangeStream
+ *                  Description: Fixed ring of event slots that any number of
+ *                               writers publish into and any number of
+ *                               subscriptions read independently. A writer claims
+ *                               the next sequence number with one atomic add and
+ *                               copies the event into its slot; it never waits for
+ *                               readers. Each slot carries a stamp derived from the
+ *                               sequence it holds, so a reader can tell a slot that
+ *                               is not yet written from one that has already been
+ *                               overwritten by a later lap; the latter is reported
+ *                               as a gap. Names longer than the slot holds (more
+ *                               than kMaxText bytes together) are truncated and
+ *                               flagged.
+ *****************************************************************************/
+
+class ChangeStream {
+public:
+    static constexpr std::size_t kMaxText = 496;   // Bytes of app and permission name per slot
+
+    /******************************************************************************
+     *                  Name: ChangeStream
+     *                  Description: Constructor allocating the slots
+     *                  Arguments: std::size_t capacity - Events kept before the oldest is
+     *                                                    overwritten; rounded up to a
+     *                                                    power of two
+     *                  Returns: None
+     *****************************************************************************/
+    explicit ChangeStream(std::size_t capacity = 4096);
+
+    ~ChangeStream();
+    ChangeStream(const ChangeStream&) = delete;
+    ChangeStream& operator=(const ChangeStream&) = delete;
+
+    /******************************************************************************
+     *                  Name: publish
+     *                  Description: Appends an event and wakes any waiting subscriber
+     *                  Arguments: ChangeType type - Kind of change
+     *                             std::string_view appName - Affected app
+     *                             std::string_view permission - Affected permission, if any
+     *                  Returns: std::uint64_t - Sequence number of the event
+     *****************************************************************************/
+    std::uint64_t publish(ChangeType type, std::string_view appName, std::string_view permission = std::string_view());
+
+    /******************************************************************************
+     *                  Name: head
+     *                  Description: Returns the sequence the next event will get
+     *                  Arguments: None
+     *                  Returns: std::uint64_t - Number of events claimed so far
+     *****************************************************************************/
+    std::uint64_t head() const;
+
+    /******************************************************************************
+     *                  Name: capacity
+     *                  Description: Returns the number of slots
+     *                  Arguments: None
+     *                  Returns: std::size_t - Slot count
+     *****************************************************************************/
+    std::size_t capacity() const;
+
+private:
+    friend class ChangeSubscription;
+
+    struct Slot;
+
+    enum class ReadResult { Ready, Pending, Overwritten };
+
+    ReadResult read(std::uint64_t sequence, ChangeEvent& event) const;
+    bool waitPast(std::uint64_t sequence, std::chrono::milliseconds timeout) const;
+
+    std::unique_ptr<Slot[]> slots;             // Ring storage
+    std::size_t mask;                          // capacity - 1
+    alignas(64) std::atomic<std::uint64_t> next{0};   // Next sequence to claim
+    alignas(64) mutable std::atomic<int> waiters{0};  // Subscribers blocked in wait
+    mutable std::mutex waitMutex;                     // Pairs with wakeup
+    mutable std::condition_variable wakeup;           // Signalled on publish while waiters > 0
+};
+
+/******************************************************************************
+ *                  Class Definition: ChangeSubscription
+ *                  Description: A reader's cursor into a ChangeStream. Each
+ *                               subscription sees every event from its start point
+ *                               on, unless it falls more than a ring's length
+ *                               behind; it then skips to the oldest event still
+ *                               held and counts the lost ones in missed(). Used by
+ *                               one thread at a time.
+ *****************************************************************************/
+
+class ChangeSubscription {
+public:
+    /******************************************************************************
+     *                  Name: ChangeSubscription
+     *                  Description: Constructor starting at the stream's current head,
+     *                               so only later events are delivered
+     *                  Arguments: std::shared_ptr<ChangeStream> stream - Stream to follow
+     *                  Returns: None
+     *****************************************************************************/
+    explicit ChangeSubscription(std::shared_ptr<ChangeStream> stream);
+
+    /******************************************************************************
+     *                  Name: poll
+     *                  Description: Returns the next event if one is available
+     *                  Arguments: ChangeEvent& event - Receives the event
+     *                  Returns: bool - False if no new event has been published
+     *****************************************************************************/
+    bool poll(ChangeEvent& event);
+
+    /******************************************************************************
+     *                  Name: wait
+     *                  Description: Returns the next event, sleeping until one is
+     *                               published or the timeout passes
+     *                  Arguments: ChangeEvent& event - Receives the event
+     *                             std::chrono::milliseconds timeout - Longest wait
+     *                  Returns: bool - False on timeout
+     *****************************************************************************/
+    bool wait(ChangeEvent& event, std::chrono::milliseconds timeout);
+
+    /******************************************************************************
+     *                  Name: position
+     *                  Description: Returns the sequence of the next event to deliver
+     *                  Arguments: None
+     *                  Returns: std::uint64_t - Cursor
+     *****************************************************************************/
+    std::uint64_t position() const;
+
+    /******************************************************************************
+     *                  Name: missed
+     *                  Description: Returns how many events were overwritten before
+     *                               this subscription read them
+     *                  Arguments: None
+     *                  Returns: std::uint64_t - Events skipped over all gaps
+     *****************************************************************************/
+    std::uint64_t missed() const;
+
+private:
+    std::shared_ptr<ChangeStream> stream;   // Stream being followed
+    std::uint64_t cursor;                   // Next sequence to deliver
+    std::uint64_t skipped = 0;              // Events lost to overruns
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,456 @@
+
+/******************************************************************************
+ *                    File Name: CommandProcessor.cpp
+ *                    Description: Implementation file for the command file processor
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "CommandProcessor.h"
+#include "Journal.h"
+#include <algorithm>  // For std::max, std::min
+#include <chrono>
+#include <condition_variable>
+#include <cstring>    // For std::memchr
+#include <fstream>
+#include <iomanip>    // For std::setprecision
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::size_t kOutputFlushBytes = 1 << 16;   // List output buffered before a write
+constexpr std::chrono::milliseconds kPollInterval(50);
+
+/******************************************************************************
+ *                  Name: isBlank
+ *                  Description: Checks for a token separator
+ *                  Arguments: char c - Character to test
+ *                  Returns: bool - True for space and tab
+ *****************************************************************************/
+bool isBlank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+}  // namespace
+
+/******************************************************************************
+ *                  Structure Definition: Chunk
+ *                  Description: A run of whole lines and, once parsed, its commands.
+ *                               Chunks are recycled through the pipeline window so
+ *                               their buffers are reused.
+ *****************************************************************************/
+struct CommandProcessor::Chunk {
+    std::string storage;                     // Bytes read from a stream; unused for mapped input
+    std::string_view text;                   // The chunk's lines
+    std::vector<Command> commands;           // Parsed commands in line order
+    std::vector<std::uint32_t> malformed;    // Chunk-relative numbers of malformed lines
+    std::uint32_t lines = 0;                 // Lines in the chunk
+    bool parsed = false;                     // Set by the parser under the pipeline lock
+};
+
+/******************************************************************************
+ *                  Name: summary
+ *                  Description: Formats the totals with line and byte throughput
+ *                  Arguments: None
+ *                  Returns: std::string - One-line report
+ *****************************************************************************/
+std::string CommandStats::summary() const {
+    double elapsed = seconds > 0 ? seconds : 1e-9;
+    std::ostringstream report;
+    report << lines << " lines, " << commands << " commands (" << failed << " failed, " << malformed
+           << " malformed) in " << std::fixed << std::setprecision(3) << seconds << " s: " << std::setprecision(0)
+           << lines / elapsed << " lines/s, " << std::setprecision(1) << bytes / elapsed / (1 << 20) << " MiB/s";
+    return report.str();
+}
+
+/******************************************************************************
+ *                  Constructor: CommandProcessor
+ *                  Description: Binds the manager and streams
+ *                  Arguments: MobileAppManager& manager - Registry commands apply to
+ *                             std::ostream& output - Receives list output
+ *                             std::ostream& errors - Receives malformed-line reports
+ *                             CommandOptions options - Pipeline tuning
+ *                  Returns: None
+ *****************************************************************************/
+CommandProcessor::CommandProcessor(MobileAppManager& target, std::ostream& out, std::ostream& err,
+                                   CommandOptions tuning)
+    : manager(target), output(out), errors(err), options(tuning) {}
+
+/******************************************************************************
+ *                  Name: runFile
+ *                  Description: Maps the file and cuts chunks at the first line end
+ *                               after every chunkBytes
+ *                  Arguments: const std::string& path - Command file
+ *                  Returns: bool - False if the file could not be read
+ *****************************************************************************/
+bool CommandProcessor::runFile(const std::string& path) {
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    const char* data = nullptr;
+    if (size > 0) {
+        void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        ::madvise(mapping, size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(mapping);
+    }
+    ::close(fd);
+
+    std::size_t chunkBytes = std::max<std::size_t>(options.chunkBytes, 1);
+    std::size_t offset = 0;
+    runPipeline([&](Chunk& chunk) {
+        if (offset >= size) {
+            return false;
+        }
+        std::size_t end = std::min(size, offset + chunkBytes);
+        if (end < size) {
+            const void* newline = std::memchr(data + end - 1, '\n', size - end + 1);
+            end = newline != nullptr ? static_cast<const char*>(newline) - data + 1 : size;
+        }
+        chunk.text = std::string_view(data + offset, end - offset);
+        offset = end;
+        return true;
+    });
+    if (data != nullptr) {
+        ::munmap(const_cast<char*>(data), size);
+    }
+    return true;
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    runStream(in);
+    return true;
+#endif
+}
+
+/******************************************************************************
+ *                  Name: runStream
+ *                  Description: Reads blocks of chunkBytes, keeping the partial last
+ *                               line for the next chunk
+ *                  Arguments: std::istream& input - Command stream
+ *                  Returns: None
+ *****************************************************************************/
+void CommandProcessor::runStream(std::istream& input) {
+    std::size_t chunkBytes = std::max<std::size_t>(options.chunkBytes, 1);
+    std::string carry;
+    runPipeline([&](Chunk& chunk) {
+        std::string& storage = chunk.storage;
+        storage.swap(carry);
+        carry.clear();
+        while (input) {
+            std::size_t old = storage.size();
+            storage.resize(old + chunkBytes);
+            input.read(&storage[old], static_cast<std::streamsize>(chunkBytes));
+            storage.resize(old + static_cast<std::size_t>(input.gcount()));
+            std::size_t last = storage.rfind('\n');
+            if (input && last != std::string::npos) {
+                carry.assign(storage, last + 1, std::string::npos);
+                storage.resize(last + 1);
+                break;
+            }
+        }
+        chunk.text = storage;
+        return !storage.empty();
+    });
+}
+
+/******************************************************************************
+ *                  Name: runBinary
+ *                  Description: Applies every record of a journal file in order
+ *                  Arguments: const std::string& path - Journal file
+ *                  Returns: bool - False if the file could not be read
+ *****************************************************************************/
+bool CommandProcessor::runBinary(const std::string& path) {
+    std::ifstream probe(path, std::ios::binary | std::ios::ate);
+    if (!probe) {
+        return false;
+    }
+    auto start = std::chrono::steady_clock::now();
+    totals = CommandStats();
+    totals.bytes = static_cast<std::uint64_t>(probe.tellg());
+    probe.close();
+    totals.lines = Journal::replay(path, [this](const JournalRecord& record) {
+        totals.failed += manager.applyRecord(record) != OpStatus::Ok;
+        ++totals.commands;
+    });
+    totals.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: stats
+ *                  Description: Returns the totals of the last run
+ *                  Arguments: None
+ *                  Returns: const CommandStats& - Totals
+ *****************************************************************************/
+const CommandStats& CommandProcessor::stats() const {
+    return totals;
+}
+
+/******************************************************************************
+ *                  Name: parseLine
+ *                  Description: Splits the line into at most three tokens and checks
+ *                               the verb's argument count
+ *                  Arguments: std::string_view line - Line without its newline
+ *                             Command& command - Receives the command
+ *                  Returns: ParseResult - Command, Skip or Malformed
+ *****************************************************************************/
+ParseResult CommandProcessor::parseLine(std::string_view line, Command& command) {
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    std::string_view tokens[3];
+    std::size_t count = 0;
+    std::size_t pos = 0;
+    for (;;) {
+        while (pos < line.size() && isBlank(line[pos])) {
+            ++pos;
+        }
+        if (pos == line.size()) {
+            break;
+        }
+        if (count == 3) {
+            return ParseResult::Malformed;
+        }
+        std::size_t start = pos;
+        while (pos < line.size() && !isBlank(line[pos])) {
+            ++pos;
+        }
+        tokens[count++] = line.substr(start, pos - start);
+    }
+    if (count == 0 || tokens[0][0] == '#') {
+        return ParseResult::Skip;
+    }
+
+    std::string_view verb = tokens[0];
+    std::size_t arguments = count - 1;
+    if ((verb == "install" || verb == "uninstall") && arguments == 1) {
+        command.type = verb == "install" ? CommandType::Install : CommandType::Uninstall;
+    } else if ((verb == "grant" || verb == "assign" || verb == "revoke") && arguments == 2) {
+        command.type = verb == "revoke" ? CommandType::Revoke : CommandType::Grant;
+    } else if (verb == "list" && arguments <= 1) {
+        command.type = arguments == 0 ? CommandType::List : CommandType::ListPermissions;
+    } else {
+        return ParseResult::Malformed;
+    }
+    command.appName = tokens[1];
+    command.permission = tokens[2];
+    return ParseResult::Command;
+}
+
+/******************************************************************************
+ *                  Name: runPipeline
+ *                  Description: Runs the three stages. The calling thread produces
+ *                               chunks into a window of recycled slots, parser
+ *                               threads claim them in order and parse them in
+ *                               parallel, and the apply thread executes each chunk
+ *                               once it and all before it are parsed. The window
+ *                               stalls the producer when the apply stage falls
+ *                               behind.
+ *                  Arguments: const std::function<bool(Chunk&)>& produce - Fills the
+ *                                 next chunk's text; false at end of input
+ *                  Returns: None
+ *****************************************************************************/
+void CommandProcessor::runPipeline(const std::function<bool(Chunk&)>& produce) {
+    auto start = std::chrono::steady_clock::now();
+    totals = CommandStats();
+    std::size_t window = std::max<std::size_t>(options.window, 2);
+    std::size_t threads = options.parseThreads;
+    if (threads == 0) {
+        unsigned cores = std::thread::hardware_concurrency();   // Leave one core each to reading and applying
+        threads = cores > 2 ? cores - 2 : 1;
+    }
+
+    std::vector<std::unique_ptr<Chunk>> slots(window);
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::uint64_t produced = 0;   // Chunks handed to the pipeline
+    std::uint64_t claimed = 0;    // Chunks taken by a parser
+    std::uint64_t applied = 0;    // Chunks executed
+    bool finished = false;        // No more chunks will be produced
+
+    std::vector<std::thread> parsers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        parsers.emplace_back([&] {
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;) {
+                while (!changed.wait_for(lock, kPollInterval, [&] { return claimed < produced || finished; })) {
+                }
+                if (claimed == produced) {
+                    return;
+                }
+                Chunk& chunk = *slots[claimed++ % window];
+                lock.unlock();
+                parseChunk(chunk);
+                lock.lock();
+                chunk.parsed = true;
+                changed.notify_all();
+            }
+        });
+    }
+
+    std::thread applier([&] {
+        std::string out;
+        std::uint64_t lineBase = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            while (!changed.wait_for(lock, kPollInterval, [&] {
+                return (applied < produced && slots[applied % window]->parsed) || (finished && applied == produced);
+            })) {
+            }
+            if (applied == produced) {
+                break;
+            }
+            Chunk& chunk = *slots[applied % window];
+            lock.unlock();
+            for (const Command& command : chunk.commands) {
+                totals.failed += apply(command, out) != OpStatus::Ok;
+                if (out.size() >= kOutputFlushBytes) {
+                    output.write(out.data(), static_cast<std::streamsize>(out.size()));
+                    out.clear();
+                }
+            }
+            for (std::uint32_t line : chunk.malformed) {
+                errors << "line " << lineBase + line + 1 << ": malformed command\n";
+            }
+            totals.commands += chunk.commands.size();
+            totals.malformed += chunk.malformed.size();
+            totals.lines += chunk.lines;
+            totals.bytes += chunk.text.size();
+            lineBase += chunk.lines;
+            lock.lock();
+            ++applied;
+            changed.notify_all();
+        }
+        lock.unlock();
+        output.write(out.data(), static_cast<std::streamsize>(out.size()));
+        output.flush();
+    });
+
+    for (;;) {
+        std::unique_ptr<Chunk> chunk;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!changed.wait_for(lock, kPollInterval, [&] { return produced - applied < window; })) {
+            }
+            chunk = std::move(slots[produced % window]);   // Applied already; recycle it
+        }
+        if (chunk == nullptr) {
+            chunk = std::make_unique<Chunk>();
+        }
+        chunk->commands.clear();
+        chunk->malformed.clear();
+        chunk->lines = 0;
+        chunk->parsed = false;
+        if (!produce(*chunk)) {
+            break;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        slots[produced % window] = std::move(chunk);
+        ++produced;
+        changed.notify_all();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+        changed.notify_all();
+    }
+    for (std::thread& parser : parsers) {
+        parser.join();
+    }
+    applier.join();
+    totals.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/******************************************************************************
+ *                  Name: parseChunk
+ *                  Description: Parses every line of a chunk into commands
+ *                  Arguments: Chunk& chunk - Chunk with its text set
+ *                  Returns: None
+ *****************************************************************************/
+void CommandProcessor::parseChunk(Chunk& chunk) {
+    std::string_view text = chunk.text;
+    chunk.commands.reserve(text.size() / 24);
+    std::uint32_t line = 0;
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        const void* newline = std::memchr(text.data() + pos, '\n', text.size() - pos);
+        std::size_t end = newline != nullptr ? static_cast<const char*>(newline) - text.data() : text.size();
+        Command command;
+        switch (parseLine(text.substr(pos, end - pos), command)) {
+        case ParseResult::Command:
+            command.line = line;
+            chunk.commands.push_back(command);
+            break;
+        case ParseResult::Malformed:
+            chunk.malformed.push_back(line);
+            break;
+        case ParseResult::Skip:
+            break;
+        }
+        ++line;
+        pos = end + 1;
+    }
+    chunk.lines = line;
+}
+
+/******************************************************************************
+ *                  Name: apply
+ *                  Description: Executes one command on the manager
+ *                  Arguments: const Command& command - Command to execute
+ *                             std::string& out - Receives list output
+ *                  Returns: OpStatus - Outcome of the operation
+ *****************************************************************************/
+OpStatus CommandProcessor::apply(const Command& command, std::string& out) {
+    auto print = [&](std::string_view name) {
+        out.append(name);
+        out.push_back('\n');
+    };
+    switch (command.type) {
+    case CommandType::Install:
+        return manager.installApp(command.appName);
+    case CommandType::Uninstall:
+        return manager.uninstallApp(command.appName);
+    case CommandType::Grant:
+        return manager.assignPermission(command.appName, command.permission);
+    case CommandType::Revoke:
+        return manager.revokePermission(command.appName, command.permission);
+    case CommandType::List:
+        manager.forEachInstalledApp(print);
+        return OpStatus::Ok;
+    case CommandType::ListPermissions:
+        return manager.forEachAppPermission(command.appName, print) ? OpStatus::Ok : OpStatus::AppNotFound;
+    }
+    return OpStatus::Ok;
+}
+
+/******************************** End of File ********************************/
@@ -0,0 +1,185 @@
+
+/******************************************************************************
+ *                    File Name: CommandProcessor.h
+ *                    Description: Header file for CommandProcessor, which replays
+ *                                 command files against a MobileAppManager through a
+ *                                 pipelined parse/apply engine
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __COMMAND_PROCESSOR_H__
+#define __COMMAND_PROCESSOR_H__
+
+#include "MobileAppManager.h"
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+/******************************************************************************
+ *                  Enum Definition: CommandType
+ *                  Description: Kind of command on one line of a command file
+ *****************************************************************************/
+
+enum class CommandType : std::uint8_t {
+    Install,          // install <app>
+    Uninstall,        // uninstall <app>
+    Grant,            // grant <app> <permission>, or assign
+    Revoke,           // revoke <app> <permission>
+    List,             // list: installed apps, one per line
+    ListPermissions   // list <app>: the app's permissions, one per line
+};
+
+/******************************************************************************
+ *                  Enum Definition: ParseResult
+ *                  Description: Outcome of parsing one line
+ *****************************************************************************/
+
+enum class ParseResult : std::uint8_t {
+    Command,     // The line holds a command
+    Skip,        // Blank line or # comment
+    Malformed    // Unknown verb or wrong number of arguments
+};
+
+/******************************************************************************
+ *                  Structure Definition: Command
+ *                  Description: One parsed command. The names are views into the
+ *                               input buffer, which outlives the command.
+ *****************************************************************************/
+
+struct Command {
+    CommandType type = CommandType::List;   // What to do
+    std::uint32_t line = 0;                 // Line number within its chunk, from 0
+    std::string_view appName;               // Target application, if any
+    std::string_view permission;            // Permission for Grant/Revoke
+};
+
+/******************************************************************************
+ *                  Structure Definition: CommandOptions
+ *                  Description: Tuning knobs of the pipeline
+ *****************************************************************************/
+
+struct CommandOptions {
+    std::size_t parseThreads = 0;          // Parser threads; 0 picks from the hardware
+    std::size_t chunkBytes = 1 << 20;      // Input handed to a parser at a time
+    std::size_t window = 32;               // Chunks read ahead of the one being applied
+};
+
+/******************************************************************************
+ *                  Structure Definition: CommandStats
+ *                  Description: Totals of one run
+ *****************************************************************************/
+
+struct CommandStats {
+    std::uint64_t bytes = 0;       // Input bytes read
+    std::uint64_t lines = 0;       // Lines read, including blank and malformed ones
+    std::uint64_t commands = 0;    // Commands applied
+    std::uint64_t failed = 0;      // Commands applied with an outcome other than Ok
+    std::uint64_t malformed = 0;   // Lines that were not a valid command
+    double seconds = 0;            // Wall-clock time of the run
+
+    /******************************************************************************
+     *                  Name: summary
+     *                  Description: Formats the totals with line and byte throughput
+     *                  Arguments: None
+     *                  Returns: std::string - One-line report
+     *****************************************************************************/
+    std::string summary() const;
+};
+
+/******************************************************************************
+ *                  Class Definition: CommandProcessor
+ *                  Description: Replays text command files, one command per line,
+ *                               or binary journal files against a manager. Text
+ *                               input is mapped (files) or read in large blocks
+ *                               (streams) and cut into chunks at line ends; parser
+ *                               threads tokenize chunks into commands whose names
+ *                               are views into the input, and a single apply
+ *                               thread executes the chunks strictly in input order.
+ *                               At most window chunks are in flight, which bounds
+ *                               memory on inputs of any size. Output of list
+ *                               commands goes to the output stream; malformed
+ *                               lines are reported to the error stream.
+ *****************************************************************************/
+
+class CommandProcessor {
+public:
+    /******************************************************************************
+     *                  Name: CommandProcessor
+     *                  Description: Constructor binding the manager and streams
+     *                  Arguments: MobileAppManager& manager - Registry commands apply to
+     *                             std::ostream& output - Receives list output
+     *                             std::ostream& errors - Receives malformed-line reports
+     *                             CommandOptions options - Pipeline tuning
+     *                  Returns: None
+     *****************************************************************************/
+    CommandProcessor(MobileAppManager& manager, std::ostream& output, std::ostream& errors,
+                     CommandOptions options = CommandOptions());
+
+    /******************************************************************************
+     *                  Name: runFile
+     *                  Description: Memory-maps a text command file and replays it
+     *                  Arguments: const std::string& path - Command file
+     *                  Returns: bool - False if the file could not be read
+     *****************************************************************************/
+    bool runFile(const std::string& path);
+
+    /******************************************************************************
+     *                  Name: runStream
+     *                  Description: Replays text commands read from a stream, such as
+     *                               standard input, in chunkBytes blocks
+     *                  Arguments: std::istream& input - Command stream
+     *                  Returns: None
+     *****************************************************************************/
+    void runStream(std::istream& input);
+
+    /******************************************************************************
+     *                  Name: runBinary
+     *                  Description: Replays a binary operation log in the journal
+     *                               format (see Journal.h), dropping a torn tail
+     *                  Arguments: const std::string& path - Journal file
+     *                  Returns: bool - False if the file could not be read
+     *****************************************************************************/
+    bool runBinary(const std::string& path);
+
+    /******************************************************************************
+     *                  Name: stats
+     *                  Description: Returns the totals of the last run
+     *                  Arguments: None
+     *                  Returns: const CommandStats& - Totals
+     *****************************************************************************/
+    const CommandStats& stats() const;
+
+    /******************************************************************************
+     *                  Name: parseLine
+     *                  Description: Tokenizes one line on spaces and tabs without
+     *                               copying; a trailing carriage return is ignored
+     *                  Arguments: std::string_view line - Line without its newline
+     *                             Command& command - Receives the command
+     *                  Returns: ParseResult - Command, Skip or Malformed
+     *****************************************************************************/
+    static ParseResult parseLine(std::string_view line, Command& command);
+
+private:
+    struct Chunk;
+
+    void runPipeline(const std::function<bool(Chunk&)>& produce);
+    static void parseChunk(Chunk& chunk);
+    OpStatus apply(const Command& command, std::string& out);
+
+    MobileAppManager& manager;   // Registry commands apply to
+    std::ostream& output;        // List output
+    std::ostream& errors;        // Malformed-line reports
+    CommandOptions options;      // Pipeline tuning
+    CommandStats totals;         // Totals of the last run
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,539 @@
+
+/******************************************************************************
+ *                    File Name: ConcurrentAppManager.cpp
+ *                    Description: Implementation file for the sharded thread-safe manager
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "ConcurrentAppManager.h"
+#include <algorithm>   // For std::partial_sort, std::sort
+#include <functional>  // For std::hash
+#include <iterator>    // For std::make_move_iterator
+#include <mutex>
+
+/******************************************************************************
+ *                  Constructor: ConcurrentAppManager
+ *                  Description: Allocates the shards and points them at one sink
+ *                  Arguments: std::size_t shardCount - Number of shards (at least 1)
+ *                             std::shared_ptr<LogSink> sink - Log destination
+ *                  Returns: None
+ *****************************************************************************/
+ConcurrentAppManager::ConcurrentAppManager(std::size_t shardCount, std::shared_ptr<LogSink> sink)
+    : shards(new Shard[shardCount == 0 ? 1 : shardCount]), count(shardCount == 0 ? 1 : shardCount) {
+    for (std::size_t i = 0; i < count; ++i) {
+        shards[i].manager.setLogSink(sink);
+    }
+}
+
+/******************************************************************************
+ *                  Destructor: ConcurrentAppManager
+ *                  Description: Stops the expiry thread before the shards go away
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+ConcurrentAppManager::~ConcurrentAppManager() {
+    stopExpiryThread();
+}
+
+/******************************************************************************
+ *                  Name: shardFor
+ *                  Description: Maps an app name to the shard that owns it
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: Shard& - Owning shard
+ *****************************************************************************/
+ConcurrentAppManager::Shard& ConcurrentAppManager::shardFor(std::string_view appName) const {
+    return shards[std::hash<std::string_view>{}(appName) % count];
+}
+
+/******************************************************************************
+ *                  Name: installApp
+ *                  Description: Installs an app under its shard's exclusive lock
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: OpStatus - Ok, or why nothing changed
+ *****************************************************************************/
+OpStatus ConcurrentAppManager::installApp(std::string_view appName) {
+    Shard& shard = shardFor(appName);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.manager.installApp(appName);
+}
+
+/******************************************************************************
+ *                  Name: uninstallApp
+ *                  Description: Uninstalls an app under its shard's exclusive lock
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: OpStatus - Ok, or why nothing changed
+ *****************************************************************************/
+OpStatus ConcurrentAppManager::uninstallApp(std::string_view appName) {
+    Shard& shard = shardFor(appName);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.manager.uninstallApp(appName);
+}
+
+/******************************************************************************
+ *                  Name: assignPermission
+ *                  Description: Assigns a permission under the app's shard lock
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission to assign
+ *                  Returns: OpStatus - Ok, or why nothing changed
+ *****************************************************************************/
+OpStatus ConcurrentAppManager::assignPermission(std::string_view appName, std::string_view permission) {
+    Shard& shard = shardFor(appName);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.manager.assignPermission(appName, permission);
+}
+
+/******************************************************************************
+ *                  Name: assignPermission
+ *                  Description: Converts the time to live to a deadline
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission to assign
+ *                             std::chrono::milliseconds ttl - Time until it expires
+ *                  Returns: OpStatus - Ok, or why nothing changed
+ *****************************************************************************/
+OpStatus ConcurrentAppManager::assignPermission(std::string_view appName, std::string_view permission,
+                                                std::chrono::milliseconds ttl) {
+    using ExpiryClock = MobileAppManager::ExpiryClock;
+    ExpiryClock::time_point now = ExpiryClock::now();
+    ExpiryClock::time_point deadline = ExpiryClock::time_point::max();
+    if (ttl < std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now)) {
+        deadline = now + ttl;
+    }
+    return assignPermission(appName, permission, deadline);
+}
+
+/******************************************************************************
+ *                  Name: assignPermission
+ *                  Description: Assigns a timed permission under the app's shard
+ *                               lock, then wakes the expiry thread
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission to assign
+ *                             MobileAppManager::ExpiryClock::time_point deadline -
+ *                                 When it expires
+ *                  Returns: OpStatus - Ok, or why nothing changed
+ *****************************************************************************/
+OpStatus ConcurrentAppManager::assignPermission(std::string_view appName, std::string_view permission,
+                                                MobileAppManager::ExpiryClock::time_point deadline) {
+    Shard& shard = shardFor(appName);
+    OpStatus status;
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        status = shard.manager.assignPermission(appName, permission, deadline);
+    }
+    if (status == OpStatus::Ok) {
+        wakeExpiry(deadline);
+    }
+    return status;
+}
+
+/******************************************************************************
+ *                  Name: revokePermission
+ *                  Description: Revokes a permission under the app's shard lock
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission to revoke
+ *                  Returns: OpStatus - Ok, or why nothing changed
+ *****************************************************************************/
+OpStatus ConcurrentAppManager::revokePermission(std::string_view appName, std::string_view permission) {
+    Shard& shard = shardFor(appName);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.manager.revokePermission(appName, permission);
+}
+
+/******************************************************************************
+ *                  Name: definePermissionGroup
+ *                  Description: Takes every shard's exclusive lock in index order, as
+ *                               readSnapshot() does, then applies the definition to
+ *                               each shard, so no reader sees the old definition on
+ *                               one shard and the new one on another. Every shard
+ *                               holds the same definitions, so the outcome is the
+ *                               same on all of them and the first decides.
+ *                  Arguments: std::string_view group - Group name
+ *                             const std::vector<std::string_view>& permissions - Permissions
+ *                             const std::vector<std::string_view>& includes - Included groups
+ *                  Returns: OpStatus - Ok, or why nothing changed
+ *****************************************************************************/
+OpStatus ConcurrentAppManager::definePermissionGroup(std::string_view group,
+                                                     const std::vector<std::string_view>& permissions,
+                                                     const std::vector<std::string_view>& includes) {
+    std::vector<std::unique_lock<std::shared_mutex>> locks;
+    locks.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        locks.emplace_back(shards[i].mutex);
+    }
+    OpStatus status = OpStatus::Ok;
+    for (std::size_t i = 0; i < count && status == OpStatus::Ok; ++i) {
+        status = shards[i].manager.definePermissionGroup(group, permissions, includes);
+    }
+    return status;
+}
+
+/******************************************************************************
+ *                  Name: defineRole
+ *                  Description: Defines a group made only of other groups on every
+ *                               shard, under all shard locks like definePermissionGroup
+ *                  Arguments: std::string_view role - Role name
+ *                             const std::vector<std::string_view>& groups - Included groups
+ *                  Returns: OpStatus - Ok, or why nothing changed
+ *****************************************************************************/
+OpStatus ConcurrentAppManager::defineRole(std::string_view role, const std::vector<std::string_view>& groups) {
+    return definePermissionGroup(role, {}, groups);
+}
+
+/******************************************************************************
+ *                  Name: assignGroup
+ *                  Description: Assigns a group under the app's shard lock
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::string_view group - Group or role to assign
+ *                  Returns: OpStatus - Ok, or why nothing changed
+ *****************************************************************************/
+OpStatus ConcurrentAppManager::assignGroup(std::string_view appName, std::string_view group) {
+    Shard& shard = shardFor(appName);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.manager.assignGroup(appName, group);
+}
+
+/******************************************************************************
+ *                  Name: revokeGroup
+ *                  Description: Removes a group under the app's shard lock
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::string_view group - Group or role to remove
+ *                  Returns: OpStatus - Ok, or why nothing changed
+ *****************************************************************************/
+OpStatus ConcurrentAppManager::revokeGroup(std::string_view appName, std::string_view group) {
+    Shard& shard = shardFor(appName);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.manager.revokeGroup(appName, group);
+}
+
+/******************************************************************************
+ *                  Name: listInstalledApps
+ *                  Description: Collects app names from every shard and sorts them
+ *                  Arguments: None
+ *                  Returns: std::vector<std::string> - Names of installed apps
+ *****************************************************************************/
+std::vector<std::string> ConcurrentAppManager::listInstalledApps() const {
+    std::vector<std::string> appNames;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::shared_lock<std::shared_mutex> lock(shards[i].mutex);
+        std::vector<std::string> shardApps = shards[i].manager.listInstalledApps();
+        appNames.insert(appNames.end(), std::make_move_iterator(shardApps.begin()),
+                        std::make_move_iterator(shardApps.end()));
+    }
+    std::sort(appNames.begin(), appNames.end());
+    return appNames;
+}
+
+/******************************************************************************
+ *                  Name: mergePages
+ *                  Description: Runs a paginated query on every shard under its shared
+ *                               lock and keeps the first limit names overall. Each
+ *                               shard returns at most limit names, all of which are
+ *                               candidates for the merged page.
+ *                  Arguments: std::size_t limit - Maximum names returned
+ *                             Query query - Called with a shard's manager; returns
+ *                                           its page as string views
+ *                  Returns: std::vector<std::string> - Merged, sorted page
+ *****************************************************************************/
+template <typename Query>
+std::vector<std::string> ConcurrentAppManager::mergePages(std::size_t limit, Query query) const {
+    std::vector<std::string> page;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::shared_lock<std::shared_mutex> lock(shards[i].mutex);
+        for (std::string_view appName : query(shards[i].manager)) {
+            page.emplace_back(appName);
+        }
+    }
+    if (page.size() > limit) {
+        std::partial_sort(page.begin(), page.begin() + limit, page.end());
+        page.resize(limit);
+    } else {
+        std::sort(page.begin(), page.end());
+    }
+    return page;
+}
+
+/******************************************************************************
+ *                  Name: findApps
+ *                  Description: Merges the prefix matches of every shard
+ *                  Arguments: std::string_view prefix - Required name prefix
+ *                             std::string_view after - Resume point
+ *                             std::size_t limit - Maximum names returned
+ *                  Returns: std::vector<std::string> - Matching names
+ *****************************************************************************/
+std::vector<std::string> ConcurrentAppManager::findApps(std::string_view prefix, std::string_view after,
+                                                        std::size_t limit) const {
+    return mergePages(limit, [&](const MobileAppManager& manager) {
+        return manager.findApps(prefix, after, limit);
+    });
+}
+
+/******************************************************************************
+ *                  Name: searchApps
+ *                  Description: Merges the substring matches of every shard
+ *                  Arguments: std::string_view pattern - Substring to look for
+ *                             std::string_view after - Resume point
+ *                             std::size_t limit - Maximum names returned
+ *                  Returns: std::vector<std::string> - Matching names
+ *****************************************************************************/
+std::vector<std::string> ConcurrentAppManager::searchApps(std::string_view pattern, std::string_view after,
+                                                          std::size_t limit) const {
+    return mergePages(limit, [&](const MobileAppManager& manager) {
+        return manager.searchApps(pattern, after, limit);
+    });
+}
+
+/******************************************************************************
+ *                  Name: listAppPermissions
+ *                  Description: Lists an app's permissions under its shard's shared lock
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: std::vector<std::string> - List of permissions
+ *****************************************************************************/
+std::vector<std::string> ConcurrentAppManager::listAppPermissions(std::string_view appName) const {
+    Shard& shard = shardFor(appName);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.manager.listAppPermissions(appName);
+}
+
+/******************************************************************************
+ *                  Name: hasPermission
+ *                  Description: Checks a permission under the app's shard shared lock
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission to check
+ *                  Returns: bool - True if the app is installed and holds the permission
+ *****************************************************************************/
+bool ConcurrentAppManager::hasPermission(std::string_view appName, std::string_view permission) const {
+    Shard& shard = shardFor(appName);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.manager.hasPermission(appName, permission);
+}
+
+/******************************************************************************
+ *                  Name: appsWithPermission
+ *                  Description: Queries each shard's reverse index and sorts the union
+ *                  Arguments: std::string_view permission - Permission to look up
+ *                  Returns: std::vector<std::string> - Sorted names of the holders
+ *****************************************************************************/
+std::vector<std::string> ConcurrentAppManager::appsWithPermission(std::string_view permission) const {
+    std::vector<std::string> holders;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::shared_lock<std::shared_mutex> lock(shards[i].mutex);
+        std::vector<std::string> shardHolders = shards[i].manager.appsWithPermission(permission);
+        holders.insert(holders.end(), std::make_move_iterator(shardHolders.begin()),
+                       std::make_move_iterator(shardHolders.end()));
+    }
+    std::sort(holders.begin(), holders.end());
+    return holders;
+}
+
+/******************************************************************************
+ *                  Name: shardCount
+ *                  Description: Returns the number of shards
+ *                  Arguments: None
+ *                  Returns: std::size_t - Shard count
+ *****************************************************************************/
+std::size_t ConcurrentAppManager::shardCount() const {
+    return count;
+}
+
+/******************************************************************************
+ *                  Name: attachMetrics
+ *                  Description: Points every shard at the same collector
+ *                  Arguments: std::shared_ptr<OperationMetrics> metrics - Collector, or nullptr
+ *                  Returns: None
+ *****************************************************************************/
+void ConcurrentAppManager::attachMetrics(std::shared_ptr<OperationMetrics> newMetrics) {
+    for (std::size_t i = 0; i < count; ++i) {
+        std::unique_lock<std::shared_mutex> lock(shards[i].mutex);
+        shards[i].manager.attachMetrics(newMetrics);
+    }
+    metrics = std::move(newMetrics);
+}
+
+/******************************************************************************
+ *                  Name: attachChangeStream
+ *                  Description: Points every shard at the same stream
+ *                  Arguments: std::shared_ptr<ChangeStream> stream - Stream, or nullptr
+ *                  Returns: None
+ *****************************************************************************/
+void ConcurrentAppManager::attachChangeStream(std::shared_ptr<ChangeStream> stream) {
+    for (std::size_t i = 0; i < count; ++i) {
+        std::unique_lock<std::shared_mutex> lock(shards[i].mutex);
+        shards[i].manager.attachChangeStream(stream);
+    }
+}
+
+/******************************************************************************
+ *                  Name: stats
+ *                  Description: Returns the totals of the attached collector
+ *                  Arguments: None
+ *                  Returns: MetricsSnapshot - Totals over all shards
+ *****************************************************************************/
+MetricsSnapshot ConcurrentAppManager::stats() const {
+    return metrics != nullptr ? metrics->stats() : MetricsSnapshot();
+}
+
+/******************************************************************************
+ *                  Name: enableSnapshotReads
+ *                  Description: Enables snapshot reads on each shard under its lock
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void ConcurrentAppManager::enableSnapshotReads() {
+    for (std::size_t i = 0; i < count; ++i) {
+        std::unique_lock<std::shared_mutex> lock(shards[i].mutex);
+        shards[i].manager.enableSnapshotReads();
+    }
+}
+
+/******************************************************************************
+ *                  Name: readSnapshot
+ *                  Description: Takes every shard's shared lock in index order, so no
+ *                               write lands between two shards' pins, pins each
+ *                               shard's version and releases the locks
+ *                  Arguments: None
+ *                  Returns: std::vector<AppMapSnapshot> - One snapshot per shard
+ *****************************************************************************/
+std::vector<AppMapSnapshot> ConcurrentAppManager::readSnapshot() const {
+    std::vector<std::shared_lock<std::shared_mutex>> locks;
+    locks.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        locks.emplace_back(shards[i].mutex);
+    }
+    std::vector<AppMapSnapshot> snapshots;
+    snapshots.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        snapshots.push_back(shards[i].manager.readSnapshot());
+    }
+    return snapshots;
+}
+
+/******************************************************************************
+ *                  Name: expireGrants
+ *                  Description: Checks each shard under its shared lock and expires
+ *                               it under its exclusive lock only if a deadline passed
+ *                  Arguments: None
+ *                  Returns: std::size_t - Grants revoked
+ *****************************************************************************/
+std::size_t ConcurrentAppManager::expireGrants() {
+    std::size_t expired = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        {
+            std::shared_lock<std::shared_mutex> lock(shards[i].mutex);
+            if (shards[i].manager.nextExpiry() > MobileAppManager::ExpiryClock::now()) {
+                continue;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(shards[i].mutex);
+        expired += shards[i].manager.expireGrants();
+    }
+    return expired;
+}
+
+/******************************************************************************
+ *                  Name: nextExpiry
+ *                  Description: Takes the minimum over the shards, one shared lock
+ *                               at a time
+ *                  Arguments: None
+ *                  Returns: MobileAppManager::ExpiryClock::time_point - Time
+ *****************************************************************************/
+MobileAppManager::ExpiryClock::time_point ConcurrentAppManager::nextExpiry() const {
+    MobileAppManager::ExpiryClock::time_point next = MobileAppManager::ExpiryClock::time_point::max();
+    for (std::size_t i = 0; i < count; ++i) {
+        std::shared_lock<std::shared_mutex> lock(shards[i].mutex);
+        next = std::min(next, shards[i].manager.nextExpiry());
+    }
+    return next;
+}
+
+/******************************************************************************
+ *                  Name: startExpiryThread
+ *                  Description: Starts the background expiry thread
+ *                  Arguments: std::chrono::milliseconds maxIdle - Longest sleep
+ *                  Returns: None
+ *****************************************************************************/
+void ConcurrentAppManager::startExpiryThread(std::chrono::milliseconds maxIdle) {
+    std::lock_guard<std::mutex> lock(expiryMutex);
+    if (expiryThread.joinable()) {
+        return;
+    }
+    expiryRunning = true;
+    expiryWake = MobileAppManager::ExpiryClock::time_point::max();
+    expiryThread = std::thread([this, maxIdle]() { runExpiry(maxIdle); });
+}
+
+/******************************************************************************
+ *                  Name: stopExpiryThread
+ *                  Description: Signals the expiry thread and joins it
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void ConcurrentAppManager::stopExpiryThread() {
+    {
+        std::lock_guard<std::mutex> lock(expiryMutex);
+        if (!expiryThread.joinable()) {
+            return;
+        }
+        expiryRunning = false;
+    }
+    expiryWakeup.notify_one();
+    expiryThread.join();
+    expiryThread = std::thread();
+}
+
+/******************************************************************************
+ *                  Name: runExpiry
+ *                  Description: Background loop: expire what is due, then sleep
+ *                               until the next deadline, at most maxIdle, or until
+ *                               an earlier deadline or a stop is signalled. With no
+ *                               deadline reached the loop does no work, however
+ *                               many grants are pending.
+ *                  Arguments: std::chrono::milliseconds maxIdle - Longest sleep
+ *                  Returns: None
+ *****************************************************************************/
+void ConcurrentAppManager::runExpiry(std::chrono::milliseconds maxIdle) {
+    using ExpiryClock = MobileAppManager::ExpiryClock;
+    std::unique_lock<std::mutex> lock(expiryMutex);
+    while (expiryRunning) {
+        // While awake, wakeExpiry records any deadline scheduled behind the scan
+        expiryWake = ExpiryClock::time_point::max();
+        lock.unlock();
+        expireGrants();
+        ExpiryClock::time_point next = nextExpiry();
+        lock.lock();
+        if (!expiryRunning) {
+            break;
+        }
+        next = std::min(next, expiryWake);
+        ExpiryClock::time_point now = ExpiryClock::now();
+        ExpiryClock::duration sleep = next > now ? std::min<ExpiryClock::duration>(next - now, maxIdle)
+                                                 : ExpiryClock::duration::zero();
+        expiryWake = now + sleep;
+        ExpiryClock::time_point planned = expiryWake;
+        expiryWakeup.wait_for(lock, sleep, [&]() { return !expiryRunning || expiryWake != planned; });
+    }
+}
+
+/******************************************************************************
+ *                  Name: wakeExpiry
+ *                  Description: Wakes the expiry thread if a deadline falls before
+ *                               its planned wakeup
+ *                  Arguments: MobileAppManager::ExpiryClock::time_point deadline -
+ *                                 Deadline just scheduled
+ *                  Returns: None
+ *****************************************************************************/
+void ConcurrentAppManager::wakeExpiry(MobileAppManager::ExpiryClock::time_point deadline) {
+    {
+        std::lock_guard<std::mutex> lock(expiryMutex);
+        if (!expiryRunning || deadline >= expiryWake) {
+            return;
+        }
+        expiryWake = deadline;
+    }
+    expiryWakeup.notify_one();
+}
+
+/******************************** End of File ********************************/
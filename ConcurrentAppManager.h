@@ -0,0 +1,385 @@
+
+/******************************************************************************
+ *                    File Name: ConcurrentAppManager.h
+ *                    Description: Header file for ConcurrentAppManager, a thread-safe
+ *                                 MobileAppManager split into independently locked shards
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __CONCURRENT_APP_MANAGER_H__
+#define __CONCURRENT_APP_MANAGER_H__
+
+#include "MobileAppManager.h"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+/******************************************************************************
+ *                  Class Definition: ConcurrentAppManager
+ *                  Description: Hash-partitions installed apps across a fixed number
+ *                               of shards. Each shard is a MobileAppManager guarded
+ *                               by its own reader-writer lock, so readers run in
+ *                               parallel and writers to different shards never
+ *                               contend. Every operation touching one app takes
+ *                               exactly one shard lock, which makes it linearizable.
+ *****************************************************************************/
+
+class ConcurrentAppManager {
+public:
+    static constexpr std::size_t kDefaultShardCount = 16;
+    static constexpr std::chrono::milliseconds kDefaultExpiryIdle{1000};   // Longest sleep of the expiry thread
+
+    /******************************************************************************
+     *                  Name: ConcurrentAppManager
+     *                  Description: Constructor creating the shards
+     *                  Arguments: std::size_t shardCount - Number of shards (at least 1)
+     *                             std::shared_ptr<LogSink> sink - Log destination shared by
+     *                                                             every shard
+     *                  Returns: None
+     *****************************************************************************/
+    explicit ConcurrentAppManager(std::size_t shardCount = kDefaultShardCount,
+                                  std::shared_ptr<LogSink> sink = LogSink::console());
+
+    /******************************************************************************
+     *                  Name: ~ConcurrentAppManager
+     *                  Description: Stops the expiry thread if it is running
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    ~ConcurrentAppManager();
+
+    ConcurrentAppManager(const ConcurrentAppManager&) = delete;
+    ConcurrentAppManager& operator=(const ConcurrentAppManager&) = delete;
+
+    /******************************************************************************
+     *                  Name: installApp
+     *                  Description: Installs a new application with the given name
+     *                  Arguments: std::string_view appName - Name of the application
+     *                  Returns: OpStatus - Ok, or why nothing changed
+     *****************************************************************************/
+    OpStatus installApp(std::string_view appName);
+
+    /******************************************************************************
+     *                  Name: uninstallApp
+     *                  Description: Uninstalls the application with the given name
+     *                  Arguments: std::string_view appName - Name of the application
+     *                  Returns: OpStatus - Ok, or why nothing changed
+     *****************************************************************************/
+    OpStatus uninstallApp(std::string_view appName);
+
+    /******************************************************************************
+     *                  Name: assignPermission
+     *                  Description: Assigns a permission to the specified app
+     *                  Arguments: std::string_view appName - Name of the app
+     *                             std::string_view permission - Permission to assign
+     *                  Returns: OpStatus - Ok, or why nothing changed
+     *****************************************************************************/
+    OpStatus assignPermission(std::string_view appName, std::string_view permission);
+
+    /******************************************************************************
+     *                  Name: assignPermission
+     *                  Description: Assigns a permission that expires after a time to live
+     *                  Arguments: std::string_view appName - Name of the app
+     *                             std::string_view permission - Permission to assign
+     *                             std::chrono::milliseconds ttl - Time until it expires
+     *                  Returns: OpStatus - Ok, or why nothing changed
+     *****************************************************************************/
+    OpStatus assignPermission(std::string_view appName, std::string_view permission, std::chrono::milliseconds ttl);
+
+    /******************************************************************************
+     *                  Name: assignPermission
+     *                  Description: Assigns a permission that expires at a deadline,
+     *                               waking the expiry thread if it is the earliest
+     *                  Arguments: std::string_view appName - Name of the app
+     *                             std::string_view permission - Permission to assign
+     *                             MobileAppManager::ExpiryClock::time_point deadline -
+     *                                 When it expires
+     *                  Returns: OpStatus - Ok, or why nothing changed
+     *****************************************************************************/
+    OpStatus assignPermission(std::string_view appName, std::string_view permission,
+                              MobileAppManager::ExpiryClock::time_point deadline);
+
+    /******************************************************************************
+     *                  Name: revokePermission
+     *                  Description: Removes a permission from the specified app
+     *                  Arguments: std::string_view appName - Name of the app
+     *                             std::string_view permission - Permission to revoke
+     *                  Returns: OpStatus - Ok, or why nothing changed
+     *****************************************************************************/
+    OpStatus revokePermission(std::string_view appName, std::string_view permission);
+
+    /******************************************************************************
+     *                  Name: definePermissionGroup
+     *                  Description: Defines or redefines a permission group on every
+     *                               shard while holding every shard lock, so the
+     *                               change appears on all shards at once
+     *                  Arguments: std::string_view group - Group name
+     *                             const std::vector<std::string_view>& permissions -
+     *                                 Permissions the group grants
+     *                             const std::vector<std::string_view>& includes -
+     *                                 Groups whose permissions it also grants
+     *                  Returns: OpStatus - Ok, or why nothing changed
+     *****************************************************************************/
+    OpStatus definePermissionGroup(std::string_view group, const std::vector<std::string_view>& permissions,
+                                   const std::vector<std::string_view>& includes = {});
+
+    /******************************************************************************
+     *                  Name: defineRole
+     *                  Description: Defines a role as the union of groups on every shard
+     *                  Arguments: std::string_view role - Role name
+     *                             const std::vector<std::string_view>& groups - Groups granted
+     *                  Returns: OpStatus - Ok, or why nothing changed
+     *****************************************************************************/
+    OpStatus defineRole(std::string_view role, const std::vector<std::string_view>& groups);
+
+    /******************************************************************************
+     *                  Name: assignGroup
+     *                  Description: Assigns a group or role to the specified app
+     *                  Arguments: std::string_view appName - Name of the app
+     *                             std::string_view group - Group or role to assign
+     *                  Returns: OpStatus - Ok, or why nothing changed
+     *****************************************************************************/
+    OpStatus assignGroup(std::string_view appName, std::string_view group);
+
+    /******************************************************************************
+     *                  Name: revokeGroup
+     *                  Description: Removes a group or role from the specified app
+     *                  Arguments: std::string_view appName - Name of the app
+     *                             std::string_view group - Group or role to remove
+     *                  Returns: OpStatus - Ok, or why nothing changed
+     *****************************************************************************/
+    OpStatus revokeGroup(std::string_view appName, std::string_view group);
+
+    /******************************************************************************
+     *                  Name: listInstalledApps
+     *                  Description: Returns the sorted names of all installed apps. Each
+     *                               shard is read under its own lock, so the result
+     *                               is not an atomic view across shards.
+     *                  Arguments: None
+     *                  Returns: std::vector<std::string> - Names of installed apps
+     *****************************************************************************/
+    std::vector<std::string> listInstalledApps() const;
+
+    /******************************************************************************
+     *                  Name: findApps
+     *                  Description: Returns one sorted page of the apps whose name starts
+     *                               with a prefix, merged from every shard
+     *                  Arguments: std::string_view prefix - Required name prefix
+     *                             std::string_view after - Resume point; empty starts at
+     *                                                      the first match
+     *                             std::size_t limit - Maximum names returned
+     *                  Returns: std::vector<std::string> - Matching names
+     *****************************************************************************/
+    std::vector<std::string> findApps(std::string_view prefix, std::string_view after = std::string_view(),
+                                      std::size_t limit = std::numeric_limits<std::size_t>::max()) const;
+
+    /******************************************************************************
+     *                  Name: searchApps
+     *                  Description: Returns one sorted page of the apps whose name
+     *                               contains a pattern, merged from every shard
+     *                  Arguments: std::string_view pattern - Substring to look for
+     *                             std::string_view after - Resume point; empty starts at
+     *                                                      the first match
+     *                             std::size_t limit - Maximum names returned
+     *                  Returns: std::vector<std::string> - Matching names
+     *****************************************************************************/
+    std::vector<std::string> searchApps(std::string_view pattern, std::string_view after = std::string_view(),
+                                        std::size_t limit = std::numeric_limits<std::size_t>::max()) const;
+
+    /******************************************************************************
+     *                  Name: listAppPermissions
+     *                  Description: Returns a list of permissions for the specified app
+     *                  Arguments: std::string_view appName - Name of the app
+     *                  Returns: std::vector<std::string> - List of permissions, sorted
+     *****************************************************************************/
+    std::vector<std::string> listAppPermissions(std::string_view appName) const;
+
+    /******************************************************************************
+     *                  Name: forEachAppPermission
+     *                  Description: Calls fn(std::string_view) for every permission of an
+     *                               app while holding its shard's shared lock, so the
+     *                               callback must not call back into this manager
+     *                  Arguments: std::string_view appName - Name of the app
+     *                             Fn fn - Callback invoked per permission name
+     *                  Returns: bool - False if the app is not installed
+     *****************************************************************************/
+    template <typename Fn>
+    bool forEachAppPermission(std::string_view appName, Fn fn) const {
+        Shard& shard = shardFor(appName);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.manager.forEachAppPermission(appName, fn);
+    }
+
+    /******************************************************************************
+     *                  Name: hasPermission
+     *                  Description: Checks whether an app holds a permission
+     *                  Arguments: std::string_view appName - Name of the app
+     *                             std::string_view permission - Permission to check
+     *                  Returns: bool - True if the app is installed and holds the permission
+     *****************************************************************************/
+    bool hasPermission(std::string_view appName, std::string_view permission) const;
+
+    /******************************************************************************
+     *                  Name: appsWithPermission
+     *                  Description: Returns every installed app holding a permission,
+     *                               gathered shard by shard
+     *                  Arguments: std::string_view permission - Permission to look up
+     *                  Returns: std::vector<std::string> - Sorted names of the holders
+     *****************************************************************************/
+    std::vector<std::string> appsWithPermission(std::string_view permission) const;
+
+    /******************************************************************************
+     *                  Name: forEachAppWithPermission
+     *                  Description: Calls fn(std::string_view) for every app holding a
+     *                               permission, shard by shard and unordered, while
+     *                               holding that shard's shared lock, so the callback
+     *                               must not call back into this manager
+     *                  Arguments: std::string_view permission - Permission to look up
+     *                             Fn fn - Callback invoked per app name
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEachAppWithPermission(std::string_view permission, Fn fn) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            std::shared_lock<std::shared_mutex> lock(shards[i].mutex);
+            shards[i].manager.forEachAppWithPermission(permission, fn);
+        }
+    }
+
+    /******************************************************************************
+     *                  Name: shardCount
+     *                  Description: Returns the number of shards
+     *                  Arguments: None
+     *                  Returns: std::size_t - Shard count
+     *****************************************************************************/
+    std::size_t shardCount() const;
+
+    /******************************************************************************
+     *                  Name: attachMetrics
+     *                  Description: Records every shard's operations into one collector;
+     *                               its per-thread buffers keep shards from contending
+     *                  Arguments: std::shared_ptr<OperationMetrics> metrics - Collector, or nullptr
+     *                  Returns: None
+     *****************************************************************************/
+    void attachMetrics(std::shared_ptr<OperationMetrics> metrics);
+
+    /******************************************************************************
+     *                  Name: stats
+     *                  Description: Returns the totals of the attached collector
+     *                  Arguments: None
+     *                  Returns: MetricsSnapshot - Totals over all shards
+     *****************************************************************************/
+    MetricsSnapshot stats() const;
+
+    /******************************************************************************
+     *                  Name: attachChangeStream
+     *                  Description: Publishes every shard's changes to one stream.
+     *                               Shards publish concurrently, so events for one app
+     *                               are in order but events for apps on different
+     *                               shards interleave arbitrarily.
+     *                  Arguments: std::shared_ptr<ChangeStream> stream - Stream, or nullptr
+     *                  Returns: None
+     *****************************************************************************/
+    void attachChangeStream(std::shared_ptr<ChangeStream> stream);
+
+    /******************************************************************************
+     *                  Name: enableSnapshotReads
+     *                  Description: Starts keeping a multi-version copy of every shard
+     *                               for readSnapshot()
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void enableSnapshotReads();
+
+    /******************************************************************************
+     *                  Name: readSnapshot
+     *                  Description: Returns a consistent point-in-time view of the
+     *                               whole registry. All shard locks are held together
+     *                               only while each shard's current version is pinned,
+     *                               a few microseconds; iterating the snapshots takes
+     *                               no locks, so a full export never stalls writers.
+     *                  Arguments: None
+     *                  Returns: std::vector<AppMapSnapshot> - One snapshot per shard; an
+     *                           app is in the one of the shard it hashes to
+     *****************************************************************************/
+    std::vector<AppMapSnapshot> readSnapshot() const;
+
+    /******************************************************************************
+     *                  Name: expireGrants
+     *                  Description: Revokes the expired timed grants of every shard. A
+     *                               shard's exclusive lock is only taken when one of
+     *                               its deadlines has passed.
+     *                  Arguments: None
+     *                  Returns: std::size_t - Grants revoked
+     *****************************************************************************/
+    std::size_t expireGrants();
+
+    /******************************************************************************
+     *                  Name: nextExpiry
+     *                  Description: Returns the earliest nextExpiry of the shards
+     *                  Arguments: None
+     *                  Returns: MobileAppManager::ExpiryClock::time_point - Time, or
+     *                           time_point::max() if no timed grant is pending
+     *****************************************************************************/
+    MobileAppManager::ExpiryClock::time_point nextExpiry() const;
+
+    /******************************************************************************
+     *                  Name: startExpiryThread
+     *                  Description: Starts a thread that sleeps until the next deadline
+     *                               and runs expireGrants, so expired grants leave
+     *                               whole-registry reads without any caller ticking.
+     *                               Timed grants with an earlier deadline wake it.
+     *                               Does nothing if the thread is already running.
+     *                  Arguments: std::chrono::milliseconds maxIdle - Longest sleep,
+     *                                                               bounding the delay
+     *                                                               of a missed wakeup
+     *                  Returns: None
+     *****************************************************************************/
+    void startExpiryThread(std::chrono::milliseconds maxIdle = kDefaultExpiryIdle);
+
+    /******************************************************************************
+     *                  Name: stopExpiryThread
+     *                  Description: Stops the expiry thread and waits for it to exit
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void stopExpiryThread();
+
+private:
+    /******************************************************************************
+     *                  Structure Definition: Shard
+     *                  Description: One partition of the registry and its lock, padded
+     *                               to its own cache line to avoid false sharing
+     *****************************************************************************/
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;  // Readers share, writers are exclusive
+        MobileAppManager manager;         // Apps hashed to this shard
+    };
+
+    Shard& shardFor(std::string_view appName) const;
+    template <typename Query>
+    std::vector<std::string> mergePages(std::size_t limit, Query query) const;
+    void runExpiry(std::chrono::milliseconds maxIdle);
+    void wakeExpiry(MobileAppManager::ExpiryClock::time_point deadline);
+
+    std::unique_ptr<Shard[]> shards;  // Fixed array of shards
+    std::size_t count;                // Number of shards
+    std::shared_ptr<OperationMetrics> metrics;  // Collector shared by the shards, may be null
+    std::mutex expiryMutex;                     // Guards the expiry thread's state
+    std::condition_variable expiryWakeup;       // Signals an earlier deadline or a stop
+    std::thread expiryThread;                   // Background expiry thread, if started
+    bool expiryRunning = false;                 // The thread is running and not told to stop
+    MobileAppManager::ExpiryClock::time_point expiryWake;   // When the thread next wakes
+};
+
+#endif
+
+/******************************** End of File ********************************/
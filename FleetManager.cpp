@@ -0,0 +1,626 @@
+
+/******************************************************************************
+ *                    File Name: FleetManager.cpp
+ *                    Description: Implementation file for the deduplicated fleet
+ *                                 manager
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "FleetManager.h"
+#include <algorithm>  // For std::lower_bound, std::sort
+#include <utility>    // For std::move
+
+namespace {
+
+/******************************************************************************
+ *                  Name: finalize
+ *                  Description: splitmix64 finalizer used to combine ids into hashes
+ *                  Arguments: std::uint64_t value - Value to scramble
+ *                  Returns: std::uint64_t - Scrambled value
+ *****************************************************************************/
+std::uint64_t finalize(std::uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+}  // namespace
+
+/******************************************************************************
+ *                  Constructor: FleetManager
+ *                  Description: Creates the shared empty state at kEmptyState
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+FleetManager::FleetManager() : states(1) {}
+
+/******************************************************************************
+ *                  Name: addDevice
+ *                  Description: Registers a device in the empty state, reusing the
+ *                               slot of a removed device when there is one
+ *                  Arguments: std::string_view device - Device name
+ *                  Returns: OpStatus - Ok or DeviceExists
+ *****************************************************************************/
+OpStatus FleetManager::addDevice(std::string_view device) {
+    if (deviceIds.count(device) != 0) {
+        return OpStatus::DeviceExists;
+    }
+    DeviceId id;
+    if (!freeDevices.empty()) {
+        id = freeDevices.back();
+        freeDevices.pop_back();
+        deviceNames[id].assign(device.data(), device.size());
+    } else {
+        id = static_cast<DeviceId>(deviceStates.size());
+        deviceStates.push_back(kEmptyState);
+        deviceNames.emplace_back(device);
+    }
+    deviceIds.emplace(std::string_view(deviceNames[id]), id);
+    return OpStatus::Ok;
+}
+
+/******************************************************************************
+ *                  Name: addDevice
+ *                  Description: Registers a device, interns a record for each of the
+ *                               source's apps and points the device at the state
+ *                               made of them
+ *                  Arguments: std::string_view device - Device name
+ *                             const MobileAppManager& source - Registry to copy
+ *                  Returns: OpStatus - Ok or DeviceExists
+ *****************************************************************************/
+OpStatus FleetManager::addDevice(std::string_view device, const MobileAppManager& source) {
+    OpStatus status = addDevice(device);
+    if (status != OpStatus::Ok) {
+        return status;
+    }
+    PermissionRegistry& registry = PermissionRegistry::instance();
+    std::vector<RecordId> members;
+    source.forEachInstalledApp([&](std::string_view appName) {
+        PermissionSet permissions;
+        source.forEachAppPermission(appName, [&](std::string_view permission) {
+            permissions.insert(registry.intern(permission));
+        });
+        members.push_back(acquireRecord(internApp(appName), std::move(permissions)));
+    });
+    std::sort(members.begin(), members.end(),
+              [&](RecordId a, RecordId b) { return records[a].app < records[b].app; });
+    StateId state = acquireState(members);
+    for (RecordId member : members) {
+        releaseRecord(member);
+    }
+    deviceStates[deviceIds.find(device)->second] = state;
+    return OpStatus::Ok;
+}
+
+/******************************************************************************
+ *                  Name: removeDevice
+ *                  Description: Drops the device's state and frees its slot
+ *                  Arguments: std::string_view device - Device name
+ *                  Returns: OpStatus - Ok or DeviceNotFound
+ *****************************************************************************/
+OpStatus FleetManager::removeDevice(std::string_view device) {
+    DeviceId id;
+    if (!findDevice(device, id)) {
+        return OpStatus::DeviceNotFound;
+    }
+    deviceIds.erase(device);
+    releaseState(deviceStates[id]);
+    deviceStates[id] = kEmptyState;
+    deviceNames[id].clear();
+    freeDevices.push_back(id);
+    return OpStatus::Ok;
+}
+
+/******************************************************************************
+ *                  Name: installApp
+ *                  Description: Adds an empty-permission record for the app to the
+ *                               device's state
+ *                  Arguments: std::string_view device - Device name
+ *                             std::string_view appName - Name of the application
+ *                  Returns: OpStatus - Ok, DeviceNotFound, InvalidAppName or AppExists
+ *****************************************************************************/
+OpStatus FleetManager::installApp(std::string_view device, std::string_view appName) {
+    DeviceId id;
+    if (!findDevice(device, id)) {
+        return OpStatus::DeviceNotFound;
+    }
+    if (appName.empty()) {
+        return OpStatus::InvalidAppName;
+    }
+    AppKey app = internApp(appName);
+    if (findRecord(states[deviceStates[id]], app) != nullptr) {
+        return OpStatus::AppExists;
+    }
+    RecordId record = acquireRecord(app, PermissionSet());
+    setRecord(id, app, record);
+    releaseRecord(record);
+    return OpStatus::Ok;
+}
+
+/******************************************************************************
+ *                  Name: uninstallApp
+ *                  Description: Removes the app's record from the device's state
+ *                  Arguments: std::string_view device - Device name
+ *                             std::string_view appName - Name of the application
+ *                  Returns: OpStatus - Ok, DeviceNotFound or AppNotFound
+ *****************************************************************************/
+OpStatus FleetManager::uninstallApp(std::string_view device, std::string_view appName) {
+    DeviceId id;
+    if (!findDevice(device, id)) {
+        return OpStatus::DeviceNotFound;
+    }
+    AppKey app;
+    if (!findApp(appName, app) || findRecord(states[deviceStates[id]], app) == nullptr) {
+        return OpStatus::AppNotFound;
+    }
+    setRecord(id, app, kNoRecord);
+    return OpStatus::Ok;
+}
+
+/******************************************************************************
+ *                  Name: assignPermission
+ *                  Description: Replaces the app's record with one that also holds
+ *                               the permission
+ *                  Arguments: std::string_view device - Device name
+ *                             std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission to assign
+ *                  Returns: OpStatus - Ok, DeviceNotFound, InvalidPermission or
+ *                           AppNotFound
+ *****************************************************************************/
+OpStatus FleetManager::assignPermission(std::string_view device, std::string_view appName,
+                                        std::string_view permission) {
+    DeviceId id;
+    if (!findDevice(device, id)) {
+        return OpStatus::DeviceNotFound;
+    }
+    if (permission.empty()) {
+        return OpStatus::InvalidPermission;
+    }
+    AppKey app;
+    const Record* current = findApp(appName, app) ? findRecord(states[deviceStates[id]], app) : nullptr;
+    if (current == nullptr) {
+        return OpStatus::AppNotFound;
+    }
+    PermissionSet permissions = current->permissions;
+    if (permissions.insert(PermissionRegistry::instance().intern(permission))) {
+        RecordId record = acquireRecord(app, std::move(permissions));
+        setRecord(id, app, record);
+        releaseRecord(record);
+    }
+    return OpStatus::Ok;
+}
+
+/******************************************************************************
+ *                  Name: revokePermission
+ *                  Description: Replaces the app's record with one without the
+ *                               permission
+ *                  Arguments: std::string_view device - Device name
+ *                             std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission to revoke
+ *                  Returns: OpStatus - Ok, DeviceNotFound or AppNotFound
+ *****************************************************************************/
+OpStatus FleetManager::revokePermission(std::string_view device, std::string_view appName,
+                                        std::string_view permission) {
+    DeviceId id;
+    if (!findDevice(device, id)) {
+        return OpStatus::DeviceNotFound;
+    }
+    AppKey app;
+    const Record* current = findApp(appName, app) ? findRecord(states[deviceStates[id]], app) : nullptr;
+    if (current == nullptr) {
+        return OpStatus::AppNotFound;
+    }
+    PermissionId permissionId;
+    if (PermissionRegistry::instance().find(permission, permissionId) && current->permissions.contains(permissionId)) {
+        PermissionSet permissions = current->permissions;
+        permissions.erase(permissionId);
+        RecordId record = acquireRecord(app, std::move(permissions));
+        setRecord(id, app, record);
+        releaseRecord(record);
+    }
+    return OpStatus::Ok;
+}
+
+/******************************************************************************
+ *                  Name: hasPermission
+ *                  Description: Checks the app's record in the device's state
+ *                  Arguments: std::string_view device - Device name
+ *                             std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission to check
+ *                  Returns: bool - True if the device, app and grant all exist
+ *****************************************************************************/
+bool FleetManager::hasPermission(std::string_view device, std::string_view appName,
+                                 std::string_view permission) const {
+    DeviceId id;
+    AppKey app;
+    PermissionId permissionId;
+    if (!findDevice(device, id) || !findApp(appName, app) ||
+        !PermissionRegistry::instance().find(permission, permissionId)) {
+        return false;
+    }
+    const Record* record = findRecord(states[deviceStates[id]], app);
+    return record != nullptr && record->permissions.contains(permissionId);
+}
+
+/******************************************************************************
+ *                  Name: listInstalledApps
+ *                  Description: Lists the apps of a device
+ *                  Arguments: std::string_view device - Device name
+ *                  Returns: std::vector<std::string> - App names, sorted
+ *****************************************************************************/
+std::vector<std::string> FleetManager::listInstalledApps(std::string_view device) const {
+    std::vector<std::string> names;
+    DeviceId id;
+    if (findDevice(device, id)) {
+        for (RecordId record : states[deviceStates[id]].records) {
+            names.push_back(appNames[records[record].app]);
+        }
+        std::sort(names.begin(), names.end());
+    }
+    return names;
+}
+
+/******************************************************************************
+ *                  Name: listAppPermissions
+ *                  Description: Lists the permissions of an app on a device
+ *                  Arguments: std::string_view device - Device name
+ *                             std::string_view appName - Name of the application
+ *                  Returns: std::vector<std::string> - Permission names, sorted
+ *****************************************************************************/
+std::vector<std::string> FleetManager::listAppPermissions(std::string_view device, std::string_view appName) const {
+    std::vector<std::string> names;
+    DeviceId id;
+    AppKey app;
+    if (findDevice(device, id) && findApp(appName, app)) {
+        if (const Record* record = findRecord(states[deviceStates[id]], app)) {
+            PermissionRegistry& registry = PermissionRegistry::instance();
+            record->permissions.forEach([&](PermissionId permission) { names.push_back(registry.name(permission)); });
+            std::sort(names.begin(), names.end());
+        }
+    }
+    return names;
+}
+
+/******************************************************************************
+ *                  Name: devicesWithApp
+ *                  Description: Marks the states containing the app, then collects
+ *                               the devices in a marked state
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: std::vector<std::string> - Device names, sorted
+ *****************************************************************************/
+std::vector<std::string> FleetManager::devicesWithApp(std::string_view appName) const {
+    std::vector<std::string> names;
+    AppKey app;
+    if (!findApp(appName, app)) {
+        return names;
+    }
+    std::vector<bool> matching(states.size(), false);
+    for (std::size_t state = 0; state < states.size(); ++state) {
+        matching[state] = states[state].references != 0 && findRecord(states[state], app) != nullptr;
+    }
+    for (DeviceId id = 0; id < deviceStates.size(); ++id) {
+        if (matching[deviceStates[id]]) {
+            names.push_back(deviceNames[id]);
+        }
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+/******************************************************************************
+ *                  Name: devicesWithPermission
+ *                  Description: Marks the records of the app holding the permission,
+ *                               then the states containing a marked record, then
+ *                               collects the devices in a marked state
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission to look for
+ *                  Returns: std::vector<std::string> - Device names, sorted
+ *****************************************************************************/
+std::vector<std::string> FleetManager::devicesWithPermission(std::string_view appName,
+                                                             std::string_view permission) const {
+    std::vector<std::string> names;
+    AppKey app;
+    PermissionId permissionId;
+    if (!findApp(appName, app) || !PermissionRegistry::instance().find(permission, permissionId)) {
+        return names;
+    }
+    std::vector<bool> matching(states.size(), false);
+    for (std::size_t state = 0; state < states.size(); ++state) {
+        const Record* record = states[state].references != 0 ? findRecord(states[state], app) : nullptr;
+        matching[state] = record != nullptr && record->permissions.contains(permissionId);
+    }
+    for (DeviceId id = 0; id < deviceStates.size(); ++id) {
+        if (matching[deviceStates[id]]) {
+            names.push_back(deviceNames[id]);
+        }
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+/******************************************************************************
+ *                  Name: stats
+ *                  Description: Counts live devices, states and records and sums the
+ *                               memory of every table
+ *                  Arguments: None
+ *                  Returns: FleetStats - Current figures
+ *****************************************************************************/
+FleetStats FleetManager::stats() const {
+    FleetStats result;
+    result.devices = deviceIds.size();
+    // Hash nodes hold a key, a value and a next pointer, plus a bucket pointer each
+    const std::size_t nodeBytes = 3 * sizeof(void*);
+    result.bytes = deviceStates.capacity() * sizeof(StateId) + freeDevices.capacity() * sizeof(DeviceId) +
+                   deviceIds.size() * (sizeof(std::string_view) + nodeBytes) +
+                   appKeys.size() * (sizeof(std::string_view) + nodeBytes) +
+                   records.capacity() * sizeof(Record) + states.capacity() * sizeof(State) +
+                   (recordIds.size() + stateIds.size()) * (sizeof(std::uint64_t) + nodeBytes);
+    for (const std::string& name : deviceNames) {
+        result.bytes += sizeof(std::string) + (name.capacity() > 15 ? name.capacity() + 1 : 0);
+    }
+    for (const std::string& name : appNames) {
+        result.bytes += sizeof(std::string) + (name.capacity() > 15 ? name.capacity() + 1 : 0);
+    }
+    for (const State& state : states) {
+        result.bytes += state.records.capacity() * sizeof(RecordId);
+    }
+    result.deviceStates = stateIds.size();
+    result.appRecords = recordIds.size();
+    return result;
+}
+
+/******************************************************************************
+ *                  Name: findDevice
+ *                  Description: Looks up a registered device
+ *                  Arguments: std::string_view device - Device name
+ *                             DeviceId& id - Receives the device slot
+ *                  Returns: bool - False if the device is not registered
+ *****************************************************************************/
+bool FleetManager::findDevice(std::string_view device, DeviceId& id) const {
+    auto it = deviceIds.find(device);
+    if (it == deviceIds.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: findApp
+ *                  Description: Looks up the key of an app name
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             AppKey& app - Receives the key
+ *                  Returns: bool - False if no device ever had the app
+ *****************************************************************************/
+bool FleetManager::findApp(std::string_view appName, AppKey& app) const {
+    auto it = appKeys.find(appName);
+    if (it == appKeys.end()) {
+        return false;
+    }
+    app = it->second;
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: internApp
+ *                  Description: Returns the key of an app name, assigning the next
+ *                               one on first use
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: AppKey - Key of the name
+ *****************************************************************************/
+FleetManager::AppKey FleetManager::internApp(std::string_view appName) {
+    auto it = appKeys.find(appName);
+    if (it != appKeys.end()) {
+        return it->second;
+    }
+    AppKey app = static_cast<AppKey>(appNames.size());
+    appNames.emplace_back(appName);
+    appKeys.emplace(std::string_view(appNames.back()), app);
+    return app;
+}
+
+/******************************************************************************
+ *                  Name: findRecord
+ *                  Description: Binary-searches a state for an app's record
+ *                  Arguments: const State& state - State to search
+ *                             AppKey app - App to find
+ *                  Returns: const Record* - The record, or nullptr
+ *****************************************************************************/
+const FleetManager::Record* FleetManager::findRecord(const State& state, AppKey app) const {
+    auto it = std::lower_bound(state.records.begin(), state.records.end(), app,
+                               [&](RecordId record, AppKey key) { return records[record].app < key; });
+    return it != state.records.end() && records[*it].app == app ? &records[*it] : nullptr;
+}
+
+/******************************************************************************
+ *                  Name: setRecord
+ *                  Description: Moves a device to the state equal to its current one
+ *                               with the app's record replaced, added or removed;
+ *                               the new state is acquired before the old one is
+ *                               released so shared records survive the switch
+ *                  Arguments: DeviceId device - Device to update
+ *                             AppKey app - App whose record changes
+ *                             RecordId record - New record, held by the caller, or
+ *                                               kNoRecord to remove the app
+ *                  Returns: None
+ *****************************************************************************/
+void FleetManager::setRecord(DeviceId device, AppKey app, RecordId record) {
+    StateId old = deviceStates[device];
+    std::vector<RecordId> members = states[old].records;
+    auto it = std::lower_bound(members.begin(), members.end(), app,
+                               [&](RecordId member, AppKey key) { return records[member].app < key; });
+    bool present = it != members.end() && records[*it].app == app;
+    if (record == kNoRecord) {
+        members.erase(it);
+    } else if (present) {
+        *it = record;
+    } else {
+        members.insert(it, record);
+    }
+    deviceStates[device] = acquireState(std::move(members));
+    releaseState(old);
+}
+
+/******************************************************************************
+ *                  Name: acquireRecord
+ *                  Description: Returns the interned record equal to (app,
+ *                               permissions), creating it on first use, and takes a
+ *                               reference on it
+ *                  Arguments: AppKey app - App name
+ *                             PermissionSet permissions - Granted permissions
+ *                  Returns: RecordId - The record
+ *****************************************************************************/
+FleetManager::RecordId FleetManager::acquireRecord(AppKey app, PermissionSet permissions) {
+    std::uint64_t hash = recordHash(app, permissions);
+    auto [first, last] = recordIds.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        Record& record = records[it->second];
+        if (record.app == app && record.permissions == permissions) {
+            ++record.references;
+            return it->second;
+        }
+    }
+    RecordId id;
+    if (!freeRecords.empty()) {
+        id = freeRecords.back();
+        freeRecords.pop_back();
+    } else {
+        id = static_cast<RecordId>(records.size());
+        records.emplace_back();
+    }
+    Record& record = records[id];
+    record.app = app;
+    record.permissions = std::move(permissions);
+    record.hash = hash;
+    record.references = 1;
+    recordIds.emplace(hash, id);
+    return id;
+}
+
+/******************************************************************************
+ *                  Name: releaseRecord
+ *                  Description: Drops a reference, freeing the record with the last
+ *                  Arguments: RecordId id - Record the caller holds
+ *                  Returns: None
+ *****************************************************************************/
+void FleetManager::releaseRecord(RecordId id) {
+    Record& record = records[id];
+    if (--record.references != 0) {
+        return;
+    }
+    auto [first, last] = recordIds.equal_range(record.hash);
+    for (auto it = first; it != last; ++it) {
+        if (it->second == id) {
+            recordIds.erase(it);
+            break;
+        }
+    }
+    record.permissions.clear();
+    freeRecords.push_back(id);
+}
+
+/******************************************************************************
+ *                  Name: acquireState
+ *                  Description: Returns the interned state with the given records,
+ *                               creating it on first use (which takes a reference on
+ *                               each record), and takes a reference on it
+ *                  Arguments: std::vector<RecordId> members - Records by ascending AppKey
+ *                  Returns: StateId - The state
+ *****************************************************************************/
+FleetManager::StateId FleetManager::acquireState(std::vector<RecordId> members) {
+    if (members.empty()) {
+        return kEmptyState;
+    }
+    std::uint64_t hash = stateHash(members);
+    auto [first, last] = stateIds.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        State& state = states[it->second];
+        if (state.records == members) {
+            ++state.references;
+            return it->second;
+        }
+    }
+    StateId id;
+    if (!freeStates.empty()) {
+        id = freeStates.back();
+        freeStates.pop_back();
+    } else {
+        id = static_cast<StateId>(states.size());
+        states.emplace_back();
+    }
+    for (RecordId member : members) {
+        ++records[member].references;
+    }
+    State& state = states[id];
+    state.records = std::move(members);
+    state.records.shrink_to_fit();
+    state.hash = hash;
+    state.references = 1;
+    stateIds.emplace(hash, id);
+    return id;
+}
+
+/******************************************************************************
+ *                  Name: releaseState
+ *                  Description: Drops a reference, freeing the state and releasing
+ *                               its records with the last one
+ *                  Arguments: StateId id - State the caller holds
+ *                  Returns: None
+ *****************************************************************************/
+void FleetManager::releaseState(StateId id) {
+    if (id == kEmptyState || --states[id].references != 0) {
+        return;
+    }
+    State& state = states[id];
+    auto [first, last] = stateIds.equal_range(state.hash);
+    for (auto it = first; it != last; ++it) {
+        if (it->second == id) {
+            stateIds.erase(it);
+            break;
+        }
+    }
+    for (RecordId member : state.records) {
+        releaseRecord(member);
+    }
+    state.records.clear();
+    state.records.shrink_to_fit();
+    freeStates.push_back(id);
+}
+
+/******************************************************************************
+ *                  Name: recordHash
+ *                  Description: Hashes a record's app and its permissions; the
+ *                               permission terms are summed so order does not matter
+ *                  Arguments: AppKey app - App name
+ *                             const PermissionSet& permissions - Granted permissions
+ *                  Returns: std::uint64_t - Hash
+ *****************************************************************************/
+std::uint64_t FleetManager::recordHash(AppKey app, const PermissionSet& permissions) {
+    std::uint64_t hash = finalize(app);
+    permissions.forEach([&](PermissionId id) { hash += finalize((std::uint64_t(id) << 32) ^ app ^ 0x5bd1e995ULL); });
+    return hash;
+}
+
+/******************************************************************************
+ *                  Name: stateHash
+ *                  Description: Hashes an ordered list of record ids
+ *                  Arguments: const std::vector<RecordId>& members - Records of a state
+ *                  Returns: std::uint64_t - Hash
+ *****************************************************************************/
+std::uint64_t FleetManager::stateHash(const std::vector<RecordId>& members) {
+    std::uint64_t hash = members.size();
+    for (RecordId member : members) {
+        hash = finalize(hash * 31 + member);
+    }
+    return hash;
+}
+
+/******************************** End of File ********************************/
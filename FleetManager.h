@@ -0,0 +1,238 @@
+
+/******************************************************************************
+ *                    File Name: FleetManager.h
+ *                    Description: Header file for FleetManager, which holds the app
+ *                                 registries of many devices as references to shared,
+ *                                 deduplicated records
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __FLEET_MANAGER_H__
+#define __FLEET_MANAGER_H__
+
+#include "MobileAppManager.h"
+#include "OpStatus.h"
+#include "PermissionSet.h"
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/******************************************************************************
+ *                  Structure Definition: FleetStats
+ *                  Description: Sharing achieved by a fleet
+ *****************************************************************************/
+
+struct FleetStats {
+    std::size_t devices = 0;        // Registered devices
+    std::size_t deviceStates = 0;   // Distinct app sets, shared by the devices
+    std::size_t appRecords = 0;     // Distinct (app, permissions) records, shared by the app sets
+    std::size_t bytes = 0;          // Approximate heap bytes of the whole fleet
+};
+
+/******************************************************************************
+ *                  Class Definition: FleetManager
+ *                  Description: Registries of many devices with shared state. An
+ *                               app record, an app name with a permission set, is
+ *                               stored once however many devices have it; a device
+ *                               state, the sorted list of a device's records, is
+ *                               also stored once however many devices have exactly
+ *                               those apps. A device is a name and a state id.
+ *                               Records and states are immutable and hash-consed:
+ *                               a mutation builds the device's new state (copying
+ *                               only its list of record ids), looks it up in the
+ *                               intern table, and drops a reference on the old one,
+ *                               which is freed with its last device. Fleet-wide
+ *                               queries scan the distinct records and states rather
+ *                               than every device. Permission semantics follow
+ *                               MobileAppManager; groups are not supported. Not
+ *                               thread-safe.
+ *****************************************************************************/
+
+class FleetManager {
+public:
+    /******************************************************************************
+     *                  Name: FleetManager
+     *                  Description: Constructor creating an empty fleet
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    FleetManager();
+
+    /******************************************************************************
+     *                  Name: addDevice
+     *                  Description: Registers a device with no apps
+     *                  Arguments: std::string_view device - Device name
+     *                  Returns: OpStatus - Ok or DeviceExists
+     *****************************************************************************/
+    OpStatus addDevice(std::string_view device);
+
+    /******************************************************************************
+     *                  Name: addDevice
+     *                  Description: Registers a device holding a copy of a manager's
+     *                               apps and effective permissions
+     *                  Arguments: std::string_view device - Device name
+     *                             const MobileAppManager& source - Registry to copy
+     *                  Returns: OpStatus - Ok or DeviceExists
+     *****************************************************************************/
+    OpStatus addDevice(std::string_view device, const MobileAppManager& source);
+
+    /******************************************************************************
+     *                  Name: removeDevice
+     *                  Description: Unregisters a device and drops its state
+     *                  Arguments: std::string_view device - Device name
+     *                  Returns: OpStatus - Ok or DeviceNotFound
+     *****************************************************************************/
+    OpStatus removeDevice(std::string_view device);
+
+    /******************************************************************************
+     *                  Name: installApp
+     *                  Description: Installs an app on a device
+     *                  Arguments: std::string_view device - Device name
+     *                             std::string_view appName - Name of the application
+     *                  Returns: OpStatus - Ok, DeviceNotFound, InvalidAppName or AppExists
+     *****************************************************************************/
+    OpStatus installApp(std::string_view device, std::string_view appName);
+
+    /******************************************************************************
+     *                  Name: uninstallApp
+     *                  Description: Uninstalls an app from a device
+     *                  Arguments: std::string_view device - Device name
+     *                             std::string_view appName - Name of the application
+     *                  Returns: OpStatus - Ok, DeviceNotFound or AppNotFound
+     *****************************************************************************/
+    OpStatus uninstallApp(std::string_view device, std::string_view appName);
+
+    /******************************************************************************
+     *                  Name: assignPermission
+     *                  Description: Grants a permission to an app on a device
+     *                  Arguments: std::string_view device - Device name
+     *                             std::string_view appName - Name of the application
+     *                             std::string_view permission - Permission to assign
+     *                  Returns: OpStatus - Ok, DeviceNotFound, InvalidPermission or
+     *                           AppNotFound
+     *****************************************************************************/
+    OpStatus assignPermission(std::string_view device, std::string_view appName, std::string_view permission);
+
+    /******************************************************************************
+     *                  Name: revokePermission
+     *                  Description: Revokes a permission from an app on a device
+     *                  Arguments: std::string_view device - Device name
+     *                             std::string_view appName - Name of the application
+     *                             std::string_view permission - Permission to revoke
+     *                  Returns: OpStatus - Ok, DeviceNotFound or AppNotFound
+     *****************************************************************************/
+    OpStatus revokePermission(std::string_view device, std::string_view appName, std::string_view permission);
+
+    /******************************************************************************
+     *                  Name: hasPermission
+     *                  Description: Checks whether an app on a device holds a permission
+     *                  Arguments: std::string_view device - Device name
+     *                             std::string_view appName - Name of the application
+     *                             std::string_view permission - Permission to check
+     *                  Returns: bool - True if the device, app and grant all exist
+     *****************************************************************************/
+    bool hasPermission(std::string_view device, std::string_view appName, std::string_view permission) const;
+
+    /******************************************************************************
+     *                  Name: listInstalledApps
+     *                  Description: Lists the apps of a device
+     *                  Arguments: std::string_view device - Device name
+     *                  Returns: std::vector<std::string> - App names, sorted; empty if
+     *                           the device is not registered
+     *****************************************************************************/
+    std::vector<std::string> listInstalledApps(std::string_view device) const;
+
+    /******************************************************************************
+     *                  Name: listAppPermissions
+     *                  Description: Lists the permissions of an app on a device
+     *                  Arguments: std::string_view device - Device name
+     *                             std::string_view appName - Name of the application
+     *                  Returns: std::vector<std::string> - Permission names, sorted
+     *****************************************************************************/
+    std::vector<std::string> listAppPermissions(std::string_view device, std::string_view appName) const;
+
+    /******************************************************************************
+     *                  Name: devicesWithApp
+     *                  Description: Lists the devices with an app installed
+     *                  Arguments: std::string_view appName - Name of the application
+     *                  Returns: std::vector<std::string> - Device names, sorted
+     *****************************************************************************/
+    std::vector<std::string> devicesWithApp(std::string_view appName) const;
+
+    /******************************************************************************
+     *                  Name: devicesWithPermission
+     *                  Description: Lists the devices where an app holds a permission
+     *                  Arguments: std::string_view appName - Name of the application
+     *                             std::string_view permission - Permission to look for
+     *                  Returns: std::vector<std::string> - Device names, sorted
+     *****************************************************************************/
+    std::vector<std::string> devicesWithPermission(std::string_view appName, std::string_view permission) const;
+
+    /******************************************************************************
+     *                  Name: stats
+     *                  Description: Reports device, state and record counts and the
+     *                               approximate memory held
+     *                  Arguments: None
+     *                  Returns: FleetStats - Current figures
+     *****************************************************************************/
+    FleetStats stats() const;
+
+private:
+    using AppKey = std::uint32_t;     // Interned app name
+    using RecordId = std::uint32_t;   // Shared (app, permissions) record
+    using StateId = std::uint32_t;    // Shared device state
+    using DeviceId = std::uint32_t;   // Registered device
+
+    static constexpr StateId kEmptyState = 0;   // State of a device with no apps; never freed
+    static constexpr RecordId kNoRecord = ~RecordId(0);   // Passed to setRecord to remove an app
+
+    struct Record {
+        AppKey app = 0;                  // App name
+        PermissionSet permissions;       // Granted permissions
+        std::uint64_t hash = 0;          // Intern table key
+        std::uint32_t references = 0;    // States holding the record; 0 when free
+    };
+
+    struct State {
+        std::vector<RecordId> records;   // One record per app, by ascending AppKey
+        std::uint64_t hash = 0;          // Intern table key
+        std::uint32_t references = 0;    // Devices in the state; 0 when free
+    };
+
+    bool findDevice(std::string_view device, DeviceId& id) const;
+    bool findApp(std::string_view appName, AppKey& app) const;
+    AppKey internApp(std::string_view appName);
+    const Record* findRecord(const State& state, AppKey app) const;
+    void setRecord(DeviceId device, AppKey app, RecordId record);
+    RecordId acquireRecord(AppKey app, PermissionSet permissions);
+    void releaseRecord(RecordId id);
+    StateId acquireState(std::vector<RecordId> members);
+    void releaseState(StateId id);
+    static std::uint64_t recordHash(AppKey app, const PermissionSet& permissions);
+    static std::uint64_t stateHash(const std::vector<RecordId>& members);
+
+    std::vector<Record> records;                                 // Records by RecordId
+    std::vector<RecordId> freeRecords;                           // Free record slots
+    std::unordered_multimap<std::uint64_t, RecordId> recordIds;  // Hash -> live records
+    std::vector<State> states;                                   // States by StateId
+    std::vector<StateId> freeStates;                             // Free state slots
+    std::unordered_multimap<std::uint64_t, StateId> stateIds;    // Hash -> live states
+    std::vector<StateId> deviceStates;                           // State of each device slot
+    std::deque<std::string> deviceNames;                         // Name of each device slot
+    std::vector<DeviceId> freeDevices;                           // Slots of removed devices
+    std::unordered_map<std::string_view, DeviceId> deviceIds;    // Name -> device, keys view into deviceNames
+    std::deque<std::string> appNames;                            // AppKey -> name, stable addresses
+    std::unordered_map<std::string_view, AppKey> appKeys;        // Name -> AppKey, keys view into appNames
+};
+
+#endif
+
+/******************************** End of File ********************************/
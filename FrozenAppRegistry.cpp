@@ -0,0 +1,383 @@
+/******************************************************************************
+ *                    File Name: FrozenAppRegistry.cpp
+ *                    Description: Implementation file for the frozen registry and its
+ *                                 minimal perfect hash
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "FrozenAppRegistry.h"
+#include "AppIndex.h"
+#include "PermissionRegistry.h"
+#include <algorithm>  // For std::sort, std::lower_bound
+
+namespace {
+
+constexpr std::uint32_t kKeysPerBucket = 4;         // Average bucket load of the perfect hash
+constexpr std::uint32_t kMaxSeed = 1u << 24;        // Seeds tried per bucket before giving up
+
+/******************************************************************************
+ *                  Name: scale
+ *                  Description: Maps 32 hash bits onto [0, range) without division
+ *                  Arguments: std::uint32_t bits - Hash bits
+ *                             std::uint32_t range - Range size
+ *                  Returns: std::uint32_t - Value in range
+ *****************************************************************************/
+std::uint32_t scale(std::uint32_t bits, std::uint32_t range) {
+    return static_cast<std::uint32_t>((std::uint64_t(bits) * range) >> 32);
+}
+
+/******************************************************************************
+ *                  Name: seededSlot
+ *                  Description: Slot of a key under a bucket seed; splitmix64 over
+ *                               the key hash and the seed
+ *                  Arguments: std::uint64_t hash - Key hash
+ *                             std::uint32_t seed - Bucket seed
+ *                             std::uint32_t slots - Table size
+ *                  Returns: std::uint32_t - Slot
+ *****************************************************************************/
+std::uint32_t seededSlot(std::uint64_t hash, std::uint32_t seed, std::uint32_t slots) {
+    std::uint64_t value = hash + (std::uint64_t(seed) + 1) * 0x9e3779b97f4a7c15ULL;
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return scale(static_cast<std::uint32_t>(value >> 32), slots);
+}
+
+/******************************************************************************
+ *                  Name: appendName
+ *                  Description: Appends a name to a blob and records its end offset
+ *                  Arguments: std::string& blob - Concatenated names
+ *                             std::vector<std::uint32_t>& offsets - Start offsets
+ *                             std::string_view name - Name to append
+ *                  Returns: None
+ *****************************************************************************/
+void appendName(std::string& blob, std::vector<std::uint32_t>& offsets, std::string_view name) {
+    blob.append(name);
+    offsets.push_back(static_cast<std::uint32_t>(blob.size()));
+}
+
+}  // namespace
+
+/******************************************************************************
+ *                  Name: build
+ *                  Description: Assigns every key a slot. Keys are bucketed by the
+ *                               high hash bits; buckets are placed largest first,
+ *                               each trying seeds until all of its keys land on
+ *                               free, distinct slots. Single-key buckets take the
+ *                               next free slot directly.
+ *                  Arguments: const std::vector<std::uint64_t>& hashes - Key hashes
+ *                             std::vector<std::uint32_t>& slotOf - Receives each key's slot
+ *                  Returns: bool - False if some bucket exhausted its seeds
+ *****************************************************************************/
+bool FrozenAppRegistry::PerfectHash::build(const std::vector<std::uint64_t>& hashes,
+                                           std::vector<std::uint32_t>& slotOf) {
+    slots = static_cast<std::uint32_t>(hashes.size());
+    std::uint32_t buckets = std::max<std::uint32_t>(1, slots / kKeysPerBucket);
+    seeds.assign(buckets, 0);
+    slotOf.assign(slots, 0);
+
+    // Counting sort of the keys by bucket
+    std::vector<std::uint32_t> starts(buckets + 1, 0);
+    for (std::uint64_t hash : hashes) {
+        ++starts[scale(static_cast<std::uint32_t>(hash >> 32), buckets) + 1];
+    }
+    for (std::uint32_t b = 0; b < buckets; ++b) {
+        starts[b + 1] += starts[b];
+    }
+    std::vector<std::uint32_t> keys(slots);
+    std::vector<std::uint32_t> fill(starts.begin(), starts.end() - 1);
+    for (std::uint32_t key = 0; key < slots; ++key) {
+        keys[fill[scale(static_cast<std::uint32_t>(hashes[key] >> 32), buckets)]++] = key;
+    }
+
+    std::vector<std::uint32_t> order(buckets);
+    for (std::uint32_t b = 0; b < buckets; ++b) {
+        order[b] = b;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return starts[a + 1] - starts[a] > starts[b + 1] - starts[b];
+    });
+
+    std::vector<bool> taken(slots, false);
+    std::vector<std::uint32_t> candidate;
+    std::uint32_t nextFree = 0;
+    for (std::uint32_t bucket : order) {
+        std::uint32_t begin = starts[bucket];
+        std::uint32_t count = starts[bucket + 1] - begin;
+        if (count == 0) {
+            break;   // Sorted by size, so every remaining bucket is empty
+        }
+        if (count == 1) {
+            while (taken[nextFree]) {
+                ++nextFree;
+            }
+            taken[nextFree] = true;
+            slotOf[keys[begin]] = nextFree;
+            seeds[bucket] = kDirect | nextFree;
+            continue;
+        }
+        std::uint32_t seed = 0;
+        for (; seed < kMaxSeed; ++seed) {
+            candidate.clear();
+            for (std::uint32_t i = begin; i < begin + count; ++i) {
+                std::uint32_t slot = seededSlot(hashes[keys[i]], seed, slots);
+                if (taken[slot] || std::find(candidate.begin(), candidate.end(), slot) != candidate.end()) {
+                    break;
+                }
+                candidate.push_back(slot);
+            }
+            if (candidate.size() == count) {
+                break;
+            }
+        }
+        if (seed == kMaxSeed) {
+            return false;
+        }
+        seeds[bucket] = seed;
+        for (std::uint32_t i = 0; i < count; ++i) {
+            taken[candidate[i]] = true;
+            slotOf[keys[begin + i]] = candidate[i];
+        }
+    }
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: slot
+ *                  Description: Returns the slot a hash maps to. Keys that were not
+ *                               in the built set map to an arbitrary slot.
+ *                  Arguments: std::uint64_t hash - Key hash
+ *                  Returns: std::uint32_t - Slot
+ *****************************************************************************/
+std::uint32_t FrozenAppRegistry::PerfectHash::slot(std::uint64_t hash) const {
+    std::uint32_t seed = seeds[scale(static_cast<std::uint32_t>(hash >> 32),
+                                     static_cast<std::uint32_t>(seeds.size()))];
+    return (seed & kDirect) != 0 ? seed & ~kDirect : seededSlot(hash, seed, slots);
+}
+
+/******************************************************************************
+ *                  Name: memoryUsage
+ *                  Description: Returns the bytes of the seed array
+ *                  Arguments: None
+ *                  Returns: std::size_t - Bytes
+ *****************************************************************************/
+std::size_t FrozenAppRegistry::PerfectHash::memoryUsage() const {
+    return seeds.capacity() * sizeof(std::uint32_t);
+}
+
+/******************************************************************************
+ *                  Name: build
+ *                  Description: Numbers the permissions in use by interning order,
+ *                               builds both perfect hashes and lays names and
+ *                               permission lists out by slot
+ *                  Arguments: const std::vector<Entry>& apps - Apps with distinct names
+ *                             FrozenAppRegistry& registry - Receives the result
+ *                  Returns: bool - False if no perfect hash was found
+ *****************************************************************************/
+bool FrozenAppRegistry::build(const std::vector<Entry>& apps, FrozenAppRegistry& registry) {
+    FrozenAppRegistry frozen;
+    const PermissionRegistry& names = PermissionRegistry::instance();
+
+    // Permissions in use, renumbered densely in ascending PermissionId order
+    PermissionSet used;
+    for (const Entry& entry : apps) {
+        used |= entry.second;
+    }
+    std::vector<PermissionId> globals;
+    used.forEach([&](PermissionId id) { globals.push_back(id); });
+    std::vector<std::uint64_t> hashes;
+    hashes.reserve(globals.size());
+    frozen.permissionNameOffsets.push_back(0);
+    for (PermissionId id : globals) {
+        appendName(frozen.permissionNames, frozen.permissionNameOffsets, names.name(id));
+        hashes.push_back(AppIndex::hash(names.name(id)));
+    }
+    std::vector<std::uint32_t> slotOf;
+    if (!frozen.permissionHash.build(hashes, slotOf)) {
+        return false;
+    }
+    frozen.permissionLocals.assign(globals.size(), 0);
+    for (std::uint32_t local = 0; local < globals.size(); ++local) {
+        frozen.permissionLocals[slotOf[local]] = local;
+    }
+
+    hashes.clear();
+    hashes.reserve(apps.size());
+    for (const Entry& entry : apps) {
+        hashes.push_back(AppIndex::hash(entry.first));
+    }
+    if (!frozen.appHash.build(hashes, slotOf)) {
+        return false;
+    }
+    std::vector<std::uint32_t> entryOf(apps.size());
+    for (std::uint32_t index = 0; index < apps.size(); ++index) {
+        entryOf[slotOf[index]] = index;
+    }
+
+    std::size_t nameBytes = 0;
+    std::size_t grants = 0;
+    for (const Entry& entry : apps) {
+        nameBytes += entry.first.size();
+        grants += entry.second.size();
+    }
+    frozen.appNames.reserve(nameBytes);
+    frozen.appNameOffsets.reserve(apps.size() + 1);
+    frozen.permissionOffsets.reserve(apps.size() + 1);
+    frozen.permissions.reserve(grants);
+    frozen.appNameOffsets.push_back(0);
+    frozen.permissionOffsets.push_back(0);
+    for (std::uint32_t slot = 0; slot < apps.size(); ++slot) {
+        const Entry& entry = apps[entryOf[slot]];
+        appendName(frozen.appNames, frozen.appNameOffsets, entry.first);
+        entry.second.forEach([&](PermissionId id) {
+            frozen.permissions.push_back(static_cast<std::uint32_t>(
+                std::lower_bound(globals.begin(), globals.end(), id) - globals.begin()));
+        });
+        frozen.permissionOffsets.push_back(static_cast<std::uint32_t>(frozen.permissions.size()));
+    }
+
+    // Entries usually arrive in name order already, which skips the sort
+    std::vector<std::uint32_t> byName(apps.size());
+    for (std::uint32_t index = 0; index < apps.size(); ++index) {
+        byName[index] = index;
+    }
+    auto nameLess = [&](std::uint32_t a, std::uint32_t b) { return apps[a].first < apps[b].first; };
+    if (!std::is_sorted(byName.begin(), byName.end(), nameLess)) {
+        std::sort(byName.begin(), byName.end(), nameLess);
+    }
+    frozen.sortedSlots.resize(apps.size());
+    for (std::uint32_t rank = 0; rank < apps.size(); ++rank) {
+        frozen.sortedSlots[rank] = slotOf[byName[rank]];
+    }
+
+    registry = std::move(frozen);
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: size
+ *                  Description: Returns the number of apps
+ *                  Arguments: None
+ *                  Returns: std::size_t - App count
+ *****************************************************************************/
+std::size_t FrozenAppRegistry::size() const {
+    return sortedSlots.size();
+}
+
+/******************************************************************************
+ *                  Name: contains
+ *                  Description: Checks whether an app is in the registry
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: bool - True if present
+ *****************************************************************************/
+bool FrozenAppRegistry::contains(std::string_view appName) const {
+    std::uint32_t slot;
+    return findApp(appName, slot);
+}
+
+/******************************************************************************
+ *                  Name: hasPermission
+ *                  Description: Resolves the permission through its perfect hash and
+ *                               binary-searches the app's ascending list
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission to check
+ *                  Returns: bool - True if the app is present and holds it
+ *****************************************************************************/
+bool FrozenAppRegistry::hasPermission(std::string_view appName, std::string_view permission) const {
+    std::uint32_t slot;
+    if (permissionLocals.empty() || !findApp(appName, slot)) {
+        return false;
+    }
+    std::uint32_t local = permissionLocals[permissionHash.slot(AppIndex::hash(permission))];
+    if (permissionName(local) != permission) {
+        return false;
+    }
+    const std::uint32_t* begin = permissions.data() + permissionOffsets[slot];
+    const std::uint32_t* end = permissions.data() + permissionOffsets[slot + 1];
+    return std::binary_search(begin, end, local);
+}
+
+/******************************************************************************
+ *                  Name: listAppPermissions
+ *                  Description: Copies the permission names of an app and sorts them
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: std::vector<std::string> - Permission names, sorted
+ *****************************************************************************/
+std::vector<std::string> FrozenAppRegistry::listAppPermissions(std::string_view appName) const {
+    std::vector<std::string> result;
+    forEachAppPermission(appName, [&](std::string_view permission) { result.emplace_back(permission); });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+/******************************************************************************
+ *                  Name: listInstalledApps
+ *                  Description: Copies every app name in name order
+ *                  Arguments: None
+ *                  Returns: std::vector<std::string> - App names, sorted
+ *****************************************************************************/
+std::vector<std::string> FrozenAppRegistry::listInstalledApps() const {
+    std::vector<std::string> result;
+    result.reserve(sortedSlots.size());
+    forEachInstalledApp([&](std::string_view appName) { result.emplace_back(appName); });
+    return result;
+}
+
+/******************************************************************************
+ *                  Name: memoryUsage
+ *                  Description: Sums the capacity of every array
+ *                  Arguments: None
+ *                  Returns: std::size_t - Bytes
+ *****************************************************************************/
+std::size_t FrozenAppRegistry::memoryUsage() const {
+    return appHash.memoryUsage() + appNames.capacity() +
+           (appNameOffsets.capacity() + permissionOffsets.capacity() + permissions.capacity() +
+            sortedSlots.capacity() + permissionLocals.capacity() + permissionNameOffsets.capacity()) *
+               sizeof(std::uint32_t) +
+           permissionHash.memoryUsage() + permissionNames.capacity();
+}
+
+/******************************************************************************
+ *                  Name: findApp
+ *                  Description: Maps a name to its slot and confirms the name there
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::uint32_t& slot - Receives the slot
+ *                  Returns: bool - True if present
+ *****************************************************************************/
+bool FrozenAppRegistry::findApp(std::string_view appName, std::uint32_t& slot) const {
+    if (sortedSlots.empty()) {
+        return false;
+    }
+    slot = appHash.slot(AppIndex::hash(appName));
+    return this->appName(slot) == appName;
+}
+
+/******************************************************************************
+ *                  Name: appName
+ *                  Description: Returns the name stored in a slot
+ *                  Arguments: std::uint32_t slot - App slot
+ *                  Returns: std::string_view - View into the name blob
+ *****************************************************************************/
+std::string_view FrozenAppRegistry::appName(std::uint32_t slot) const {
+    return std::string_view(appNames.data() + appNameOffsets[slot], appNameOffsets[slot + 1] - appNameOffsets[slot]);
+}
+
+/******************************************************************************
+ *                  Name: permissionName
+ *                  Description: Returns the name of a local permission number
+ *                  Arguments: std::uint32_t local - Local permission number
+ *                  Returns: std::string_view - View into the permission blob
+ *****************************************************************************/
+std::string_view FrozenAppRegistry::permissionName(std::uint32_t local) const {
+    return std::string_view(permissionNames.data() + permissionNameOffsets[local],
+                            permissionNameOffsets[local + 1] - permissionNameOffsets[local]);
+}
+
+/******************************** End of File ********************************/
@@ -0,0 +1,176 @@
+
+/******************************************************************************
+ *                    File Name: FrozenAppRegistry.h
+ *                    Description: Header file for FrozenAppRegistry, an immutable
+ *                                 registry compiled for read-only lookups
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __FROZEN_APP_REGISTRY_H__
+#define __FROZEN_APP_REGISTRY_H__
+
+#include "PermissionSet.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/******************************************************************************
+ *                  Class Definition: FrozenAppRegistry
+ *                  Description: Read-only snapshot of a registry's apps and their
+ *                               effective permissions, stored in a few flat arrays:
+ *                                 - a minimal perfect hash (hash-and-displace) mapping
+ *                                   each app name to a slot in [0, apps), checked
+ *                                   against the name in one contiguous string blob;
+ *                                 - CSR offsets per slot into one array of permission
+ *                                   numbers, ascending in interning order;
+ *                                 - the permission names in a second blob with their
+ *                                   own perfect hash.
+ *                               A lookup hashes the name once, reads one seed and
+ *                               lands on the app's offsets and name. Nothing is
+ *                               mutated after construction and permission names are
+ *                               copied in, so any number of threads may read one
+ *                               registry concurrently without locks.
+ *****************************************************************************/
+
+class FrozenAppRegistry {
+public:
+    using Entry = std::pair<std::string_view, PermissionSet>;   // App name and effective permissions
+
+    /******************************************************************************
+     *                  Name: build
+     *                  Description: Compiles a registry from app entries
+     *                  Arguments: const std::vector<Entry>& apps - Apps with distinct
+     *                                                             names, in any order
+     *                             FrozenAppRegistry& registry - Receives the result
+     *                  Returns: bool - False if no perfect hash was found, which
+     *                           takes a 64-bit hash collision between two names
+     *****************************************************************************/
+    static bool build(const std::vector<Entry>& apps, FrozenAppRegistry& registry);
+
+    /******************************************************************************
+     *                  Name: size
+     *                  Description: Returns the number of apps
+     *                  Arguments: None
+     *                  Returns: std::size_t - App count
+     *****************************************************************************/
+    std::size_t size() const;
+
+    /******************************************************************************
+     *                  Name: contains
+     *                  Description: Checks whether an app is in the registry
+     *                  Arguments: std::string_view appName - Name of the application
+     *                  Returns: bool - True if present
+     *****************************************************************************/
+    bool contains(std::string_view appName) const;
+
+    /******************************************************************************
+     *                  Name: hasPermission
+     *                  Description: Checks whether an app holds a permission
+     *                  Arguments: std::string_view appName - Name of the application
+     *                             std::string_view permission - Permission to check
+     *                  Returns: bool - True if the app is present and holds it
+     *****************************************************************************/
+    bool hasPermission(std::string_view appName, std::string_view permission) const;
+
+    /******************************************************************************
+     *                  Name: forEachAppPermission
+     *                  Description: Calls fn(std::string_view) for every permission of
+     *                               an app, in the manager's interning order
+     *                  Arguments: std::string_view appName - Name of the application
+     *                             Fn fn - Callback invoked per permission name
+     *                  Returns: bool - False if the app is not present
+     *****************************************************************************/
+    template <typename Fn>
+    bool forEachAppPermission(std::string_view appName, Fn fn) const {
+        std::uint32_t slot;
+        if (!findApp(appName, slot)) {
+            return false;
+        }
+        for (std::uint32_t i = permissionOffsets[slot]; i < permissionOffsets[slot + 1]; ++i) {
+            fn(permissionName(permissions[i]));
+        }
+        return true;
+    }
+
+    /******************************************************************************
+     *                  Name: listAppPermissions
+     *                  Description: Lists the permissions of an app
+     *                  Arguments: std::string_view appName - Name of the application
+     *                  Returns: std::vector<std::string> - Permission names, sorted; empty
+     *                           if the app is not present
+     *****************************************************************************/
+    std::vector<std::string> listAppPermissions(std::string_view appName) const;
+
+    /******************************************************************************
+     *                  Name: forEachInstalledApp
+     *                  Description: Calls fn(std::string_view) for every app, in name
+     *                               order
+     *                  Arguments: Fn fn - Callback invoked per app name
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEachInstalledApp(Fn fn) const {
+        for (std::uint32_t slot : sortedSlots) {
+            fn(appName(slot));
+        }
+    }
+
+    /******************************************************************************
+     *                  Name: listInstalledApps
+     *                  Description: Lists every app
+     *                  Arguments: None
+     *                  Returns: std::vector<std::string> - App names, sorted
+     *****************************************************************************/
+    std::vector<std::string> listInstalledApps() const;
+
+    /******************************************************************************
+     *                  Name: memoryUsage
+     *                  Description: Returns the heap bytes of all arrays
+     *                  Arguments: None
+     *                  Returns: std::size_t - Bytes
+     *****************************************************************************/
+    std::size_t memoryUsage() const;
+
+private:
+    /**************************************************************************
+     *  PerfectHash: keys fall into buckets by the high hash bits; each bucket
+     *  stores a seed that sends all of its keys to free slots, or, for a single
+     *  key, the slot itself (kDirect set). Buckets are placed largest first.
+     **************************************************************************/
+    struct PerfectHash {
+        static constexpr std::uint32_t kDirect = 0x80000000u;   // Seed holds the slot itself
+
+        std::vector<std::uint32_t> seeds;   // One per bucket
+        std::uint32_t slots = 0;            // Keys, and slots
+
+        bool build(const std::vector<std::uint64_t>& hashes, std::vector<std::uint32_t>& slotOf);
+        std::uint32_t slot(std::uint64_t hash) const;
+        std::size_t memoryUsage() const;
+    };
+
+    bool findApp(std::string_view appName, std::uint32_t& slot) const;
+    std::string_view appName(std::uint32_t slot) const;
+    std::string_view permissionName(std::uint32_t local) const;
+
+    PerfectHash appHash;                              // App name -> slot
+    std::string appNames;                             // Names by slot, concatenated
+    std::vector<std::uint32_t> appNameOffsets;        // Slot -> start in appNames; one extra end
+    std::vector<std::uint32_t> permissionOffsets;     // Slot -> start in permissions; one extra end
+    std::vector<std::uint32_t> permissions;           // Local permission numbers per app, ascending
+    std::vector<std::uint32_t> sortedSlots;           // Slots in app name order
+    PerfectHash permissionHash;                       // Permission name -> slot
+    std::vector<std::uint32_t> permissionLocals;      // Perfect hash slot -> local number
+    std::string permissionNames;                      // Names by local number, concatenated
+    std::vector<std::uint32_t> permissionNameOffsets; // Local number -> start in permissionNames
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,542 @@
+
+/******************************************************************************
+ *                    File Name: Journal.cpp
+ *                    Description: Implementation file for the write-ahead journal
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "Journal.h"
+#include <cerrno>
+#include <cstring>    // For std::memcpy
+#include <fstream>
+#include <iterator>   // For std::istreambuf_iterator
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::size_t kFrameBytes = 8;             // Length and checksum words
+constexpr std::uint32_t kMaxPayloadBytes = 1 << 24; // Larger lengths mean corruption
+constexpr std::chrono::milliseconds kIdleWait(100); // Upper bound on a single condition wait
+
+/******************************************************************************
+ *                  Name: fnv1a32
+ *                  Description: 32-bit FNV-1a hash of a byte range
+ *                  Arguments: const char* bytes - Start of the range
+ *                             std::size_t length - Number of bytes
+ *                  Returns: std::uint32_t - Hash value
+ *****************************************************************************/
+std::uint32_t fnv1a32(const char* bytes, std::size_t length) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<unsigned char>(bytes[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/******************************************************************************
+ *                  Name: putVarint
+ *                  Description: Appends an unsigned LEB128 integer
+ *                  Arguments: std::string& out - Destination buffer
+ *                             std::uint64_t value - Value to encode
+ *                  Returns: None
+ *****************************************************************************/
+void putVarint(std::string& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+/******************************************************************************
+ *                  Name: getVarint
+ *                  Description: Decodes an unsigned LEB128 integer
+ *                  Arguments: const char*& cursor - Read position, advanced past the value
+ *                             const char* end - End of the readable range
+ *                             std::uint64_t& value - Receives the decoded value
+ *                  Returns: bool - False if the range ends inside the value
+ *****************************************************************************/
+bool getVarint(const char*& cursor, const char* end, std::uint64_t& value) {
+    value = 0;
+    for (unsigned shift = 0; cursor < end && shift < 64; shift += 7) {
+        unsigned char byte = static_cast<unsigned char>(*cursor++);
+        value |= std::uint64_t(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/******************************************************************************
+ *                  Name: getString
+ *                  Description: Decodes a varint length followed by that many bytes
+ *                  Arguments: const char*& cursor - Read position, advanced past the string
+ *                             const char* end - End of the readable range
+ *                             std::string& value - Receives the string
+ *                  Returns: bool - False if the range ends inside the string
+ *****************************************************************************/
+bool getString(const char*& cursor, const char* end, std::string& value) {
+    std::uint64_t length;
+    if (!getVarint(cursor, end, length) || length > static_cast<std::uint64_t>(end - cursor)) {
+        return false;
+    }
+    value.assign(cursor, static_cast<std::size_t>(length));
+    cursor += length;
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: getList
+ *                  Description: Decodes a varint count followed by that many strings
+ *                  Arguments: const char*& cursor - Read position, advanced past the list
+ *                             const char* end - End of the readable range
+ *                             std::vector<std::string>& values - Receives the strings
+ *                  Returns: bool - False if the range ends inside the list
+ *****************************************************************************/
+bool getList(const char*& cursor, const char* end, std::vector<std::string>& values) {
+    std::uint64_t count;
+    if (!getVarint(cursor, end, count) || count > static_cast<std::uint64_t>(end - cursor)) {
+        return false;
+    }
+    values.resize(static_cast<std::size_t>(count));
+    for (std::string& value : values) {
+        if (!getString(cursor, end, value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: syncFile
+ *                  Description: Flushes a file's data to stable storage, retrying if
+ *                               a signal interrupts the call
+ *                  Arguments: int fd - File descriptor
+ *                  Returns: bool - True on success
+ *****************************************************************************/
+bool syncFile(int fd) {
+#if defined(_WIN32)
+    return ::_commit(fd) == 0;
+#else
+    int result;
+    do {
+#if defined(__APPLE__)
+        result = ::fsync(fd);
+#else
+        result = ::fdatasync(fd);
+#endif
+    } while (result != 0 && errno == EINTR);
+    return result == 0;
+#endif
+}
+
+}  // namespace
+
+/******************************************************************************
+ *                  Destructor: Journal
+ *                  Description: Syncs pending records and closes the file
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+Journal::~Journal() {
+    close();
+}
+
+/******************************************************************************
+ *                  Name: open
+ *                  Description: Opens the file in append mode and starts the commit thread
+ *                  Arguments: const std::string& path - Journal file
+ *                             JournalOptions options - Group commit tuning
+ *                  Returns: bool - True on success
+ *****************************************************************************/
+bool Journal::open(const std::string& path, JournalOptions journalOptions) {
+    close();
+#ifdef _WIN32
+    fd = ::_open(path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, 0644);
+#else
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+#endif
+    if (fd < 0) {
+        return false;
+    }
+    options = journalOptions;
+    appended = durable = syncs = 0;
+    urgent = stopping = failed = false;
+    pending.clear();
+    worker = std::thread([this]() { run(); });
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: close
+ *                  Description: Stops the commit thread after it has written every
+ *                               pending record, then closes the file
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void Journal::close() {
+    if (fd < 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    pendingReady.notify_one();
+    worker.join();
+#ifdef _WIN32
+    ::_close(fd);
+#else
+    ::close(fd);
+#endif
+    fd = -1;
+}
+
+/******************************************************************************
+ *                  Name: append
+ *                  Description: Journals a batch kind under the record kind of the
+ *                               same value
+ *                  Arguments: BatchOpType type - Kind of mutation
+ *                             std::string_view appName - Target application
+ *                             std::string_view permission - Permission, may be empty
+ *                  Returns: std::uint64_t - Sequence number of the record
+ *****************************************************************************/
+std::uint64_t Journal::append(BatchOpType type, std::string_view appName, std::string_view permission) {
+    return append(static_cast<JournalRecordType>(type), appName, permission);
+}
+
+/******************************************************************************
+ *                  Name: append
+ *                  Description: Encodes the record straight into the pending batch and
+ *                               wakes the commit thread when a batch starts or fills
+ *                  Arguments: JournalRecordType type - Kind of record
+ *                             std::string_view appName - Target application
+ *                             std::string_view permission - Permission or group, may be empty
+ *                  Returns: std::uint64_t - Sequence number of the record
+ *****************************************************************************/
+std::uint64_t Journal::append(JournalRecordType type, std::string_view appName, std::string_view permission) {
+    std::unique_lock<std::mutex> lock(mutex);
+    bool batchStarted = pending.empty();
+    std::size_t frame = pending.size();
+    pending.append(kFrameBytes, '\0');
+    pending.push_back(static_cast<char>(type));
+    putVarint(pending, appName.size());
+    pending.append(appName);
+    putVarint(pending, permission.size());
+    pending.append(permission);
+    return seal(lock, frame, batchStarted);
+}
+
+/******************************************************************************
+ *                  Name: appendGroup
+ *                  Description: Encodes a DefineGroup record: the common fields with
+ *                               an empty permission, then each list as a varint
+ *                               count followed by its strings
+ *                  Arguments: std::string_view group - Group name
+ *                             const std::vector<std::string_view>& permissions -
+ *                                 Permissions granted by the group
+ *                             const std::vector<std::string_view>& includes -
+ *                                 Groups it includes
+ *                  Returns: std::uint64_t - Sequence number of the record
+ *****************************************************************************/
+std::uint64_t Journal::appendGroup(std::string_view group, const std::vector<std::string_view>& permissions,
+                                   const std::vector<std::string_view>& includes) {
+    std::unique_lock<std::mutex> lock(mutex);
+    bool batchStarted = pending.empty();
+    std::size_t frame = pending.size();
+    pending.append(kFrameBytes, '\0');
+    pending.push_back(static_cast<char>(JournalRecordType::DefineGroup));
+    putVarint(pending, group.size());
+    pending.append(group);
+    putVarint(pending, 0);
+    for (const std::vector<std::string_view>* list : {&permissions, &includes}) {
+        putVarint(pending, list->size());
+        for (std::string_view name : *list) {
+            putVarint(pending, name.size());
+            pending.append(name);
+        }
+    }
+    return seal(lock, frame, batchStarted);
+}
+
+/******************************************************************************
+ *                  Name: seal
+ *                  Description: Fills in the frame of the record just encoded at the
+ *                               end of the pending batch, assigns its sequence and
+ *                               wakes the commit thread when a batch starts or fills
+ *                  Arguments: std::unique_lock<std::mutex>& lock - Held; released here
+ *                             std::size_t frame - Offset of the record's frame
+ *                             bool batchStarted - The record opened a new batch
+ *                  Returns: std::uint64_t - Sequence number of the record
+ *****************************************************************************/
+std::uint64_t Journal::seal(std::unique_lock<std::mutex>& lock, std::size_t frame, bool batchStarted) {
+    std::uint32_t length = static_cast<std::uint32_t>(pending.size() - frame - kFrameBytes);
+    std::uint32_t checksum = fnv1a32(&pending[frame + kFrameBytes], length);
+    std::memcpy(&pending[frame], &length, sizeof(length));
+    std::memcpy(&pending[frame + sizeof(length)], &checksum, sizeof(checksum));
+
+    std::uint64_t sequence = ++appended;
+    bool full = pending.size() >= options.maxBatchBytes;
+    lock.unlock();
+    if (batchStarted || full) {
+        pendingReady.notify_one();
+    }
+    return sequence;
+}
+
+/******************************************************************************
+ *                  Name: waitDurable
+ *                  Description: Blocks until the commit thread has synced a sequence
+ *                  Arguments: std::uint64_t sequence - Sequence returned by append()
+ *                  Returns: bool - False if a write or sync failed
+ *****************************************************************************/
+bool Journal::waitDurable(std::uint64_t sequence) {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (durable < sequence && !failed) {
+        durableReady.wait_for(lock, kIdleWait);
+    }
+    return !failed;
+}
+
+/******************************************************************************
+ *                  Name: sync
+ *                  Description: Asks the commit thread to skip the batching delay and
+ *                               waits for everything appended so far
+ *                  Arguments: None
+ *                  Returns: bool - False if a write or sync failed
+ *****************************************************************************/
+bool Journal::sync() {
+    std::unique_lock<std::mutex> lock(mutex);
+    std::uint64_t target = appended;
+    urgent = true;
+    pendingReady.notify_one();
+    while (durable < target && !failed) {
+        durableReady.wait_for(lock, kIdleWait);
+    }
+    return !failed;
+}
+
+/******************************************************************************
+ *                  Name: reset
+ *                  Description: Waits until every appended record is synced and no
+ *                               commit is in flight, then truncates the file in the
+ *                               same lock hold, so no record can be written between
+ *                               the drain and the truncation. The caller must not
+ *                               append concurrently.
+ *                  Arguments: None
+ *                  Returns: bool - True on success
+ *****************************************************************************/
+bool Journal::reset() {
+    if (fd < 0) {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    urgent = true;
+    pendingReady.notify_one();
+    while ((committing || durable < appended) && !failed) {
+        durableReady.wait_for(lock, kIdleWait);
+    }
+    if (failed) {
+        return false;
+    }
+#ifdef _WIN32
+    return ::_chsize_s(fd, 0) == 0 && syncFile(fd);
+#else
+    return ::ftruncate(fd, 0) == 0 && syncFile(fd);
+#endif
+}
+
+/******************************************************************************
+ *                  Name: syncCount
+ *                  Description: Returns how many group commits have been synced
+ *                  Arguments: None
+ *                  Returns: std::uint64_t - Number of fdatasync calls
+ *****************************************************************************/
+std::uint64_t Journal::syncCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return syncs;
+}
+
+/******************************************************************************
+ *                  Name: run
+ *                  Description: Commit thread: wait for a first record, keep collecting
+ *                               until the delay expires, the batch fills or sync()
+ *                               asks, then commit the whole batch
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void Journal::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        while (!stopping && !urgent && pending.empty()) {
+            pendingReady.wait_for(lock, kIdleWait);
+        }
+        if (pending.empty()) {
+            urgent = false;
+            if (stopping) {
+                return;
+            }
+            continue;
+        }
+        auto deadline = std::chrono::steady_clock::now() + options.maxDelay;
+        pendingReady.wait_until(lock, deadline, [&]() {
+            return stopping || urgent || pending.size() >= options.maxBatchBytes;
+        });
+        commit(lock);
+    }
+}
+
+/******************************************************************************
+ *                  Name: commit
+ *                  Description: Takes the pending batch, writes and syncs it without
+ *                               holding the mutex, then publishes the new durable
+ *                               sequence. A failure is sticky: after a failed
+ *                               fsync the kernel may have dropped the dirty pages,
+ *                               so later syncs cannot vouch for this batch.
+ *                  Arguments: std::unique_lock<std::mutex>& lock - Held on entry and exit
+ *                  Returns: bool - True if the batch reached the disk
+ *****************************************************************************/
+bool Journal::commit(std::unique_lock<std::mutex>& lock) {
+    std::string batch;
+    batch.swap(pending);
+    std::uint64_t sequence = appended;
+    urgent = false;
+    committing = true;
+    lock.unlock();
+
+    // Short writes continue where they stopped and interrupted ones are retried;
+    // only a real error fails the batch
+    bool ok = true;
+    for (std::size_t written = 0; ok && written < batch.size();) {
+#ifdef _WIN32
+        int result = ::_write(fd, batch.data() + written, static_cast<unsigned>(batch.size() - written));
+#else
+        ssize_t result = ::write(fd, batch.data() + written, batch.size() - written);
+#endif
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        ok = result > 0;
+        written += ok ? static_cast<std::size_t>(result) : 0;
+    }
+    ok = ok && syncFile(fd);
+
+    lock.lock();
+    committing = false;
+    if (ok) {
+        durable = sequence;
+        ++syncs;
+    } else {
+        failed = true;
+    }
+    durableReady.notify_all();
+    return ok;
+}
+
+/******************************************************************************
+ *                  Name: replay
+ *                  Description: Decodes records in file order and truncates the file
+ *                               after the last intact one
+ *                  Arguments: const std::string& path - Journal file
+ *                             const std::function<void(const JournalRecord&)>& fn - Per record
+ *                  Returns: std::size_t - Number of records replayed
+ *****************************************************************************/
+std::size_t Journal::replay(const std::string& path, const std::function<void(const JournalRecord&)>& fn) {
+    std::string contents;
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return 0;
+        }
+        contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    const char* cursor = contents.data();
+    const char* end = cursor + contents.size();
+    std::size_t records = 0;
+    JournalRecord record;
+    while (static_cast<std::size_t>(end - cursor) >= kFrameBytes) {
+        std::uint32_t length;
+        std::uint32_t checksum;
+        std::memcpy(&length, cursor, sizeof(length));
+        std::memcpy(&checksum, cursor + sizeof(length), sizeof(checksum));
+        const char* payload = cursor + kFrameBytes;
+        if (length == 0 || length > kMaxPayloadBytes || length > static_cast<std::size_t>(end - payload) ||
+            fnv1a32(payload, length) != checksum) {
+            break;
+        }
+        const char* field = payload;
+        const char* payloadEnd = payload + length;
+        unsigned char type = static_cast<unsigned char>(*field++);
+        if (type > static_cast<unsigned char>(JournalRecordType::RevokeGroup) ||
+            !getString(field, payloadEnd, record.appName) || !getString(field, payloadEnd, record.permission)) {
+            break;
+        }
+        record.permissions.clear();
+        record.includes.clear();
+        if (type == static_cast<unsigned char>(JournalRecordType::DefineGroup) &&
+            (!getList(field, payloadEnd, record.permissions) || !getList(field, payloadEnd, record.includes))) {
+            break;
+        }
+        record.type = static_cast<JournalRecordType>(type);
+        fn(record);
+        ++records;
+        cursor = payloadEnd;
+    }
+
+    // If truncation fails the torn tail stays; the next replay stops at it again
+    if (cursor != end) {
+        std::size_t intact = static_cast<std::size_t>(cursor - contents.data());
+#ifdef _WIN32
+        int file = ::_open(path.c_str(), _O_WRONLY | _O_BINARY);
+        if (file >= 0) {
+            ::_chsize_s(file, static_cast<__int64>(intact));
+            ::_close(file);
+        }
+#else
+        int truncated = ::truncate(path.c_str(), static_cast<off_t>(intact));
+        static_cast<void>(truncated);
+#endif
+    }
+    return records;
+}
+
+/******************************************************************************
+ *                  Name: truncate
+ *                  Description: Opens the file, truncates it to empty and syncs it
+ *                  Arguments: const std::string& path - Journal file
+ *                  Returns: bool - True on success or if the file does not exist
+ *****************************************************************************/
+bool Journal::truncate(const std::string& path) {
+#ifdef _WIN32
+    int file = ::_open(path.c_str(), _O_WRONLY | _O_BINARY);
+#else
+    int file = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);
+#endif
+    if (file < 0) {
+        return errno == ENOENT;
+    }
+#ifdef _WIN32
+    bool ok = ::_chsize_s(file, 0) == 0 && syncFile(file);
+    return ::_close(file) == 0 && ok;
+#else
+    bool ok = ::ftruncate(file, 0) == 0 && syncFile(file);
+    return ::close(file) == 0 && ok;
+#endif
+}
+
+/******************************** End of File ********************************/
@@ -0,0 +1,230 @@
+
+/******************************************************************************
+ *                    File Name: Journal.h
+ *                    Description: Header file for Journal, an append-only write-ahead
+ *                                 log of registry mutations with group commit
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __JOURNAL_H__
+#define __JOURNAL_H__
+
+#include "AppBatch.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/******************************************************************************
+ *                  Enum Definition: JournalRecordType
+ *                  Description: Kind of a journal record. The app kinds share their
+ *                               values with BatchOpType; the group kinds exist only
+ *                               in the journal.
+ *****************************************************************************/
+
+enum class JournalRecordType : std::uint8_t {
+    Install = static_cast<std::uint8_t>(BatchOpType::Install),
+    Uninstall = static_cast<std::uint8_t>(BatchOpType::Uninstall),
+    Grant = static_cast<std::uint8_t>(BatchOpType::Grant),
+    Revoke = static_cast<std::uint8_t>(BatchOpType::Revoke),
+    DefineGroup,
+    AssignGroup,
+    RevokeGroup
+};
+
+/******************************************************************************
+ *                  Structure Definition: JournalRecord
+ *                  Description: One replayed record. permission is empty for Install
+ *                               and Uninstall and holds the group for AssignGroup
+ *                               and RevokeGroup. DefineGroup names the group in
+ *                               appName and lists its definition in permissions
+ *                               and includes.
+ *****************************************************************************/
+
+struct JournalRecord {
+    JournalRecordType type = JournalRecordType::Install;  // What to do
+    std::string appName;                                  // Target application, or the group defined
+    std::string permission;                               // Permission, or the group assigned or revoked
+    std::vector<std::string> permissions;                 // Permissions granted by a DefineGroup
+    std::vector<std::string> includes;                    // Groups included by a DefineGroup
+};
+
+/******************************************************************************
+ *                  Structure Definition: JournalOptions
+ *                  Description: Group commit tuning. A batch is written and synced
+ *                               once maxDelay has passed since its first record or
+ *                               once it holds maxBatchBytes, whichever comes first.
+ *****************************************************************************/
+
+struct JournalOptions {
+    std::chrono::microseconds maxDelay{2000};  // Longest a record waits before its sync
+    std::size_t maxBatchBytes = 1 << 20;       // Batch size that triggers an early sync
+};
+
+/******************************************************************************
+ *                  Class Definition: Journal
+ *                  Description: Records are framed as
+ *                                 uint32 payload length | uint32 FNV-1a of payload | payload
+ *                               and the payload is
+ *                                 uint8 JournalRecordType | varint length | app name
+ *                                                   | varint length | permission
+ *                               A DefineGroup record carries the group name as the
+ *                               app name and appends its permissions and includes,
+ *                               each as a varint count of length-prefixed names.
+ *                               append() only copies the record into the pending
+ *                               batch. A background thread writes each batch with
+ *                               one write and one fdatasync, so many records share
+ *                               one sync. sync() and waitDurable() block until
+ *                               records are on disk.
+ *****************************************************************************/
+
+class Journal {
+public:
+    Journal() = default;
+    ~Journal();
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    /******************************************************************************
+     *                  Name: open
+     *                  Description: Opens or creates the journal file for appending and
+     *                               starts the commit thread
+     *                  Arguments: const std::string& path - Journal file
+     *                             JournalOptions options - Group commit tuning
+     *                  Returns: bool - True on success
+     *****************************************************************************/
+    bool open(const std::string& path, JournalOptions options = JournalOptions());
+
+    /******************************************************************************
+     *                  Name: close
+     *                  Description: Syncs every pending record and closes the file
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void close();
+
+    /******************************************************************************
+     *                  Name: append
+     *                  Description: Queues one mutation record for the next group commit
+     *                  Arguments: BatchOpType type - Kind of mutation
+     *                             std::string_view appName - Target application
+     *                             std::string_view permission - Permission, empty for
+     *                                                           Install and Uninstall
+     *                  Returns: std::uint64_t - Sequence number of the record
+     *****************************************************************************/
+    std::uint64_t append(BatchOpType type, std::string_view appName, std::string_view permission);
+
+    /******************************************************************************
+     *                  Name: append
+     *                  Description: Queues one record of any kind but DefineGroup, which
+     *                               needs appendGroup()
+     *                  Arguments: JournalRecordType type - Kind of record
+     *                             std::string_view appName - Target application
+     *                             std::string_view value - Permission or group, may be empty
+     *                  Returns: std::uint64_t - Sequence number of the record
+     *****************************************************************************/
+    std::uint64_t append(JournalRecordType type, std::string_view appName, std::string_view value);
+
+    /******************************************************************************
+     *                  Name: appendGroup
+     *                  Description: Queues a DefineGroup record holding the whole
+     *                               definition, so replay never sees half of one
+     *                  Arguments: std::string_view group - Group name
+     *                             const std::vector<std::string_view>& permissions -
+     *                                 Permissions granted by the group
+     *                             const std::vector<std::string_view>& includes -
+     *                                 Groups it includes
+     *                  Returns: std::uint64_t - Sequence number of the record
+     *****************************************************************************/
+    std::uint64_t appendGroup(std::string_view group, const std::vector<std::string_view>& permissions,
+                              const std::vector<std::string_view>& includes);
+
+    /******************************************************************************
+     *                  Name: waitDurable
+     *                  Description: Blocks until a record and all before it are synced
+     *                  Arguments: std::uint64_t sequence - Sequence returned by append()
+     *                  Returns: bool - False if a write or sync failed
+     *****************************************************************************/
+    bool waitDurable(std::uint64_t sequence);
+
+    /******************************************************************************
+     *                  Name: sync
+     *                  Description: Commits the pending batch now and waits for it
+     *                  Arguments: None
+     *                  Returns: bool - False if a write or sync failed
+     *****************************************************************************/
+    bool sync();
+
+    /******************************************************************************
+     *                  Name: reset
+     *                  Description: Syncs, then truncates the file to empty. Used after a
+     *                               checkpoint has captured every record.
+     *                  Arguments: None
+     *                  Returns: bool - True on success
+     *****************************************************************************/
+    bool reset();
+
+    /******************************************************************************
+     *                  Name: syncCount
+     *                  Description: Returns how many group commits have been synced
+     *                  Arguments: None
+     *                  Returns: std::uint64_t - Number of fdatasync calls
+     *****************************************************************************/
+    std::uint64_t syncCount() const;
+
+    /******************************************************************************
+     *                  Name: replay
+     *                  Description: Reads a journal file from the start and calls fn for
+     *                               each intact record. Reading stops at the first
+     *                               short or corrupt record, which marks a torn tail
+     *                               from a crash; the file is truncated there.
+     *                  Arguments: const std::string& path - Journal file
+     *                             const std::function<void(const JournalRecord&)>& fn - Per record
+     *                  Returns: std::size_t - Number of records replayed
+     *****************************************************************************/
+    static std::size_t replay(const std::string& path, const std::function<void(const JournalRecord&)>& fn);
+
+    /******************************************************************************
+     *                  Name: truncate
+     *                  Description: Empties a journal file that is not open here and
+     *                               syncs the truncation, for recovery after the
+     *                               replayed records have been checkpointed
+     *                  Arguments: const std::string& path - Journal file
+     *                  Returns: bool - True on success or if the file does not exist
+     *****************************************************************************/
+    static bool truncate(const std::string& path);
+
+private:
+    void run();
+    bool commit(std::unique_lock<std::mutex>& lock);
+    std::uint64_t seal(std::unique_lock<std::mutex>& lock, std::size_t frame, bool batchStarted);
+
+    int fd = -1;                              // Journal file descriptor
+    JournalOptions options;                   // Group commit tuning
+    mutable std::mutex mutex;                 // Guards everything below
+    std::condition_variable pendingReady;     // Wakes the commit thread
+    std::condition_variable durableReady;     // Wakes threads waiting for a sync
+    std::string pending;                      // Encoded records not yet written
+    std::uint64_t appended = 0;               // Sequence of the last appended record
+    std::uint64_t durable = 0;                // Sequence of the last synced record
+    std::uint64_t syncs = 0;                  // Group commits synced
+    bool urgent = false;                      // sync() asked to skip the delay
+    bool stopping = false;                    // close() is shutting the thread down
+    bool committing = false;                  // The commit thread is writing a batch unlocked
+    bool failed = false;                      // A write or sync failed with a real error
+    std::thread worker;                       // Commit thread
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,166 @@
+
+/******************************************************************************
+ *                    File Name: LogSink.cpp
+ *                    Description: Implementation file for the basic log sinks
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "LogSink.h"
+#include <iostream>
+
+/******************************************************************************
+ *                  Constructor: LogSink
+ *                  Description: Initializes the threshold level
+ *                  Arguments: LogLevel level - Lowest level that is written
+ *                  Returns: None
+ *****************************************************************************/
+LogSink::LogSink(LogLevel level) : threshold(level) {}
+
+/******************************************************************************
+ *                  Name: flush
+ *                  Description: Default for unbuffered sinks: nothing to do
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void LogSink::flush() {}
+
+/******************************************************************************
+ *                  Name: setLevel
+ *                  Description: Changes the threshold level
+ *                  Arguments: LogLevel level - Lowest level that is written
+ *                  Returns: None
+ *****************************************************************************/
+void LogSink::setLevel(LogLevel level) {
+    threshold.store(level, std::memory_order_relaxed);
+}
+
+/******************************************************************************
+ *                  Name: console
+ *                  Description: Returns the shared sink writing to std::cout
+ *                  Arguments: None
+ *                  Returns: std::shared_ptr<LogSink> - Console sink
+ *****************************************************************************/
+std::shared_ptr<LogSink> LogSink::console() {
+    static std::shared_ptr<LogSink> sink = std::make_shared<StreamLogSink>(std::cout);
+    return sink;
+}
+
+/******************************************************************************
+ *                  Constructor: NullLogSink
+ *                  Description: Creates a sink whose threshold filters everything
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+NullLogSink::NullLogSink() : LogSink(LogLevel::Off) {}
+
+/******************************************************************************
+ *                  Name: write
+ *                  Description: Discards the message
+ *                  Arguments: LogLevel level - Severity of the message
+ *                             std::string_view message - Text without a newline
+ *                  Returns: None
+ *****************************************************************************/
+void NullLogSink::write(LogLevel, std::string_view) {}
+
+/******************************************************************************
+ *                  Constructor: StreamLogSink
+ *                  Description: Binds the sink to a stream
+ *                  Arguments: std::ostream& out - Destination stream
+ *                             LogLevel level - Lowest level that is written
+ *                  Returns: None
+ *****************************************************************************/
+StreamLogSink::StreamLogSink(std::ostream& out, LogLevel level) : LogSink(level), out(out) {}
+
+/******************************************************************************
+ *                  Name: write
+ *                  Description: Writes the message followed by '\n'
+ *                  Arguments: LogLevel level - Severity of the message
+ *                             std::string_view message - Text without a newline
+ *                  Returns: None
+ *****************************************************************************/
+void StreamLogSink::write(LogLevel, std::string_view message) {
+    std::lock_guard<std::mutex> lock(mutex);
+    out << message << '\n';
+}
+
+/******************************************************************************
+ *                  Name: flush
+ *                  Description: Flushes the underlying stream
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void StreamLogSink::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    out.flush();
+}
+
+/******************************************************************************
+ *                  Constructor: BufferedLogSink
+ *                  Description: Binds the sink to a stream and reserves the buffer
+ *                  Arguments: std::ostream& out - Destination stream
+ *                             std::size_t capacity - Bytes buffered before a write
+ *                             LogLevel level - Lowest level that is written
+ *                  Returns: None
+ *****************************************************************************/
+BufferedLogSink::BufferedLogSink(std::ostream& out, std::size_t capacity, LogLevel level)
+    : LogSink(level), out(out), capacity(capacity) {
+    buffer.reserve(capacity);
+}
+
+/******************************************************************************
+ *                  Destructor: BufferedLogSink
+ *                  Description: Writes out whatever is still buffered
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+BufferedLogSink::~BufferedLogSink() {
+    flush();
+}
+
+/******************************************************************************
+ *                  Name: write
+ *                  Description: Appends the message and writes the buffer out once
+ *                               it reaches capacity
+ *                  Arguments: LogLevel level - Severity of the message
+ *                             std::string_view message - Text without a newline
+ *                  Returns: None
+ *****************************************************************************/
+void BufferedLogSink::write(LogLevel, std::string_view message) {
+    std::lock_guard<std::mutex> lock(mutex);
+    buffer.append(message);
+    buffer.push_back('\n');
+    if (buffer.size() >= capacity) {
+        drain();
+    }
+}
+
+/******************************************************************************
+ *                  Name: flush
+ *                  Description: Writes out the buffer and flushes the stream
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void BufferedLogSink::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    drain();
+    out.flush();
+}
+
+/******************************************************************************
+ *                  Name: drain
+ *                  Description: Hands the buffer to the stream in one write. Caller
+ *                               holds the mutex.
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void BufferedLogSink::drain() {
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
+
+/******************************** End of File ********************************/
@@ -0,0 +1,182 @@
+
+/******************************************************************************
+ *                    File Name: LogSink.h
+ *                    Description: Header file for the levelled logging interface
+ *                                 injected into MobileAppManager and its basic sinks
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __LOG_SINK_H__
+#define __LOG_SINK_H__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/******************************************************************************
+ *                  Enum Definition: LogLevel
+ *                  Description: Severity of a log message, lowest first
+ *****************************************************************************/
+
+enum class LogLevel : std::uint8_t {
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Off     // Threshold only: disables every message
+};
+
+/******************************************************************************
+ *                  Class Definition: LogSink
+ *                  Description: Destination for log messages. Every sink has a
+ *                               threshold level; callers check enabled() before
+ *                               formatting so filtered messages cost nothing.
+ *                               Implementations must be safe to call from
+ *                               several threads at once.
+ *****************************************************************************/
+
+class LogSink {
+public:
+    /******************************************************************************
+     *                  Name: LogSink
+     *                  Description: Constructor setting the threshold level
+     *                  Arguments: LogLevel level - Lowest level that is written
+     *                  Returns: None
+     *****************************************************************************/
+    explicit LogSink(LogLevel level);
+
+    virtual ~LogSink() = default;
+
+    /******************************************************************************
+     *                  Name: write
+     *                  Description: Writes one message. Callers have already checked
+     *                               enabled(level).
+     *                  Arguments: LogLevel level - Severity of the message
+     *                             std::string_view message - Text without a newline
+     *                  Returns: None
+     *****************************************************************************/
+    virtual void write(LogLevel level, std::string_view message) = 0;
+
+    /******************************************************************************
+     *                  Name: flush
+     *                  Description: Pushes any buffered messages to their destination
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    virtual void flush();
+
+    /******************************************************************************
+     *                  Name: enabled
+     *                  Description: Checks whether messages of a level are written
+     *                  Arguments: LogLevel level - Severity to check
+     *                  Returns: bool - True if level is at or above the threshold
+     *****************************************************************************/
+    bool enabled(LogLevel level) const {
+        return level >= threshold.load(std::memory_order_relaxed);
+    }
+
+    /******************************************************************************
+     *                  Name: setLevel
+     *                  Description: Changes the threshold level
+     *                  Arguments: LogLevel level - Lowest level that is written
+     *                  Returns: None
+     *****************************************************************************/
+    void setLevel(LogLevel level);
+
+    /******************************************************************************
+     *                  Name: console
+     *                  Description: Returns the shared sink writing to std::cout, the
+     *                               default for managers that are not given one
+     *                  Arguments: None
+     *                  Returns: std::shared_ptr<LogSink> - Console sink
+     *****************************************************************************/
+    static std::shared_ptr<LogSink> console();
+
+private:
+    std::atomic<LogLevel> threshold;  // Lowest level that is written
+};
+
+/******************************************************************************
+ *                  Class Definition: NullLogSink
+ *                  Description: Discards everything. Its threshold is Off, so
+ *                               callers skip formatting entirely.
+ *****************************************************************************/
+
+class NullLogSink : public LogSink {
+public:
+    NullLogSink();
+    void write(LogLevel level, std::string_view message) override;
+};
+
+/******************************************************************************
+ *                  Class Definition: StreamLogSink
+ *                  Description: Writes each message as one line to an ostream
+ *                               under a mutex, without flushing per line
+ *****************************************************************************/
+
+class StreamLogSink : public LogSink {
+public:
+    /******************************************************************************
+     *                  Name: StreamLogSink
+     *                  Description: Constructor binding the sink to a stream
+     *                  Arguments: std::ostream& out - Destination stream
+     *                             LogLevel level - Lowest level that is written
+     *                  Returns: None
+     *****************************************************************************/
+    explicit StreamLogSink(std::ostream& out, LogLevel level = LogLevel::Info);
+
+    void write(LogLevel level, std::string_view message) override;
+    void flush() override;
+
+private:
+    std::mutex mutex;   // Serialises writes to out
+    std::ostream& out;  // Destination stream
+};
+
+/******************************************************************************
+ *                  Class Definition: BufferedLogSink
+ *                  Description: Appends messages to an in-memory buffer and hands
+ *                               the buffer to the stream in one write once it
+ *                               reaches its capacity, on flush() and on destruction
+ *****************************************************************************/
+
+class BufferedLogSink : public LogSink {
+public:
+    static constexpr std::size_t kDefaultCapacity = 64 * 1024;
+
+    /******************************************************************************
+     *                  Name: BufferedLogSink
+     *                  Description: Constructor binding the sink to a stream
+     *                  Arguments: std::ostream& out - Destination stream
+     *                             std::size_t capacity - Bytes buffered before a write
+     *                             LogLevel level - Lowest level that is written
+     *                  Returns: None
+     *****************************************************************************/
+    explicit BufferedLogSink(std::ostream& out, std::size_t capacity = kDefaultCapacity,
+                             LogLevel level = LogLevel::Info);
+    ~BufferedLogSink() override;
+
+    void write(LogLevel level, std::string_view message) override;
+    void flush() override;
+
+private:
+    void drain();
+
+    std::mutex mutex;       // Guards buffer and out
+    std::ostream& out;      // Destination stream
+    std::size_t capacity;   // Buffer size that triggers a write
+    std::string buffer;     // Pending lines
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,73 @@
+
+/******************************************************************************
+ *                    File Name: MemoryUsage.h
+ *                    Description: Header file for the registry memory breakdown and
+ *                                 the heap-size helpers used to compute it
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __MEMORY_USAGE_H__
+#define __MEMORY_USAGE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/******************************************************************************
+ *                  Structure Definition: MemoryUsage
+ *                  Description: Bytes held by a MobileAppManager, by structure.
+ *                               Heap blocks are counted at their requested size;
+ *                               the allocator field adds unused pool slots and a
+ *                               per-block header estimate. Snapshot-read versions
+ *                               and attached journals, metrics, streams and
+ *                               histories are owned elsewhere and not included.
+ *****************************************************************************/
+
+struct MemoryUsage {
+    std::size_t index = 0;            // Hash index, name trie, trigram index and app ids
+    std::size_t names = 0;            // Heap bytes of the app name strings
+    std::size_t records = 0;          // App objects in the pool
+    std::size_t permissions = 0;      // Permission set overflow and the reverse indexes
+    std::size_t extensions = 0;       // Merkle, bitmap and spill indexes, when enabled
+    std::size_t allocator = 0;        // Unused pool slots and heap block headers
+    std::size_t overflow = 0;         // Resident apps' permission IDs past the inline
+                                      // bitset, the bytes setPermissionOverflowBudget
+                                      // bounds; already counted above
+    std::size_t spilledApps = 0;      // Apps whose permissions are on disk
+    std::uint64_t spillFileBytes = 0; // Size of the spill file; not part of total()
+
+    /******************************************************************************
+     *                  Name: total
+     *                  Description: Sums the in-memory fields
+     *                  Arguments: None
+     *                  Returns: std::size_t - Bytes
+     *****************************************************************************/
+    std::size_t total() const {
+        return index + names + records + permissions + extensions + allocator;
+    }
+};
+
+constexpr std::size_t kHeapBlockOverhead = 16;   // Allocator header and rounding per heap block
+
+/******************************************************************************
+ *                  Name: stringHeapBytes
+ *                  Description: Returns the heap bytes behind a string; zero when
+ *                               the characters live in the small-string buffer
+ *                  Arguments: const std::string& text - String to measure
+ *                  Returns: std::size_t - Bytes
+ *****************************************************************************/
+inline std::size_t stringHeapBytes(const std::string& text) {
+    const char* inlineBegin = reinterpret_cast<const char*>(&text);
+    const char* inlineEnd = inlineBegin + sizeof(std::string);
+    bool local = text.data() >= inlineBegin && text.data() < inlineEnd;
+    return local ? 0 : text.capacity() + 1;
+}
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,176 @@
+
+/******************************************************************************
+ *                    File Name: MerkleIndex.cpp
+ *                    Description: Implementation file for the registry hash tree
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "MerkleIndex.h"
+#include "AppIndex.h"
+#include <algorithm>  // For std::find
+
+namespace {
+
+/******************************************************************************
+ *                  Name: finalize
+ *                  Description: splitmix64 finalizer; turns structured input into
+ *                               independent-looking 64-bit terms
+ *                  Arguments: std::uint64_t value - Value to scramble
+ *                  Returns: std::uint64_t - Scrambled value
+ *****************************************************************************/
+std::uint64_t finalize(std::uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+}  // namespace
+
+/******************************************************************************
+ *                  Constructor: MerkleIndex
+ *                  Description: Allocates the zeroed tree and the leaf member lists
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+MerkleIndex::MerkleIndex() : nodes(2 * kLeaves, 0), members(kLeaves) {}
+
+/******************************************************************************
+ *                  Name: addApp
+ *                  Description: Records the app in its leaf and adds its terms
+ *                  Arguments: const App* app - App to add
+ *                             const PermissionSet& permissions - The app's permissions
+ *                  Returns: None
+ *****************************************************************************/
+void MerkleIndex::addApp(const App* app, const PermissionSet& permissions) {
+    std::uint64_t nameHash = AppIndex::hash(app->getAppName());
+    std::uint64_t delta = appTerm(nameHash);
+    permissions.forEach([&](PermissionId id) { delta += permissionTerm(nameHash, id); });
+    members[nameHash >> (64 - kLeafBits)].push_back(app);
+    add(nameHash, delta);
+}
+
+/******************************************************************************
+ *                  Name: removeApp
+ *                  Description: Drops the app from its leaf and subtracts its terms
+ *                  Arguments: const App* app - App previously added
+ *                  Returns: None
+ *****************************************************************************/
+void MerkleIndex::removeApp(const App* app) {
+    std::uint64_t nameHash = AppIndex::hash(app->getAppName());
+    std::uint64_t delta = appTerm(nameHash);
+    app->getPermissionSet().forEach([&](PermissionId id) { delta += permissionTerm(nameHash, id); });
+    std::vector<const App*>& leaf = members[nameHash >> (64 - kLeafBits)];
+    auto it = std::find(leaf.begin(), leaf.end(), app);
+    if (it == leaf.end()) {
+        return;
+    }
+    *it = leaf.back();
+    leaf.pop_back();
+    add(nameHash, 0 - delta);
+}
+
+/******************************************************************************
+ *                  Name: addPermission
+ *                  Description: Adds the (app, permission) term
+ *                  Arguments: const App* app - App in the index
+ *                             PermissionId id - New permission
+ *                  Returns: None
+ *****************************************************************************/
+void MerkleIndex::addPermission(const App* app, PermissionId id) {
+    std::uint64_t nameHash = AppIndex::hash(app->getAppName());
+    add(nameHash, permissionTerm(nameHash, id));
+}
+
+/******************************************************************************
+ *                  Name: removePermission
+ *                  Description: Subtracts the (app, permission) term
+ *                  Arguments: const App* app - App in the index
+ *                             PermissionId id - Removed permission
+ *                  Returns: None
+ *****************************************************************************/
+void MerkleIndex::removePermission(const App* app, PermissionId id) {
+    std::uint64_t nameHash = AppIndex::hash(app->getAppName());
+    add(nameHash, 0 - permissionTerm(nameHash, id));
+}
+
+/******************************************************************************
+ *                  Name: clear
+ *                  Description: Zeroes the tree and empties every leaf
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void MerkleIndex::clear() {
+    std::fill(nodes.begin(), nodes.end(), 0);
+    for (std::vector<const App*>& leaf : members) {
+        leaf.clear();
+    }
+}
+
+/******************************************************************************
+ *                  Name: rootHash
+ *                  Description: Returns the hash of the whole registry
+ *                  Arguments: None
+ *                  Returns: std::uint64_t - Root hash
+ *****************************************************************************/
+std::uint64_t MerkleIndex::rootHash() const {
+    return nodes[1];
+}
+
+/******************************************************************************
+ *                  Name: memoryUsage
+ *                  Description: Sums the tree array and every leaf list
+ *                  Arguments: None
+ *                  Returns: std::size_t - Bytes
+ *****************************************************************************/
+std::size_t MerkleIndex::memoryUsage() const {
+    std::size_t bytes = nodes.capacity() * sizeof(std::uint64_t) + members.capacity() * sizeof(members[0]);
+    for (const std::vector<const App*>& leaf : members) {
+        bytes += leaf.capacity() * sizeof(const App*);
+    }
+    return bytes;
+}
+
+/******************************************************************************
+ *                  Name: appTerm
+ *                  Description: Term contributed by an app's presence
+ *                  Arguments: std::uint64_t nameHash - Hash of the app name
+ *                  Returns: std::uint64_t - Term
+ *****************************************************************************/
+std::uint64_t MerkleIndex::appTerm(std::uint64_t nameHash) {
+    return finalize(nameHash);
+}
+
+/******************************************************************************
+ *                  Name: permissionTerm
+ *                  Description: Term contributed by one permission of an app
+ *                  Arguments: std::uint64_t nameHash - Hash of the app name
+ *                             PermissionId id - The permission
+ *                  Returns: std::uint64_t - Term
+ *****************************************************************************/
+std::uint64_t MerkleIndex::permissionTerm(std::uint64_t nameHash, PermissionId id) {
+    return finalize(nameHash + (std::uint64_t(id) + 1) * 0x9e3779b97f4a7c15ULL);
+}
+
+/******************************************************************************
+ *                  Name: add
+ *                  Description: Adds a delta to the app's leaf and every ancestor;
+ *                               arithmetic wraps modulo 2^64
+ *                  Arguments: std::uint64_t nameHash - Hash of the app name
+ *                             std::uint64_t delta - Amount to add
+ *                  Returns: None
+ *****************************************************************************/
+void MerkleIndex::add(std::uint64_t nameHash, std::uint64_t delta) {
+    for (std::size_t node = kLeaves + (nameHash >> (64 - kLeafBits)); node != 0; node >>= 1) {
+        nodes[node] += delta;
+    }
+}
+
+/******************************** End of File ********************************/
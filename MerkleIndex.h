@@ -0,0 +1,152 @@
+
+/******************************************************************************
+ *                    File Name: MerkleIndex.h
+ *                    Description: Header file for MerkleIndex, a hash tree over a
+ *                                 registry's apps used to find where two registries
+ *                                 differ without comparing every app
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __MERKLE_INDEX_H__
+#define __MERKLE_INDEX_H__
+
+#include "App.h"
+#include <cstdint>
+#include <vector>
+
+/******************************************************************************
+ *                  Class Definition: MerkleIndex
+ *                  Description: Complete binary hash tree with kLeaves leaves. An
+ *                               app belongs to the leaf picked by the top bits of
+ *                               its name hash, so the same app lands in the same
+ *                               leaf in every registry. A leaf's hash is the sum of
+ *                               a term for each of its apps and a term for each
+ *                               (app, permission) pair; an inner node's hash is the
+ *                               sum of its children. Sums make every update O(log
+ *                               kLeaves) additions with no rehashing of siblings,
+ *                               and two registries agree on a subtree exactly when
+ *                               (up to 64-bit collisions) their apps there agree.
+ *                               Permission terms use PermissionIds, which are
+ *                               process-wide, so only indexes in the same process
+ *                               compare meaningfully.
+ *****************************************************************************/
+
+class MerkleIndex {
+public:
+    static constexpr unsigned kLeafBits = 12;                          // log2 of the leaf count
+    static constexpr std::size_t kLeaves = std::size_t(1) << kLeafBits;   // Leaves of the tree
+
+    /******************************************************************************
+     *                  Name: MerkleIndex
+     *                  Description: Constructor creating an empty tree
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    MerkleIndex();
+
+    /******************************************************************************
+     *                  Name: addApp
+     *                  Description: Adds an app with its permissions, which are passed
+     *                               separately so an evicted app can be added
+     *                  Arguments: const App* app - App to add; must outlive its entry
+     *                             const PermissionSet& permissions - The app's permissions
+     *                  Returns: None
+     *****************************************************************************/
+    void addApp(const App* app, const PermissionSet& permissions);
+
+    /******************************************************************************
+     *                  Name: removeApp
+     *                  Description: Removes an app and its current permissions
+     *                  Arguments: const App* app - App previously added
+     *                  Returns: None
+     *****************************************************************************/
+    void removeApp(const App* app);
+
+    /******************************************************************************
+     *                  Name: addPermission
+     *                  Description: Accounts for a permission the app just gained
+     *                  Arguments: const App* app - App in the index
+     *                             PermissionId id - New permission
+     *                  Returns: None
+     *****************************************************************************/
+    void addPermission(const App* app, PermissionId id);
+
+    /******************************************************************************
+     *                  Name: removePermission
+     *                  Description: Accounts for a permission the app just lost
+     *                  Arguments: const App* app - App in the index
+     *                             PermissionId id - Removed permission
+     *                  Returns: None
+     *****************************************************************************/
+    void removePermission(const App* app, PermissionId id);
+
+    /******************************************************************************
+     *                  Name: clear
+     *                  Description: Removes every app
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void clear();
+
+    /******************************************************************************
+     *                  Name: rootHash
+     *                  Description: Returns the hash of the whole registry
+     *                  Arguments: None
+     *                  Returns: std::uint64_t - Root hash
+     *****************************************************************************/
+    std::uint64_t rootHash() const;
+
+    /******************************************************************************
+     *                  Name: memoryUsage
+     *                  Description: Returns the heap bytes of the tree and the leaf lists
+     *                  Arguments: None
+     *                  Returns: std::size_t - Bytes
+     *****************************************************************************/
+    std::size_t memoryUsage() const;
+
+    /******************************************************************************
+     *                  Name: forEachDifference
+     *                  Description: Descends both trees from the root, skipping every
+     *                               subtree whose hashes agree, and calls
+     *                               fn(const std::vector<const App*>& mine,
+     *                                  const std::vector<const App*>& theirs)
+     *                               with the unordered apps of each leaf that differs
+     *                  Arguments: const MerkleIndex& other - Tree to compare with
+     *                             Fn fn - Callback invoked per differing leaf
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEachDifference(const MerkleIndex& other, Fn fn) const {
+        std::vector<std::size_t> pending{1};
+        while (!pending.empty()) {
+            std::size_t node = pending.back();
+            pending.pop_back();
+            if (nodes[node] == other.nodes[node]) {
+                continue;
+            }
+            if (node >= kLeaves) {
+                fn(members[node - kLeaves], other.members[node - kLeaves]);
+            } else {
+                pending.push_back(2 * node + 1);
+                pending.push_back(2 * node);
+            }
+        }
+    }
+
+private:
+    static std::uint64_t appTerm(std::uint64_t nameHash);
+    static std::uint64_t permissionTerm(std::uint64_t nameHash, PermissionId id);
+    void add(std::uint64_t nameHash, std::uint64_t delta);
+
+    std::vector<std::uint64_t> nodes;                 // Heap layout: 1 is the root, leaf i is kLeaves + i
+    std::vector<std::vector<const App*>> members;     // Apps of each leaf, unordered
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,405 @@
+
+/******************************************************************************
+ *                    File Name: Metrics.cpp
+ *                    Description: Implementation file for the operation counters,
+ *                                 latency histograms and Prometheus exporter
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "Metrics.h"
+#include "BitOps.h"
+#include <cmath>
+#include <cstdio>    // For std::snprintf
+#include <utility>
+
+namespace {
+
+std::atomic<std::uint64_t> nextMetricsId{1};
+constexpr std::size_t kMaxCachedBuffers = 64;
+
+/******************************************************************************
+ *                  Name: highestBit
+ *                  Description: Returns the index of the highest set bit
+ *                  Arguments: std::uint64_t value - Non-zero value
+ *                  Returns: unsigned - Bit index, 0 for the lowest bit
+ *****************************************************************************/
+unsigned highestBit(std::uint64_t value) {
+    return highestSetBit(value);
+}
+
+/******************************************************************************
+ *                  Name: bump
+ *                  Description: Adds to a counter that only the calling thread
+ *                               writes; readers on other threads load it relaxed
+ *                  Arguments: std::atomic<std::uint64_t>& counter - Counter to update
+ *                             std::uint64_t amount - Amount to add
+ *                  Returns: None
+ *****************************************************************************/
+void bump(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+/******************************************************************************
+ *                  Name: formatSeconds
+ *                  Description: Formats nanoseconds as seconds for the exporter
+ *                  Arguments: std::uint64_t nanos - Duration in nanoseconds
+ *                  Returns: std::string - Seconds in shortest %g form
+ *****************************************************************************/
+std::string formatSeconds(std::uint64_t nanos) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.9g", static_cast<double>(nanos) / 1e9);
+    return text;
+}
+
+}  // namespace
+
+/******************************************************************************
+ *                  Structure Definition: ThreadBuffer
+ *                  Description: Counters written by a single thread. Cache-line
+ *                               aligned so neighbouring buffers never share a line.
+ *****************************************************************************/
+struct alignas(64) OperationMetrics::ThreadBuffer {
+    std::atomic<std::uint64_t> outcomes[kMetricOpCount][kOpStatusCount] = {};
+    std::atomic<std::uint64_t> buckets[kMetricOpCount][LatencyHistogram::kBucketCount] = {};
+    std::atomic<std::uint64_t> totals[kMetricOpCount] = {};
+};
+
+/******************************************************************************
+ *                  Name: bucketFor
+ *                  Description: Values below 16 get a bucket each; above that the
+ *                               exponent picks a group of 16 buckets and the next
+ *                               four bits below the top bit pick one within it
+ *                  Arguments: std::uint64_t nanos - Latency in nanoseconds
+ *                  Returns: std::size_t - Bucket index
+ *****************************************************************************/
+std::size_t LatencyHistogram::bucketFor(std::uint64_t nanos) {
+    if (nanos < kSubBuckets) {
+        return static_cast<std::size_t>(nanos);
+    }
+    unsigned exponent = highestBit(nanos);
+    if (exponent > kMaxExponent) {
+        return kBucketCount - 1;
+    }
+    std::size_t sub = (nanos >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+    return (exponent - kSubBucketBits + 1) * kSubBuckets + sub;
+}
+
+/******************************************************************************
+ *                  Name: bucketUpperBound
+ *                  Description: Returns the largest latency a bucket holds
+ *                  Arguments: std::size_t bucket - Bucket index
+ *                  Returns: std::uint64_t - Upper bound in nanoseconds
+ *****************************************************************************/
+std::uint64_t LatencyHistogram::bucketUpperBound(std::size_t bucket) {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+    unsigned shift = static_cast<unsigned>(bucket / kSubBuckets) - 1;
+    std::uint64_t lower = (kSubBuckets + bucket % kSubBuckets) << shift;
+    return lower + (std::uint64_t(1) << shift) - 1;
+}
+
+/******************************************************************************
+ *                  Name: record
+ *                  Description: Adds one latency
+ *                  Arguments: std::uint64_t nanos - Latency in nanoseconds
+ *                  Returns: None
+ *****************************************************************************/
+void LatencyHistogram::record(std::uint64_t nanos) {
+    ++buckets[bucketFor(nanos)];
+    ++samples;
+    total += nanos;
+}
+
+/******************************************************************************
+ *                  Name: add
+ *                  Description: Adds raw counts, used to merge per-thread buffers
+ *                  Arguments: std::size_t bucket - Bucket index
+ *                             std::uint64_t hits - Samples to add to the bucket
+ *                             std::uint64_t nanos - Latency to add to the sum
+ *                  Returns: None
+ *****************************************************************************/
+void LatencyHistogram::add(std::size_t bucket, std::uint64_t hits, std::uint64_t nanos) {
+    buckets[bucket] += hits;
+    samples += hits;
+    total += nanos;
+}
+
+/******************************************************************************
+ *                  Name: merge
+ *                  Description: Adds every count of another histogram to this one
+ *                  Arguments: const LatencyHistogram& other - Histogram to add
+ *                  Returns: None
+ *****************************************************************************/
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    samples += other.samples;
+    total += other.total;
+}
+
+/******************************************************************************
+ *                  Name: percentile
+ *                  Description: Walks the buckets until the requested rank is reached
+ *                  Arguments: double fraction - Quantile in [0, 1]
+ *                  Returns: std::uint64_t - Bucket upper bound in nanoseconds
+ *****************************************************************************/
+std::uint64_t LatencyHistogram::percentile(double fraction) const {
+    if (samples == 0) {
+        return 0;
+    }
+    fraction = fraction < 0 ? 0 : fraction > 1 ? 1 : fraction;
+    std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(fraction * samples));
+    rank = rank == 0 ? 1 : rank;
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return bucketUpperBound(i);
+        }
+    }
+    return bucketUpperBound(kBucketCount - 1);
+}
+
+/******************************************************************************
+ *                  Name: count
+ *                  Description: Returns how many latencies were recorded
+ *                  Arguments: None
+ *                  Returns: std::uint64_t - Sample count
+ *****************************************************************************/
+std::uint64_t LatencyHistogram::count() const {
+    return samples;
+}
+
+/******************************************************************************
+ *                  Name: sum
+ *                  Description: Returns the total of the recorded latencies
+ *                  Arguments: None
+ *                  Returns: std::uint64_t - Sum in nanoseconds
+ *****************************************************************************/
+std::uint64_t LatencyHistogram::sum() const {
+    return total;
+}
+
+/******************************************************************************
+ *                  Name: bucketCount
+ *                  Description: Returns the number of samples in one bucket
+ *                  Arguments: std::size_t bucket - Bucket index
+ *                  Returns: std::uint64_t - Samples in the bucket
+ *****************************************************************************/
+std::uint64_t LatencyHistogram::bucketCount(std::size_t bucket) const {
+    return buckets[bucket];
+}
+
+/******************************************************************************
+ *                  Name: calls
+ *                  Description: Returns the number of calls over all outcomes
+ *                  Arguments: None
+ *                  Returns: std::uint64_t - Call count
+ *****************************************************************************/
+std::uint64_t OperationStats::calls() const {
+    std::uint64_t total = 0;
+    for (std::uint64_t outcome : outcomes) {
+        total += outcome;
+    }
+    return total;
+}
+
+/******************************************************************************
+ *                  Constructor: OperationMetrics
+ *                  Description: Creates an empty collector with a unique id
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+OperationMetrics::OperationMetrics() : id(nextMetricsId.fetch_add(1, std::memory_order_relaxed)) {}
+
+/******************************************************************************
+ *                  Destructor: OperationMetrics
+ *                  Description: Releases the thread buffers
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+OperationMetrics::~OperationMetrics() = default;
+
+/******************************************************************************
+ *                  Name: localBuffer
+ *                  Description: Returns the calling thread's buffer, creating it on
+ *                               first use. Each thread caches (instance id, buffer)
+ *                               pairs; ids are never reused, so an entry left by a
+ *                               destroyed instance can never match again.
+ *                  Arguments: None
+ *                  Returns: ThreadBuffer& - Buffer owned by this instance
+ *****************************************************************************/
+OperationMetrics::ThreadBuffer& OperationMetrics::localBuffer() {
+    thread_local std::vector<std::pair<std::uint64_t, ThreadBuffer*>> cache;
+    for (const auto& entry : cache) {
+        if (entry.first == id) {
+            return *entry.second;
+        }
+    }
+    if (cache.size() >= kMaxCachedBuffers) {
+        cache.clear();   // Live instances just hand this thread a fresh buffer
+    }
+    std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+    ThreadBuffer* raw = buffer.get();
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffers.push_back(std::move(buffer));
+    }
+    cache.emplace_back(id, raw);
+    return *raw;
+}
+
+/******************************************************************************
+ *                  Name: record
+ *                  Description: Counts one call and its latency in the calling
+ *                               thread's buffer
+ *                  Arguments: MetricOp op - Operation performed
+ *                             OpStatus status - Its outcome
+ *                             std::uint64_t nanos - Its latency in nanoseconds
+ *                  Returns: None
+ *****************************************************************************/
+void OperationMetrics::record(MetricOp op, OpStatus status, std::uint64_t nanos) {
+    ThreadBuffer& buffer = localBuffer();
+    std::size_t index = static_cast<std::size_t>(op);
+    bump(buffer.outcomes[index][static_cast<std::size_t>(status)], 1);
+    bump(buffer.buckets[index][LatencyHistogram::bucketFor(nanos)], 1);
+    bump(buffer.totals[index], nanos);
+}
+
+/******************************************************************************
+ *                  Name: stats
+ *                  Description: Merges every thread's buffer into one snapshot
+ *                  Arguments: None
+ *                  Returns: MetricsSnapshot - Current totals
+ *****************************************************************************/
+MetricsSnapshot OperationMetrics::stats() const {
+    MetricsSnapshot snapshot;
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (const std::unique_ptr<ThreadBuffer>& buffer : buffers) {
+        for (std::size_t op = 0; op < kMetricOpCount; ++op) {
+            OperationStats& stats = snapshot.operations[op];
+            for (std::size_t status = 0; status < kOpStatusCount; ++status) {
+                stats.outcomes[status] += buffer->outcomes[op][status].load(std::memory_order_relaxed);
+            }
+            for (std::size_t bucket = 0; bucket < LatencyHistogram::kBucketCount; ++bucket) {
+                std::uint64_t samples = buffer->buckets[op][bucket].load(std::memory_order_relaxed);
+                if (samples != 0) {
+                    stats.latency.add(bucket, samples, 0);
+                }
+            }
+            stats.latency.add(0, 0, buffer->totals[op].load(std::memory_order_relaxed));
+        }
+    }
+    return snapshot;
+}
+
+/******************************************************************************
+ *                  Name: metricOpName
+ *                  Description: Returns the snake_case name of an operation
+ *                  Arguments: MetricOp op - Operation
+ *                  Returns: const char* - Name used in exported metrics
+ *****************************************************************************/
+const char* metricOpName(MetricOp op) {
+    switch (op) {
+    case MetricOp::Install:            return "install";
+    case MetricOp::Uninstall:          return "uninstall";
+    case MetricOp::Assign:             return "assign_permission";
+    case MetricOp::Revoke:             return "revoke_permission";
+    case MetricOp::HasPermission:      return "has_permission";
+    case MetricOp::ListAppPermissions: return "list_app_permissions";
+    case MetricOp::ListInstalledApps:  return "list_installed_apps";
+    case MetricOp::AppsWithPermission: return "apps_with_permission";
+    case MetricOp::FindApps:           return "find_apps";
+    case MetricOp::SearchApps:         return "search_apps";
+    case MetricOp::ApplyBatch:         return "apply_batch";
+    case MetricOp::DefineGroup:        return "define_group";
+    case MetricOp::AssignGroup:        return "assign_group";
+    case MetricOp::RevokeGroup:        return "revoke_group";
+    case MetricOp::Count:              break;
+    }
+    return "unknown";
+}
+
+/******************************************************************************
+ *                  Name: opStatusName
+ *                  Description: Returns the snake_case name of an outcome
+ *                  Arguments: OpStatus status - Outcome
+ *                  Returns: const char* - Name used in exported metrics
+ *****************************************************************************/
+const char* opStatusName(OpStatus status) {
+    switch (status) {
+    case OpStatus::Ok:                return "ok";
+    case OpStatus::InvalidAppName:    return "invalid_app_name";
+    case OpStatus::InvalidPermission: return "invalid_permission";
+    case OpStatus::AppExists:         return "app_exists";
+    case OpStatus::AppNotFound:       return "app_not_found";
+    case OpStatus::GroupNotFound:     return "group_not_found";
+    case OpStatus::GroupCycle:        return "group_cycle";
+    case OpStatus::DeviceNotFound:    return "device_not_found";
+    case OpStatus::DeviceExists:      return "device_exists";
+    case OpStatus::NotApplied:        return "not_applied";
+    }
+    return "unknown";
+}
+
+/******************************************************************************
+ *                  Name: toPrometheus
+ *                  Description: Renders the outcome counters, then one histogram
+ *                               per operation with decade buckets from 1us to 10s
+ *                  Arguments: const MetricsSnapshot& snapshot - Totals to render
+ *                  Returns: std::string - Exposition text
+ *****************************************************************************/
+std::string toPrometheus(const MetricsSnapshot& snapshot) {
+    static const std::uint64_t kBoundsNanos[] = {1000, 10000, 100000, 1000000, 10000000,
+                                                 100000000, 1000000000, 10000000000ULL};
+    std::string out;
+    out += "# HELP mobileapp_operations_total Registry operations by outcome.\n";
+    out += "# TYPE mobileapp_operations_total counter\n";
+    for (std::size_t op = 0; op < kMetricOpCount; ++op) {
+        const OperationStats& stats = snapshot.operations[op];
+        for (std::size_t status = 0; status < kOpStatusCount; ++status) {
+            if (stats.outcomes[status] == 0) {
+                continue;
+            }
+            out += "mobileapp_operations_total{op=\"";
+            out += metricOpName(static_cast<MetricOp>(op));
+            out += "\",status=\"";
+            out += opStatusName(static_cast<OpStatus>(status));
+            out += "\"} " + std::to_string(stats.outcomes[status]) + "\n";
+        }
+    }
+
+    out += "# HELP mobileapp_operation_duration_seconds Registry operation latency.\n";
+    out += "# TYPE mobileapp_operation_duration_seconds histogram\n";
+    for (std::size_t op = 0; op < kMetricOpCount; ++op) {
+        const LatencyHistogram& latency = snapshot.operations[op].latency;
+        if (latency.count() == 0) {
+            continue;
+        }
+        std::string label = std::string("op=\"") + metricOpName(static_cast<MetricOp>(op)) + "\"";
+        std::uint64_t cumulative = 0;
+        std::size_t bucket = 0;
+        for (std::uint64_t bound : kBoundsNanos) {
+            for (; bucket < LatencyHistogram::kBucketCount && LatencyHistogram::bucketUpperBound(bucket) <= bound;
+                 ++bucket) {
+                cumulative += latency.bucketCount(bucket);
+            }
+            out += "mobileapp_operation_duration_seconds_bucket{" + label + ",le=\"" + formatSeconds(bound) +
+                   "\"} " + std::to_string(cumulative) + "\n";
+        }
+        out += "mobileapp_operation_duration_seconds_bucket{" + label + ",le=\"+Inf\"} " +
+               std::to_string(latency.count()) + "\n";
+        out += "mobileapp_operation_duration_seconds_sum{" + label + "} " + formatSeconds(latency.sum()) + "\n";
+        out += "mobileapp_operation_duration_seconds_count{" + label + "} " + std::to_string(latency.count()) + "\n";
+    }
+    return out;
+}
+
+/******************************** End of File ********************************/
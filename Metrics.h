@@ -0,0 +1,310 @@
+
+/******************************************************************************
+ *                    File Name: Metrics.h
+ *                    Description: Header file for the operation counters and
+ *                                 latency histograms of the app registry
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __METRICS_H__
+#define __METRICS_H__
+
+#include "OpStatus.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Build with -DMOBILEAPP_METRICS=0 to compile the instrumentation out entirely
+#ifndef MOBILEAPP_METRICS
+#define MOBILEAPP_METRICS 1
+#endif
+
+/******************************************************************************
+ *                  Enum Definition: MetricOp
+ *                  Description: Registry operations that are counted and timed
+ *****************************************************************************/
+
+enum class MetricOp : std::uint8_t {
+    Install,
+    Uninstall,
+    Assign,
+    Revoke,
+    HasPermission,
+    ListAppPermissions,
+    ListInstalledApps,
+    AppsWithPermission,
+    FindApps,
+    SearchApps,
+    ApplyBatch,
+    DefineGroup,
+    AssignGroup,
+    RevokeGroup,
+    Count               // Number of operations, not an operation
+};
+
+constexpr std::size_t kMetricOpCount = static_cast<std::size_t>(MetricOp::Count);
+constexpr std::size_t kOpStatusCount = static_cast<std::size_t>(OpStatus::NotApplied) + 1;
+
+/******************************************************************************
+ *                  Class Definition: LatencyHistogram
+ *                  Description: HDR-style log-linear histogram of nanosecond
+ *                               latencies. Each power of two is split into 16
+ *                               linear sub-buckets, so any recorded value is
+ *                               reported within 1/16 (6.25%) of its true value.
+ *                               Values above 2^40 ns (about 18 minutes) land in
+ *                               the last bucket.
+ *****************************************************************************/
+
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBucketBits = 4;
+    static constexpr std::size_t kSubBuckets = std::size_t(1) << kSubBucketBits;
+    static constexpr unsigned kMaxExponent = 40;
+    static constexpr std::size_t kBucketCount = (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+    /******************************************************************************
+     *                  Name: bucketFor
+     *                  Description: Maps a latency to its bucket
+     *                  Arguments: std::uint64_t nanos - Latency in nanoseconds
+     *                  Returns: std::size_t - Bucket index
+     *****************************************************************************/
+    static std::size_t bucketFor(std::uint64_t nanos);
+
+    /******************************************************************************
+     *                  Name: bucketUpperBound
+     *                  Description: Returns the largest latency a bucket holds
+     *                  Arguments: std::size_t bucket - Bucket index
+     *                  Returns: std::uint64_t - Upper bound in nanoseconds
+     *****************************************************************************/
+    static std::uint64_t bucketUpperBound(std::size_t bucket);
+
+    /******************************************************************************
+     *                  Name: record
+     *                  Description: Adds one latency
+     *                  Arguments: std::uint64_t nanos - Latency in nanoseconds
+     *                  Returns: None
+     *****************************************************************************/
+    void record(std::uint64_t nanos);
+
+    /******************************************************************************
+     *                  Name: add
+     *                  Description: Adds raw counts, e.g. from a per-thread buffer
+     *                  Arguments: std::size_t bucket - Bucket index
+     *                             std::uint64_t hits - Samples to add to the bucket
+     *                             std::uint64_t nanos - Latency to add to the sum
+     *                  Returns: None
+     *****************************************************************************/
+    void add(std::size_t bucket, std::uint64_t hits, std::uint64_t nanos);
+
+    /******************************************************************************
+     *                  Name: merge
+     *                  Description: Adds every count of another histogram to this one
+     *                  Arguments: const LatencyHistogram& other - Histogram to add
+     *                  Returns: None
+     *****************************************************************************/
+    void merge(const LatencyHistogram& other);
+
+    /******************************************************************************
+     *                  Name: percentile
+     *                  Description: Returns the latency below which a fraction of the
+     *                               recorded values fall
+     *                  Arguments: double fraction - Quantile in [0, 1], e.g. 0.99
+     *                  Returns: std::uint64_t - Bucket upper bound in nanoseconds;
+     *                           0 if nothing was recorded
+     *****************************************************************************/
+    std::uint64_t percentile(double fraction) const;
+
+    /******************************************************************************
+     *                  Name: count
+     *                  Description: Returns how many latencies were recorded
+     *                  Arguments: None
+     *                  Returns: std::uint64_t - Sample count
+     *****************************************************************************/
+    std::uint64_t count() const;
+
+    /******************************************************************************
+     *                  Name: sum
+     *                  Description: Returns the total of the recorded latencies
+     *                  Arguments: None
+     *                  Returns: std::uint64_t - Sum in nanoseconds
+     *****************************************************************************/
+    std::uint64_t sum() const;
+
+    /******************************************************************************
+     *                  Name: bucketCount
+     *                  Description: Returns the number of samples in one bucket
+     *                  Arguments: std::size_t bucket - Bucket index
+     *                  Returns: std::uint64_t - Samples in the bucket
+     *****************************************************************************/
+    std::uint64_t bucketCount(std::size_t bucket) const;
+
+private:
+    std::array<std::uint64_t, kBucketCount> buckets{};  // Samples per bucket
+    std::uint64_t samples = 0;                          // Total samples
+    std::uint64_t total = 0;                            // Sum of samples in ns
+};
+
+/******************************************************************************
+ *                  Structure Definition: OperationStats
+ *                  Description: Counters and latencies of one operation type
+ *****************************************************************************/
+
+struct OperationStats {
+    std::array<std::uint64_t, kOpStatusCount> outcomes{};  // Calls per OpStatus
+    LatencyHistogram latency;                              // Call latencies
+
+    std::uint64_t calls() const;                           // Calls over all outcomes
+};
+
+/******************************************************************************
+ *                  Structure Definition: MetricsSnapshot
+ *                  Description: Point-in-time totals of every operation, merged
+ *                               from all threads
+ *****************************************************************************/
+
+struct MetricsSnapshot {
+    std::array<OperationStats, kMetricOpCount> operations;  // Indexed by MetricOp
+
+    const OperationStats& operator[](MetricOp op) const {
+        return operations[static_cast<std::size_t>(op)];
+    }
+};
+
+/******************************************************************************
+ *                  Class Definition: OperationMetrics
+ *                  Description: Collects per-operation counters and latency
+ *                               histograms. Each recording thread writes only to
+ *                               its own buffer, allocated on its first record, so
+ *                               threads never share a written cache line; stats()
+ *                               merges the buffers. One instance may be shared by
+ *                               several managers, e.g. the shards of a
+ *                               ConcurrentAppManager.
+ *****************************************************************************/
+
+class OperationMetrics {
+public:
+    OperationMetrics();
+    ~OperationMetrics();
+    OperationMetrics(const OperationMetrics&) = delete;
+    OperationMetrics& operator=(const OperationMetrics&) = delete;
+
+    /******************************************************************************
+     *                  Name: record
+     *                  Description: Counts one call and its latency in the calling
+     *                               thread's buffer
+     *                  Arguments: MetricOp op - Operation performed
+     *                             OpStatus status - Its outcome
+     *                             std::uint64_t nanos - Its latency in nanoseconds
+     *                  Returns: None
+     *****************************************************************************/
+    void record(MetricOp op, OpStatus status, std::uint64_t nanos);
+
+    /******************************************************************************
+     *                  Name: stats
+     *                  Description: Merges every thread's buffer into one snapshot.
+     *                               Records made concurrently may or may not be
+     *                               included.
+     *                  Arguments: None
+     *                  Returns: MetricsSnapshot - Current totals
+     *****************************************************************************/
+    MetricsSnapshot stats() const;
+
+private:
+    struct ThreadBuffer;
+
+    ThreadBuffer& localBuffer();
+
+    const std::uint64_t id;                              // Distinguishes instances in thread caches
+    mutable std::mutex buffersMutex;                     // Guards buffers
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;  // One per recording thread
+};
+
+/******************************************************************************
+ *                  Class Definition: OperationTimer
+ *                  Description: Times one registry call and records it on done().
+ *                               With no metrics attached it never reads the clock;
+ *                               with MOBILEAPP_METRICS=0 it is an empty class.
+ *****************************************************************************/
+
+#if MOBILEAPP_METRICS
+
+class OperationTimer {
+public:
+    OperationTimer(OperationMetrics* metrics, MetricOp op)
+        : metrics(metrics), op(op) {
+        if (metrics != nullptr) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    /******************************************************************************
+     *                  Name: done
+     *                  Description: Records the call with its outcome
+     *                  Arguments: OpStatus status - Outcome of the call
+     *                  Returns: OpStatus - status, unchanged
+     *****************************************************************************/
+    OpStatus done(OpStatus status) {
+        if (metrics != nullptr) {
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            metrics->record(op, status, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+        return status;
+    }
+
+private:
+    OperationMetrics* metrics;                     // Destination, or nullptr
+    MetricOp op;                                   // Operation being timed
+    std::chrono::steady_clock::time_point start;   // Call start
+};
+
+#else
+
+class OperationTimer {
+public:
+    OperationTimer(OperationMetrics*, MetricOp) {}
+    OpStatus done(OpStatus status) { return status; }
+};
+
+#endif
+
+/******************************************************************************
+ *                  Name: metricOpName
+ *                  Description: Returns the snake_case name of an operation
+ *                  Arguments: MetricOp op - Operation
+ *                  Returns: const char* - Name used in exported metrics
+ *****************************************************************************/
+const char* metricOpName(MetricOp op);
+
+/******************************************************************************
+ *                  Name: opStatusName
+ *                  Description: Returns the snake_case name of an outcome
+ *                  Arguments: OpStatus status - Outcome
+ *                  Returns: const char* - Name used in exported metrics
+ *****************************************************************************/
+const char* opStatusName(OpStatus status);
+
+/******************************************************************************
+ *                  Name: toPrometheus
+ *                  Description: Renders a snapshot in the Prometheus text exposition
+ *                               format: a mobileapp_operations_total counter per
+ *                               operation and outcome, and a
+ *                               mobileapp_operation_duration_seconds histogram per
+ *                               operation. Operations never called are omitted.
+ *                  Arguments: const MetricsSnapshot& snapshot - Totals to render
+ *                  Returns: std::string - Exposition text
+ *****************************************************************************/
+std::string toPrometheus(const MetricsSnapshot& snapshot);
+
+#endif
+
+/******************************** End of File ********************************/
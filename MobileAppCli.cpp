@@ -0,0 +1,102 @@
+
+/******************************************************************************
+ *                    File Name: MobileAppCli.cpp
+ *                    Description: Command-line front end replaying command files
+ *                                 against a MobileAppManager
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "CommandProcessor.h"
+#include "LogSink.h"
+#include "MobileAppManager.h"
+#include <cstdlib>    // For std::strtoul
+#include <cstring>    // For std::strcmp
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+/******************************************************************************
+ *                  Name: usage
+ *                  Description: Prints the command-line synopsis
+ *                  Arguments: const char* program - Program name
+ *                  Returns: int - Exit status 2
+ *****************************************************************************/
+int usage(const char* program) {
+    std::cerr << "usage: " << program << " [--threads N] [--chunk BYTES] [--binary] [--verbose]"
+              << " [--save SNAPSHOT] [FILE|-]\n"
+              << "  Text input holds one command per line:\n"
+              << "    install <app> | uninstall <app> | grant <app> <permission>\n"
+              << "    revoke <app> <permission> | list | list <app>\n"
+              << "  --binary reads a journal file instead. Standard input is read\n"
+              << "  when FILE is - or missing.\n";
+    return 2;
+}
+
+}  // namespace
+
+/******************************************************************************
+ *                  Name: main
+ *                  Description: Parses the options, replays the input and prints
+ *                               the throughput summary to standard error
+ *                  Arguments: int argc, char* argv[] - Command line
+ *                  Returns: int - 0 on success, 1 on I/O failure, 2 on bad usage
+ *****************************************************************************/
+int main(int argc, char* argv[]) {
+    CommandOptions options;
+    bool binary = false;
+    bool verbose = false;
+    std::string snapshotPath;
+    std::string input = "-";
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            options.parseThreads = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--chunk") == 0 && hasValue) {
+            options.chunkBytes = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--binary") == 0) {
+            binary = true;
+        } else if (std::strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else if (std::strcmp(argv[i], "--save") == 0 && hasValue) {
+            snapshotPath = argv[++i];
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            return usage(argv[0]);
+        } else {
+            input = argv[i];
+        }
+    }
+    if (binary && input == "-") {
+        return usage(argv[0]);
+    }
+
+    std::ios::sync_with_stdio(false);
+    MobileAppManager manager(verbose ? LogSink::console() : std::make_shared<NullLogSink>());
+    CommandProcessor processor(manager, std::cout, std::cerr, options);
+    bool read = true;
+    if (binary) {
+        read = processor.runBinary(input);
+    } else if (input == "-") {
+        processor.runStream(std::cin);
+    } else {
+        read = processor.runFile(input);
+    }
+    if (!read) {
+        std::cerr << argv[0] << ": cannot read " << input << "\n";
+        return 1;
+    }
+    std::cerr << processor.stats().summary() << "\n";
+    if (!snapshotPath.empty() && !manager.saveSnapshot(snapshotPath)) {
+        std::cerr << argv[0] << ": cannot write " << snapshotPath << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+/******************************** End of File ********************************/
@@ -10,80 +10,513 @@
  *                      Header Files 
  *****************************************************************************/
 #include "MobileAppManager.h"
-#include <iostream>
+#include "Snapshot.h"
+#include <algorithm>  // For std::partial_sort, std::sort, std::stable_sort
+#include <cerrno>
+#include <climits>    // For INT_MAX
+#include <fstream>
+#include <istream>
+#include <iterator>   // For std::back_inserter
+#include <limits>
+#include <numeric>    // For std::iota
+#include <ostream>
+#include <unordered_map>
+#include <utility>    // For std::move, std::exchange
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::size_t kImportPublishRecords = 4096;   // Records imported between snapshot publishes
+
+/******************************************************************************
+ *                  Name: readDescriptor
+ *                  Description: Reads from a file descriptor, retrying interrupted
+ *                               reads
+ *                  Arguments: int fd - Open descriptor
+ *                             char* data - Destination
+ *                             std::size_t size - Bytes wanted
+ *                  Returns: std::ptrdiff_t - Bytes read, 0 at the end, -1 on error
+ *****************************************************************************/
+std::ptrdiff_t readDescriptor(int fd, char* data, std::size_t size) {
+    for (;;) {
+#ifdef _WIN32
+        std::ptrdiff_t count = ::_read(fd, data, static_cast<unsigned>(std::min<std::size_t>(size, INT_MAX)));
+#else
+        std::ptrdiff_t count = ::read(fd, data, size);
+#endif
+        if (count >= 0 || errno != EINTR) {
+            return count < 0 ? -1 : count;
+        }
+    }
+}
+
+/******************************************************************************
+ *                  Name: writeDescriptor
+ *                  Description: Writes all bytes to a file descriptor, continuing
+ *                               after short and interrupted writes
+ *                  Arguments: int fd - Open descriptor
+ *                             const char* data - Bytes to write
+ *                             std::size_t size - Byte count
+ *                  Returns: bool - False on an error
+ *****************************************************************************/
+bool writeDescriptor(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+#ifdef _WIN32
+        std::ptrdiff_t count = ::_write(fd, data, static_cast<unsigned>(std::min<std::size_t>(size, INT_MAX)));
+#else
+        std::ptrdiff_t count = ::write(fd, data, size);
+#endif
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += count;
+        size -= static_cast<std::size_t>(count);
+    }
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: diffApps
+ *                  Description: Sorts both app lists by name and merges them,
+ *                               appending the operations that turn the first into
+ *                               the second
+ *                  Arguments: std::vector<const App*> mine - Apps of the source
+ *                             std::vector<const App*> theirs - Apps of the target
+ *                             MineFn mineOf - Returns a source app's permissions,
+ *                                             given a scratch set
+ *                             TheirsFn theirsOf - Same for a target app
+ *                             AppBatch& changes - Receives the operations
+ *                  Returns: None
+ *****************************************************************************/
+template <typename MineFn, typename TheirsFn>
+void diffApps(std::vector<const App*> mine, std::vector<const App*> theirs, MineFn mineOf, TheirsFn theirsOf,
+              AppBatch& changes) {
+    auto byName = [](const App* a, const App* b) { return a->getAppName() < b->getAppName(); };
+    std::sort(mine.begin(), mine.end(), byName);
+    std::sort(theirs.begin(), theirs.end(), byName);
+    PermissionRegistry& registry = PermissionRegistry::instance();
+    PermissionSet haveScratch;
+    PermissionSet wantScratch;
+    auto source = mine.begin();
+    auto target = theirs.begin();
+    while (source != mine.end() || target != theirs.end()) {
+        if (target == theirs.end() || (source != mine.end() && byName(*source, *target))) {
+            changes.uninstall((*source++)->getAppName());
+        } else if (source == mine.end() || byName(*target, *source)) {
+            const std::string& appName = (*target)->getAppName();
+            changes.install(appName);
+            theirsOf(*target++, wantScratch).forEach([&](PermissionId id) {
+                changes.grant(appName, registry.name(id));
+            });
+        } else {
+            const std::string& appName = (*target)->getAppName();
+            const PermissionSet& have = mineOf(*source++, haveScratch);
+            const PermissionSet& want = theirsOf(*target++, wantScratch);
+            if (have == want) {
+                continue;
+            }
+            want.forEach([&](PermissionId id) {
+                if (!have.contains(id)) {
+                    changes.grant(appName, registry.name(id));
+                }
+            });
+            have.forEach([&](PermissionId id) {
+                if (!want.contains(id)) {
+                    changes.revoke(appName, registry.name(id));
+                }
+            });
+        }
+    }
+}
+
+}  // namespace
+
+/******************************************************************************
+ *                  Constructor: MobileAppManager
+ *                  Description: Initializes an empty registry logging to the given sink
+ *                  Arguments: std::shared_ptr<LogSink> sink - Log destination
+ *                  Returns: None
+ *****************************************************************************/
+MobileAppManager::MobileAppManager(std::shared_ptr<LogSink> sink) : logSink(std::move(sink)) {}
+
+/******************************************************************************
+ *                  Destructor: MobileAppManager
+ *                  Description: Destroys every app; the pool then releases its slabs
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+MobileAppManager::~MobileAppManager() {
+    clearApps();
+}
 
 /******************************************************************************
  *                  Name: installApp
  *                  Description: Installs a new application with the given name
- *                  Arguments: const std::string& appName - Name of the application
- *                  Returns: None
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: OpStatus - Ok, InvalidAppName or AppExists
  *****************************************************************************/
-void MobileAppManager::installApp(const std::string& appName) {
+OpStatus MobileAppManager::installApp(std::string_view appName) {
+    OperationTimer timer(metrics.get(), MetricOp::Install);
     if(appName.empty()){
-        std::cout << "Invalid app name!" << std::endl;
-        return; 
+        log(LogLevel::Warning, {"Invalid app name!"});
+        return timer.done(OpStatus::InvalidAppName);
     }
-    if (installedApps.find(appName) == installedApps.end()) {
-        installedApps[appName] = new App(appName);
-        std::cout << "App installed: " << appName << std::endl;
-    } else {
-        std::cout << "App already exists!" << std::endl;
+    if (lookup(appName) == nullptr) {
+        App* app = createApp(appName);
+        indexName(app);
+        if (spill != nullptr) {
+            touch(app);
+        }
+        stageVersion(appName, app);
+        publishVersion();
+        journalOp(JournalRecordType::Install, appName);
+        publishChange(ChangeType::Installed, appName);
+        log(LogLevel::Info, {"App installed: ", appName});
+        return timer.done(OpStatus::Ok);
     }
+    log(LogLevel::Warning, {"App already exists!"});
+    return timer.done(OpStatus::AppExists);
 }
 
 /******************************************************************************
  *                  Name: uninstallApp
  *                  Description: Uninstalls the application with the given name
- *                  Arguments: const std::string& appName - Name of the application
- *                  Returns: None
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: OpStatus - Ok or AppNotFound
  *****************************************************************************/
-void MobileAppManager::uninstallApp(const std::string& appName) {
-    auto it = installedApps.find(appName);
-    if (it != installedApps.end()) {
-        delete it->second;
-        installedApps.erase(it);
-        std::cout << "App uninstalled: " << appName << std::endl;
-    } else {
-        std::cout << "App not found!" << std::endl;
+OpStatus MobileAppManager::uninstallApp(std::string_view appName) {
+    OperationTimer timer(metrics.get(), MetricOp::Uninstall);
+    expireDue();
+    App* app = lookup(appName);
+    if (app != nullptr) {
+        journalOp(JournalRecordType::Uninstall, appName);
+        publishChange(ChangeType::Uninstalled, appName);
+        log(LogLevel::Info, {"App uninstalled: ", appName});
+        if (spill != nullptr) {
+            touch(app);
+        }
+        unindexName(app);
+        cancelExpiries(app);
+        unindexApp(*app);
+        destroyApp(app);
+        stageVersion(appName, nullptr);
+        publishVersion();
+        return timer.done(OpStatus::Ok);
     }
+    log(LogLevel::Warning, {"App not found!"});
+    return timer.done(OpStatus::AppNotFound);
 }
 
 /******************************************************************************
  *                  Name: assignPermission
  *                  Description: Assigns a permission to a given application
- *                  Arguments: const std::string& appName - Name of the application
- *                             const std::string& permission - Permission to assign
- *                  Returns: None
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission to assign
+ *                  Returns: OpStatus - Ok, InvalidPermission or AppNotFound
  *****************************************************************************/
-void MobileAppManager::assignPermission(const std::string& appName, const std::string& permission) {
+OpStatus MobileAppManager::assignPermission(std::string_view appName, std::string_view permission) {
+    OperationTimer timer(metrics.get(), MetricOp::Assign);
     if(permission.empty()){
-        std::cout << "Invalid permission!" << std::endl;
-        return;
+        log(LogLevel::Warning, {"Invalid permission!"});
+        return timer.done(OpStatus::InvalidPermission);
     }
-    auto it = installedApps.find(appName);
-    if (it != installedApps.end()) {
-        it->second->addPermission(permission);
-        std::cout << "Permission '" << permission << "' assigned to " << appName << std::endl;
-    } else {
-        std::cout << "App not found!" << std::endl;
+    expireDue();
+    App* app = lookup(appName);
+    if (app != nullptr) {
+        if (spill != nullptr) {
+            touch(app);
+        }
+        PermissionId id = PermissionRegistry::instance().intern(permission);
+        if (addPermission(app, id)) {
+            if (merkle != nullptr) {
+                merkle->addPermission(app, id);
+            }
+            if (bitmaps != nullptr) {
+                bitmaps->grant(app, id);
+            }
+            recordHistory(appName, id, HistoryOp::Grant);
+            stageVersion(appName, app);
+            publishVersion();
+            publishChange(ChangeType::PermissionGranted, appName, permission);
+        } else {
+            cancelExpiry(app, id);
+        }
+        journalOp(JournalRecordType::Grant, appName, permission);
+        log(LogLevel::Info, {"Permission '", permission, "' assigned to ", appName});
+        return timer.done(OpStatus::Ok);
+    }
+    log(LogLevel::Warning, {"App not found!"});
+    return timer.done(OpStatus::AppNotFound);
+}
+
+/******************************************************************************
+ *                  Name: assignPermission
+ *                  Description: Assigns a permission expiring after a time to live
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission to assign
+ *                             std::chrono::milliseconds ttl - Time until it expires
+ *                  Returns: OpStatus - Ok, InvalidPermission or AppNotFound
+ *****************************************************************************/
+OpStatus MobileAppManager::assignPermission(std::string_view appName, std::string_view permission,
+                                            std::chrono::milliseconds ttl) {
+    ExpiryClock::time_point now = expiryClock();
+    ExpiryClock::time_point deadline = ExpiryClock::time_point::max();
+    if (ttl < std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now)) {
+        deadline = now + ttl;
+    }
+    return assignPermission(appName, permission, deadline);
+}
+
+/******************************************************************************
+ *                  Name: assignPermission
+ *                  Description: Assigns a permission and schedules its revocation.
+ *                               The deadline is rounded up to a whole millisecond,
+ *                               the tick of the expiry wheel.
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission to assign
+ *                             ExpiryClock::time_point deadline - When it expires
+ *                  Returns: OpStatus - Ok, InvalidPermission or AppNotFound
+ *****************************************************************************/
+OpStatus MobileAppManager::assignPermission(std::string_view appName, std::string_view permission,
+                                            ExpiryClock::time_point deadline) {
+    OperationTimer timer(metrics.get(), MetricOp::Assign);
+    if(permission.empty()){
+        log(LogLevel::Warning, {"Invalid permission!"});
+        return timer.done(OpStatus::InvalidPermission);
     }
+    expireDue();
+    App* app = lookup(appName);
+    if (app != nullptr) {
+        if (spill != nullptr) {
+            touch(app);
+        }
+        PermissionId id = PermissionRegistry::instance().intern(permission);
+        auto rounded = std::chrono::ceil<std::chrono::milliseconds>(deadline.time_since_epoch()).count();
+        std::uint64_t ticks = rounded > 0 ? static_cast<std::uint64_t>(rounded) : 0;
+        if (addPermission(app, id)) {
+            if (timedGrants.empty()) {
+                // Nothing is pending, so the wheel can jump to the present without firing
+                expiryWheel.advance(expiryTicks(expiryClock()), [](const TimedGrant&) {});
+            }
+            TimedGrant grant{app, id};
+            timedGrants.emplace(grant, expiryWheel.schedule(ticks, grant));
+            if (merkle != nullptr) {
+                merkle->addPermission(app, id);
+            }
+            if (bitmaps != nullptr) {
+                bitmaps->grant(app, id);
+            }
+            recordHistory(appName, id, HistoryOp::Grant);
+            stageVersion(appName, app);
+            publishVersion();
+            publishChange(ChangeType::PermissionGranted, appName, permission);
+        } else {
+            auto it = timedGrants.find(TimedGrant{app, id});
+            if (it != timedGrants.end() && expiryWheel.deadline(it->second) < ticks) {
+                expiryWheel.reschedule(it->second, ticks);
+            }
+        }
+        log(LogLevel::Info, {"Permission '", permission, "' assigned to ", appName, " until its deadline"});
+        return timer.done(OpStatus::Ok);
+    }
+    log(LogLevel::Warning, {"App not found!"});
+    return timer.done(OpStatus::AppNotFound);
 }
 
 /******************************************************************************
  *                  Name: revokePermission
  *                  Description: Revokes a permission from the given application
- *                  Arguments: const std::string& appName - Name of the application
- *                             const std::string& permission - Permission to revoke
- *                  Returns: None
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission to revoke
+ *                  Returns: OpStatus - Ok or AppNotFound
  *****************************************************************************/
-void MobileAppManager::revokePermission(const std::string& appName, const std::string& permission) {
-    auto it = installedApps.find(appName);
-    if (it != installedApps.end()) {
-        it->second->removePermission(permission);
-        std::cout << "Permission '" << permission << "' revoked from " << appName << std::endl;
-    } else {
-        std::cout << "App not found!" << std::endl;
+OpStatus MobileAppManager::revokePermission(std::string_view appName, std::string_view permission) {
+    OperationTimer timer(metrics.get(), MetricOp::Revoke);
+    expireDue();
+    App* app = lookup(appName);
+    if (app != nullptr) {
+        if (spill != nullptr) {
+            touch(app);
+        }
+        PermissionId id;
+        if (PermissionRegistry::instance().find(permission, id) && app->removePermission(id)) {
+            cancelExpiry(app, id);
+            unindexPermission(id, app);
+            if (merkle != nullptr) {
+                merkle->removePermission(app, id);
+            }
+            if (bitmaps != nullptr) {
+                bitmaps->revoke(app, id);
+            }
+            recordHistory(appName, id, HistoryOp::Revoke);
+            stageVersion(appName, app);
+            publishVersion();
+            publishChange(ChangeType::PermissionRevoked, appName, permission);
+        }
+        journalOp(JournalRecordType::Revoke, appName, permission);
+        log(LogLevel::Info, {"Permission '", permission, "' revoked from ", appName});
+        return timer.done(OpStatus::Ok);
+    }
+    log(LogLevel::Warning, {"App not found!"});
+    return timer.done(OpStatus::AppNotFound);
+}
+
+/******************************************************************************
+ *                  Name: definePermissionGroup
+ *                  Description: Validates the names and compiles the group into its
+ *                               mask; dependent roles and group sets are recompiled
+ *                  Arguments: std::string_view group - Group name
+ *                             const std::vector<std::string_view>& permissions - Permissions
+ *                             const std::vector<std::string_view>& includes - Included groups
+ *                  Returns: OpStatus - Ok, InvalidPermission, GroupNotFound or GroupCycle
+ *****************************************************************************/
+OpStatus MobileAppManager::definePermissionGroup(std::string_view group, const std::vector<std::string_view>& permissions,
+                                                 const std::vector<std::string_view>& includes) {
+    OperationTimer timer(metrics.get(), MetricOp::DefineGroup);
+    if (group.empty() || std::any_of(permissions.begin(), permissions.end(),
+                                     [](std::string_view permission) { return permission.empty(); })) {
+        log(LogLevel::Warning, {"Invalid permission group!"});
+        return timer.done(OpStatus::InvalidPermission);
+    }
+    switch (groups.define(group, permissions, includes)) {
+    case PermissionGroups::DefineResult::UnknownInclude:
+        log(LogLevel::Warning, {"Permission group not found!"});
+        return timer.done(OpStatus::GroupNotFound);
+    case PermissionGroups::DefineResult::Cycle:
+        log(LogLevel::Warning, {"Permission group would include itself: ", group});
+        return timer.done(OpStatus::GroupCycle);
+    case PermissionGroups::DefineResult::Ok:
+        break;
+    }
+    groupHolders.resize(groups.size());
+    if (bitmaps != nullptr) {
+        bitmaps->setGroupMasks(groupMasks());
+    }
+    if (versions != nullptr) {
+        versions->setGroupMasks(groupMasks());
+        versions->publish();
+    }
+    if (journal != nullptr) {
+        journal->appendGroup(group, permissions, includes);
+    }
+    log(LogLevel::Info, {"Permission group defined: ", group});
+    return timer.done(OpStatus::Ok);
+}
+
+/******************************************************************************
+ *                  Name: defineRole
+ *                  Description: Defines a group made only of other groups
+ *                  Arguments: std::string_view role - Role name
+ *                             const std::vector<std::string_view>& groups - Included groups
+ *                  Returns: OpStatus - Ok, InvalidPermission, GroupNotFound or GroupCycle
+ *****************************************************************************/
+OpStatus MobileAppManager::defineRole(std::string_view role, const std::vector<std::string_view>& roleGroups) {
+    return definePermissionGroup(role, {}, roleGroups);
+}
+
+/******************************************************************************
+ *                  Name: assignGroup
+ *                  Description: Moves the app to the group set with the group added
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::string_view group - Group or role to assign
+ *                  Returns: OpStatus - Ok, AppNotFound or GroupNotFound
+ *****************************************************************************/
+OpStatus MobileAppManager::assignGroup(std::string_view appName, std::string_view group) {
+    OperationTimer timer(metrics.get(), MetricOp::AssignGroup);
+    expireDue();
+    App* app = lookup(appName);
+    if (app == nullptr) {
+        log(LogLevel::Warning, {"App not found!"});
+        return timer.done(OpStatus::AppNotFound);
+    }
+    GroupId id;
+    if (!groups.find(group, id)) {
+        log(LogLevel::Warning, {"Permission group not found!"});
+        return timer.done(OpStatus::GroupNotFound);
+    }
+    if (spill != nullptr) {
+        touch(app);
+    }
+    GroupSetId current = app->getGroupSet();
+    GroupSetId joined = groups.join(current, id);
+    if (joined != current) {
+        app->setGroupSet(joined);
+        groupHolders[id].add(app->getAppId());
+        if (bitmaps != nullptr) {
+            bitmaps->joinGroup(app, id);
+        }
+        stageVersion(appName, app);
+        publishVersion();
+        publishChange(ChangeType::GroupAssigned, appName, group);
+    }
+    journalOp(JournalRecordType::AssignGroup, appName, group);
+    log(LogLevel::Info, {"Permission group '", group, "' assigned to ", appName});
+    return timer.done(OpStatus::Ok);
+}
+
+/******************************************************************************
+ *                  Name: revokeGroup
+ *                  Description: Moves the app to the group set with the group removed
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::string_view group - Group or role to remove
+ *                  Returns: OpStatus - Ok, AppNotFound or GroupNotFound
+ *****************************************************************************/
+OpStatus MobileAppManager::revokeGroup(std::string_view appName, std::string_view group) {
+    OperationTimer timer(metrics.get(), MetricOp::RevokeGroup);
+    expireDue();
+    App* app = lookup(appName);
+    if (app == nullptr) {
+        log(LogLevel::Warning, {"App not found!"});
+        return timer.done(OpStatus::AppNotFound);
+    }
+    GroupId id;
+    if (!groups.find(group, id)) {
+        log(LogLevel::Warning, {"Permission group not found!"});
+        return timer.done(OpStatus::GroupNotFound);
     }
+    if (spill != nullptr) {
+        touch(app);
+    }
+    GroupSetId current = app->getGroupSet();
+    GroupSetId left = groups.leave(current, id);
+    if (left != current) {
+        app->setGroupSet(left);
+        unindexGroup(id, app);
+        if (bitmaps != nullptr) {
+            bitmaps->leaveGroup(app, id);
+        }
+        stageVersion(appName, app);
+        publishVersion();
+        publishChange(ChangeType::GroupRevoked, appName, group);
+    }
+    journalOp(JournalRecordType::RevokeGroup, appName, group);
+    log(LogLevel::Info, {"Permission group '", group, "' revoked from ", appName});
+    return timer.done(OpStatus::Ok);
+}
+
+/******************************************************************************
+ *                  Name: listAppGroups
+ *                  Description: Lists the groups in the app's group set
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: std::vector<std::string> - Group names
+ *****************************************************************************/
+std::vector<std::string> MobileAppManager::listAppGroups(std::string_view appName) const {
+    std::vector<std::string> groupNames;
+    const App* app = lookup(appName);
+    if (app != nullptr) {
+        for (GroupId id : groups.members(app->getGroupSet())) {
+            groupNames.push_back(groups.name(id));
+        }
+    }
+    return groupNames;
 }
 
 /******************************************************************************
@@ -93,25 +526,1686 @@ void MobileAppManager::revokePermission(const std::string& appName, const std::s
  *                  Returns: std::vector<std::string> - List of app names
  *****************************************************************************/
 std::vector<std::string> MobileAppManager::listInstalledApps() const {
+    OperationTimer timer(metrics.get(), MetricOp::ListInstalledApps);
     std::vector<std::string> appNames;
-    for (const auto& pair : installedApps) {
-        appNames.push_back(pair.first);
-    }
+    appNames.reserve(installedApps.size());
+    forEachInstalledApp([&](std::string_view appName) { appNames.emplace_back(appName); });
+    timer.done(OpStatus::Ok);
     return appNames;
 }
 
+/******************************************************************************
+ *                  Name: listInstalledApps
+ *                  Description: Returns one page of app names as views, sorted
+ *                  Arguments: std::string_view after - Resume point; empty starts at the beginning
+ *                             std::size_t limit - Maximum names returned
+ *                  Returns: std::vector<std::string_view> - Names on the page
+ *****************************************************************************/
+std::vector<std::string_view> MobileAppManager::listInstalledApps(std::string_view after, std::size_t limit) const {
+    OperationTimer timer(metrics.get(), MetricOp::ListInstalledApps);
+    std::vector<std::string_view> page;
+    page.reserve(std::min(limit, installedApps.size()));
+    forEachInstalledApp(after, limit, [&](std::string_view appName) { page.push_back(appName); });
+    timer.done(OpStatus::Ok);
+    return page;
+}
+
+/******************************************************************************
+ *                  Name: findApps
+ *                  Description: Walks the trie subtree of the prefix in name order
+ *                  Arguments: std::string_view prefix - Required name prefix
+ *                             std::string_view after - Resume point
+ *                             std::size_t limit - Maximum names returned
+ *                  Returns: std::vector<std::string_view> - Matching names, sorted
+ *****************************************************************************/
+std::vector<std::string_view> MobileAppManager::findApps(std::string_view prefix, std::string_view after,
+                                                         std::size_t limit) const {
+    OperationTimer timer(metrics.get(), MetricOp::FindApps);
+    drainBase();
+    std::vector<std::string_view> page;
+    if (limit != 0) {
+        appNames.forEach(prefix, after, [&](const App* app) {
+            page.push_back(app->getAppName());
+            return page.size() < limit;
+        });
+    }
+    timer.done(OpStatus::Ok);
+    return page;
+}
+
+/******************************************************************************
+ *                  Name: searchApps
+ *                  Description: Picks the cheaper of two plans. A sorted scan of the
+ *                               trie visits about limit * apps / matches names; the
+ *                               rarest trigram's posting list costs its length plus
+ *                               a sort of the matches. The posting list bounds the
+ *                               match count, so it stands in for it. Patterns shorter
+ *                               than a trigram always scan.
+ *                  Arguments: std::string_view pattern - Substring to look for
+ *                             std::string_view after - Resume point
+ *                             std::size_t limit - Maximum names returned
+ *                  Returns: std::vector<std::string_view> - Matching names, sorted
+ *****************************************************************************/
+std::vector<std::string_view> MobileAppManager::searchApps(std::string_view pattern, std::string_view after,
+                                                           std::size_t limit) const {
+    OperationTimer timer(metrics.get(), MetricOp::SearchApps);
+    drainBase();
+    std::vector<std::string_view> page;
+    if (limit == 0) {
+        timer.done(OpStatus::Ok);
+        return page;
+    }
+
+    const std::vector<std::uint32_t>* postings = nullptr;
+    if (pattern.size() >= AppGramIndex::kGram) {
+        postings = appGrams.candidates(pattern);
+        if (postings == nullptr) {
+            timer.done(OpStatus::Ok);
+            return page;   // Some trigram of the pattern occurs in no name
+        }
+        double scanCost = static_cast<double>(limit) * installedApps.size() / postings->size();
+        if (scanCost <= postings->size()) {
+            postings = nullptr;
+        }
+    }
+
+    if (postings != nullptr) {
+        for (std::uint32_t id : *postings) {
+            const App* app = appGrams.app(id);
+            if (app != nullptr) {
+                std::string_view name = app->getAppName();
+                if (name > after && name.find(pattern) != std::string_view::npos) {
+                    page.push_back(name);
+                }
+            }
+        }
+        if (page.size() > limit) {
+            std::partial_sort(page.begin(), page.begin() + limit, page.end());
+            page.resize(limit);
+        } else {
+            std::sort(page.begin(), page.end());
+        }
+    } else {
+        appNames.forEach(std::string_view(), after, [&](const App* app) {
+            std::string_view name = app->getAppName();
+            if (name.find(pattern) != std::string_view::npos) {
+                page.push_back(name);
+            }
+            return page.size() < limit;
+        });
+    }
+    timer.done(OpStatus::Ok);
+    return page;
+}
+
 /******************************************************************************
  *                  Name: listAppPermissions
  *                  Description: Lists permissions of a given application
- *                  Arguments: const std::string& appName - Name of the application
+ *                  Arguments: std::string_view appName - Name of the application
  *                  Returns: std::vector<std::string> - List of permissions
  *****************************************************************************/
-std::vector<std::string> MobileAppManager::listAppPermissions(const std::string& appName) const {
-    auto it = installedApps.find(appName);
-    if (it != installedApps.end()) {
-        return it->second->getPermissions();
+std::vector<std::string> MobileAppManager::listAppPermissions(std::string_view appName) const {
+    OperationTimer timer(metrics.get(), MetricOp::ListAppPermissions);
+    std::vector<std::string> permissions;
+    bool found = forEachAppPermission(appName, [&](std::string_view permission) { permissions.emplace_back(permission); });
+    std::sort(permissions.begin(), permissions.end());
+    timer.done(found ? OpStatus::Ok : OpStatus::AppNotFound);
+    return permissions;
+}
+
+/******************************************************************************
+ *                  Name: hasPermission
+ *                  Description: Checks whether an app holds a permission without
+ *                               copying its permission list
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission to check
+ *                  Returns: bool - True if the app is installed and holds the permission
+ *****************************************************************************/
+bool MobileAppManager::hasPermission(std::string_view appName, std::string_view permission) const {
+    OperationTimer timer(metrics.get(), MetricOp::HasPermission);
+    App* app = lookup(appName);
+    if (app != nullptr && spill != nullptr) {
+        touch(app);
+    }
+    PermissionId id;
+    bool held = app != nullptr && PermissionRegistry::instance().find(permission, id) &&
+                ((app->getPermissionSet().contains(id) && !grantExpired(app, id)) ||
+                 groups.effective(app->getGroupSet()).contains(id));
+    timer.done(app != nullptr ? OpStatus::Ok : OpStatus::AppNotFound);
+    return held;
+}
+
+/******************************************************************************
+ *                  Name: appsWithPermission
+ *                  Description: Returns every installed app holding a permission.
+ *                               Timed grants past their deadline that the wheel has
+ *                               not fired yet are left out, as hasPermission does.
+ *                  Arguments: std::string_view permission - Permission to look up
+ *                  Returns: std::vector<std::string> - Sorted names of the holders
+ *****************************************************************************/
+std::vector<std::string> MobileAppManager::appsWithPermission(std::string_view permission) const {
+    OperationTimer timer(metrics.get(), MetricOp::AppsWithPermission);
+    std::vector<std::string> holderNames;
+    forEachAppWithPermission(permission, [&](std::string_view appName) { holderNames.emplace_back(appName); });
+    std::sort(holderNames.begin(), holderNames.end());
+    timer.done(OpStatus::Ok);
+    return holderNames;
+}
+
+/******************************************************************************
+ *                  Name: applyBatch
+ *                  Description: Applies a batch of operations all-or-nothing
+ *                  Arguments: const AppBatch& batch - Operations to apply
+ *                  Returns: std::vector<OpStatus> - One status per operation
+ *****************************************************************************/
+std::vector<OpStatus> MobileAppManager::applyBatch(const AppBatch& batch) {
+    OperationTimer timer(metrics.get(), MetricOp::ApplyBatch);
+    expireDue();
+    const std::vector<BatchOp>& ops = batch.operations();
+    std::vector<OpStatus> results(ops.size(), OpStatus::Ok);
+
+    // Group operations by app; the stable sort keeps each app's operations in order
+    std::vector<std::size_t> order(ops.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return ops[a].appName < ops[b].appName;
+    });
+
+    // Validation pass: look up each app once and track whether it is installed
+    // as its operations are simulated in order
+    std::vector<App*> positions;
+    std::size_t installs = 0;
+    bool failed = false;
+    for (std::size_t begin = 0; begin < order.size();) {
+        const std::string& appName = ops[order[begin]].appName;
+        App* position = lookup(appName);
+        bool installed = position != nullptr;
+        positions.push_back(position);
+
+        std::size_t end = begin;
+        for (; end < order.size() && ops[order[end]].appName == appName; ++end) {
+            const BatchOp& op = ops[order[end]];
+            OpStatus& status = results[order[end]];
+            switch (op.type) {
+            case BatchOpType::Install:
+                status = appName.empty() ? OpStatus::InvalidAppName
+                       : installed       ? OpStatus::AppExists
+                                         : OpStatus::Ok;
+                installs += status == OpStatus::Ok;
+                installed = installed || status == OpStatus::Ok;
+                break;
+            case BatchOpType::Uninstall:
+                status = installed ? OpStatus::Ok : OpStatus::AppNotFound;
+                installed = false;
+                break;
+            case BatchOpType::Grant:
+                status = op.permission.empty() ? OpStatus::InvalidPermission
+                       : installed             ? OpStatus::Ok
+                                               : OpStatus::AppNotFound;
+                break;
+            case BatchOpType::Revoke:
+                status = installed ? OpStatus::Ok : OpStatus::AppNotFound;
+                break;
+            }
+            failed = failed || status != OpStatus::Ok;
+        }
+        begin = end;
+    }
+
+    if (failed) {
+        for (OpStatus& status : results) {
+            if (status == OpStatus::Ok) {
+                status = OpStatus::NotApplied;
+            }
+        }
+        timer.done(OpStatus::NotApplied);
+        return results;
+    }
+
+    // Intern every permission up front and grow the reverse index once
+    const PermissionId unknown = std::numeric_limits<PermissionId>::max();
+    PermissionRegistry& registry = PermissionRegistry::instance();
+    std::vector<PermissionId> permissionIds(ops.size(), unknown);
+    std::size_t indexSize = permissionHolders.size();
+    for (std::size_t i = 0; i < ops.size(); ++i) {
+        if (ops[i].type == BatchOpType::Grant) {
+            permissionIds[i] = registry.intern(ops[i].permission);
+            indexSize = std::max<std::size_t>(indexSize, permissionIds[i] + 1);
+        } else if (ops[i].type == BatchOpType::Revoke) {
+            registry.find(ops[i].permission, permissionIds[i]);
+        }
+    }
+    permissionHolders.resize(indexSize);
+    installedApps.reserve(installedApps.size() + installs);
+
+    // Apply pass: each group starts from the app found during validation;
+    // groups touch disjoint apps, so those pointers stay valid
+    std::size_t group = 0;
+    for (std::size_t begin = 0; begin < order.size(); ++group) {
+        const std::string& appName = ops[order[begin]].appName;
+        App* position = positions[group];
+        if (spill != nullptr && position != nullptr) {
+            touch(position);
+        }
+
+        std::size_t end = begin;
+        for (; end < order.size() && ops[order[end]].appName == appName; ++end) {
+            std::size_t index = order[end];
+            PermissionId id = permissionIds[index];
+            switch (ops[index].type) {
+            case BatchOpType::Install:
+                position = createApp(appName);
+                indexName(position);
+                if (spill != nullptr) {
+                    touch(position);
+                }
+                publishChange(ChangeType::Installed, appName);
+                break;
+            case BatchOpType::Uninstall:
+                unindexName(position);
+                cancelExpiries(position);
+                unindexApp(*position);
+                destroyApp(position);
+                position = nullptr;
+                publishChange(ChangeType::Uninstalled, appName);
+                break;
+            case BatchOpType::Grant:
+                if (addPermission(position, id)) {
+                    if (merkle != nullptr) {
+                        merkle->addPermission(position, id);
+                    }
+                    if (bitmaps != nullptr) {
+                        bitmaps->grant(position, id);
+                    }
+                    recordHistory(appName, id, HistoryOp::Grant);
+                    publishChange(ChangeType::PermissionGranted, appName, ops[index].permission);
+                } else {
+                    cancelExpiry(position, id);
+                }
+                break;
+            case BatchOpType::Revoke:
+                if (id != unknown && position->removePermission(id)) {
+                    cancelExpiry(position, id);
+                    unindexPermission(id, position);
+                    if (merkle != nullptr) {
+                        merkle->removePermission(position, id);
+                    }
+                    if (bitmaps != nullptr) {
+                        bitmaps->revoke(position, id);
+                    }
+                    recordHistory(appName, id, HistoryOp::Revoke);
+                    publishChange(ChangeType::PermissionRevoked, appName, ops[index].permission);
+                }
+                break;
+            }
+        }
+        stageVersion(appName, position);
+        begin = end;
+    }
+    publishVersion();
+    if (spill != nullptr && residentOverflow > overflowBudget) {
+        enforceBudget();
+    }
+
+    for (const BatchOp& op : ops) {
+        journalOp(static_cast<JournalRecordType>(op.type), op.appName, op.permission);
+    }
+    timer.done(OpStatus::Ok);
+    return results;
+}
+
+/******************************************************************************
+ *                  Name: saveSnapshot
+ *                  Description: Feeds the group definitions to a SnapshotWriter in id
+ *                               order, then the apps with their groups in name order
+ *                  Arguments: const std::string& path - Destination file
+ *                  Returns: bool - True on success
+ *****************************************************************************/
+bool MobileAppManager::saveSnapshot(const std::string& path) const {
+    drainBase();
+    SnapshotWriter writer;
+    for (GroupId id = 0; id < groups.size(); ++id) {
+        writer.addGroup(groups.name(id), groups.permissions(id), groups.includes(id));
+    }
+    PermissionSet scratch;
+    appNames.forEach(std::string_view(), std::string_view(), [&](const App* app) {
+        writer.addApp(app->getAppName(), durablePermissionsOf(app, scratch), groups.members(app->getGroupSet()));
+        return true;
+    });
+    return writer.write(path);
+}
+
+/******************************************************************************
+ *                  Name: loadSnapshot
+ *                  Description: Maps and validates the snapshot, interns its permission
+ *                               table once and restores the groups. The apps stay
+ *                               in the mapping until lookup() or drainBase() copies
+ *                               them out, unless an index built over every app is
+ *                               enabled.
+ *                  Arguments: const std::string& path - Snapshot file
+ *                             bool verifyChecksum - Also hash the whole file first
+ *                  Returns: bool - True if the snapshot was loaded
+ *****************************************************************************/
+bool MobileAppManager::loadSnapshot(const std::string& path, bool verifyChecksum) {
+    auto view = std::make_unique<SnapshotView>();
+    if (!view->open(path, verifyChecksum)) {
+        log(LogLevel::Error, {"Snapshot could not be loaded: ", path});
+        return false;
+    }
+
+    PermissionRegistry& registry = PermissionRegistry::instance();
+    std::vector<PermissionId> ids(view->permissionCount());
+    std::size_t indexSize = 0;
+    for (std::uint32_t local = 0; local < ids.size(); ++local) {
+        ids[local] = registry.intern(view->permissionName(local));
+        indexSize = std::max<std::size_t>(indexSize, ids[local] + 1);
+    }
+
+    clearApps();
+    loadGroups(*view);
+    permissionHolders.assign(indexSize, {});
+    base = std::move(view);
+    baseIds = std::move(ids);
+    if (merkle != nullptr || bitmaps != nullptr || versions != nullptr) {
+        drainBase();
+    }
+    if (versions != nullptr) {
+        rebuildVersions();
+    }
+    if (spill != nullptr && residentOverflow > overflowBudget) {
+        enforceBudget();
+    }
+    publishChange(ChangeType::Reset, std::string_view());
+    log(LogLevel::Info, {"Snapshot loaded: ", path});
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: loadGroups
+ *                  Description: Replaces the group table with a snapshot's. Every group
+ *                               is first created empty, in table order, so ids match
+ *                               the snapshot and every include resolves; each is then
+ *                               redefined with its permissions and includes.
+ *                  Arguments: const SnapshotView& view - Open snapshot
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::loadGroups(const SnapshotView& view) {
+    groups = PermissionGroups();
+    for (std::size_t group = 0; group < view.groupCount(); ++group) {
+        groups.define(view.groupName(group), {}, {});
+    }
+    std::vector<std::string_view> listed;
+    std::vector<std::string_view> included;
+    for (std::size_t group = 0; group < view.groupCount(); ++group) {
+        listed.clear();
+        included.clear();
+        view.forEachGroupPermission(group, [&](std::uint32_t local) { listed.push_back(view.permissionName(local)); });
+        view.forEachInclude(group, [&](std::uint32_t include) { included.push_back(view.groupName(include)); });
+        groups.define(view.groupName(group), listed, included);
+    }
+    groupHolders.assign(groups.size(), RoaringBitmap());
+    if (bitmaps != nullptr) {
+        bitmaps->setGroupMasks(groupMasks());
+    }
+}
+
+/******************************************************************************
+ *                  Name: lookup
+ *                  Description: Finds an installed app, copying it out of the loaded
+ *                               snapshot the first time it is asked for
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: App* - The app, or nullptr if it is not installed
+ *****************************************************************************/
+App* MobileAppManager::lookup(std::string_view appName) const {
+    App* app = installedApps.find(appName);
+    std::size_t index;
+    if (app == nullptr && base != nullptr && base->findApp(appName, index) && baseTaken.insert(index).second) {
+        app = materialize(index);
+    }
+    return app;
+}
+
+/******************************************************************************
+ *                  Name: materialize
+ *                  Description: Creates the app at a snapshot position with its
+ *                               permissions and groups and adds it to every index
+ *                  Arguments: std::size_t index - Position in the loaded snapshot
+ *                  Returns: App* - The new app
+ *****************************************************************************/
+App* MobileAppManager::materialize(std::size_t index) const {
+    App* app = createApp(base->appName(index));
+    base->forEachPermission(index, [&](std::uint32_t local) {
+        if (local < baseIds.size() && app->addPermission(baseIds[local])) {
+            permissionHolders[baseIds[local]].add(app->getAppId());
+        }
+    });
+    base->forEachAppGroup(index, [&](std::uint32_t group) {
+        if (group >= groups.size()) {
+            return;
+        }
+        GroupSetId current = app->getGroupSet();
+        GroupSetId joined = groups.join(current, group);
+        if (joined != current) {
+            app->setGroupSet(joined);
+            groupHolders[group].add(app->getAppId());
+        }
+    });
+    indexName(app);
+    return app;
+}
+
+/******************************************************************************
+ *                  Name: drainBase
+ *                  Description: Copies every app not yet taken out of the loaded
+ *                               snapshot, in name order, then unmaps it. Called
+ *                               before anything that reads the whole registry.
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::drainBase() const {
+    if (base == nullptr) {
+        return;
+    }
+    std::size_t remaining = base->appCount() - baseTaken.size();
+    appPool.reserve(installedApps.size() + remaining);
+    installedApps.reserve(installedApps.size() + remaining);
+    for (std::size_t index = 0; index < base->appCount(); ++index) {
+        if (baseTaken.count(index) == 0) {
+            materialize(index);
+        }
+    }
+    base.reset();
+    baseTaken.clear();
+    baseIds.clear();
+}
+
+/******************************************************************************
+ *                  Name: attachJournal
+ *                  Description: Sets the journal successful mutations are recorded to
+ *                  Arguments: std::shared_ptr<Journal> journal - Open journal, or nullptr
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::attachJournal(std::shared_ptr<Journal> newJournal) {
+    journal = std::move(newJournal);
+}
+
+/******************************************************************************
+ *                  Name: applyRecord
+ *                  Description: Dispatches a journal record to the public call that
+ *                               recorded it
+ *                  Arguments: const JournalRecord& record - Record read from a journal
+ *                  Returns: OpStatus - Outcome of the operation
+ *****************************************************************************/
+OpStatus MobileAppManager::applyRecord(const JournalRecord& record) {
+    switch (record.type) {
+    case JournalRecordType::Install:
+        return installApp(record.appName);
+    case JournalRecordType::Uninstall:
+        return uninstallApp(record.appName);
+    case JournalRecordType::Grant:
+        return assignPermission(record.appName, record.permission);
+    case JournalRecordType::Revoke:
+        return revokePermission(record.appName, record.permission);
+    case JournalRecordType::DefineGroup:
+        return definePermissionGroup(record.appName,
+                                     std::vector<std::string_view>(record.permissions.begin(), record.permissions.end()),
+                                     std::vector<std::string_view>(record.includes.begin(), record.includes.end()));
+    case JournalRecordType::AssignGroup:
+        return assignGroup(record.appName, record.permission);
+    case JournalRecordType::RevokeGroup:
+        return revokeGroup(record.appName, record.permission);
+    }
+    return OpStatus::Ok;
+}
+
+/******************************************************************************
+ *                  Name: checkpoint
+ *                  Description: Saves a snapshot, then truncates the journal. The
+ *                               snapshot is synced and renamed into place before
+ *                               the journal is touched, so a crash at any point
+ *                               leaves either the old snapshot with the full
+ *                               journal or the new one with records that replay
+ *                               idempotently on it.
+ *                  Arguments: const std::string& snapshotPath - Snapshot file
+ *                  Returns: bool - True on success
+ *****************************************************************************/
+bool MobileAppManager::checkpoint(const std::string& snapshotPath) {
+    if (!saveSnapshot(snapshotPath)) {
+        return false;
+    }
+    return journal == nullptr || journal->reset();
+}
+
+/******************************************************************************
+ *                  Name: recover
+ *                  Description: Loads the snapshot with its checksum verified, as
+ *                               compacting reads every app anyway, replays the
+ *                               journal quietly and without re-journaling, then
+ *                               compacts: the new
+ *                               snapshot is durable before the journal is
+ *                               truncated and the truncation is synced
+ *                  Arguments: const std::string& snapshotPath - Snapshot file
+ *                             const std::string& journalPath - Journal file
+ *                  Returns: bool - True on success
+ *****************************************************************************/
+bool MobileAppManager::recover(const std::string& snapshotPath, const std::string& journalPath) {
+    std::shared_ptr<ChangeStream> stream = std::exchange(changes, nullptr);
+    if (std::ifstream(snapshotPath).good() && !loadSnapshot(snapshotPath, true)) {
+        changes = std::move(stream);
+        return false;
+    }
+    std::shared_ptr<PermissionHistory> store = std::exchange(history, nullptr);
+
+    std::shared_ptr<LogSink> sink = std::exchange(logSink, std::make_shared<NullLogSink>());
+    std::shared_ptr<Journal> attached = std::exchange(journal, nullptr);
+    std::size_t records = Journal::replay(journalPath, [this](const JournalRecord& record) { applyRecord(record); });
+    logSink = std::move(sink);
+    journal = std::move(attached);
+    changes = std::move(stream);
+    history = std::move(store);
+    publishChange(ChangeType::Reset, std::string_view());
+
+    if (!saveSnapshot(snapshotPath) || !Journal::truncate(journalPath)) {
+        return false;
+    }
+    log(LogLevel::Info, {"Journal replayed: ", std::to_string(records), " records"});
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: importFrom
+ *                  Description: Streams records read from an input stream
+ *                  Arguments: std::istream& input - Record stream
+ *                             RecordFormat format - JsonLines or Csv
+ *                             ImportStats* stats - Receives the totals, may be null
+ *                  Returns: bool - False if the input could not be read
+ *****************************************************************************/
+bool MobileAppManager::importFrom(std::istream& input, RecordFormat format, ImportStats* stats) {
+    RecordReader reader(format, [&input](char* data, std::size_t size) -> std::ptrdiff_t {
+        input.read(data, static_cast<std::streamsize>(size));
+        return input.bad() ? -1 : static_cast<std::ptrdiff_t>(input.gcount());
+    });
+    return importRecords(reader, stats);
+}
+
+/******************************************************************************
+ *                  Name: importFrom
+ *                  Description: Streams records read from a file descriptor
+ *                  Arguments: int fd - Open descriptor
+ *                             RecordFormat format - JsonLines or Csv
+ *                             ImportStats* stats - Receives the totals, may be null
+ *                  Returns: bool - False if the input could not be read
+ *****************************************************************************/
+bool MobileAppManager::importFrom(int fd, RecordFormat format, ImportStats* stats) {
+    RecordReader reader(format, [fd](char* data, std::size_t size) { return readDescriptor(fd, data, size); });
+    return importRecords(reader, stats);
+}
+
+/******************************************************************************
+ *                  Name: exportTo
+ *                  Description: Streams every app to an output stream
+ *                  Arguments: std::ostream& output - Destination stream
+ *                             RecordFormat format - JsonLines or Csv
+ *                  Returns: bool - False if a write failed
+ *****************************************************************************/
+bool MobileAppManager::exportTo(std::ostream& output, RecordFormat format) const {
+    RecordWriter writer(format, [&output](const char* data, std::size_t size) {
+        return static_cast<bool>(output.write(data, static_cast<std::streamsize>(size)));
+    });
+    return exportRecords(writer) && static_cast<bool>(output.flush());
+}
+
+/******************************************************************************
+ *                  Name: exportTo
+ *                  Description: Streams every app to a file descriptor
+ *                  Arguments: int fd - Open descriptor
+ *                             RecordFormat format - JsonLines or Csv
+ *                  Returns: bool - False if a write failed
+ *****************************************************************************/
+bool MobileAppManager::exportTo(int fd, RecordFormat format) const {
+    RecordWriter writer(format, [fd](const char* data, std::size_t size) { return writeDescriptor(fd, data, size); });
+    return exportRecords(writer);
+}
+
+/******************************************************************************
+ *                  Name: attachMetrics
+ *                  Description: Sets the collector operations are recorded to
+ *                  Arguments: std::shared_ptr<OperationMetrics> metrics - Collector, or nullptr
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::attachMetrics(std::shared_ptr<OperationMetrics> newMetrics) {
+    metrics = std::move(newMetrics);
+}
+
+/******************************************************************************
+ *                  Name: stats
+ *                  Description: Returns the totals of the attached collector
+ *                  Arguments: None
+ *                  Returns: MetricsSnapshot - Merged counters; all zero without one
+ *****************************************************************************/
+MetricsSnapshot MobileAppManager::stats() const {
+    return metrics != nullptr ? metrics->stats() : MetricsSnapshot();
+}
+
+/******************************************************************************
+ *                  Name: attachChangeStream
+ *                  Description: Sets the stream state changes are published to
+ *                  Arguments: std::shared_ptr<ChangeStream> stream - Stream, or nullptr
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::attachChangeStream(std::shared_ptr<ChangeStream> stream) {
+    changes = std::move(stream);
+}
+
+/******************************************************************************
+ *                  Name: attachHistory
+ *                  Description: Sets the store grants and revokes are recorded in
+ *                  Arguments: std::shared_ptr<PermissionHistory> store - History, or nullptr
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::attachHistory(std::shared_ptr<PermissionHistory> store) {
+    history = std::move(store);
+}
+
+/******************************************************************************
+ *                  Name: enableSnapshotReads
+ *                  Description: Creates the versioned copy from the current state
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::enableSnapshotReads() {
+    drainBase();
+    if (versions == nullptr) {
+        versions = std::make_unique<VersionedAppMap>();
+        rebuildVersions();
+    }
+}
+
+/******************************************************************************
+ *                  Name: readSnapshot
+ *                  Description: Pins the latest published version
+ *                  Arguments: None
+ *                  Returns: AppMapSnapshot - Point-in-time view; empty if snapshot
+ *                           reads are not enabled
+ *****************************************************************************/
+AppMapSnapshot MobileAppManager::readSnapshot() const {
+    return versions != nullptr ? versions->snapshot() : AppMapSnapshot();
+}
+
+/******************************************************************************
+ *                  Name: enableMerkleIndex
+ *                  Description: Creates the hash tree from the current apps
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::enableMerkleIndex() {
+    drainBase();
+    if (merkle == nullptr) {
+        merkle = std::make_unique<MerkleIndex>();
+        PermissionSet scratch;
+        installedApps.forEach([&](App* app) { merkle->addApp(app, permissionsOf(app, scratch)); });
+    }
+}
+
+/******************************************************************************
+ *                  Name: diff
+ *                  Description: Compares only the differing Merkle leaves when both
+ *                               sides have the index, otherwise merges the full
+ *                               name-ordered app lists
+ *                  Arguments: const MobileAppManager& target - Desired state
+ *                  Returns: AppBatch - Operations turning this registry into target
+ *****************************************************************************/
+AppBatch MobileAppManager::diff(const MobileAppManager& target) const {
+    drainBase();
+    target.drainBase();
+    AppBatch changes;
+    auto mineOf = [this](const App* app, PermissionSet& scratch) -> const PermissionSet& {
+        return permissionsOf(app, scratch);
+    };
+    auto theirsOf = [&target](const App* app, PermissionSet& scratch) -> const PermissionSet& {
+        return target.permissionsOf(app, scratch);
+    };
+    if (merkle != nullptr && target.merkle != nullptr) {
+        merkle->forEachDifference(*target.merkle, [&](const std::vector<const App*>& mine,
+                                                      const std::vector<const App*>& theirs) {
+            diffApps(mine, theirs, mineOf, theirsOf, changes);
+        });
+        return changes;
+    }
+    auto collect = [](const MobileAppManager& manager) {
+        std::vector<const App*> apps;
+        apps.reserve(manager.installedApps.size());
+        manager.appNames.forEach(std::string_view(), std::string_view(), [&](const App* app) {
+            apps.push_back(app);
+            return true;
+        });
+        return apps;
+    };
+    diffApps(collect(*this), collect(target), mineOf, theirsOf, changes);
+    return changes;
+}
+
+/******************************************************************************
+ *                  Name: enableBitmapIndex
+ *                  Description: Creates the bitmap index from the current apps and
+ *                               group masks
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::enableBitmapIndex() {
+    drainBase();
+    if (bitmaps == nullptr) {
+        bitmaps = std::make_unique<PermissionBitmapIndex>();
+        bitmaps->setGroupMasks(groupMasks());
+        PermissionSet scratch;
+        installedApps.forEach([&](App* app) {
+            bitmaps->addApp(app, permissionsOf(app, scratch), groups.members(app->getGroupSet()));
+        });
+    }
+}
+
+/******************************************************************************
+ *                  Name: queryPermissions
+ *                  Description: Evaluates the query on the bitmap index, building a
+ *                               temporary one owned by the result if it is not
+ *                               enabled
+ *                  Arguments: const PermissionQuery& query - Parsed expression
+ *                  Returns: PermissionQueryResult - Matching apps
+ *****************************************************************************/
+PermissionQueryResult MobileAppManager::queryPermissions(const PermissionQuery& query) const {
+    drainBase();
+    PermissionQueryResult result;
+    if (bitmaps == nullptr) {
+        auto index = std::make_shared<PermissionBitmapIndex>();
+        index->setGroupMasks(groupMasks());
+        PermissionSet scratch;
+        installedApps.forEach([&](App* app) {
+            index->addApp(app, permissionsOf(app, scratch), groups.members(app->getGroupSet()));
+        });
+        result.owned = std::move(index);
+    }
+    result.index = bitmaps != nullptr ? bitmaps.get() : result.owned.get();
+    result.bits = result.index->evaluate(query);
+    return result;
+}
+
+/******************************************************************************
+ *                  Name: freeze
+ *                  Description: Collects each app with its own and group permissions,
+ *                               in name order, and compiles them
+ *                  Arguments: FrozenAppRegistry& frozen - Receives the registry
+ *                  Returns: bool - False if the perfect hash could not be built
+ *****************************************************************************/
+bool MobileAppManager::freeze(FrozenAppRegistry& frozen) const {
+    drainBase();
+    std::vector<FrozenAppRegistry::Entry> entries;
+    entries.reserve(installedApps.size());
+    PermissionSet scratch;
+    appNames.forEach(std::string_view(), std::string_view(), [&](const App* app) {
+        entries.emplace_back(app->getAppName(), permissionsOf(app, scratch));
+        entries.back().second |= groups.effective(app->getGroupSet());
+        return true;
+    });
+    if (!FrozenAppRegistry::build(entries, frozen)) {
+        log(LogLevel::Error, {"Registry could not be frozen!"});
+        return false;
+    }
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: appPoolStats
+ *                  Description: Returns the occupancy counters of the App pool
+ *                  Arguments: None
+ *                  Returns: PoolStats - Live objects, high-water mark and slab usage
+ *****************************************************************************/
+PoolStats MobileAppManager::appPoolStats() const {
+    return appPool.stats();
+}
+
+/******************************************************************************
+ *                  Name: memoryUsage
+ *                  Description: Sums each structure's heap bytes; app names and
+ *                               reverse-index bitmaps are walked one by one
+ *                  Arguments: None
+ *                  Returns: MemoryUsage - Breakdown by structure
+ *****************************************************************************/
+MemoryUsage MobileAppManager::memoryUsage() const {
+    MemoryUsage usage;
+    usage.index = installedApps.memoryUsage() + appNames.memoryUsage() + appGrams.memoryUsage();
+    PoolStats pool = appPool.stats();
+    usage.records = pool.live * sizeof(App);
+    usage.allocator = (pool.capacity - pool.live) * sizeof(App);
+    installedApps.forEach([&](App* app) {
+        std::size_t nameBytes = stringHeapBytes(app->getAppName());
+        std::size_t setBytes = app->getPermissionSet().memoryUsage();
+        usage.names += nameBytes;
+        usage.permissions += setBytes;
+        usage.allocator += (nameBytes != 0 ? kHeapBlockOverhead : 0) + (setBytes != 0 ? kHeapBlockOverhead : 0);
+        usage.overflow += overflowBytes(app->getPermissionSet());
+    });
+    usage.index += appSlots.capacity() * sizeof(App*) + freeAppIds.capacity() * sizeof(std::uint32_t);
+    for (const std::vector<RoaringBitmap>* index : {&permissionHolders, &groupHolders}) {
+        usage.permissions += index->capacity() * sizeof(RoaringBitmap);
+        for (const RoaringBitmap& holders : *index) {
+            usage.permissions += holders.memoryUsage();
+        }
+    }
+    if (merkle != nullptr) {
+        usage.extensions += merkle->memoryUsage();
+    }
+    if (bitmaps != nullptr) {
+        usage.extensions += bitmaps->memoryUsage();
+    }
+    usage.extensions += expiryWheel.memoryUsage() +
+                        timedGrants.size() * (sizeof(void*) + sizeof(TimedGrant) + sizeof(TimerWheel<TimedGrant>::TimerId));
+    if (timedGrants.bucket_count() > 1) {
+        usage.extensions += timedGrants.bucket_count() * sizeof(void*);   // A lone bucket is stored inline
+    }
+    usage.allocator += timedGrants.size() * kHeapBlockOverhead;
+    if (spill != nullptr) {
+        usage.extensions += spill->memoryUsage();
+        usage.spilledApps = spill->size();
+        usage.spillFileBytes = spill->fileBytes();
+    }
+    return usage;
+}
+
+/******************************************************************************
+ *                  Name: setPermissionOverflowBudget
+ *                  Description: Reloads any app evicted under the previous budget,
+ *                               then opens the spill file and evicts down to the
+ *                               new budget
+ *                  Arguments: std::size_t bytes - Budget, 0 for none
+ *                             const std::string& spillPath - File for evicted apps
+ *                  Returns: bool - False if the spill file could not be opened
+ *****************************************************************************/
+bool MobileAppManager::setPermissionOverflowBudget(std::size_t bytes, const std::string& spillPath) {
+    if (spill != nullptr) {
+        installedApps.forEach([&](App* app) {
+            if (app->getLastAccess() == App::kEvicted) {
+                fault(app);
+                app->setLastAccess(accessClock);
+            }
+        });
+        spill->clear();
+        spill.reset();
+    }
+    overflowBudget = 0;
+    if (bytes == 0) {
+        log(LogLevel::Info, {"Permission overflow budget removed"});
+        return true;
+    }
+
+    auto store = std::make_unique<AppSpillStore>();
+    if (!store->open(spillPath)) {
+        log(LogLevel::Error, {"Spill file could not be opened: ", spillPath});
+        return false;
+    }
+    spill = std::move(store);
+    overflowBudget = bytes;
+    if (residentOverflow > overflowBudget) {
+        enforceBudget();
+    }
+    log(LogLevel::Info, {"Permission overflow budget set; spilling to ", spillPath});
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: expireGrants
+ *                  Description: Advances the expiry wheel to the clock and revokes
+ *                               each grant it fires, publishing one version for all
+ *                  Arguments: None
+ *                  Returns: std::size_t - Grants revoked
+ *****************************************************************************/
+std::size_t MobileAppManager::expireGrants() {
+    std::size_t expired = expiryWheel.advance(expiryTicks(expiryClock()), [&](const TimedGrant& grant) {
+        timedGrants.erase(grant);
+        revokeExpired(grant);
+    });
+    if (expired != 0) {
+        publishVersion();
+        log(LogLevel::Info, {"Expired ", std::to_string(expired), " timed permission grants"});
+    }
+    return expired;
+}
+
+/******************************************************************************
+ *                  Name: nextExpiry
+ *                  Description: Converts the wheel's next event back to clock time
+ *                  Arguments: None
+ *                  Returns: ExpiryClock::time_point - Time, or time_point::max()
+ *****************************************************************************/
+MobileAppManager::ExpiryClock::time_point MobileAppManager::nextExpiry() const {
+    const auto latest = std::chrono::duration_cast<std::chrono::milliseconds>(
+        ExpiryClock::time_point::max().time_since_epoch()).count();
+    std::uint64_t ticks = timedGrants.empty() ? TimerWheel<TimedGrant>::kNever : expiryWheel.nextExpiry();
+    if (ticks >= static_cast<std::uint64_t>(latest)) {
+        return ExpiryClock::time_point::max();
+    }
+    return ExpiryClock::time_point(std::chrono::milliseconds(static_cast<std::int64_t>(ticks)));
+}
+
+/******************************************************************************
+ *                  Name: pendingExpiries
+ *                  Description: Returns the number of timed grants not yet revoked
+ *                  Arguments: None
+ *                  Returns: std::size_t - Timed grants
+ *****************************************************************************/
+std::size_t MobileAppManager::pendingExpiries() const {
+    return timedGrants.size();
+}
+
+/******************************************************************************
+ *                  Name: setExpiryClock
+ *                  Description: Replaces the clock deadlines are checked against
+ *                  Arguments: std::function<ExpiryClock::time_point()> clock - Clock
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::setExpiryClock(std::function<ExpiryClock::time_point()> clock) {
+    expiryClock = std::move(clock);
+}
+
+/******************************************************************************
+ *                  Name: setLogSink
+ *                  Description: Replaces the sink operations log to
+ *                  Arguments: std::shared_ptr<LogSink> sink - New log destination
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::setLogSink(std::shared_ptr<LogSink> sink) {
+    logSink = std::move(sink);
+}
+
+/******************************************************************************
+ *                  Name: log
+ *                  Description: Writes the concatenated parts to the sink. The message
+ *                               is only built when the sink accepts the level.
+ *                  Arguments: LogLevel level - Severity of the message
+ *                             std::initializer_list<std::string_view> parts - Message pieces
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::log(LogLevel level, std::initializer_list<std::string_view> parts) const {
+    if (!logSink->enabled(level)) {
+        return;
+    }
+    std::string message;
+    for (std::string_view part : parts) {
+        message.append(part);
+    }
+    logSink->write(level, message);
+}
+
+/******************************************************************************
+ *                  Name: createApp
+ *                  Description: Takes an app from the pool and gives it a dense id,
+ *                               reusing the id of an uninstalled app first
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: App* - The new app, not yet indexed
+ *****************************************************************************/
+App* MobileAppManager::createApp(std::string_view appName) const {
+    App* app = appPool.create(appName);
+    if (freeAppIds.empty()) {
+        app->setAppId(static_cast<std::uint32_t>(appSlots.size()));
+        appSlots.push_back(app);
+    } else {
+        app->setAppId(freeAppIds.back());
+        freeAppIds.pop_back();
+        appSlots[app->getAppId()] = app;
+    }
+    return app;
+}
+
+/******************************************************************************
+ *                  Name: destroyApp
+ *                  Description: Frees an app's id and returns it to the pool; the
+ *                               app must already be out of the reverse indexes
+ *                  Arguments: App* app - App to destroy
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::destroyApp(App* app) const {
+    appSlots[app->getAppId()] = nullptr;
+    freeAppIds.push_back(app->getAppId());
+    appPool.destroy(app);
+}
+
+/******************************************************************************
+ *                  Name: indexName
+ *                  Description: Adds a new app to the hash index, the name trie, the
+ *                               trigram index and the Merkle and bitmap indexes, if
+ *                               enabled, and counts its permission overflow
+ *                  Arguments: App* app - App to add
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::indexName(App* app) const {
+    installedApps.insert(app);
+    appNames.insert(app);
+    appGrams.insert(app);
+    if (merkle != nullptr) {
+        merkle->addApp(app, app->getPermissionSet());
+    }
+    if (bitmaps != nullptr) {
+        bitmaps->addApp(app, app->getPermissionSet(), groups.members(app->getGroupSet()));
+    }
+    residentOverflow += overflowBytes(app->getPermissionSet());
+}
+
+/******************************************************************************
+ *                  Name: unindexName
+ *                  Description: Removes an app from the hash index, the name trie, the
+ *                               trigram index and the Merkle and bitmap indexes, if
+ *                               enabled
+ *                  Arguments: const App* app - App to remove
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::unindexName(const App* app) {
+    installedApps.erase(app->getAppName());
+    appNames.erase(app->getAppName());
+    appGrams.erase(app);
+    if (merkle != nullptr) {
+        merkle->removeApp(app);
+    }
+    if (bitmaps != nullptr) {
+        bitmaps->removeApp(app, groups.members(app->getGroupSet()));
+    }
+}
+
+/******************************************************************************
+ *                  Name: clearApps
+ *                  Description: Returns every app to the pool and empties the name
+ *                               indexes, the reverse indexes, the spill file and
+ *                               the expiry wheel; group definitions are kept
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::clearApps() {
+    installedApps.forEach([&](App* app) {
+        groups.release(app->getGroupSet());
+        appPool.destroy(app);
+    });
+    appSlots.clear();
+    freeAppIds.clear();
+    installedApps.clear();
+    appNames.clear();
+    appGrams.clear();
+    permissionHolders.clear();
+    base.reset();
+    baseTaken.clear();
+    baseIds.clear();
+    if (merkle != nullptr) {
+        merkle->clear();
+    }
+    if (bitmaps != nullptr) {
+        bitmaps->clear();
+    }
+    groupHolders.assign(groups.size(), RoaringBitmap());
+    if (spill != nullptr) {
+        spill->clear();
+    }
+    residentOverflow = 0;
+    expiryWheel.clear();
+    timedGrants.clear();
+}
+
+/******************************************************************************
+ *                  Name: importRecords
+ *                  Description: Applies records as they are parsed. Permission names
+ *                               are interned once per import through a local table
+ *                               keyed by the registry's own strings, and snapshot
+ *                               readers see the import in steps of
+ *                               kImportPublishRecords records.
+ *                  Arguments: RecordReader& reader - Parser over the input
+ *                             ImportStats* stats - Receives the totals, may be null
+ *                  Returns: bool - False if the input could not be read
+ *****************************************************************************/
+bool MobileAppManager::importRecords(RecordReader& reader, ImportStats* stats) {
+    expireDue();
+    PermissionRegistry& registry = PermissionRegistry::instance();
+    std::unordered_map<std::string_view, PermissionId> interned;
+    std::vector<PermissionId> ids;
+    ImportStats totals;
+    std::size_t staged = 0;
+    RecordReader::Result result;
+    while ((result = reader.next()) != RecordReader::Result::End && result != RecordReader::Result::Error) {
+        if (result == RecordReader::Result::Malformed) {
+            ++totals.malformed;
+            continue;
+        }
+        const std::vector<std::string_view>& permissions = reader.permissions();
+        ids.clear();
+        for (std::string_view permission : permissions) {
+            auto it = interned.find(permission);
+            if (it == interned.end()) {
+                PermissionId id = registry.intern(permission);
+                it = interned.emplace(std::string_view(registry.name(id)), id).first;
+            }
+            ids.push_back(it->second);
+        }
+
+        std::string_view appName = reader.appName();
+        App* app = lookup(appName);
+        if (app == nullptr) {
+            app = createApp(appName);
+            indexName(app);
+            journalOp(JournalRecordType::Install, appName);
+            publishChange(ChangeType::Installed, appName);
+            ++totals.installed;
+        }
+        if (spill != nullptr) {
+            touch(app);
+        }
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            PermissionId id = ids[i];
+            if (addPermission(app, id)) {
+                if (merkle != nullptr) {
+                    merkle->addPermission(app, id);
+                }
+                if (bitmaps != nullptr) {
+                    bitmaps->grant(app, id);
+                }
+                recordHistory(appName, id, HistoryOp::Grant);
+                publishChange(ChangeType::PermissionGranted, appName, permissions[i]);
+                ++totals.granted;
+            } else {
+                cancelExpiry(app, id);
+            }
+            journalOp(JournalRecordType::Grant, appName, permissions[i]);
+        }
+        stageVersion(appName, app);
+        ++totals.records;
+        if (++staged == kImportPublishRecords) {
+            publishVersion();
+            staged = 0;
+        }
+    }
+    publishVersion();
+    totals.bytes = reader.bytesRead();
+    if (stats != nullptr) {
+        *stats = totals;
+    }
+    if (totals.malformed > 0) {
+        log(LogLevel::Warning, {"Import skipped ", std::to_string(totals.malformed), " malformed records"});
+    }
+    if (result == RecordReader::Result::Error) {
+        log(LogLevel::Error, {"Import input could not be read!"});
+        return false;
+    }
+    log(LogLevel::Info, {"Imported ", std::to_string(totals.records), " records"});
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: exportRecords
+ *                  Description: Formats every app in name order; evicted apps are
+ *                               read through from the spill file
+ *                  Arguments: RecordWriter& writer - Formatter over the output
+ *                  Returns: bool - False if a write failed
+ *****************************************************************************/
+bool MobileAppManager::exportRecords(RecordWriter& writer) const {
+    drainBase();
+    PermissionRegistry& registry = PermissionRegistry::instance();
+    PermissionSet scratch;
+    appNames.forEach(std::string_view(), std::string_view(), [&](const App* app) {
+        writer.beginRecord(app->getAppName());
+        durablePermissionsOf(app, scratch).forEach([&](PermissionId id) { writer.addPermission(registry.name(id)); });
+        writer.endRecord();
+        return true;
+    });
+    if (!writer.finish()) {
+        log(LogLevel::Error, {"Export output could not be written!"});
+        return false;
+    }
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: journalOp
+ *                  Description: Appends a successful mutation to the journal, if any
+ *                  Arguments: JournalRecordType type - Kind of mutation
+ *                             std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission or group, if any
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::journalOp(JournalRecordType type, std::string_view appName, std::string_view permission) {
+    if (journal != nullptr) {
+        journal->append(type, appName, permission);
+    }
+}
+
+/******************************************************************************
+ *                  Name: publishChange
+ *                  Description: Publishes a change of state to the stream, if any
+ *                  Arguments: ChangeType type - Kind of change
+ *                             std::string_view appName - Name of the application
+ *                             std::string_view permission - Permission, if any
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::publishChange(ChangeType type, std::string_view appName, std::string_view permission) {
+    if (changes != nullptr) {
+        changes->publish(type, appName, permission);
+    }
+}
+
+/******************************************************************************
+ *                  Name: recordHistory
+ *                  Description: Records a change of a direct grant in the history,
+ *                               if any
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             PermissionId permission - Permission changed
+ *                             HistoryOp op - Grant or Revoke
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::recordHistory(std::string_view appName, PermissionId permission, HistoryOp op) {
+    if (history != nullptr) {
+        history->record(appName, permission, op);
+    }
+}
+
+/******************************************************************************
+ *                  Name: stageVersion
+ *                  Description: Copies an app's state into the versioned map, if
+ *                               enabled, without publishing it
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             const App* app - The app, or nullptr once uninstalled
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::stageVersion(std::string_view appName, const App* app) {
+    if (versions == nullptr) {
+        return;
+    }
+    if (app != nullptr) {
+        PermissionSet scratch;
+        versions->put(appName, permissionsOf(app, scratch), groups.members(app->getGroupSet()));
+    } else {
+        versions->erase(appName);
+    }
+}
+
+/******************************************************************************
+ *                  Name: publishVersion
+ *                  Description: Publishes the staged changes to snapshot readers, if
+ *                               enabled
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::publishVersion() {
+    if (versions != nullptr) {
+        versions->publish();
+    }
+}
+
+/******************************************************************************
+ *                  Name: rebuildVersions
+ *                  Description: Replaces the versioned map's contents with every app
+ *                               and group mask, as one version
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::rebuildVersions() {
+    versions->clear();
+    versions->setGroupMasks(groupMasks());
+    appNames.forEach(std::string_view(), std::string_view(), [&](const App* app) {
+        stageVersion(app->getAppName(), app);
+        return true;
+    });
+    versions->publish();
+}
+
+/******************************************************************************
+ *                  Name: groupMasks
+ *                  Description: Copies the compiled mask of every group
+ *                  Arguments: None
+ *                  Returns: std::vector<PermissionSet> - Masks indexed by GroupId
+ *****************************************************************************/
+std::vector<PermissionSet> MobileAppManager::groupMasks() const {
+    std::vector<PermissionSet> masks;
+    masks.reserve(groups.size());
+    for (GroupId id = 0; id < groups.size(); ++id) {
+        masks.push_back(groups.mask(id));
+    }
+    return masks;
+}
+
+/******************************************************************************
+ *                  Name: addPermission
+ *                  Description: Grants a permission to an app, adds it to the
+ *                               holders and counts any growth of the overflow
+ *                  Arguments: App* app - Resident app
+ *                             PermissionId id - Permission to grant
+ *                  Returns: bool - False if the app already held it
+ *****************************************************************************/
+bool MobileAppManager::addPermission(App* app, PermissionId id) {
+    std::size_t before = overflowBytes(app->getPermissionSet());
+    if (!app->addPermission(id)) {
+        return false;
+    }
+    if (permissionHolders.size() <= id) {
+        permissionHolders.resize(id + 1);
+    }
+    permissionHolders[id].add(app->getAppId());
+    residentOverflow += overflowBytes(app->getPermissionSet()) - before;
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: unindexPermission
+ *                  Description: Removes an app from the holders of one permission
+ *                  Arguments: PermissionId id - Permission that was revoked
+ *                             const App* app - The application
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::unindexPermission(PermissionId id, const App* app) {
+    permissionHolders[id].remove(app->getAppId());
+}
+
+/******************************************************************************
+ *                  Name: unindexGroup
+ *                  Description: Removes an app from the holders of one group; an app
+ *                               missing there, as after a partial load, is skipped
+ *                  Arguments: GroupId group - Group the app left
+ *                             const App* app - The application
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::unindexGroup(GroupId group, const App* app) {
+    if (group < groupHolders.size()) {
+        groupHolders[group].remove(app->getAppId());
+    }
+}
+
+/******************************************************************************
+ *                  Name: unindexApp
+ *                  Description: Removes an app from the reverse index entry of every
+ *                               permission and group it holds, releases its group
+ *                               set and stops counting its overflow
+ *                  Arguments: const App& app - The application being removed
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::unindexApp(const App& app) {
+    app.getPermissionSet().forEach([&](PermissionId id) {
+        unindexPermission(id, &app);
+        recordHistory(app.getAppName(), id, HistoryOp::Revoke);
+    });
+    for (GroupId group : groups.members(app.getGroupSet())) {
+        unindexGroup(group, &app);
+    }
+    groups.release(app.getGroupSet());
+    residentOverflow -= overflowBytes(app.getPermissionSet());
+}
+
+/******************************************************************************
+ *                  Name: touch
+ *                  Description: Reads an evicted app back in and stamps it as the
+ *                               most recently used, then evicts others if the
+ *                               resident overflow is over budget. The clock is
+ *                               renumbered on the rare wrap so order is kept.
+ *                  Arguments: App* app - App being accessed
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::touch(App* app) const {
+    if (app->getLastAccess() == App::kEvicted) {
+        fault(app);
+    }
+    if (++accessClock == App::kEvicted) {
+        installedApps.forEach([](App* other) {
+            if (other->getLastAccess() != App::kEvicted) {
+                other->setLastAccess(1);
+            }
+        });
+        accessClock = 2;
+    }
+    app->setLastAccess(accessClock);
+    if (residentOverflow > overflowBudget) {
+        enforceBudget();
+    }
+}
+
+/******************************************************************************
+ *                  Name: evict
+ *                  Description: Moves an app's permissions to the spill file. The
+ *                               reverse index keeps the app's id, so holder
+ *                               queries never read the file.
+ *                  Arguments: App* app - Resident app
+ *                  Returns: bool - False if the spill file could not be written;
+ *                           the app is then left resident
+ *****************************************************************************/
+bool MobileAppManager::evict(App* app) const {
+    PermissionSet permissions = app->takePermissions();
+    if (!spill->put(app, permissions)) {
+        app->restorePermissions(std::move(permissions));
+        return false;
+    }
+    residentOverflow -= overflowBytes(permissions);
+    app->setLastAccess(App::kEvicted);
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: fault
+ *                  Description: Reads an evicted app's permissions back from the
+ *                               spill file
+ *                  Arguments: App* app - Evicted app
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::fault(App* app) const {
+    PermissionSet permissions;
+    if (!spill->take(app, permissions)) {
+        log(LogLevel::Error, {"Evicted app could not be read back: ", app->getAppName()});
+        return;
+    }
+    residentOverflow += overflowBytes(permissions);
+    app->restorePermissions(std::move(permissions));
+}
+
+/******************************************************************************
+ *                  Name: enforceBudget
+ *                  Description: Evicts the least recently used apps with overflow
+ *                               until the resident overflow is at three quarters
+ *                               of the budget, leaving headroom so the next check
+ *                               is not immediate. Only the app being accessed is
+ *                               kept, so the target is missed only when that one
+ *                               app alone holds more than it.
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::enforceBudget() const {
+    const std::size_t target = overflowBudget - overflowBudget / 4;
+    std::vector<App*> cold;
+    installedApps.forEach([&](App* app) {
+        std::uint32_t tick = app->getLastAccess();
+        if (tick != App::kEvicted && tick != accessClock && overflowBytes(app->getPermissionSet()) != 0) {
+            cold.push_back(app);
+        }
+    });
+    std::sort(cold.begin(), cold.end(),
+              [](const App* a, const App* b) { return a->getLastAccess() < b->getLastAccess(); });
+    for (App* app : cold) {
+        if (residentOverflow <= target) {
+            break;
+        }
+        if (!evict(app)) {
+            log(LogLevel::Error, {"Spill file could not be written!"});
+            break;
+        }
+    }
+    if (residentOverflow > target) {
+        log(LogLevel::Warning, {"Permission overflow budget is smaller than the app in use"});
+    }
+}
+
+/******************************************************************************
+ *                  Name: permissionsOf
+ *                  Description: Returns an app's permissions, reading an evicted
+ *                               app's from the spill file without loading it
+ *                  Arguments: const App* app - Installed app
+ *                             PermissionSet& scratch - Receives spilled permissions
+ *                  Returns: const PermissionSet& - The app's set or scratch
+ *****************************************************************************/
+const PermissionSet& MobileAppManager::permissionsOf(const App* app, PermissionSet& scratch) const {
+    if (app->getLastAccess() != App::kEvicted) {
+        return app->getPermissionSet();
+    }
+    if (!spill->read(app, scratch)) {
+        log(LogLevel::Error, {"Evicted app could not be read: ", app->getAppName()});
+        scratch.clear();
+    }
+    return scratch;
+}
+
+/******************************************************************************
+ *                  Name: overflowBytes
+ *                  Description: Returns the heap bytes of a permission set beyond its
+ *                               inline words, with the block header; eviction frees
+ *                               these but not the inline words inside the App
+ *                  Arguments: const PermissionSet& permissions - Set to measure
+ *                  Returns: std::size_t - Bytes
+ *****************************************************************************/
+std::size_t MobileAppManager::overflowBytes(const PermissionSet& permissions) {
+    std::size_t bytes = permissions.memoryUsage();
+    return bytes != 0 ? bytes + kHeapBlockOverhead : 0;
+}
+
+/******************************************************************************
+ *                  Name: expiryTicks
+ *                  Description: Converts a clock time to a tick of the expiry wheel
+ *                  Arguments: ExpiryClock::time_point time - Time to convert
+ *                  Returns: std::uint64_t - Whole milliseconds since the clock's
+ *                           epoch, rounded down
+ *****************************************************************************/
+std::uint64_t MobileAppManager::expiryTicks(ExpiryClock::time_point time) {
+    auto ticks = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+    return ticks > 0 ? static_cast<std::uint64_t>(ticks) : 0;
+}
+
+/******************************************************************************
+ *                  Name: expireDue
+ *                  Description: Runs expireGrants if the wheel may have a deadline
+ *                               due; the check is one clock read and a few bit
+ *                               scans, so mutations call it unconditionally
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::expireDue() {
+    if (!timedGrants.empty() && expiryTicks(expiryClock()) >= expiryWheel.nextExpiry()) {
+        expireGrants();
+    }
+}
+
+/******************************************************************************
+ *                  Name: revokeExpired
+ *                  Description: Revokes a grant fired by the expiry wheel, updating
+ *                               what revokePermission updates except the journal,
+ *                               which never saw the grant
+ *                  Arguments: const TimedGrant& grant - Expired grant
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::revokeExpired(const TimedGrant& grant) {
+    App* app = installedApps.find(grant.app->getAppName());
+    if (spill != nullptr) {
+        touch(app);
+    }
+    if (!app->removePermission(grant.id)) {
+        return;
+    }
+    const std::string& appName = app->getAppName();
+    unindexPermission(grant.id, app);
+    if (merkle != nullptr) {
+        merkle->removePermission(app, grant.id);
+    }
+    if (bitmaps != nullptr) {
+        bitmaps->revoke(app, grant.id);
+    }
+    recordHistory(appName, grant.id, HistoryOp::Revoke);
+    stageVersion(appName, app);
+    publishChange(ChangeType::PermissionRevoked, appName, PermissionRegistry::instance().name(grant.id));
+}
+
+/******************************************************************************
+ *                  Name: cancelExpiry
+ *                  Description: Drops the timer of a grant that was revoked or made
+ *                               permanent
+ *                  Arguments: const App* app - Holder of the grant
+ *                             PermissionId id - The permission
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::cancelExpiry(const App* app, PermissionId id) {
+    if (timedGrants.empty()) {
+        return;
+    }
+    auto it = timedGrants.find(TimedGrant{app, id});
+    if (it != timedGrants.end()) {
+        expiryWheel.cancel(it->second);
+        timedGrants.erase(it);
+    }
+}
+
+/******************************************************************************
+ *                  Name: cancelExpiries
+ *                  Description: Drops the timers of every grant of an app about to
+ *                               be uninstalled
+ *                  Arguments: const App* app - Installed app
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::cancelExpiries(const App* app) {
+    if (timedGrants.empty()) {
+        return;
+    }
+    PermissionSet scratch;
+    permissionsOf(app, scratch).forEach([&](PermissionId id) { cancelExpiry(app, id); });
+}
+
+/******************************************************************************
+ *                  Name: grantExpired
+ *                  Description: Checks whether a held permission is a timed grant
+ *                               past its deadline that the wheel has not fired yet
+ *                  Arguments: const App* app - Holder of the permission
+ *                             PermissionId id - The permission
+ *                  Returns: bool - True if the grant has expired
+ *****************************************************************************/
+bool MobileAppManager::grantExpired(const App* app, PermissionId id) const {
+    if (timedGrants.empty()) {
+        return false;
+    }
+    auto it = timedGrants.find(TimedGrant{app, id});
+    return it != timedGrants.end() && expiryWheel.deadline(it->second) <= expiryTicks(expiryClock());
+}
+
+/******************************************************************************
+ *                  Name: dropTimedGrants
+ *                  Description: Removes from a set of the app's permissions its timed
+ *                               grants with a deadline at or before a tick
+ *                  Arguments: const App* app - Holder of the permissions
+ *                             PermissionSet& permissions - Set to filter
+ *                             std::uint64_t expiredBy - Latest deadline to remove
+ *                  Returns: None
+ *****************************************************************************/
+void MobileAppManager::dropTimedGrants(const App* app, PermissionSet& permissions, std::uint64_t expiredBy) const {
+    PermissionSet held = permissions;
+    held.forEach([&](PermissionId id) {
+        auto it = timedGrants.find(TimedGrant{app, id});
+        if (it != timedGrants.end() && expiryWheel.deadline(it->second) <= expiredBy) {
+            permissions.erase(id);
+        }
+    });
+}
+
+/******************************************************************************
+ *                  Name: durablePermissionsOf
+ *                  Description: Returns the permissions of an app that outlive a
+ *                               restart: those of permissionsOf without its timed
+ *                               grants
+ *                  Arguments: const App* app - Installed app
+ *                             PermissionSet& scratch - Receives a filtered copy
+ *                  Returns: const PermissionSet& - The app's set or scratch
+ *****************************************************************************/
+const PermissionSet& MobileAppManager::durablePermissionsOf(const App* app, PermissionSet& scratch) const {
+    const PermissionSet& permissions = permissionsOf(app, scratch);
+    if (timedGrants.empty()) {
+        return permissions;
+    }
+    if (&permissions != &scratch) {
+        scratch = permissions;
     }
-    return {};
+    dropTimedGrants(app, scratch, TimerWheel<TimedGrant>::kNever);
+    return scratch;
 }
 
 /******************************** End of File ********************************/
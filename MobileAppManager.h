@@ -14,49 +14,188 @@
 #define __MOBILE_APP_MANAGER_H__
 
 #include "App.h"
-#include <map>
+#include "AppBatch.h"
+#include "AppGramIndex.h"
+#include "AppIndex.h"
+#include "AppSpillStore.h"
+#include "AppTrie.h"
+#include "ChangeStream.h"
+#include "FrozenAppRegistry.h"
+#include "Journal.h"
+#include "MerkleIndex.h"
+#include "LogSink.h"
+#include "MemoryUsage.h"
+#include "Metrics.h"
+#include "ObjectPool.h"
+#include "OpStatus.h"
+#include "PermissionHistory.h"
+#include "PermissionQuery.h"
+#include "RecordStream.h"
+#include "RoaringBitmap.h"
+#include "TimerWheel.h"
+#include "VersionedAppMap.h"
+#include <chrono>
+#include <functional>  // For std::function
+#include <initializer_list>
+#include <iosfwd>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+class SnapshotView;
 
 /******************************************************************************
  *                  Class Definition: MobileAppManager
  *                  Description: Manages the installation, uninstallation, and 
- *                               permission control of mobile applications
+ *                               permission control of mobile applications.
+ *                               Outcomes are returned as OpStatus and reported
+ *                               to an injected LogSink.
  *****************************************************************************/
 
 class MobileAppManager {
 public:
+    using ExpiryClock = std::chrono::steady_clock;   // Clock of timed grant deadlines
+
+    /******************************************************************************
+     *                  Name: MobileAppManager
+     *                  Description: Constructor taking the sink operations log to
+     *                  Arguments: std::shared_ptr<LogSink> sink - Log destination; defaults
+     *                                                              to the console
+     *                  Returns: None
+     *****************************************************************************/
+    explicit MobileAppManager(std::shared_ptr<LogSink> sink = LogSink::console());
+
+    /******************************************************************************
+     *                  Name: ~MobileAppManager
+     *                  Description: Destroys every installed app and releases the pool
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    ~MobileAppManager();
+
+    MobileAppManager(const MobileAppManager&) = delete;
+    MobileAppManager& operator=(const MobileAppManager&) = delete;
+
     /******************************************************************************
      *                  Name: installApp
      *                  Description: Installs a new application with the given name
-     *                  Arguments: const std::string& appName - Name of the application
-     *                  Returns: None
+     *                  Arguments: std::string_view appName - Name of the application
+     *                  Returns: OpStatus - Ok, or why nothing changed
      *****************************************************************************/
-    void installApp(const std::string& appName);
+    OpStatus installApp(std::string_view appName);
 
     /******************************************************************************
      *                  Name: uninstallApp
      *                  Description: Uninstalls the application with the given name
-     *                  Arguments: const std::string& appName - Name of the application
-     *                  Returns: None
+     *                  Arguments: std::string_view appName - Name of the application
+     *                  Returns: OpStatus - Ok, or why nothing changed
      *****************************************************************************/
-    void uninstallApp(const std::string& appName);
+    OpStatus uninstallApp(std::string_view appName);
 
     /******************************************************************************
      *                  Name: assignPermission
      *                  Description: Assigns a permission to the specified app
-     *                  Arguments: const std::string& appName - Name of the app
-     *                             const std::string& permission - Permission to assign
-     *                  Returns: None
+     *                  Arguments: std::string_view appName - Name of the app
+     *                             std::string_view permission - Permission to assign
+     *                  Returns: OpStatus - Ok, or why nothing changed
+     *****************************************************************************/
+    OpStatus assignPermission(std::string_view appName, std::string_view permission);
+
+    /******************************************************************************
+     *                  Name: assignPermission
+     *                  Description: Assigns a permission that expires after a time to
+     *                               live; see the deadline overload
+     *                  Arguments: std::string_view appName - Name of the app
+     *                             std::string_view permission - Permission to assign
+     *                             std::chrono::milliseconds ttl - Time until it expires
+     *                  Returns: OpStatus - Ok, or why nothing changed
+     *****************************************************************************/
+    OpStatus assignPermission(std::string_view appName, std::string_view permission, std::chrono::milliseconds ttl);
+
+    /******************************************************************************
+     *                  Name: assignPermission
+     *                  Description: Assigns a permission that is revoked once the
+     *                               expiry clock reaches the deadline. Granting a
+     *                               timed permission again keeps the later deadline;
+     *                               a permission already held without a deadline
+     *                               stays permanent, and a permanent grant or import
+     *                               of a timed one makes it permanent. Timed grants
+     *                               are not journaled, saved in snapshots or
+     *                               exported, so they do not survive a restart.
+     *                  Arguments: std::string_view appName - Name of the app
+     *                             std::string_view permission - Permission to assign
+     *                             ExpiryClock::time_point deadline - When it expires
+     *                  Returns: OpStatus - Ok, or why nothing changed
      *****************************************************************************/
-    void assignPermission(const std::string& appName, const std::string& permission);
+    OpStatus assignPermission(std::string_view appName, std::string_view permission, ExpiryClock::time_point deadline);
 
     /******************************************************************************
      *                  Name: revokePermission
      *                  Description: Removes a permission from the specified app
-     *                  Arguments: const std::string& appName - Name of the app
-     *                             const std::string& permission - Permission to revoke
-     *                  Returns: None
+     *                  Arguments: std::string_view appName - Name of the app
+     *                             std::string_view permission - Permission to revoke
+     *                  Returns: OpStatus - Ok, or why nothing changed
+     *****************************************************************************/
+    OpStatus revokePermission(std::string_view appName, std::string_view permission);
+
+    /******************************************************************************
+     *                  Name: definePermissionGroup
+     *                  Description: Defines a named bundle of permissions, optionally
+     *                               including other groups, or redefines an existing
+     *                               one. Apps holding the group, directly or through a
+     *                               role, see the new definition at once; no app is
+     *                               visited.
+     *                  Arguments: std::string_view group - Group name
+     *                             const std::vector<std::string_view>& permissions -
+     *                                 Permissions the group grants
+     *                             const std::vector<std::string_view>& includes -
+     *                                 Groups whose permissions it also grants
+     *                  Returns: OpStatus - Ok, InvalidPermission, GroupNotFound (unknown
+     *                           include) or GroupCycle
+     *****************************************************************************/
+    OpStatus definePermissionGroup(std::string_view group, const std::vector<std::string_view>& permissions,
+                                   const std::vector<std::string_view>& includes = {});
+
+    /******************************************************************************
+     *                  Name: defineRole
+     *                  Description: Defines a role as the union of existing groups;
+     *                               roles share the group namespace and are assigned
+     *                               with assignGroup
+     *                  Arguments: std::string_view role - Role name
+     *                             const std::vector<std::string_view>& groups - Groups
+     *                                 the role grants
+     *                  Returns: OpStatus - Ok, InvalidPermission, GroupNotFound or GroupCycle
+     *****************************************************************************/
+    OpStatus defineRole(std::string_view role, const std::vector<std::string_view>& groups);
+
+    /******************************************************************************
+     *                  Name: assignGroup
+     *                  Description: Grants an app every permission of a group or role
+     *                               as a unit. Its effective permissions are its own
+     *                               plus those of its groups; revokePermission only
+     *                               removes its own.
+     *                  Arguments: std::string_view appName - Name of the app
+     *                             std::string_view group - Group or role to assign
+     *                  Returns: OpStatus - Ok, AppNotFound or GroupNotFound
      *****************************************************************************/
-    void revokePermission(const std::string& appName, const std::string& permission);
+    OpStatus assignGroup(std::string_view appName, std::string_view group);
+
+    /******************************************************************************
+     *                  Name: revokeGroup
+     *                  Description: Removes a group or role from an app
+     *                  Arguments: std::string_view appName - Name of the app
+     *                             std::string_view group - Group or role to remove
+     *                  Returns: OpStatus - Ok, AppNotFound or GroupNotFound
+     *****************************************************************************/
+    OpStatus revokeGroup(std::string_view appName, std::string_view group);
+
+    /******************************************************************************
+     *                  Name: listAppGroups
+     *                  Description: Returns the groups and roles assigned to an app
+     *                  Arguments: std::string_view appName - Name of the app
+     *                  Returns: std::vector<std::string> - Group names in definition order
+     *****************************************************************************/
+    std::vector<std::string> listAppGroups(std::string_view appName) const;
 
     /******************************************************************************
      *                  Name: listInstalledApps
@@ -66,16 +205,662 @@ public:
      *****************************************************************************/
     std::vector<std::string> listInstalledApps() const;
 
+    /******************************************************************************
+     *                  Name: listInstalledApps
+     *                  Description: Returns one page of installed app names in sorted
+     *                               order as views into the registry. Pass the last
+     *                               name of a page as after to get the next page.
+     *                  Arguments: std::string_view after - Names up to and including this
+     *                                                      are skipped; empty starts at
+     *                                                      the beginning
+     *                             std::size_t limit - Maximum names returned
+     *                  Returns: std::vector<std::string_view> - Names, valid until the app
+     *                           is uninstalled
+     *****************************************************************************/
+    std::vector<std::string_view> listInstalledApps(std::string_view after, std::size_t limit) const;
+
+    /******************************************************************************
+     *                  Name: forEachInstalledApp
+     *                  Description: Calls fn(std::string_view) for every installed app in
+     *                               sorted order without allocating
+     *                  Arguments: Fn fn - Callback invoked per app name
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEachInstalledApp(Fn fn) const {
+        drainBase();
+        appNames.forEach(std::string_view(), std::string_view(), [&](const App* app) {
+            fn(std::string_view(app->getAppName()));
+            return true;
+        });
+    }
+
+    /******************************************************************************
+     *                  Name: forEachInstalledApp
+     *                  Description: Paginated form: calls fn(std::string_view) for at most
+     *                               limit apps sorted after the given name, without
+     *                               allocating
+     *                  Arguments: std::string_view after - Resume point; empty starts at
+     *                                                      the beginning
+     *                             std::size_t limit - Maximum apps visited
+     *                             Fn fn - Callback invoked per app name
+     *                  Returns: std::size_t - Number of apps visited; fewer than limit
+     *                           means the end was reached
+     *****************************************************************************/
+    template <typename Fn>
+    std::size_t forEachInstalledApp(std::string_view after, std::size_t limit, Fn fn) const {
+        std::size_t visited = 0;
+        if (limit == 0) {
+            return visited;
+        }
+        drainBase();
+        appNames.forEach(std::string_view(), after, [&](const App* app) {
+            fn(std::string_view(app->getAppName()));
+            return ++visited < limit;
+        });
+        return visited;
+    }
+
+    /******************************************************************************
+     *                  Name: findApps
+     *                  Description: Returns installed apps whose name starts with a
+     *                               prefix, e.g. every "com.vendor." package, in sorted
+     *                               order. Answered from the name trie without visiting
+     *                               any other app.
+     *                  Arguments: std::string_view prefix - Required name prefix
+     *                             std::string_view after - Resume point; empty starts at
+     *                                                      the first match
+     *                             std::size_t limit - Maximum names returned
+     *                  Returns: std::vector<std::string_view> - Names, valid until the app
+     *                           is uninstalled
+     *****************************************************************************/
+    std::vector<std::string_view> findApps(std::string_view prefix, std::string_view after = std::string_view(),
+                                           std::size_t limit = std::numeric_limits<std::size_t>::max()) const;
+
+    /******************************************************************************
+     *                  Name: searchApps
+     *                  Description: Returns installed apps whose name contains a
+     *                               pattern, in sorted order. Patterns of three or more
+     *                               bytes are answered from the trigram index, or by a
+     *                               sorted scan when matches are common enough that the
+     *                               page fills quickly.
+     *                  Arguments: std::string_view pattern - Substring to look for
+     *                             std::string_view after - Resume point; empty starts at
+     *                                                      the first match
+     *                             std::size_t limit - Maximum names returned
+     *                  Returns: std::vector<std::string_view> - Names, valid until the app
+     *                           is uninstalled
+     *****************************************************************************/
+    std::vector<std::string_view> searchApps(std::string_view pattern, std::string_view after = std::string_view(),
+                                             std::size_t limit = std::numeric_limits<std::size_t>::max()) const;
+
+    /******************************************************************************
+     *                  Name: forEachAppPermission
+     *                  Description: Calls fn(std::string_view) for every effective
+     *                               permission of an app, its own and its groups', in
+     *                               interning order without copying names. Timed
+     *                               grants past their deadline are skipped even if
+     *                               expiry has not run yet.
+     *                  Arguments: std::string_view appName - Name of the app
+     *                             Fn fn - Callback invoked per permission name
+     *                  Returns: bool - False if the app is not installed
+     *****************************************************************************/
+    template <typename Fn>
+    bool forEachAppPermission(std::string_view appName, Fn fn) const {
+        App* app = lookup(appName);
+        if (app == nullptr) {
+            return false;
+        }
+        if (spill != nullptr) {
+            touch(app);
+        }
+        if (app->getGroupSet() == PermissionGroups::kNoGroups && timedGrants.empty()) {
+            app->forEachPermission(fn);
+            return true;
+        }
+        PermissionSet effective = app->getPermissionSet();
+        if (!timedGrants.empty()) {
+            dropTimedGrants(app, effective, expiryTicks(expiryClock()));
+        }
+        effective |= groups.effective(app->getGroupSet());
+        const PermissionRegistry& registry = PermissionRegistry::instance();
+        effective.forEach([&](PermissionId id) { fn(std::string_view(registry.name(id))); });
+        return true;
+    }
+
     /******************************************************************************
      *                  Name: listAppPermissions
-     *                  Description: Returns a list of permissions for the specified app
-     *                  Arguments: const std::string& appName - Name of the app
-     *                  Returns: std::vector<std::string> - List of permissions
+     *                  Description: Returns a list of permissions for the specified app,
+     *                               sorted by name so it is the same in every run
+     *                  Arguments: std::string_view appName - Name of the app
+     *                  Returns: std::vector<std::string> - List of permissions, sorted
+     *****************************************************************************/
+    std::vector<std::string> listAppPermissions(std::string_view appName) const;
+
+    /******************************************************************************
+     *                  Name: hasPermission
+     *                  Description: Checks whether an app holds a permission without
+     *                               copying its permission list
+     *                  Arguments: std::string_view appName - Name of the app
+     *                             std::string_view permission - Permission to check
+     *                  Returns: bool - True if the app is installed and holds the permission
+     *****************************************************************************/
+    bool hasPermission(std::string_view appName, std::string_view permission) const;
+
+    /******************************************************************************
+     *                  Name: appsWithPermission
+     *                  Description: Returns every installed app holding a permission,
+     *                               itself or through a group, answered from the
+     *                               reverse indexes of permissions and groups
+     *                  Arguments: std::string_view permission - Permission to look up
+     *                  Returns: std::vector<std::string> - Sorted names of the holders
+     *****************************************************************************/
+    std::vector<std::string> appsWithPermission(std::string_view permission) const;
+
+    /******************************************************************************
+     *                  Name: forEachAppWithPermission
+     *                  Description: Calls fn(std::string_view) once for every installed
+     *                               app holding a permission, itself or through a
+     *                               group, in no particular order and without
+     *                               allocating; for sweeps that do not need the
+     *                               sorted list. Expired timed grants are skipped.
+     *                  Arguments: std::string_view permission - Permission to look up
+     *                             Fn fn - Callback invoked per app name
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEachAppWithPermission(std::string_view permission, Fn fn) const {
+        drainBase();
+        PermissionId id;
+        if (!PermissionRegistry::instance().find(permission, id)) {
+            return;
+        }
+        const RoaringBitmap* direct = id < permissionHolders.size() ? &permissionHolders[id] : nullptr;
+        if (direct != nullptr) {
+            direct->forEach([&](std::uint32_t appId) {
+                const App* app = appSlots[appId];
+                if (!grantExpired(app, id)) {
+                    fn(std::string_view(app->getAppName()));
+                }
+            });
+        }
+        for (GroupId group = 0; group < groupHolders.size(); ++group) {
+            if (groupHolders[group].empty() || !groups.mask(group).contains(id)) {
+                continue;
+            }
+            groupHolders[group].forEach([&](std::uint32_t appId) {
+                const App* app = appSlots[appId];
+                if (direct != nullptr && direct->contains(appId) && !grantExpired(app, id)) {
+                    return;
+                }
+                for (GroupId earlier = 0; earlier < group; ++earlier) {
+                    if (groups.mask(earlier).contains(id) && groupHolders[earlier].contains(appId)) {
+                        return;
+                    }
+                }
+                fn(std::string_view(app->getAppName()));
+            });
+        }
+    }
+
+    /******************************************************************************
+     *                  Name: applyBatch
+     *                  Description: Applies a batch of operations all-or-nothing. The
+     *                               operations are grouped by app so each app is looked
+     *                               up once, validated in a first pass and applied in a
+     *                               second. Operations on the same app keep their order.
+     *                               Nothing is printed.
+     *                  Arguments: const AppBatch& batch - Operations to apply
+     *                  Returns: std::vector<OpStatus> - One status per operation. If any
+     *                           entry is a failure, no operation was applied and the
+     *                           valid ones report NotApplied.
+     *****************************************************************************/
+    std::vector<OpStatus> applyBatch(const AppBatch& batch);
+
+    /******************************************************************************
+     *                  Name: saveSnapshot
+     *                  Description: Writes every app and its permissions to a binary
+     *                               snapshot file (see Snapshot.h for the format)
+     *                  Arguments: const std::string& path - Destination file
+     *                  Returns: bool - True on success
+     *****************************************************************************/
+    bool saveSnapshot(const std::string& path) const;
+
+    /******************************************************************************
+     *                  Name: loadSnapshot
+     *                  Description: Replaces the registry with the contents of a snapshot
+     *                               file. The file is memory-mapped and only its
+     *                               header, permission table and groups are read up
+     *                               front; an app is copied out of the mapping the
+     *                               first time it is looked up or changed, and every
+     *                               remaining one the first time the whole registry
+     *                               is read (listing, search, queries, export, save).
+     *                               Startup therefore costs the pages touched, not
+     *                               the number of apps, unless the Merkle, bitmap or
+     *                               snapshot-read index is enabled, as those are
+     *                               built from every app at once. On any error the
+     *                               registry is left unchanged.
+     *                  Arguments: const std::string& path - Snapshot file
+     *                             bool verifyChecksum - Also hash the whole file first,
+     *                                                   which reads every page
+     *                  Returns: bool - True if the snapshot was loaded
+     *****************************************************************************/
+    bool loadSnapshot(const std::string& path, bool verifyChecksum = false);
+
+    /******************************************************************************
+     *                  Name: attachJournal
+     *                  Description: Starts recording successful installs, uninstalls,
+     *                               grants, revokes, group definitions and group
+     *                               assignments to a write-ahead journal; nullptr
+     *                               stops recording. Timed grants are not recorded,
+     *                               as they are not durable.
+     *                  Arguments: std::shared_ptr<Journal> journal - Open journal
+     *                  Returns: None
+     *****************************************************************************/
+    void attachJournal(std::shared_ptr<Journal> journal);
+
+    /******************************************************************************
+     *                  Name: applyRecord
+     *                  Description: Applies one journal record through the matching
+     *                               public call, as replaying a journal does
+     *                  Arguments: const JournalRecord& record - Record read from a journal
+     *                  Returns: OpStatus - Outcome of the operation
+     *****************************************************************************/
+    OpStatus applyRecord(const JournalRecord& record);
+
+    /******************************************************************************
+     *                  Name: checkpoint
+     *                  Description: Saves a snapshot and then empties the attached
+     *                               journal, whose records the snapshot now holds
+     *                  Arguments: const std::string& snapshotPath - Snapshot file
+     *                  Returns: bool - True on success
+     *****************************************************************************/
+    bool checkpoint(const std::string& snapshotPath);
+
+    /******************************************************************************
+     *                  Name: recover
+     *                  Description: Rebuilds the registry after a restart: loads the
+     *                               snapshot if one exists, replays the journal on top
+     *                               (dropping a torn tail), then compacts both into a
+     *                               fresh snapshot and an empty journal. Replay is safe
+     *                               after a crash between snapshot and truncation
+     *                               because every journaled operation is idempotent
+     *                               when the sequence is applied again.
+     *                  Arguments: const std::string& snapshotPath - Snapshot file
+     *                             const std::string& journalPath - Journal file
+     *                  Returns: bool - False if the snapshot exists but is invalid, or
+     *                           the compacted state could not be written
+     *****************************************************************************/
+    bool recover(const std::string& snapshotPath, const std::string& journalPath);
+
+    /******************************************************************************
+     *                  Name: importFrom
+     *                  Description: Streams app records in JSON Lines or CSV into the
+     *                               registry. Each record installs its app if needed
+     *                               and grants its permissions, with the same journal,
+     *                               change stream, history and index updates as
+     *                               installApp and assignPermission, but without a
+     *                               log message per record. Malformed records are
+     *                               counted and skipped. Memory stays bounded by the
+     *                               read buffer whatever the input size.
+     *                  Arguments: std::istream& input - Record stream
+     *                             RecordFormat format - JsonLines or Csv
+     *                             ImportStats* stats - Receives the totals, may be null
+     *                  Returns: bool - False if the input could not be read; records
+     *                           before the failure stay applied
+     *****************************************************************************/
+    bool importFrom(std::istream& input, RecordFormat format, ImportStats* stats = nullptr);
+
+    /******************************************************************************
+     *                  Name: importFrom
+     *                  Description: Same as above, reading from a file descriptor such
+     *                               as a pipe or socket
+     *                  Arguments: int fd - Open descriptor; not closed
+     *                             RecordFormat format - JsonLines or Csv
+     *                             ImportStats* stats - Receives the totals, may be null
+     *                  Returns: bool - False if the input could not be read
+     *****************************************************************************/
+    bool importFrom(int fd, RecordFormat format, ImportStats* stats = nullptr);
+
+    /******************************************************************************
+     *                  Name: exportTo
+     *                  Description: Writes one record per app, in name order, with the
+     *                               app's direct permissions; group grants are not
+     *                               included. Apps are formatted straight from the
+     *                               name trie into a fixed-size buffer, so no list of
+     *                               apps is built.
+     *                  Arguments: std::ostream& output - Destination stream
+     *                             RecordFormat format - JsonLines or Csv
+     *                  Returns: bool - False if a write failed
+     *****************************************************************************/
+    bool exportTo(std::ostream& output, RecordFormat format) const;
+
+    /******************************************************************************
+     *                  Name: exportTo
+     *                  Description: Same as above, writing to a file descriptor
+     *                  Arguments: int fd - Open descriptor; not closed
+     *                             RecordFormat format - JsonLines or Csv
+     *                  Returns: bool - False if a write failed
+     *****************************************************************************/
+    bool exportTo(int fd, RecordFormat format) const;
+
+    /******************************************************************************
+     *                  Name: attachMetrics
+     *                  Description: Starts counting and timing every operation into a
+     *                               collector, which may be shared with other managers;
+     *                               nullptr stops it. Without a collector an operation
+     *                               costs one extra branch, and with MOBILEAPP_METRICS=0
+     *                               nothing at all.
+     *                  Arguments: std::shared_ptr<OperationMetrics> metrics - Collector
+     *                  Returns: None
+     *****************************************************************************/
+    void attachMetrics(std::shared_ptr<OperationMetrics> metrics);
+
+    /******************************************************************************
+     *                  Name: stats
+     *                  Description: Returns the counters and latency histograms of the
+     *                               attached collector; see toPrometheus() for export
+     *                  Arguments: None
+     *                  Returns: MetricsSnapshot - Totals per operation and outcome
+     *****************************************************************************/
+    MetricsSnapshot stats() const;
+
+    /******************************************************************************
+     *                  Name: attachChangeStream
+     *                  Description: Publishes every change of state (install,
+     *                               uninstall, new grant, actual revoke) to a stream,
+     *                               which may be shared with other managers; nullptr
+     *                               stops it. Redundant grants and revokes of absent
+     *                               permissions publish nothing. Loading a snapshot or
+     *                               recovering publishes a single Reset.
+     *                  Arguments: std::shared_ptr<ChangeStream> stream - Stream to publish to
+     *                  Returns: None
+     *****************************************************************************/
+    void attachChangeStream(std::shared_ptr<ChangeStream> stream);
+
+    /******************************************************************************
+     *                  Name: attachHistory
+     *                  Description: Records every new direct grant and every actual
+     *                               revoke, including the implicit revokes of an
+     *                               uninstall, in a history store; nullptr stops it.
+     *                               Group membership, snapshot loads and recovery
+     *                               are not recorded.
+     *                  Arguments: std::shared_ptr<PermissionHistory> history - Store to record in
+     *                  Returns: None
+     *****************************************************************************/
+    void attachHistory(std::shared_ptr<PermissionHistory> history);
+
+    /******************************************************************************
+     *                  Name: enableSnapshotReads
+     *                  Description: Starts keeping a multi-version copy of the registry
+     *                               for readSnapshot(). Each later mutation then also
+     *                               copies the O(log n) tree nodes on its path and
+     *                               publishes a new version; a batch publishes once.
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void enableSnapshotReads();
+
+    /******************************************************************************
+     *                  Name: readSnapshot
+     *                  Description: Returns a point-in-time view of every app and its
+     *                               effective permissions that can be iterated for as
+     *                               long as needed without blocking mutations. Unlike
+     *                               the other members, it may be called from any
+     *                               thread while another thread mutates the manager.
+     *                               The snapshot must not outlive the manager.
+     *                  Arguments: None
+     *                  Returns: AppMapSnapshot - Pinned version; empty unless
+     *                           enableSnapshotReads() was called
+     *****************************************************************************/
+    AppMapSnapshot readSnapshot() const;
+
+    /******************************************************************************
+     *                  Name: enableMerkleIndex
+     *                  Description: Starts maintaining a hash tree over the apps so
+     *                               diff() only visits the parts of two registries
+     *                               that differ. Each later mutation costs a few
+     *                               extra additions.
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void enableMerkleIndex();
+
+    /******************************************************************************
+     *                  Name: diff
+     *                  Description: Computes the minimal change set turning this
+     *                               registry into target: installs (with the new
+     *                               app's grants), uninstalls, and the grants and
+     *                               revokes of apps present in both. Direct
+     *                               permissions are compared; groups are not. When
+     *                               both managers have the Merkle index enabled only
+     *                               differing leaves are compared, otherwise every
+     *                               app is. Apply the result with applyBatch().
+     *                  Arguments: const MobileAppManager& target - Desired state
+     *                  Returns: AppBatch - Operations, empty if the states are equal
+     *****************************************************************************/
+    AppBatch diff(const MobileAppManager& target) const;
+
+    /******************************************************************************
+     *                  Name: enableBitmapIndex
+     *                  Description: Starts maintaining a compressed bitmap of app ids
+     *                               per permission and per group, so queryPermissions()
+     *                               combines whole bitmaps instead of visiting apps.
+     *                               Each later grant, revoke or group change sets or
+     *                               clears one bit.
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void enableBitmapIndex();
+
+    /******************************************************************************
+     *                  Name: queryPermissions
+     *                  Description: Finds the installed apps whose effective
+     *                               permissions, direct or through groups, satisfy a
+     *                               boolean expression. Without enableBitmapIndex() a
+     *                               temporary index is built for the call.
+     *                  Arguments: const PermissionQuery& query - Parsed expression
+     *                  Returns: PermissionQueryResult - Matching apps; valid until the
+     *                           next mutation
+     *****************************************************************************/
+    PermissionQueryResult queryPermissions(const PermissionQuery& query) const;
+
+    /******************************************************************************
+     *                  Name: freeze
+     *                  Description: Compiles the installed apps and their effective
+     *                               permissions into an immutable registry that any
+     *                               number of threads can read without locks. Later
+     *                               changes to this manager do not affect it.
+     *                  Arguments: FrozenAppRegistry& frozen - Receives the registry
+     *                  Returns: bool - False if the perfect hash could not be built
+     *****************************************************************************/
+    bool freeze(FrozenAppRegistry& frozen) const;
+
+    /******************************************************************************
+     *                  Name: appPoolStats
+     *                  Description: Returns the occupancy counters of the pool holding
+     *                               the App objects
+     *                  Arguments: None
+     *                  Returns: PoolStats - Live objects, high-water mark and slab usage
+     *****************************************************************************/
+    PoolStats appPoolStats() const;
+
+    /******************************************************************************
+     *                  Name: memoryUsage
+     *                  Description: Walks the registry's structures and reports the
+     *                               bytes each holds. Costs time linear in the apps
+     *                               and grants.
+     *                  Arguments: None
+     *                  Returns: MemoryUsage - Breakdown by structure
+     *****************************************************************************/
+    MemoryUsage memoryUsage() const;
+
+    /******************************************************************************
+     *                  Name: setPermissionOverflowBudget
+     *                  Description: Bounds the heap held by permission IDs past the
+     *                               inline bitset, which registries interning more than
+     *                               PermissionSet::kInlineBits permissions keep per app;
+     *                               reported as MemoryUsage::overflow. It is not a cap
+     *                               on the registry: names, App records, the inline
+     *                               bitsets and the name and reverse indexes stay in
+     *                               memory. Once the resident overflow passes the
+     *                               budget, the least recently used apps with overflow
+     *                               have their permissions moved to a file until it is
+     *                               back under three quarters of the budget. The
+     *                               resident overflow is kept current by every grant and
+     *                               uninstall, so checking it costs nothing. Any access
+     *                               to an evicted app reads it back in; resident apps
+     *                               see no extra cost beyond a stamp. Whole-registry
+     *                               reads such as diff, freeze and saveSnapshot read
+     *                               evicted apps through without loading them. With a
+     *                               budget set, reads update access stamps, so the
+     *                               manager must not be shared by concurrent readers. A
+     *                               budget of 0 reloads every evicted app and removes
+     *                               the bound.
+     *                  Arguments: std::size_t bytes - Budget, 0 for none
+     *                             const std::string& spillPath - File for evicted apps;
+     *                                                            truncated when opened
+     *                  Returns: bool - False if the spill file could not be opened; the
+     *                           registry is then left fully loaded with no budget
+     *****************************************************************************/
+    bool setPermissionOverflowBudget(std::size_t bytes, const std::string& spillPath);
+
+    /******************************************************************************
+     *                  Name: expireGrants
+     *                  Description: Revokes every timed grant whose deadline the expiry
+     *                               clock has reached. Mutations run it themselves
+     *                               once a deadline has passed, and point reads skip
+     *                               expired grants, so it is only needed to bring
+     *                               whole-registry reads such as queries, diff and
+     *                               freeze up to date, or to free expired grants
+     *                               while the registry is idle. Costs nothing when
+     *                               no deadline has passed, however many are pending.
+     *                               Expiries are recorded in history and the change
+     *                               stream but not journaled.
+     *                  Arguments: None
+     *                  Returns: std::size_t - Grants revoked
+     *****************************************************************************/
+    std::size_t expireGrants();
+
+    /******************************************************************************
+     *                  Name: nextExpiry
+     *                  Description: Returns when expireGrants may next have work; never
+     *                               later than the earliest pending deadline
+     *                  Arguments: None
+     *                  Returns: ExpiryClock::time_point - Time, or time_point::max()
+     *                           if no timed grant is pending
+     *****************************************************************************/
+    ExpiryClock::time_point nextExpiry() const;
+
+    /******************************************************************************
+     *                  Name: pendingExpiries
+     *                  Description: Returns the number of timed grants not yet revoked
+     *                  Arguments: None
+     *                  Returns: std::size_t - Timed grants
      *****************************************************************************/
-    std::vector<std::string> listAppPermissions(const std::string& appName) const;
+    std::size_t pendingExpiries() const;
+
+    /******************************************************************************
+     *                  Name: setExpiryClock
+     *                  Description: Replaces the clock deadlines are checked against,
+     *                               for tests and simulations; must not go backwards
+     *                  Arguments: std::function<ExpiryClock::time_point()> clock - Clock
+     *                  Returns: None
+     *****************************************************************************/
+    void setExpiryClock(std::function<ExpiryClock::time_point()> clock);
+
+    /******************************************************************************
+     *                  Name: setLogSink
+     *                  Description: Replaces the sink operations log to
+     *                  Arguments: std::shared_ptr<LogSink> sink - New log destination
+     *                  Returns: None
+     *****************************************************************************/
+    void setLogSink(std::shared_ptr<LogSink> sink);
 
 private:
-    std::map<std::string, App*> installedApps; // Map to store installed apps with their names as keys
+    /******************************************************************************
+     *                  Structure Definition: TimedGrant
+     *                  Description: A permission of an app that expires
+     *****************************************************************************/
+    struct TimedGrant {
+        const App* app = nullptr;   // Holder; the entry goes before the app does
+        PermissionId id = 0;        // The permission
+
+        bool operator==(const TimedGrant& other) const { return app == other.app && id == other.id; }
+    };
+
+    struct TimedGrantHash {
+        std::size_t operator()(const TimedGrant& grant) const {
+            return std::hash<const App*>{}(grant.app) ^ (std::size_t(grant.id) * 0x9e3779b97f4a7c15ULL);
+        }
+    };
+
+    App* createApp(std::string_view appName) const;
+    void destroyApp(App* app) const;
+    void indexName(App* app) const;
+    void unindexName(const App* app);
+    void clearApps();
+    void loadGroups(const SnapshotView& view);
+    App* lookup(std::string_view appName) const;
+    App* materialize(std::size_t index) const;
+    void drainBase() const;
+    bool importRecords(RecordReader& reader, ImportStats* stats);
+    bool exportRecords(RecordWriter& writer) const;
+    void log(LogLevel level, std::initializer_list<std::string_view> parts) const;
+    void journalOp(JournalRecordType type, std::string_view appName, std::string_view permission = std::string_view());
+    void publishChange(ChangeType type, std::string_view appName, std::string_view permission = std::string_view());
+    void recordHistory(std::string_view appName, PermissionId permission, HistoryOp op);
+    bool addPermission(App* app, PermissionId id);
+    void unindexPermission(PermissionId id, const App* app);
+    void unindexGroup(GroupId group, const App* app);
+    void unindexApp(const App& app);
+    void stageVersion(std::string_view appName, const App* app);
+    void publishVersion();
+    void rebuildVersions();
+    std::vector<PermissionSet> groupMasks() const;
+    void touch(App* app) const;
+    bool evict(App* app) const;
+    void fault(App* app) const;
+    void enforceBudget() const;
+    const PermissionSet& permissionsOf(const App* app, PermissionSet& scratch) const;
+    static std::size_t overflowBytes(const PermissionSet& permissions);
+    static std::uint64_t expiryTicks(ExpiryClock::time_point time);
+    void expireDue();
+    void revokeExpired(const TimedGrant& grant);
+    void cancelExpiry(const App* app, PermissionId id);
+    void cancelExpiries(const App* app);
+    bool grantExpired(const App* app, PermissionId id) const;
+    void dropTimedGrants(const App* app, PermissionSet& permissions, std::uint64_t expiredBy) const;
+    const PermissionSet& durablePermissionsOf(const App* app, PermissionSet& scratch) const;
+
+    // The app containers are mutable because reads copy apps out of a loaded snapshot
+    mutable ObjectPool<App> appPool;                       // Owns every App; the index holds borrowed pointers
+    mutable AppIndex installedApps;                        // Hash index of installed apps by name
+    mutable AppTrie appNames;                              // Installed apps in name order, for listing and prefixes
+    mutable AppGramIndex appGrams;                         // Trigram index for substring search
+    mutable PermissionGroups groups;                       // Group and role definitions, app group sets
+    mutable std::vector<App*> appSlots;                    // Dense app id -> app; null for free ids
+    mutable std::vector<std::uint32_t> freeAppIds;         // Ids of uninstalled apps, reused first
+    mutable std::vector<RoaringBitmap> groupHolders;       // Reverse index: GroupId -> ids of member apps
+    mutable std::vector<RoaringBitmap> permissionHolders;  // Reverse index: PermissionId -> ids of apps granted it
+    mutable std::unique_ptr<SnapshotView> base;            // Loaded snapshot still holding apps not copied out; may be null
+    mutable std::unordered_set<std::size_t> baseTaken;     // Positions in base already copied out
+    mutable std::vector<PermissionId> baseIds;             // Permission table index in base -> PermissionId
+    std::shared_ptr<LogSink> logSink;                      // Destination for operation messages
+    std::shared_ptr<Journal> journal;                      // Write-ahead journal, may be null
+    std::shared_ptr<OperationMetrics> metrics;             // Operation metrics, may be null
+    std::shared_ptr<ChangeStream> changes;                 // Change event stream, may be null
+    std::shared_ptr<PermissionHistory> history;            // Grant/revoke history, may be null
+    std::unique_ptr<MerkleIndex> merkle;                   // Hash tree for diff(), may be null
+    std::unique_ptr<PermissionBitmapIndex> bitmaps;        // Bitmaps for queryPermissions(), may be null
+    std::unique_ptr<VersionedAppMap> versions;             // Multi-version copy for snapshot reads, may be null
+    std::unique_ptr<AppSpillStore> spill;                  // Permissions of evicted apps, null without a budget
+    std::size_t overflowBudget = 0;                        // Overflow bytes allowed before evicting; 0 for no bound
+    mutable std::size_t residentOverflow = 0;              // Permission overflow bytes of resident apps
+    mutable std::uint32_t accessClock = App::kEvicted;     // Last access tick handed out
+    TimerWheel<TimedGrant> expiryWheel;                    // Deadlines of timed grants, in milliseconds
+    std::unordered_map<TimedGrant, TimerWheel<TimedGrant>::TimerId, TimedGrantHash> timedGrants;   // Timer of each timed grant
+    std::function<ExpiryClock::time_point()> expiryClock = ExpiryClock::now;   // Clock deadlines are checked against
 };
 
 #endif
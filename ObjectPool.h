@@ -0,0 +1,139 @@
+
+/******************************************************************************
+ *                    File Name: ObjectPool.h
+ *                    Description: Header file for ObjectPool, a slab allocator with
+ *                                 freelist reuse for fixed-type objects
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __OBJECT_POOL_H__
+#define __OBJECT_POOL_H__
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/******************************************************************************
+ *                  Structure Definition: PoolStats
+ *                  Description: Occupancy counters of an ObjectPool
+ *****************************************************************************/
+
+struct PoolStats {
+    std::size_t live = 0;           // Objects currently constructed
+    std::size_t highWaterMark = 0;  // Most objects ever live at once
+    std::size_t capacity = 0;       // Slots across all slabs
+    std::size_t slabs = 0;          // Slabs allocated
+    std::size_t bytesReserved = 0;  // Bytes held by the slabs
+};
+
+/******************************************************************************
+ *                  Class Definition: ObjectPool
+ *                  Description: Hands out T objects from slabs of kSlabSize
+ *                               contiguous slots. Destroyed slots go onto an
+ *                               intrusive freelist and are reused before any new
+ *                               slab is allocated, so churn never returns memory
+ *                               to the heap piecemeal. Slabs are released when the
+ *                               pool is destroyed; every object must have been
+ *                               destroyed first. Not thread-safe.
+ *****************************************************************************/
+
+template <typename T, std::size_t kSlabSize = 256>
+class ObjectPool {
+public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /******************************************************************************
+     *                  Name: create
+     *                  Description: Constructs a T in a free slot
+     *                  Arguments: Args&&... args - Constructor arguments
+     *                  Returns: T* - The new object, owned by the pool
+     *****************************************************************************/
+    template <typename... Args>
+    T* create(Args&&... args) {
+        if (freeList == nullptr) {
+            addSlab();
+        }
+        Slot* slot = freeList;
+        freeList = slot->next;  // Read the link before the object overwrites it
+        T* object = new (slot->storage) T(std::forward<Args>(args)...);
+        if (++counters.live > counters.highWaterMark) {
+            counters.highWaterMark = counters.live;
+        }
+        return object;
+    }
+
+    /******************************************************************************
+     *                  Name: destroy
+     *                  Description: Destructs an object and puts its slot on the freelist
+     *                  Arguments: T* object - Object returned by create()
+     *                  Returns: None
+     *****************************************************************************/
+    void destroy(T* object) {
+        object->~T();
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        slot->next = freeList;
+        freeList = slot;
+        --counters.live;
+    }
+
+    /******************************************************************************
+     *                  Name: reserve
+     *                  Description: Allocates slabs up front for a known object count
+     *                  Arguments: std::size_t count - Objects expected to be live
+     *                  Returns: None
+     *****************************************************************************/
+    void reserve(std::size_t count) {
+        while (counters.capacity < count) {
+            addSlab();
+        }
+    }
+
+    /******************************************************************************
+     *                  Name: stats
+     *                  Description: Returns the pool's occupancy counters
+     *                  Arguments: None
+     *                  Returns: PoolStats - Current counters
+     *****************************************************************************/
+    PoolStats stats() const {
+        return counters;
+    }
+
+private:
+    /******************************************************************************
+     *                  Union Definition: Slot
+     *                  Description: Storage for one T, or the freelist link while free
+     *****************************************************************************/
+    union Slot {
+        Slot* next;                                    // Next free slot
+        alignas(T) unsigned char storage[sizeof(T)];   // Object storage while live
+    };
+
+    void addSlab() {
+        slabs.emplace_back(new Slot[kSlabSize]);
+        Slot* slab = slabs.back().get();
+        for (std::size_t i = kSlabSize; i-- > 0;) {   // Hand out low addresses first
+            slab[i].next = freeList;
+            freeList = &slab[i];
+        }
+        counters.capacity += kSlabSize;
+        counters.slabs = slabs.size();
+        counters.bytesReserved = slabs.size() * kSlabSize * sizeof(Slot);
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> slabs;  // Owned slot arrays
+    Slot* freeList = nullptr;                     // Head of the free slot list
+    PoolStats counters;                           // Occupancy counters
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,39 @@
+
+/******************************************************************************
+ *                    File Name: OpStatus.h
+ *                    Description: Header file for the status codes reported by
+ *                                 registry operations
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __OP_STATUS_H__
+#define __OP_STATUS_H__
+
+#include <cstdint>
+
+/******************************************************************************
+ *                  Enum Definition: OpStatus
+ *                  Description: Outcome of a single registry operation
+ *****************************************************************************/
+
+enum class OpStatus : std::uint8_t {
+    Ok,                 // Operation applied
+    InvalidAppName,     // App name was empty
+    InvalidPermission,  // Permission name was empty
+    AppExists,          // Install of an app that is already installed
+    AppNotFound,        // Operation on an app that is not installed
+    GroupNotFound,      // Operation naming a permission group that is not defined
+    GroupCycle,         // Group definition that would include the group itself
+    DeviceNotFound,     // Fleet operation on a device that is not registered
+    DeviceExists,       // Fleet registration of a device that is already registered
+    NotApplied          // Valid, but skipped because another operation in the batch failed
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,269 @@
+
+/******************************************************************************
+ *                    File Name: PermissionGroups.cpp
+ *                    Description: Implementation file for permission groups and roles
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "PermissionGroups.h"
+#include <algorithm>  // For std::sort, std::unique, std::find, std::lower_bound
+#include <utility>    // For std::move, std::pair
+
+/******************************************************************************
+ *                  Constructor: PermissionGroups
+ *                  Description: Creates the empty group set at kNoGroups
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+PermissionGroups::PermissionGroups() : sets(1) {}
+
+/******************************************************************************
+ *                  Name: define
+ *                  Description: Resolves and checks the includes, replaces the
+ *                               definition, then recompiles the group and everything
+ *                               that includes it in dependency order, followed by
+ *                               the group sets containing any of them
+ *                  Arguments: std::string_view name - Group name
+ *                             const std::vector<std::string_view>& permissions - Permissions
+ *                             const std::vector<std::string_view>& includes - Included groups
+ *                  Returns: DefineResult - Ok, UnknownInclude or Cycle
+ *****************************************************************************/
+PermissionGroups::DefineResult PermissionGroups::define(std::string_view name,
+                                                        const std::vector<std::string_view>& permissions,
+                                                        const std::vector<std::string_view>& includes) {
+    std::vector<GroupId> includeIds;
+    includeIds.reserve(includes.size());
+    for (std::string_view include : includes) {
+        GroupId includeId;
+        if (!find(include, includeId)) {
+            return DefineResult::UnknownInclude;
+        }
+        includeIds.push_back(includeId);
+    }
+    GroupId id;
+    bool exists = find(name, id);
+    if (exists) {
+        for (GroupId include : includeIds) {
+            if (reaches(include, id)) {
+                return DefineResult::Cycle;
+            }
+        }
+    }
+    std::sort(includeIds.begin(), includeIds.end());
+    includeIds.erase(std::unique(includeIds.begin(), includeIds.end()), includeIds.end());
+
+    if (!exists) {
+        id = static_cast<GroupId>(groups.size());
+        groups.emplace_back();
+        groups.back().name.assign(name.data(), name.size());
+        ids.emplace(std::string_view(groups.back().name), id);
+    }
+    Group& group = groups[id];
+    for (GroupId include : group.includes) {
+        std::vector<GroupId>& parents = groups[include].includedBy;
+        parents.erase(std::find(parents.begin(), parents.end(), id));
+    }
+    group.includes = std::move(includeIds);
+    for (GroupId include : group.includes) {
+        groups[include].includedBy.push_back(id);
+    }
+    group.permissions.clear();
+    PermissionRegistry& registry = PermissionRegistry::instance();
+    for (std::string_view permission : permissions) {
+        group.permissions.insert(registry.intern(permission));
+    }
+
+    // Post-order over includedBy lists each group after all groups including it;
+    // reversed, every group is compiled before the groups that include it
+    std::vector<bool> affected(groups.size(), false);
+    std::vector<GroupId> order;
+    std::vector<std::pair<GroupId, std::size_t>> stack{{id, 0}};
+    affected[id] = true;
+    while (!stack.empty()) {
+        auto& [current, next] = stack.back();
+        const std::vector<GroupId>& parents = groups[current].includedBy;
+        if (next < parents.size()) {
+            GroupId parent = parents[next++];
+            if (!affected[parent]) {
+                affected[parent] = true;
+                stack.emplace_back(parent, 0);
+            }
+        } else {
+            order.push_back(current);
+            stack.pop_back();
+        }
+    }
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        compile(*it);
+    }
+
+    for (GroupSet& set : sets) {
+        if (std::any_of(set.groups.begin(), set.groups.end(), [&](GroupId member) { return affected[member]; })) {
+            compileSet(set);
+        }
+    }
+    return DefineResult::Ok;
+}
+
+/******************************************************************************
+ *                  Name: find
+ *                  Description: Looks up a group by name
+ *                  Arguments: std::string_view name - Group name
+ *                             GroupId& id - Receives the id when found
+ *                  Returns: bool - True if the group is defined
+ *****************************************************************************/
+bool PermissionGroups::find(std::string_view name, GroupId& id) const {
+    auto it = ids.find(name);
+    if (it == ids.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: join
+ *                  Description: Interns the set's groups plus one
+ *                  Arguments: GroupSetId set - Current set, which the caller holds
+ *                             GroupId group - Group to add
+ *                  Returns: GroupSetId - New set
+ *****************************************************************************/
+GroupSetId PermissionGroups::join(GroupSetId set, GroupId group) {
+    std::vector<GroupId> members = sets[set].groups;
+    auto it = std::lower_bound(members.begin(), members.end(), group);
+    if (it != members.end() && *it == group) {
+        return set;
+    }
+    members.insert(it, group);
+    GroupSetId joined = acquire(std::move(members));
+    release(set);
+    return joined;
+}
+
+/******************************************************************************
+ *                  Name: leave
+ *                  Description: Interns the set's groups minus one
+ *                  Arguments: GroupSetId set - Current set, which the caller holds
+ *                             GroupId group - Group to remove
+ *                  Returns: GroupSetId - New set
+ *****************************************************************************/
+GroupSetId PermissionGroups::leave(GroupSetId set, GroupId group) {
+    std::vector<GroupId> members = sets[set].groups;
+    auto it = std::lower_bound(members.begin(), members.end(), group);
+    if (it == members.end() || *it != group) {
+        return set;
+    }
+    members.erase(it);
+    GroupSetId left = acquire(std::move(members));
+    release(set);
+    return left;
+}
+
+/******************************************************************************
+ *                  Name: release
+ *                  Description: Drops a reference, freeing the slot with the last one
+ *                  Arguments: GroupSetId set - Set the caller holds
+ *                  Returns: None
+ *****************************************************************************/
+void PermissionGroups::release(GroupSetId set) {
+    if (set == kNoGroups || --sets[set].references != 0) {
+        return;
+    }
+    setIds.erase(sets[set].groups);
+    sets[set].groups.clear();
+    sets[set].mask.clear();
+    freeSets.push_back(set);
+}
+
+/******************************************************************************
+ *                  Name: reaches
+ *                  Description: Checks whether a group is, or includes directly or
+ *                               transitively, another group
+ *                  Arguments: GroupId from - Group to start at
+ *                             GroupId target - Group looked for
+ *                  Returns: bool - True if target is reachable through includes
+ *****************************************************************************/
+bool PermissionGroups::reaches(GroupId from, GroupId target) const {
+    std::vector<bool> visited(groups.size(), false);
+    std::vector<GroupId> pending{from};
+    while (!pending.empty()) {
+        GroupId current = pending.back();
+        pending.pop_back();
+        if (current == target) {
+            return true;
+        }
+        if (!visited[current]) {
+            visited[current] = true;
+            pending.insert(pending.end(), groups[current].includes.begin(), groups[current].includes.end());
+        }
+    }
+    return false;
+}
+
+/******************************************************************************
+ *                  Name: compile
+ *                  Description: Rebuilds a group's mask from its permissions and the
+ *                               already compiled masks of its includes
+ *                  Arguments: GroupId id - Group to compile
+ *                  Returns: None
+ *****************************************************************************/
+void PermissionGroups::compile(GroupId id) {
+    Group& group = groups[id];
+    group.mask = group.permissions;
+    for (GroupId include : group.includes) {
+        group.mask |= groups[include].mask;
+    }
+}
+
+/******************************************************************************
+ *                  Name: compileSet
+ *                  Description: Rebuilds a group set's mask from its groups' masks
+ *                  Arguments: GroupSet& set - Set to compile
+ *                  Returns: None
+ *****************************************************************************/
+void PermissionGroups::compileSet(GroupSet& set) const {
+    set.mask.clear();
+    for (GroupId member : set.groups) {
+        set.mask |= groups[member].mask;
+    }
+}
+
+/******************************************************************************
+ *                  Name: acquire
+ *                  Description: Returns the interned set with the given groups,
+ *                               creating and compiling it on first use, and takes
+ *                               a reference on it
+ *                  Arguments: std::vector<GroupId> members - Ascending group ids
+ *                  Returns: GroupSetId - The set
+ *****************************************************************************/
+GroupSetId PermissionGroups::acquire(std::vector<GroupId> members) {
+    if (members.empty()) {
+        return kNoGroups;
+    }
+    auto it = setIds.find(members);
+    if (it != setIds.end()) {
+        ++sets[it->second].references;
+        return it->second;
+    }
+    GroupSetId id;
+    if (!freeSets.empty()) {
+        id = freeSets.back();
+        freeSets.pop_back();
+    } else {
+        id = static_cast<GroupSetId>(sets.size());
+        sets.emplace_back();
+    }
+    GroupSet& set = sets[id];
+    set.groups = members;
+    set.references = 1;
+    compileSet(set);
+    setIds.emplace(std::move(members), id);
+    return id;
+}
+
+/******************************** End of File ********************************/
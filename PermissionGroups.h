@@ -0,0 +1,215 @@
+
+/******************************************************************************
+ *                    File Name: PermissionGroups.h
+ *                    Description: Header file for PermissionGroups, named permission
+ *                                 groups and roles compiled into permission masks
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __PERMISSION_GROUPS_H__
+#define __PERMISSION_GROUPS_H__
+
+#include "PermissionSet.h"
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using GroupId = std::uint32_t;      // Index of a group in its table
+using GroupSetId = std::uint32_t;   // Index of an interned combination of groups
+
+/******************************************************************************
+ *                  Class Definition: PermissionGroups
+ *                  Description: Table of named groups. A group lists permissions
+ *                               and may include other groups, which makes it a
+ *                               role; its mask (the union of all of them) is
+ *                               compiled when it is defined. Apps do not hold
+ *                               groups directly: each distinct combination of
+ *                               groups assigned to some app is interned once as a
+ *                               group set with its own precompiled mask, and the
+ *                               app keeps only the set's id. Effective permissions
+ *                               are then one OR of the app's own set and that
+ *                               mask. Redefining a group recompiles the groups
+ *                               including it and the group sets containing any of
+ *                               them, never the apps.
+ *****************************************************************************/
+
+class PermissionGroups {
+public:
+    static constexpr GroupSetId kNoGroups = 0;   // Group set of an app with no groups
+
+    enum class DefineResult { Ok, UnknownInclude, Cycle };
+
+    /******************************************************************************
+     *                  Name: PermissionGroups
+     *                  Description: Constructor creating the empty group set
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    PermissionGroups();
+
+    /******************************************************************************
+     *                  Name: define
+     *                  Description: Defines a group, or replaces the definition of an
+     *                               existing one, and recompiles every mask that
+     *                               depends on it
+     *                  Arguments: std::string_view name - Group name
+     *                             const std::vector<std::string_view>& permissions -
+     *                                 Permissions granted by the group
+     *                             const std::vector<std::string_view>& includes -
+     *                                 Groups whose permissions it also grants
+     *                  Returns: DefineResult - Ok; UnknownInclude if an included group
+     *                           is not defined; Cycle if the group would include
+     *                           itself. Nothing changes on failure.
+     *****************************************************************************/
+    DefineResult define(std::string_view name, const std::vector<std::string_view>& permissions,
+                        const std::vector<std::string_view>& includes);
+
+    /******************************************************************************
+     *                  Name: find
+     *                  Description: Looks up a group by name
+     *                  Arguments: std::string_view name - Group name
+     *                             GroupId& id - Receives the id when found
+     *                  Returns: bool - True if the group is defined
+     *****************************************************************************/
+    bool find(std::string_view name, GroupId& id) const;
+
+    /******************************************************************************
+     *                  Name: name
+     *                  Description: Returns the name of a group
+     *                  Arguments: GroupId id - Group id
+     *                  Returns: const std::string& - Group name
+     *****************************************************************************/
+    const std::string& name(GroupId id) const {
+        return groups[id].name;
+    }
+
+    /******************************************************************************
+     *                  Name: mask
+     *                  Description: Returns every permission a group grants, including
+     *                               those of the groups it includes
+     *                  Arguments: GroupId id - Group id
+     *                  Returns: const PermissionSet& - Compiled mask
+     *****************************************************************************/
+    const PermissionSet& mask(GroupId id) const {
+        return groups[id].mask;
+    }
+
+    /******************************************************************************
+     *                  Name: permissions
+     *                  Description: Returns the permissions listed in a group's definition
+     *                  Arguments: GroupId id - Group id
+     *                  Returns: const PermissionSet& - Listed permissions, without includes
+     *****************************************************************************/
+    const PermissionSet& permissions(GroupId id) const {
+        return groups[id].permissions;
+    }
+
+    /******************************************************************************
+     *                  Name: includes
+     *                  Description: Returns the groups listed in a group's definition
+     *                  Arguments: GroupId id - Group id
+     *                  Returns: const std::vector<GroupId>& - Ascending included group ids
+     *****************************************************************************/
+    const std::vector<GroupId>& includes(GroupId id) const {
+        return groups[id].includes;
+    }
+
+    /******************************************************************************
+     *                  Name: size
+     *                  Description: Returns the number of defined groups
+     *                  Arguments: None
+     *                  Returns: std::size_t - Group count
+     *****************************************************************************/
+    std::size_t size() const {
+        return groups.size();
+    }
+
+    /******************************************************************************
+     *                  Name: join
+     *                  Description: Returns the group set holding a set's groups plus
+     *                               one more, taking a reference on it and dropping
+     *                               the caller's reference on the old set
+     *                  Arguments: GroupSetId set - Current set, which the caller holds
+     *                             GroupId group - Group to add
+     *                  Returns: GroupSetId - New set; unchanged if it already held group
+     *****************************************************************************/
+    GroupSetId join(GroupSetId set, GroupId group);
+
+    /******************************************************************************
+     *                  Name: leave
+     *                  Description: Returns the group set holding a set's groups minus
+     *                               one, moving the caller's reference as join does
+     *                  Arguments: GroupSetId set - Current set, which the caller holds
+     *                             GroupId group - Group to remove
+     *                  Returns: GroupSetId - New set; unchanged if it did not hold group
+     *****************************************************************************/
+    GroupSetId leave(GroupSetId set, GroupId group);
+
+    /******************************************************************************
+     *                  Name: release
+     *                  Description: Drops a reference on a group set, freeing it with
+     *                               the last one
+     *                  Arguments: GroupSetId set - Set the caller holds
+     *                  Returns: None
+     *****************************************************************************/
+    void release(GroupSetId set);
+
+    /******************************************************************************
+     *                  Name: effective
+     *                  Description: Returns the union of the masks of a set's groups
+     *                  Arguments: GroupSetId set - Group set
+     *                  Returns: const PermissionSet& - Precompiled mask
+     *****************************************************************************/
+    const PermissionSet& effective(GroupSetId set) const {
+        return sets[set].mask;
+    }
+
+    /******************************************************************************
+     *                  Name: members
+     *                  Description: Returns the groups of a set
+     *                  Arguments: GroupSetId set - Group set
+     *                  Returns: const std::vector<GroupId>& - Ascending group ids
+     *****************************************************************************/
+    const std::vector<GroupId>& members(GroupSetId set) const {
+        return sets[set].groups;
+    }
+
+private:
+    struct Group {
+        std::string name;                  // Group name
+        PermissionSet permissions;         // Permissions listed in the definition
+        std::vector<GroupId> includes;     // Groups included by the definition
+        std::vector<GroupId> includedBy;   // Groups whose definition includes this one
+        PermissionSet mask;                // permissions plus the masks of includes
+    };
+
+    struct GroupSet {
+        std::vector<GroupId> groups;       // Ascending; empty for a free slot
+        PermissionSet mask;                // Union of the groups' masks
+        std::uint32_t references = 0;      // Apps holding the set
+    };
+
+    bool reaches(GroupId from, GroupId target) const;
+    void compile(GroupId id);
+    void compileSet(GroupSet& set) const;
+    GroupSetId acquire(std::vector<GroupId> members);
+
+    std::deque<Group> groups;                               // GroupId -> group, stable addresses
+    std::unordered_map<std::string_view, GroupId> ids;      // Name -> id, keys view into groups
+    std::vector<GroupSet> sets;                             // GroupSetId -> set; 0 is the empty set
+    std::map<std::vector<GroupId>, GroupSetId> setIds;      // Members -> interned set
+    std::vector<GroupSetId> freeSets;                       // Released slots for reuse
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,315 @@
+
+/******************************************************************************
+ *                    File Name: PermissionHistory.cpp
+ *                    Description: Implementation file for the permission history
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "PermissionHistory.h"
+#include <algorithm>  // For std::max, std::min, std::partition_point, std::sort
+#include <chrono>
+#include <set>
+
+namespace {
+
+/******************************************************************************
+ *                  Name: putVarint
+ *                  Description: Appends an unsigned LEB128 integer
+ *                  Arguments: std::string& out - Destination column
+ *                             std::uint64_t value - Value to encode
+ *                  Returns: None
+ *****************************************************************************/
+void putVarint(std::string& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+/******************************************************************************
+ *                  Name: getVarint
+ *                  Description: Decodes an unsigned LEB128 integer from a column
+ *                               written by putVarint
+ *                  Arguments: const char*& cursor - Read position, advanced past the value
+ *                  Returns: std::uint64_t - Decoded value
+ *****************************************************************************/
+std::uint64_t getVarint(const char*& cursor) {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0;; shift += 7) {
+        unsigned char byte = static_cast<unsigned char>(*cursor++);
+        value |= std::uint64_t(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+}
+
+/******************************************************************************
+ *                  Name: systemMicros
+ *                  Description: Default clock
+ *                  Arguments: None
+ *                  Returns: std::int64_t - Microseconds since the Unix epoch
+ *****************************************************************************/
+std::int64_t systemMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+}  // namespace
+
+/******************************************************************************
+ *                  Constructor: PermissionHistory
+ *                  Description: Stores the clock, defaulting to the system clock
+ *                  Arguments: Clock clock - Time source
+ *                  Returns: None
+ *****************************************************************************/
+PermissionHistory::PermissionHistory(Clock source) : clock(source ? std::move(source) : Clock(systemMicros)) {}
+
+/******************************************************************************
+ *                  Name: record
+ *                  Description: Stamps the event with the clock and appends it
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             PermissionId permission - Permission changed
+ *                             HistoryOp op - Grant or Revoke
+ *                  Returns: None
+ *****************************************************************************/
+void PermissionHistory::record(std::string_view appName, PermissionId permission, HistoryOp op) {
+    record(clock(), appName, permission, op);
+}
+
+/******************************************************************************
+ *                  Name: record
+ *                  Description: Appends to the open block's columns, opening a new
+ *                               block when the last one is full
+ *                  Arguments: std::int64_t timestamp - Microseconds since the epoch
+ *                             std::string_view appName - Name of the application
+ *                             PermissionId permission - Permission changed
+ *                             HistoryOp op - Grant or Revoke
+ *                  Returns: None
+ *****************************************************************************/
+void PermissionHistory::record(std::int64_t timestamp, std::string_view appName, PermissionId permission,
+                               HistoryOp op) {
+    std::uint32_t app = internApp(appName);
+    if (!blocks.empty()) {
+        timestamp = std::max(timestamp, blocks.back().maxTime);
+    }
+    if (blocks.empty() || blocks.back().count == kBlockEvents) {
+        if (!blocks.empty()) {
+            seal(blocks.back());
+        }
+        blocks.emplace_back();
+        blocks.back().minTime = timestamp;
+        blocks.back().maxTime = timestamp;
+    }
+    Block& block = blocks.back();
+    putVarint(block.times, static_cast<std::uint64_t>(timestamp - block.maxTime));
+    putVarint(block.apps, app);
+    putVarint(block.permissions, permission);
+    if (block.count % 64 == 0) {
+        block.ops.push_back(0);
+    }
+    if (op == HistoryOp::Revoke) {
+        block.ops.back() |= std::uint64_t(1) << (block.count % 64);
+    }
+    block.maxTime = timestamp;
+    block.minApp = std::min(block.minApp, app);
+    block.maxApp = std::max(block.maxApp, app);
+    block.minPermission = std::min(block.minPermission, permission);
+    block.maxPermission = std::max(block.maxPermission, permission);
+    ++block.count;
+    ++total;
+}
+
+/******************************************************************************
+ *                  Name: findApp
+ *                  Description: Looks up the history id of an app name
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             std::uint32_t& app - Receives the id
+ *                  Returns: bool - False if no event mentions the app
+ *****************************************************************************/
+bool PermissionHistory::findApp(std::string_view appName, std::uint32_t& app) const {
+    auto it = appIds.find(appName);
+    if (it == appIds.end()) {
+        return false;
+    }
+    app = it->second;
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: appName
+ *                  Description: Returns the name behind a history app id
+ *                  Arguments: std::uint32_t app - History app id
+ *                  Returns: const std::string& - App name
+ *****************************************************************************/
+const std::string& PermissionHistory::appName(std::uint32_t app) const {
+    return appNames[app];
+}
+
+/******************************************************************************
+ *                  Name: events
+ *                  Description: Collects the events matching the query
+ *                  Arguments: const HistoryQuery& query - Filter
+ *                  Returns: std::vector<HistoryEvent> - Events in recording order
+ *****************************************************************************/
+std::vector<HistoryEvent> PermissionHistory::events(const HistoryQuery& query) const {
+    std::vector<HistoryEvent> matched;
+    forEachEvent(query, [&](const HistoryEvent& event) { matched.push_back(event); });
+    return matched;
+}
+
+/******************************************************************************
+ *                  Name: heldDuring
+ *                  Description: Replays the permission's events up to to. The holders
+ *                               when the first event at or after from is reached
+ *                               held it at from; later grants add to them.
+ *                  Arguments: std::string_view permission - Permission name
+ *                             std::int64_t from - Start, microseconds since the epoch
+ *                             std::int64_t to - End, inclusive
+ *                  Returns: std::vector<std::string> - App names, sorted
+ *****************************************************************************/
+std::vector<std::string> PermissionHistory::heldDuring(std::string_view permission, std::int64_t from,
+                                                       std::int64_t to) const {
+    PermissionId id;
+    if (from > to || !PermissionRegistry::instance().find(permission, id)) {
+        return {};
+    }
+    std::set<std::uint32_t> holders;
+    std::set<std::uint32_t> held;
+    bool reachedFrom = false;
+    HistoryQuery query;
+    query.to = to;
+    query.permission = id;
+    forEachEvent(query, [&](const HistoryEvent& event) {
+        if (!reachedFrom && event.timestamp >= from) {
+            held = holders;
+            reachedFrom = true;
+        }
+        if (event.op == HistoryOp::Grant) {
+            holders.insert(event.app);
+            if (reachedFrom) {
+                held.insert(event.app);
+            }
+        } else {
+            holders.erase(event.app);
+        }
+    });
+    if (!reachedFrom) {
+        held = holders;
+    }
+
+    std::vector<std::string> names;
+    names.reserve(held.size());
+    for (std::uint32_t app : held) {
+        names.push_back(appNames[app]);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+/******************************************************************************
+ *                  Name: size
+ *                  Description: Returns the number of recorded events
+ *                  Arguments: None
+ *                  Returns: std::uint64_t - Event count
+ *****************************************************************************/
+std::uint64_t PermissionHistory::size() const {
+    return total;
+}
+
+/******************************************************************************
+ *                  Name: memoryUsage
+ *                  Description: Sums the column capacities, block headers and app
+ *                               name table
+ *                  Arguments: None
+ *                  Returns: std::size_t - Approximate heap bytes
+ *****************************************************************************/
+std::size_t PermissionHistory::memoryUsage() const {
+    std::size_t bytes = blocks.capacity() * sizeof(Block);
+    for (const Block& block : blocks) {
+        bytes += block.times.capacity() + block.apps.capacity() + block.permissions.capacity() +
+                 block.ops.capacity() * sizeof(std::uint64_t);
+    }
+    for (const std::string& name : appNames) {
+        bytes += sizeof(std::string) + name.capacity() + sizeof(std::pair<std::string_view, std::uint32_t>) +
+                 sizeof(void*) * 2;
+    }
+    return bytes;
+}
+
+/******************************************************************************
+ *                  Name: internApp
+ *                  Description: Returns the id of an app name, assigning the next one
+ *                               on first use
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: std::uint32_t - History app id
+ *****************************************************************************/
+std::uint32_t PermissionHistory::internApp(std::string_view appName) {
+    auto it = appIds.find(appName);
+    if (it != appIds.end()) {
+        return it->second;
+    }
+    std::uint32_t id = static_cast<std::uint32_t>(appNames.size());
+    appNames.emplace_back(appName);
+    appIds.emplace(std::string_view(appNames.back()), id);
+    return id;
+}
+
+/******************************************************************************
+ *                  Name: firstBlock
+ *                  Description: Finds the first block that can hold a timestamp at
+ *                               or after from; blocks are sorted by time
+ *                  Arguments: std::int64_t from - Earliest timestamp of interest
+ *                  Returns: std::size_t - Block index, or the block count
+ *****************************************************************************/
+std::size_t PermissionHistory::firstBlock(std::int64_t from) const {
+    auto it = std::partition_point(blocks.begin(), blocks.end(),
+                                   [&](const Block& block) { return block.maxTime < from; });
+    return static_cast<std::size_t>(it - blocks.begin());
+}
+
+/******************************************************************************
+ *                  Name: decode
+ *                  Description: Expands a block's columns into events
+ *                  Arguments: const Block& block - Block to decode
+ *                             std::vector<HistoryEvent>& events - Receives the events,
+ *                                                                 replacing its contents
+ *                  Returns: None
+ *****************************************************************************/
+void PermissionHistory::decode(const Block& block, std::vector<HistoryEvent>& events) {
+    events.resize(block.count);
+    const char* times = block.times.data();
+    const char* apps = block.apps.data();
+    const char* permissions = block.permissions.data();
+    std::int64_t timestamp = block.minTime;
+    for (std::uint32_t i = 0; i < block.count; ++i) {
+        timestamp += static_cast<std::int64_t>(getVarint(times));
+        HistoryEvent& event = events[i];
+        event.timestamp = timestamp;
+        event.app = static_cast<std::uint32_t>(getVarint(apps));
+        event.permission = static_cast<PermissionId>(getVarint(permissions));
+        event.op = (block.ops[i / 64] >> (i % 64)) & 1 ? HistoryOp::Revoke : HistoryOp::Grant;
+    }
+}
+
+/******************************************************************************
+ *                  Name: seal
+ *                  Description: Trims a full block's columns to their size
+ *                  Arguments: Block& block - Block that will receive no more events
+ *                  Returns: None
+ *****************************************************************************/
+void PermissionHistory::seal(Block& block) {
+    block.times.shrink_to_fit();
+    block.apps.shrink_to_fit();
+    block.permissions.shrink_to_fit();
+    block.ops.shrink_to_fit();
+}
+
+/******************************** End of File ********************************/
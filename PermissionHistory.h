@@ -0,0 +1,250 @@
+
+/******************************************************************************
+ *                    File Name: PermissionHistory.h
+ *                    Description: Header file for PermissionHistory, an append-only
+ *                                 record of permission grants and revokes stored in
+ *                                 compressed columnar blocks
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __PERMISSION_HISTORY_H__
+#define __PERMISSION_HISTORY_H__
+
+#include "PermissionRegistry.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/******************************************************************************
+ *                  Enum Definition: HistoryOp
+ *                  Description: Kind of recorded change
+ *****************************************************************************/
+
+enum class HistoryOp : std::uint8_t {
+    Grant,    // The app gained the permission
+    Revoke    // The app lost the permission, by revoke or uninstall
+};
+
+/******************************************************************************
+ *                  Structure Definition: HistoryEvent
+ *                  Description: One decoded event
+ *****************************************************************************/
+
+struct HistoryEvent {
+    std::int64_t timestamp;     // Microseconds since the Unix epoch
+    std::uint32_t app;          // History app id; see PermissionHistory::appName
+    PermissionId permission;    // Permission changed
+    HistoryOp op;               // Grant or Revoke
+};
+
+/******************************************************************************
+ *                  Structure Definition: HistoryQuery
+ *                  Description: Filter over events. The time range is inclusive;
+ *                               kAny leaves the app or permission unconstrained.
+ *****************************************************************************/
+
+struct HistoryQuery {
+    static constexpr std::uint32_t kAny = std::numeric_limits<std::uint32_t>::max();
+
+    std::int64_t from = std::numeric_limits<std::int64_t>::min();   // Earliest timestamp
+    std::int64_t to = std::numeric_limits<std::int64_t>::max();     // Latest timestamp
+    std::uint32_t app = kAny;                                       // App id, or kAny
+    PermissionId permission = kAny;                                 // Permission, or kAny
+
+    /******************************************************************************
+     *                  Name: matches
+     *                  Description: Checks one event against the filter
+     *                  Arguments: const HistoryEvent& event - Event to test
+     *                  Returns: bool - True if the event passes
+     *****************************************************************************/
+    bool matches(const HistoryEvent& event) const {
+        return event.timestamp >= from && event.timestamp <= to && (app == kAny || event.app == app) &&
+               (permission == kAny || event.permission == permission);
+    }
+};
+
+/******************************************************************************
+ *                  Class Definition: PermissionHistory
+ *                  Description: Append-only log of (timestamp, app, permission, op)
+ *                               events. Events are packed into blocks of
+ *                               kBlockEvents, one column per field: timestamp
+ *                               deltas, app ids and permission ids as varints, ops
+ *                               as a bitmap. Typical events take 3-5 bytes. Each
+ *                               block keeps the min/max of every column, so queries
+ *                               decode only blocks that can match. Timestamps are
+ *                               kept non-decreasing: an event stamped earlier than
+ *                               the previous one takes the previous timestamp,
+ *                               which keeps blocks sorted by time when the wall
+ *                               clock steps back. App names are interned into
+ *                               dense ids that are never reused, so history of
+ *                               uninstalled apps stays resolvable. Not thread-safe;
+ *                               use it under the same exclusion as the manager
+ *                               recording into it.
+ *****************************************************************************/
+
+class PermissionHistory {
+public:
+    static constexpr std::uint32_t kBlockEvents = 4096;   // Events per sealed block
+
+    using Clock = std::function<std::int64_t()>;   // Returns microseconds since the Unix epoch
+
+    /******************************************************************************
+     *                  Name: PermissionHistory
+     *                  Description: Constructor taking the time source
+     *                  Arguments: Clock clock - Time source for record() without a
+     *                                           timestamp; defaults to the system clock
+     *                  Returns: None
+     *****************************************************************************/
+    explicit PermissionHistory(Clock clock = Clock());
+
+    /******************************************************************************
+     *                  Name: record
+     *                  Description: Appends an event stamped with the clock
+     *                  Arguments: std::string_view appName - Name of the application
+     *                             PermissionId permission - Permission changed
+     *                             HistoryOp op - Grant or Revoke
+     *                  Returns: None
+     *****************************************************************************/
+    void record(std::string_view appName, PermissionId permission, HistoryOp op);
+
+    /******************************************************************************
+     *                  Name: record
+     *                  Description: Appends an event with an explicit timestamp
+     *                  Arguments: std::int64_t timestamp - Microseconds since the epoch
+     *                             std::string_view appName - Name of the application
+     *                             PermissionId permission - Permission changed
+     *                             HistoryOp op - Grant or Revoke
+     *                  Returns: None
+     *****************************************************************************/
+    void record(std::int64_t timestamp, std::string_view appName, PermissionId permission, HistoryOp op);
+
+    /******************************************************************************
+     *                  Name: findApp
+     *                  Description: Looks up the history id of an app name
+     *                  Arguments: std::string_view appName - Name of the application
+     *                             std::uint32_t& app - Receives the id
+     *                  Returns: bool - False if no event mentions the app
+     *****************************************************************************/
+    bool findApp(std::string_view appName, std::uint32_t& app) const;
+
+    /******************************************************************************
+     *                  Name: appName
+     *                  Description: Returns the name behind a history app id
+     *                  Arguments: std::uint32_t app - History app id
+     *                  Returns: const std::string& - App name
+     *****************************************************************************/
+    const std::string& appName(std::uint32_t app) const;
+
+    /******************************************************************************
+     *                  Name: forEachEvent
+     *                  Description: Calls fn(const HistoryEvent&) for every event
+     *                               matching the query, in recording order. Blocks
+     *                               before the time range are skipped by binary
+     *                               search, others by their column bounds.
+     *                  Arguments: const HistoryQuery& query - Filter
+     *                             Fn fn - Callback invoked per event
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEachEvent(const HistoryQuery& query, Fn fn) const {
+        std::vector<HistoryEvent> events;
+        for (std::size_t index = firstBlock(query.from); index < blocks.size(); ++index) {
+            const Block& block = blocks[index];
+            if (block.minTime > query.to) {
+                break;
+            }
+            if (!block.mayMatch(query)) {
+                continue;
+            }
+            decode(block, events);
+            for (const HistoryEvent& event : events) {
+                if (query.matches(event)) {
+                    fn(event);
+                }
+            }
+        }
+    }
+
+    /******************************************************************************
+     *                  Name: events
+     *                  Description: Collects the events matching the query
+     *                  Arguments: const HistoryQuery& query - Filter
+     *                  Returns: std::vector<HistoryEvent> - Events in recording order
+     *****************************************************************************/
+    std::vector<HistoryEvent> events(const HistoryQuery& query) const;
+
+    /******************************************************************************
+     *                  Name: heldDuring
+     *                  Description: Lists the apps that held a permission at any
+     *                               moment in [from, to]: holders at from plus apps
+     *                               granted it before to
+     *                  Arguments: std::string_view permission - Permission name
+     *                             std::int64_t from - Start, microseconds since the epoch
+     *                             std::int64_t to - End, inclusive
+     *                  Returns: std::vector<std::string> - App names, sorted
+     *****************************************************************************/
+    std::vector<std::string> heldDuring(std::string_view permission, std::int64_t from, std::int64_t to) const;
+
+    /******************************************************************************
+     *                  Name: size
+     *                  Description: Returns the number of recorded events
+     *                  Arguments: None
+     *                  Returns: std::uint64_t - Event count
+     *****************************************************************************/
+    std::uint64_t size() const;
+
+    /******************************************************************************
+     *                  Name: memoryUsage
+     *                  Description: Returns the bytes held by blocks and the app name
+     *                               table
+     *                  Arguments: None
+     *                  Returns: std::size_t - Approximate heap bytes
+     *****************************************************************************/
+    std::size_t memoryUsage() const;
+
+private:
+    struct Block {
+        std::int64_t minTime = 0;                 // First timestamp; deltas start here
+        std::int64_t maxTime = 0;                 // Last timestamp
+        std::uint32_t minApp = HistoryQuery::kAny;
+        std::uint32_t maxApp = 0;
+        PermissionId minPermission = HistoryQuery::kAny;
+        PermissionId maxPermission = 0;
+        std::uint32_t count = 0;                  // Events in the block
+        std::string times;                        // Varint timestamp deltas
+        std::string apps;                         // Varint app ids
+        std::string permissions;                  // Varint permission ids
+        std::vector<std::uint64_t> ops;           // Bit i set when event i is a revoke
+
+        bool mayMatch(const HistoryQuery& query) const {
+            return (query.app == HistoryQuery::kAny || (query.app >= minApp && query.app <= maxApp)) &&
+                   (query.permission == HistoryQuery::kAny ||
+                    (query.permission >= minPermission && query.permission <= maxPermission));
+        }
+    };
+
+    std::uint32_t internApp(std::string_view appName);
+    std::size_t firstBlock(std::int64_t from) const;
+    static void decode(const Block& block, std::vector<HistoryEvent>& events);
+    static void seal(Block& block);
+
+    Clock clock;                                              // Time source for record()
+    std::vector<Block> blocks;                                // Sealed blocks, then the open one
+    std::uint64_t total = 0;                                  // Events recorded
+    std::unordered_map<std::string_view, std::uint32_t> appIds;   // Name -> id, keys view into names
+    std::deque<std::string> appNames;                         // Id -> name, stable addresses
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,452 @@
+/******************************************************************************
+ *                    File Name: PermissionQuery.cpp
+ *                    Description: Implementation file for the query parser, the
+ *                                 permission bitmap index and query results
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "PermissionQuery.h"
+#include "PermissionRegistry.h"
+#include <algorithm>  // For std::sort
+
+/******************************************************************************
+ *                  Class Definition: QueryParser
+ *                  Description: Recursive-descent parser building the node list of
+ *                               a PermissionQuery
+ *****************************************************************************/
+
+class QueryParser {
+public:
+    static constexpr std::uint32_t kMaxDepth = 256;   // Deepest accepted nesting
+
+    QueryParser(std::string_view text, PermissionQuery& query) : text(text), query(query) {}
+
+    /******************************************************************************
+     *                  Name: run
+     *                  Description: Parses the whole text
+     *                  Arguments: std::string* error - Receives a message on failure
+     *                  Returns: bool - False if the text is malformed
+     *****************************************************************************/
+    bool run(std::string* error) {
+        std::uint32_t root = 0;
+        bool ok = parseOr(root, 0);
+        if (ok && peek() != '\0') {
+            ok = fail("unexpected '" + std::string(1, text[position]) + "'");
+        }
+        if (!ok) {
+            if (error != nullptr) {
+                *error = message + " at offset " + std::to_string(position);
+            }
+            return false;
+        }
+        query.root = root;
+        return true;
+    }
+
+private:
+    using Node = PermissionQuery::Node;
+    using NodeKind = PermissionQuery::NodeKind;
+
+    static bool isNameChar(char c) {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ||
+               c == '_' || c == '.' || c == ':';
+    }
+
+    char peek() {
+        while (position < text.size() && (text[position] == ' ' || text[position] == '\t')) {
+            ++position;
+        }
+        return position < text.size() ? text[position] : '\0';
+    }
+
+    bool fail(std::string reason) {
+        message = std::move(reason);
+        return false;
+    }
+
+    std::uint32_t add(NodeKind kind, std::uint32_t left, std::uint32_t right) {
+        Node node;
+        node.kind = kind;
+        node.left = left;
+        node.right = right;
+        query.nodes.push_back(std::move(node));
+        return static_cast<std::uint32_t>(query.nodes.size() - 1);
+    }
+
+    // or := and ('|' and)*
+    bool parseOr(std::uint32_t& out, std::uint32_t depth) {
+        if (!parseAnd(out, depth)) {
+            return false;
+        }
+        while (peek() == '|') {
+            ++position;
+            std::uint32_t right = 0;
+            if (!parseAnd(right, depth)) {
+                return false;
+            }
+            out = add(NodeKind::Or, out, right);
+        }
+        return true;
+    }
+
+    // and := unary ('&' unary)*; "a & !b" becomes one AndNot node
+    bool parseAnd(std::uint32_t& out, std::uint32_t depth) {
+        if (!parseUnary(out, depth)) {
+            return false;
+        }
+        while (peek() == '&') {
+            ++position;
+            std::uint32_t right = 0;
+            if (!parseUnary(right, depth)) {
+                return false;
+            }
+            if (query.nodes[right].kind == NodeKind::Not) {
+                out = add(NodeKind::AndNot, out, query.nodes[right].left);
+            } else {
+                out = add(NodeKind::And, out, right);
+            }
+        }
+        return true;
+    }
+
+    // unary := '!' unary | '(' or ')' | name
+    bool parseUnary(std::uint32_t& out, std::uint32_t depth) {
+        if (depth >= kMaxDepth) {
+            return fail("expression nested too deeply");
+        }
+        char c = peek();
+        if (c == '!') {
+            ++position;
+            std::uint32_t operand = 0;
+            if (!parseUnary(operand, depth + 1)) {
+                return false;
+            }
+            out = add(NodeKind::Not, operand, 0);
+            return true;
+        }
+        if (c == '(') {
+            ++position;
+            if (!parseOr(out, depth + 1)) {
+                return false;
+            }
+            if (peek() != ')') {
+                return fail("expected ')'");
+            }
+            ++position;
+            return true;
+        }
+        std::size_t start = position;
+        while (position < text.size() && isNameChar(text[position])) {
+            ++position;
+        }
+        if (position == start) {
+            return fail(c == '\0' ? "expected a permission" : "unexpected '" + std::string(1, c) + "'");
+        }
+        out = add(NodeKind::Permission, 0, 0);
+        query.nodes[out].permission = std::string(text.substr(start, position - start));
+        return true;
+    }
+
+    std::string_view text;      // Expression being parsed
+    PermissionQuery& query;     // Receives the nodes
+    std::size_t position = 0;   // Offset of the next unread character
+    std::string message;        // Reason for the first failure
+};
+
+/******************************************************************************
+ *                  Name: parse
+ *                  Description: Parses an expression into a node list
+ *                  Arguments: std::string_view expression - Text to parse
+ *                             PermissionQuery& query - Receives the query
+ *                             std::string* error - Receives a message on failure
+ *                  Returns: bool - False if the expression is malformed
+ *****************************************************************************/
+bool PermissionQuery::parse(std::string_view expression, PermissionQuery& query, std::string* error) {
+    PermissionQuery parsed;
+    if (!QueryParser(expression, parsed).run(error)) {
+        return false;
+    }
+    query = std::move(parsed);
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: addApp
+ *                  Description: Takes a free id or a new one and sets the app's bits
+ *                  Arguments: const App* app - App to add
+ *                             const PermissionSet& permissions - The app's permissions
+ *                             const std::vector<GroupId>& groups - The app's groups
+ *                  Returns: None
+ *****************************************************************************/
+void PermissionBitmapIndex::addApp(const App* app, const PermissionSet& permissions,
+                                   const std::vector<GroupId>& groups) {
+    std::uint32_t id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+        apps[id] = app;
+    } else {
+        id = static_cast<std::uint32_t>(apps.size());
+        apps.push_back(app);
+    }
+    ids[app] = id;
+    installed.add(id);
+    permissions.forEach([&](PermissionId permission) { grant(app, permission); });
+    for (GroupId group : groups) {
+        joinGroup(app, group);
+    }
+}
+
+/******************************************************************************
+ *                  Name: removeApp
+ *                  Description: Clears the app's bits and frees its id
+ *                  Arguments: const App* app - App to remove
+ *                             const std::vector<GroupId>& groups - The app's groups
+ *                  Returns: None
+ *****************************************************************************/
+void PermissionBitmapIndex::removeApp(const App* app, const std::vector<GroupId>& groups) {
+    auto it = ids.find(app);
+    if (it == ids.end()) {
+        return;
+    }
+    std::uint32_t id = it->second;
+    app->getPermissionSet().forEach([&](PermissionId permission) {
+        if (permission < direct.size()) {
+            direct[permission].remove(id);
+        }
+    });
+    for (GroupId group : groups) {
+        if (group < groupMembers.size()) {
+            groupMembers[group].remove(id);
+        }
+    }
+    installed.remove(id);
+    apps[id] = nullptr;
+    freeIds.push_back(id);
+    ids.erase(it);
+}
+
+/******************************************************************************
+ *                  Name: grant
+ *                  Description: Sets the app's bit in the permission's bitmap
+ *                  Arguments: const App* app - App in the index
+ *                             PermissionId id - Permission gained
+ *                  Returns: None
+ *****************************************************************************/
+void PermissionBitmapIndex::grant(const App* app, PermissionId id) {
+    if (id >= direct.size()) {
+        direct.resize(id + 1);
+    }
+    direct[id].add(idOf(app));
+}
+
+/******************************************************************************
+ *                  Name: revoke
+ *                  Description: Clears the app's bit in the permission's bitmap
+ *                  Arguments: const App* app - App in the index
+ *                             PermissionId id - Permission lost
+ *                  Returns: None
+ *****************************************************************************/
+void PermissionBitmapIndex::revoke(const App* app, PermissionId id) {
+    if (id < direct.size()) {
+        direct[id].remove(idOf(app));
+    }
+}
+
+/******************************************************************************
+ *                  Name: joinGroup
+ *                  Description: Sets the app's bit in the group's bitmap
+ *                  Arguments: const App* app - App in the index
+ *                             GroupId group - Group joined
+ *                  Returns: None
+ *****************************************************************************/
+void PermissionBitmapIndex::joinGroup(const App* app, GroupId group) {
+    if (group >= groupMembers.size()) {
+        groupMembers.resize(group + 1);
+    }
+    groupMembers[group].add(idOf(app));
+}
+
+/******************************************************************************
+ *                  Name: leaveGroup
+ *                  Description: Clears the app's bit in the group's bitmap
+ *                  Arguments: const App* app - App in the index
+ *                             GroupId group - Group left
+ *                  Returns: None
+ *****************************************************************************/
+void PermissionBitmapIndex::leaveGroup(const App* app, GroupId group) {
+    if (group < groupMembers.size()) {
+        groupMembers[group].remove(idOf(app));
+    }
+}
+
+/******************************************************************************
+ *                  Name: setGroupMasks
+ *                  Description: Replaces the compiled group masks
+ *                  Arguments: std::vector<PermissionSet> masks - Group masks
+ *                  Returns: None
+ *****************************************************************************/
+void PermissionBitmapIndex::setGroupMasks(std::vector<PermissionSet> masks) {
+    groupMasks = std::move(masks);
+}
+
+/******************************************************************************
+ *                  Name: clear
+ *                  Description: Drops every app, id and bitmap
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void PermissionBitmapIndex::clear() {
+    apps.clear();
+    freeIds.clear();
+    ids.clear();
+    installed.clear();
+    direct.clear();
+    groupMembers.clear();
+}
+
+/******************************************************************************
+ *                  Name: evaluate
+ *                  Description: Evaluates the query from its root node
+ *                  Arguments: const PermissionQuery& query - Parsed expression
+ *                  Returns: RoaringBitmap - Matching app ids
+ *****************************************************************************/
+RoaringBitmap PermissionBitmapIndex::evaluate(const PermissionQuery& query) const {
+    if (query.nodes.empty()) {
+        return RoaringBitmap();
+    }
+    return evaluate(query, query.root);
+}
+
+/******************************************************************************
+ *                  Name: app
+ *                  Description: Returns the app holding an id
+ *                  Arguments: std::uint32_t id - Dense app id
+ *                  Returns: const App* - The app
+ *****************************************************************************/
+const App* PermissionBitmapIndex::app(std::uint32_t id) const {
+    return apps[id];
+}
+
+/******************************************************************************
+ *                  Name: memoryUsage
+ *                  Description: Sums the bitmaps and the id tables
+ *                  Arguments: None
+ *                  Returns: std::size_t - Approximate bytes
+ *****************************************************************************/
+std::size_t PermissionBitmapIndex::memoryUsage() const {
+    std::size_t bytes = installed.memoryUsage() + apps.capacity() * sizeof(const App*) +
+                        freeIds.capacity() * sizeof(std::uint32_t) +
+                        ids.size() * (sizeof(const App*) + sizeof(std::uint32_t) + 2 * sizeof(void*));
+    for (const RoaringBitmap& bitmap : direct) {
+        bytes += sizeof(RoaringBitmap) + bitmap.memoryUsage();
+    }
+    for (const RoaringBitmap& bitmap : groupMembers) {
+        bytes += sizeof(RoaringBitmap) + bitmap.memoryUsage();
+    }
+    return bytes;
+}
+
+/******************************************************************************
+ *                  Name: evaluate
+ *                  Description: Evaluates one node. NOT is taken relative to the
+ *                               installed apps; AndNot subtracts without
+ *                               materializing the complement.
+ *                  Arguments: const PermissionQuery& query - Parsed expression
+ *                             std::uint32_t node - Node to evaluate
+ *                  Returns: RoaringBitmap - Matching app ids
+ *****************************************************************************/
+RoaringBitmap PermissionBitmapIndex::evaluate(const PermissionQuery& query, std::uint32_t node) const {
+    const PermissionQuery::Node& current = query.nodes[node];
+    RoaringBitmap result;
+    switch (current.kind) {
+    case PermissionQuery::NodeKind::Permission:
+        return holders(current.permission);
+    case PermissionQuery::NodeKind::And:
+        result = evaluate(query, current.left);
+        if (!result.empty()) {
+            result &= evaluate(query, current.right);
+        }
+        return result;
+    case PermissionQuery::NodeKind::AndNot:
+        result = evaluate(query, current.left);
+        if (!result.empty()) {
+            result -= evaluate(query, current.right);
+        }
+        return result;
+    case PermissionQuery::NodeKind::Or:
+        result = evaluate(query, current.left);
+        result |= evaluate(query, current.right);
+        return result;
+    case PermissionQuery::NodeKind::Not:
+        result = installed;
+        result -= evaluate(query, current.left);
+        return result;
+    }
+    return result;
+}
+
+/******************************************************************************
+ *                  Name: holders
+ *                  Description: Ids of the apps holding a permission directly or
+ *                               through a group
+ *                  Arguments: std::string_view permission - Permission name
+ *                  Returns: RoaringBitmap - Matching app ids
+ *****************************************************************************/
+RoaringBitmap PermissionBitmapIndex::holders(std::string_view permission) const {
+    RoaringBitmap result;
+    PermissionId id;
+    if (!PermissionRegistry::instance().find(permission, id)) {
+        return result;
+    }
+    if (id < direct.size()) {
+        result = direct[id];
+    }
+    for (GroupId group = 0; group < groupMembers.size() && group < groupMasks.size(); ++group) {
+        if (groupMasks[group].contains(id)) {
+            result |= groupMembers[group];
+        }
+    }
+    return result;
+}
+
+/******************************************************************************
+ *                  Name: idOf
+ *                  Description: Looks up the id of an indexed app
+ *                  Arguments: const App* app - App in the index
+ *                  Returns: std::uint32_t - Dense app id
+ *****************************************************************************/
+std::uint32_t PermissionBitmapIndex::idOf(const App* app) const {
+    return ids.at(app);
+}
+
+/******************************************************************************
+ *                  Name: count
+ *                  Description: Returns the number of matching apps
+ *                  Arguments: None
+ *                  Returns: std::uint64_t - App count
+ *****************************************************************************/
+std::uint64_t PermissionQueryResult::count() const {
+    return bits.cardinality();
+}
+
+/******************************************************************************
+ *                  Name: names
+ *                  Description: Collects and sorts the matching app names
+ *                  Arguments: None
+ *                  Returns: std::vector<std::string> - App names, sorted
+ *****************************************************************************/
+std::vector<std::string> PermissionQueryResult::names() const {
+    std::vector<std::string> result;
+    result.reserve(static_cast<std::size_t>(bits.cardinality()));
+    forEach([&](std::string_view name) { result.emplace_back(name); });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+/******************************** End of File ********************************/
@@ -0,0 +1,247 @@
+
+/******************************************************************************
+ *                    File Name: PermissionQuery.h
+ *                    Description: Header file for boolean permission queries: the
+ *                                 parsed expression, the per-permission bitmap index
+ *                                 that answers it, and the query result
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __PERMISSION_QUERY_H__
+#define __PERMISSION_QUERY_H__
+
+#include "App.h"
+#include "PermissionGroups.h"
+#include "PermissionSet.h"
+#include "RoaringBitmap.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/******************************************************************************
+ *                  Class Definition: PermissionQuery
+ *                  Description: Boolean expression over permission names, e.g.
+ *                                   (LOCATION & CAMERA & !VERIFIED) | SMS | CONTACTS
+ *                               '!' binds tighter than '&', which binds tighter than
+ *                               '|'; parentheses group. Names are letters, digits,
+ *                               '_', '.' and ':'. A name is true for an app that
+ *                               holds the permission directly or through a group;
+ *                               names never granted are simply false.
+ *****************************************************************************/
+
+class PermissionQuery {
+public:
+    /******************************************************************************
+     *                  Name: parse
+     *                  Description: Parses an expression
+     *                  Arguments: std::string_view expression - Text to parse
+     *                             PermissionQuery& query - Receives the query
+     *                             std::string* error - Receives a message on failure; may
+     *                                                  be nullptr
+     *                  Returns: bool - False if the expression is malformed
+     *****************************************************************************/
+    static bool parse(std::string_view expression, PermissionQuery& query, std::string* error = nullptr);
+
+private:
+    friend class PermissionBitmapIndex;
+    friend class QueryParser;
+
+    enum class NodeKind : std::uint8_t {
+        Permission,   // Leaf naming a permission
+        And,          // left & right
+        AndNot,       // left & !right, fused from '&' followed by '!'
+        Or,           // left | right
+        Not           // !left
+    };
+
+    struct Node {
+        NodeKind kind = NodeKind::Permission;
+        std::string permission;        // Name, for Permission leaves
+        std::uint32_t left = 0;        // Operand node
+        std::uint32_t right = 0;       // Second operand node of binary kinds
+    };
+
+    std::vector<Node> nodes;           // Expression tree; children precede parents
+    std::uint32_t root = 0;            // Node the expression evaluates to
+};
+
+/******************************************************************************
+ *                  Class Definition: PermissionBitmapIndex
+ *                  Description: Assigns every installed app a dense id, reusing the
+ *                               ids of uninstalled apps, and keeps a RoaringBitmap
+ *                               of ids per permission (direct grants), per group
+ *                               (members) and for all installed apps. A permission
+ *                               leaf evaluates to its direct bitmap ORed with the
+ *                               member bitmaps of every group whose compiled mask
+ *                               holds it, so queries see effective permissions.
+ *****************************************************************************/
+
+class PermissionBitmapIndex {
+public:
+    /******************************************************************************
+     *                  Name: addApp
+     *                  Description: Assigns an id to a new app and indexes its
+     *                               permissions and groups
+     *                  Arguments: const App* app - App to add
+     *                             const PermissionSet& permissions - The app's permissions
+     *                             const std::vector<GroupId>& groups - The app's groups
+     *                  Returns: None
+     *****************************************************************************/
+    void addApp(const App* app, const PermissionSet& permissions, const std::vector<GroupId>& groups);
+
+    /******************************************************************************
+     *                  Name: removeApp
+     *                  Description: Clears an app from every bitmap and frees its id
+     *                  Arguments: const App* app - App to remove
+     *                             const std::vector<GroupId>& groups - The app's groups
+     *                  Returns: None
+     *****************************************************************************/
+    void removeApp(const App* app, const std::vector<GroupId>& groups);
+
+    /******************************************************************************
+     *                  Name: grant
+     *                  Description: Sets the app's bit for a permission
+     *                  Arguments: const App* app - App in the index
+     *                             PermissionId id - Permission gained
+     *                  Returns: None
+     *****************************************************************************/
+    void grant(const App* app, PermissionId id);
+
+    /******************************************************************************
+     *                  Name: revoke
+     *                  Description: Clears the app's bit for a permission
+     *                  Arguments: const App* app - App in the index
+     *                             PermissionId id - Permission lost
+     *                  Returns: None
+     *****************************************************************************/
+    void revoke(const App* app, PermissionId id);
+
+    /******************************************************************************
+     *                  Name: joinGroup
+     *                  Description: Sets the app's bit for a group
+     *                  Arguments: const App* app - App in the index
+     *                             GroupId group - Group joined
+     *                  Returns: None
+     *****************************************************************************/
+    void joinGroup(const App* app, GroupId group);
+
+    /******************************************************************************
+     *                  Name: leaveGroup
+     *                  Description: Clears the app's bit for a group
+     *                  Arguments: const App* app - App in the index
+     *                             GroupId group - Group left
+     *                  Returns: None
+     *****************************************************************************/
+    void leaveGroup(const App* app, GroupId group);
+
+    /******************************************************************************
+     *                  Name: setGroupMasks
+     *                  Description: Replaces the compiled group masks, indexed by GroupId
+     *                  Arguments: std::vector<PermissionSet> masks - Group masks
+     *                  Returns: None
+     *****************************************************************************/
+    void setGroupMasks(std::vector<PermissionSet> masks);
+
+    /******************************************************************************
+     *                  Name: clear
+     *                  Description: Removes every app; group masks are kept
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void clear();
+
+    /******************************************************************************
+     *                  Name: evaluate
+     *                  Description: Computes the ids of the apps matching a query
+     *                  Arguments: const PermissionQuery& query - Parsed expression
+     *                  Returns: RoaringBitmap - Matching app ids
+     *****************************************************************************/
+    RoaringBitmap evaluate(const PermissionQuery& query) const;
+
+    /******************************************************************************
+     *                  Name: app
+     *                  Description: Returns the app holding an id
+     *                  Arguments: std::uint32_t id - Dense app id
+     *                  Returns: const App* - The app
+     *****************************************************************************/
+    const App* app(std::uint32_t id) const;
+
+    /******************************************************************************
+     *                  Name: memoryUsage
+     *                  Description: Returns the heap bytes held by the bitmaps and the
+     *                               id tables
+     *                  Arguments: None
+     *                  Returns: std::size_t - Approximate bytes
+     *****************************************************************************/
+    std::size_t memoryUsage() const;
+
+private:
+    RoaringBitmap evaluate(const PermissionQuery& query, std::uint32_t node) const;
+    RoaringBitmap holders(std::string_view permission) const;
+    std::uint32_t idOf(const App* app) const;
+
+    std::vector<const App*> apps;                        // Id -> app; nullptr for free ids
+    std::vector<std::uint32_t> freeIds;                  // Ids of uninstalled apps
+    std::unordered_map<const App*, std::uint32_t> ids;   // App -> id
+    RoaringBitmap installed;                             // Ids of every installed app
+    std::vector<RoaringBitmap> direct;                   // PermissionId -> ids granted it directly
+    std::vector<RoaringBitmap> groupMembers;             // GroupId -> ids of member apps
+    std::vector<PermissionSet> groupMasks;               // GroupId -> compiled mask
+};
+
+/******************************************************************************
+ *                  Class Definition: PermissionQueryResult
+ *                  Description: Apps matching a query, as a bitmap of dense ids.
+ *                               Names resolve through the manager's apps, so use the
+ *                               result before the next mutation of the manager.
+ *****************************************************************************/
+
+class PermissionQueryResult {
+public:
+    /******************************************************************************
+     *                  Name: count
+     *                  Description: Returns the number of matching apps
+     *                  Arguments: None
+     *                  Returns: std::uint64_t - App count
+     *****************************************************************************/
+    std::uint64_t count() const;
+
+    /******************************************************************************
+     *                  Name: forEach
+     *                  Description: Calls fn(std::string_view) with every matching
+     *                               app's name, in id order
+     *                  Arguments: Fn fn - Callback invoked per app
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        bits.forEach([&](std::uint32_t id) { fn(std::string_view(index->app(id)->getAppName())); });
+    }
+
+    /******************************************************************************
+     *                  Name: names
+     *                  Description: Collects the matching app names
+     *                  Arguments: None
+     *                  Returns: std::vector<std::string> - App names, sorted
+     *****************************************************************************/
+    std::vector<std::string> names() const;
+
+private:
+    friend class MobileAppManager;
+
+    RoaringBitmap bits;                                  // Matching app ids
+    const PermissionBitmapIndex* index = nullptr;        // Resolves ids to apps
+    std::shared_ptr<const PermissionBitmapIndex> owned;  // Temporary index, when one was built
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,94 @@
+
+/******************************************************************************
+ *                    File Name: PermissionRegistry.cpp
+ *                    Description: Implementation file for the permission interning table
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "PermissionRegistry.h"
+#include <mutex>
+
+/******************************************************************************
+ *                  Name: instance
+ *                  Description: Returns the shared process-wide registry
+ *                  Arguments: None
+ *                  Returns: PermissionRegistry& - The global registry
+ *****************************************************************************/
+PermissionRegistry& PermissionRegistry::instance() {
+    static PermissionRegistry registry;
+    return registry;
+}
+
+/******************************************************************************
+ *                  Name: intern
+ *                  Description: Takes the shared lock for the common already-known
+ *                               case and only upgrades to the exclusive lock when
+ *                               a new name has to be added
+ *                  Arguments: std::string_view name - Permission name
+ *                  Returns: PermissionId - ID of the permission
+ *****************************************************************************/
+PermissionId PermissionRegistry::intern(std::string_view name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = ids.find(name);
+        if (it != ids.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto it = ids.find(name);  // Another thread may have interned it meanwhile
+    if (it != ids.end()) {
+        return it->second;
+    }
+    PermissionId id = static_cast<PermissionId>(names.size());
+    names.emplace_back(name);
+    ids.emplace(std::string_view(names.back()), id);
+    return id;
+}
+
+/******************************************************************************
+ *                  Name: find
+ *                  Description: Looks up the ID of a permission without interning it
+ *                  Arguments: std::string_view name - Permission name
+ *                             PermissionId& id - Receives the ID when found
+ *                  Returns: bool - True if the permission is known
+ *****************************************************************************/
+bool PermissionRegistry::find(std::string_view name, PermissionId& id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto it = ids.find(name);
+    if (it == ids.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: name
+ *                  Description: Returns the name of an interned permission
+ *                  Arguments: PermissionId id - ID of the permission
+ *                  Returns: const std::string& - Permission name
+ *****************************************************************************/
+const std::string& PermissionRegistry::name(PermissionId id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return names[id];
+}
+
+/******************************************************************************
+ *                  Name: size
+ *                  Description: Returns the number of interned permissions
+ *                  Arguments: None
+ *                  Returns: std::size_t - Number of distinct permission names
+ *****************************************************************************/
+std::size_t PermissionRegistry::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return names.size();
+}
+
+/******************************** End of File ********************************/
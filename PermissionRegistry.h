@@ -0,0 +1,93 @@
+
+/******************************************************************************
+ *                    File Name: PermissionRegistry.h
+ *                    Description: Header file for the global permission interning
+ *                                 table mapping permission names to small integer IDs
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __PERMISSION_REGISTRY_H__
+#define __PERMISSION_REGISTRY_H__
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/******************************************************************************
+ *                  Type Definition: PermissionId
+ *                  Description: Dense integer handle for an interned permission name
+ *****************************************************************************/
+using PermissionId = std::uint32_t;
+
+/******************************************************************************
+ *                  Class Definition: PermissionRegistry
+ *                  Description: Process-wide table that interns each distinct
+ *                               permission name exactly once. IDs are handed out
+ *                               in first-seen order starting at 0 and are never
+ *                               reused, so they are safe to store in bitsets.
+ *****************************************************************************/
+
+class PermissionRegistry {
+public:
+    /******************************************************************************
+     *                  Name: instance
+     *                  Description: Returns the shared process-wide registry
+     *                  Arguments: None
+     *                  Returns: PermissionRegistry& - The global registry
+     *****************************************************************************/
+    static PermissionRegistry& instance();
+
+    /******************************************************************************
+     *                  Name: intern
+     *                  Description: Returns the ID of a permission, assigning a new
+     *                               one if the name has not been seen before
+     *                  Arguments: std::string_view name - Permission name
+     *                  Returns: PermissionId - ID of the permission
+     *****************************************************************************/
+    PermissionId intern(std::string_view name);
+
+    /******************************************************************************
+     *                  Name: find
+     *                  Description: Looks up the ID of a permission without interning it
+     *                  Arguments: std::string_view name - Permission name
+     *                             PermissionId& id - Receives the ID when found
+     *                  Returns: bool - True if the permission is known
+     *****************************************************************************/
+    bool find(std::string_view name, PermissionId& id) const;
+
+    /******************************************************************************
+     *                  Name: name
+     *                  Description: Returns the name of an interned permission. The
+     *                               reference stays valid for the life of the process.
+     *                  Arguments: PermissionId id - ID of the permission
+     *                  Returns: const std::string& - Permission name
+     *****************************************************************************/
+    const std::string& name(PermissionId id) const;
+
+    /******************************************************************************
+     *                  Name: size
+     *                  Description: Returns the number of interned permissions
+     *                  Arguments: None
+     *                  Returns: std::size_t - Number of distinct permission names
+     *****************************************************************************/
+    std::size_t size() const;
+
+private:
+    PermissionRegistry() = default;
+
+    mutable std::shared_mutex mutex;                         // Guards ids and names
+    std::unordered_map<std::string_view, PermissionId> ids;  // Name -> ID, keys view into names
+    std::deque<std::string> names;                           // ID -> name, stable addresses
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,156 @@
+
+/******************************************************************************
+ *                    File Name: PermissionSet.cpp
+ *                    Description: Implementation file for PermissionSet methods
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "PermissionSet.h"
+#include <algorithm>  // For std::lower_bound, std::set_union
+#include <iterator>   // For std::back_inserter
+
+/******************************************************************************
+ *                  Name: insert
+ *                  Description: Sets the bit for inline IDs, otherwise inserts into
+ *                               the sorted overflow vector
+ *                  Arguments: PermissionId id - Permission to add
+ *                  Returns: bool - True if the ID was not already present
+ *****************************************************************************/
+bool PermissionSet::insert(PermissionId id) {
+    if (id < kInlineBits) {
+        std::uint64_t mask = std::uint64_t(1) << (id % 64);
+        std::uint64_t& word = words[id / 64];
+        bool added = (word & mask) == 0;
+        word |= mask;
+        return added;
+    }
+    auto it = std::lower_bound(overflow.begin(), overflow.end(), id);
+    if (it != overflow.end() && *it == id) {
+        return false;
+    }
+    overflow.insert(it, id);
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: erase
+ *                  Description: Clears the bit for inline IDs, otherwise erases from
+ *                               the sorted overflow vector
+ *                  Arguments: PermissionId id - Permission to remove
+ *                  Returns: bool - True if the ID was present
+ *****************************************************************************/
+bool PermissionSet::erase(PermissionId id) {
+    if (id < kInlineBits) {
+        std::uint64_t mask = std::uint64_t(1) << (id % 64);
+        std::uint64_t& word = words[id / 64];
+        bool removed = (word & mask) != 0;
+        word &= ~mask;
+        return removed;
+    }
+    auto it = std::lower_bound(overflow.begin(), overflow.end(), id);
+    if (it == overflow.end() || *it != id) {
+        return false;
+    }
+    overflow.erase(it);
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: contains
+ *                  Description: Checks whether a permission ID is in the set
+ *                  Arguments: PermissionId id - Permission to check
+ *                  Returns: bool - True if present
+ *****************************************************************************/
+bool PermissionSet::contains(PermissionId id) const {
+    if (id < kInlineBits) {
+        return (words[id / 64] >> (id % 64)) & 1;
+    }
+    return std::binary_search(overflow.begin(), overflow.end(), id);
+}
+
+/******************************************************************************
+ *                  Name: size
+ *                  Description: Returns the number of permissions in the set
+ *                  Arguments: None
+ *                  Returns: std::size_t - Number of IDs held
+ *****************************************************************************/
+std::size_t PermissionSet::size() const {
+    std::size_t count = overflow.size();
+    for (std::uint64_t word : words) {
+        count += popCount(word);
+    }
+    return count;
+}
+
+/******************************************************************************
+ *                  Name: empty
+ *                  Description: Checks whether the set holds no permissions
+ *                  Arguments: None
+ *                  Returns: bool - True if empty
+ *****************************************************************************/
+bool PermissionSet::empty() const {
+    for (std::uint64_t word : words) {
+        if (word != 0) {
+            return false;
+        }
+    }
+    return overflow.empty();
+}
+
+/******************************************************************************
+ *                  Name: clear
+ *                  Description: Removes every permission from the set
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void PermissionSet::clear() {
+    words.fill(0);
+    overflow.clear();
+}
+
+/******************************************************************************
+ *                  Name: operator|=
+ *                  Description: ORs the bitsets and merges the sorted overflow vectors
+ *                  Arguments: const PermissionSet& other - Set to merge in
+ *                  Returns: PermissionSet& - This set
+ *****************************************************************************/
+PermissionSet& PermissionSet::operator|=(const PermissionSet& other) {
+    for (std::size_t w = 0; w < kWordCount; ++w) {
+        words[w] |= other.words[w];
+    }
+    if (!other.overflow.empty()) {
+        std::vector<PermissionId> merged;
+        merged.reserve(overflow.size() + other.overflow.size());
+        std::set_union(overflow.begin(), overflow.end(), other.overflow.begin(), other.overflow.end(),
+                       std::back_inserter(merged));
+        overflow.swap(merged);
+    }
+    return *this;
+}
+
+/******************************************************************************
+ *                  Name: operator==
+ *                  Description: Compares two sets for identical membership
+ *                  Arguments: const PermissionSet& other - Set to compare with
+ *                  Returns: bool - True if both sets hold the same IDs
+ *****************************************************************************/
+bool PermissionSet::operator==(const PermissionSet& other) const {
+    return words == other.words && overflow == other.overflow;
+}
+
+/******************************************************************************
+ *                  Name: memoryUsage
+ *                  Description: Returns the heap bytes of the overflow IDs
+ *                  Arguments: None
+ *                  Returns: std::size_t - Bytes
+ *****************************************************************************/
+std::size_t PermissionSet::memoryUsage() const {
+    return overflow.capacity() * sizeof(PermissionId);
+}
+
+/******************************** End of File ********************************/
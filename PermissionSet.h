@@ -0,0 +1,134 @@
+
+/******************************************************************************
+ *                    File Name: PermissionSet.h
+ *                    Description: Header file for PermissionSet, a dense bitset of
+ *                                 interned permission IDs with sorted overflow storage
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __PERMISSION_SET_H__
+#define __PERMISSION_SET_H__
+
+#include "BitOps.h"
+#include "PermissionRegistry.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/******************************************************************************
+ *                  Class Definition: PermissionSet
+ *                  Description: Set of permission IDs. The first kInlineBits IDs
+ *                               live in an inline bitset (O(1) add, remove and
+ *                               membership); rarer IDs beyond that spill into a
+ *                               small sorted overflow vector.
+ *****************************************************************************/
+
+class PermissionSet {
+public:
+    static constexpr PermissionId kInlineBits = 256;   // IDs held in the inline bitset
+    static constexpr std::size_t kWordCount = kInlineBits / 64;
+
+    /******************************************************************************
+     *                  Name: insert
+     *                  Description: Adds a permission ID to the set
+     *                  Arguments: PermissionId id - Permission to add
+     *                  Returns: bool - True if the ID was not already present
+     *****************************************************************************/
+    bool insert(PermissionId id);
+
+    /******************************************************************************
+     *                  Name: erase
+     *                  Description: Removes a permission ID from the set
+     *                  Arguments: PermissionId id - Permission to remove
+     *                  Returns: bool - True if the ID was present
+     *****************************************************************************/
+    bool erase(PermissionId id);
+
+    /******************************************************************************
+     *                  Name: contains
+     *                  Description: Checks whether a permission ID is in the set
+     *                  Arguments: PermissionId id - Permission to check
+     *                  Returns: bool - True if present
+     *****************************************************************************/
+    bool contains(PermissionId id) const;
+
+    /******************************************************************************
+     *                  Name: size
+     *                  Description: Returns the number of permissions in the set
+     *                  Arguments: None
+     *                  Returns: std::size_t - Number of IDs held
+     *****************************************************************************/
+    std::size_t size() const;
+
+    /******************************************************************************
+     *                  Name: empty
+     *                  Description: Checks whether the set holds no permissions
+     *                  Arguments: None
+     *                  Returns: bool - True if empty
+     *****************************************************************************/
+    bool empty() const;
+
+    /******************************************************************************
+     *                  Name: clear
+     *                  Description: Removes every permission from the set
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void clear();
+
+    /******************************************************************************
+     *                  Name: forEach
+     *                  Description: Calls fn(PermissionId) for every member in
+     *                               ascending ID order
+     *                  Arguments: Fn fn - Callback invoked per permission ID
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (std::size_t w = 0; w < kWordCount; ++w) {
+            std::uint64_t bits = words[w];
+            while (bits != 0) {
+                unsigned bit = countTrailingZeros(bits);
+                fn(static_cast<PermissionId>(w * 64 + bit));
+                bits &= bits - 1;
+            }
+        }
+        for (PermissionId id : overflow) {
+            fn(id);
+        }
+    }
+
+    /******************************************************************************
+     *                  Name: operator|=
+     *                  Description: Adds every member of another set, a word-wise OR
+     *                               for inline IDs
+     *                  Arguments: const PermissionSet& other - Set to merge in
+     *                  Returns: PermissionSet& - This set
+     *****************************************************************************/
+    PermissionSet& operator|=(const PermissionSet& other);
+
+    bool operator==(const PermissionSet& other) const;
+    bool operator!=(const PermissionSet& other) const { return !(*this == other); }
+
+    /******************************************************************************
+     *                  Name: memoryUsage
+     *                  Description: Returns the heap bytes of the overflow IDs; the
+     *                               inline bitset lives in the object itself
+     *                  Arguments: None
+     *                  Returns: std::size_t - Bytes
+     *****************************************************************************/
+    std::size_t memoryUsage() const;
+
+private:
+    std::array<std::uint64_t, kWordCount> words{};  // Bitset for IDs below kInlineBits
+    std::vector<PermissionId> overflow;             // Sorted IDs at or above kInlineBits
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,785 @@
+
+/******************************************************************************
+ *                    File Name: RecordStream.cpp
+ *                    Description: Implementation file for the JSON Lines and CSV
+ *                                 record reader and writer
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "RecordStream.h"
+#include "BitOps.h"
+#include <algorithm>  // For std::max, std::min
+#include <cstring>    // For std::memchr, std::memmove
+#include <utility>    // For std::move
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr std::size_t kMinBufferBytes = 64;   // Smallest read buffer
+
+/******************************************************************************
+ *                  Name: firstSetBit
+ *                  Description: Returns the index of the lowest set bit
+ *                  Arguments: unsigned bits - Non-zero mask
+ *                  Returns: unsigned - Bit index
+ *****************************************************************************/
+inline unsigned firstSetBit(unsigned bits) {
+    return countTrailingZeros32(bits);
+}
+
+/******************************************************************************
+ *                  Name: findAny
+ *                  Description: Finds the first byte equal to a, b or c, comparing
+ *                               32 bytes per AVX2 step or 16 per SSE2 step and
+ *                               finishing the tail one byte at a time
+ *                  Arguments: const char* pos - Start of the range
+ *                             const char* end - End of the range
+ *                             char a, char b, char c - Bytes to look for
+ *                  Returns: const char* - First match, or end
+ *****************************************************************************/
+const char* findAny(const char* pos, const char* end, char a, char b, char c) {
+#if defined(__AVX2__)
+    const __m256i wantA = _mm256_set1_epi8(a);
+    const __m256i wantB = _mm256_set1_epi8(b);
+    const __m256i wantC = _mm256_set1_epi8(c);
+    while (end - pos >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos));
+        __m256i hits = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, wantA), _mm256_cmpeq_epi8(block, wantB)),
+                                       _mm256_cmpeq_epi8(block, wantC));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+        if (mask != 0) {
+            return pos + firstSetBit(mask);
+        }
+        pos += 32;
+    }
+#elif defined(__SSE2__)
+    const __m128i wantA = _mm_set1_epi8(a);
+    const __m128i wantB = _mm_set1_epi8(b);
+    const __m128i wantC = _mm_set1_epi8(c);
+    while (end - pos >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, wantA), _mm_cmpeq_epi8(block, wantB)),
+                                    _mm_cmpeq_epi8(block, wantC));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+        if (mask != 0) {
+            return pos + firstSetBit(mask);
+        }
+        pos += 16;
+    }
+#endif
+    for (; pos != end; ++pos) {
+        if (*pos == a || *pos == b || *pos == c) {
+            return pos;
+        }
+    }
+    return end;
+}
+
+/******************************************************************************
+ *                  Name: skipSpace
+ *                  Description: Advances past JSON whitespace within a line
+ *                  Arguments: const char*& pos - Cursor, advanced
+ *                             const char* end - End of the line
+ *                  Returns: None
+ *****************************************************************************/
+inline void skipSpace(const char*& pos, const char* end) {
+    while (pos != end && (*pos == ' ' || *pos == '\t' || *pos == '\r')) {
+        ++pos;
+    }
+}
+
+/******************************************************************************
+ *                  Name: at
+ *                  Description: Returns the byte at a position, or -1 past the end
+ *                  Arguments: const char* pos - Position
+ *                             const char* end - End of the line
+ *                  Returns: int - Byte value or -1
+ *****************************************************************************/
+inline int at(const char* pos, const char* end) {
+    return pos != end ? static_cast<unsigned char>(*pos) : -1;
+}
+
+/******************************************************************************
+ *                  Name: parseHex4
+ *                  Description: Parses the four hex digits of a \u escape
+ *                  Arguments: const char* pos - First digit
+ *                             const char* end - End of the line
+ *                             std::uint32_t& value - Receives the code unit
+ *                  Returns: bool - False if fewer than four hex digits follow
+ *****************************************************************************/
+bool parseHex4(const char* pos, const char* end, std::uint32_t& value) {
+    if (end - pos < 4) {
+        return false;
+    }
+    value = 0;
+    for (int i = 0; i < 4; ++i) {
+        char c = pos[i];
+        std::uint32_t digit;
+        if (c >= '0' && c <= '9') {
+            digit = static_cast<std::uint32_t>(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            digit = static_cast<std::uint32_t>(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            digit = static_cast<std::uint32_t>(c - 'A' + 10);
+        } else {
+            return false;
+        }
+        value = value * 16 + digit;
+    }
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: appendUtf8
+ *                  Description: Appends a code point encoded as UTF-8
+ *                  Arguments: std::string& out - Destination
+ *                             std::uint32_t code - Code point
+ *                  Returns: None
+ *****************************************************************************/
+void appendUtf8(std::string& out, std::uint32_t code) {
+    if (code < 0x80) {
+        out += static_cast<char>(code);
+    } else if (code < 0x800) {
+        out += static_cast<char>(0xC0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        out += static_cast<char>(0xE0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (code >> 18));
+        out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+
+}  // namespace
+
+/******************************************************************************
+ *                  Constructor: RecordReader
+ *                  Description: Allocates the read buffer
+ *                  Arguments: RecordFormat format - Format of the input
+ *                             Source source - Byte source
+ *                             std::size_t chunkBytes - Bytes read at a time
+ *                  Returns: None
+ *****************************************************************************/
+RecordReader::RecordReader(RecordFormat format, Source source, std::size_t chunkBytes)
+    : format(format), source(std::move(source)), chunkBytes(std::max(chunkBytes, kMinBufferBytes)),
+      buffer(this->chunkBytes) {}
+
+/******************************************************************************
+ *                  Name: next
+ *                  Description: Parses from the unread part of the buffer, refilling
+ *                               it whenever a record runs past the bytes read so far
+ *                  Arguments: None
+ *                  Returns: Result - Record, Malformed, End or Error
+ *****************************************************************************/
+RecordReader::Result RecordReader::next() {
+    for (;;) {
+        if (begin == end) {
+            if (exhausted) {
+                return Result::End;
+            }
+            if (!fill() && failed) {
+                return Result::Error;
+            }
+            continue;
+        }
+        const char* cursor = buffer.data() + begin;
+        Parse parse = format == RecordFormat::Csv ? parseCsv(cursor) : parseJson(cursor);
+        if (parse == Parse::Incomplete) {
+            if (!fill() && failed) {
+                return Result::Error;
+            }
+            continue;
+        }
+        begin = static_cast<std::size_t>(cursor - buffer.data());
+        if (parse == Parse::Skip) {
+            continue;
+        }
+        if (parse == Parse::Malformed || !finishRecord()) {
+            return Result::Malformed;
+        }
+        return Result::Record;
+    }
+}
+
+/******************************************************************************
+ *                  Name: appName
+ *                  Description: Returns the app name of the current record
+ *                  Arguments: None
+ *                  Returns: std::string_view - Name, valid until next()
+ *****************************************************************************/
+std::string_view RecordReader::appName() const {
+    return app;
+}
+
+/******************************************************************************
+ *                  Name: permissions
+ *                  Description: Returns the permissions of the current record
+ *                  Arguments: None
+ *                  Returns: const std::vector<std::string_view>& - Names
+ *****************************************************************************/
+const std::vector<std::string_view>& RecordReader::permissions() const {
+    return names;
+}
+
+/******************************************************************************
+ *                  Name: bytesRead
+ *                  Description: Returns the bytes read from the source so far
+ *                  Arguments: None
+ *                  Returns: std::uint64_t - Bytes
+ *****************************************************************************/
+std::uint64_t RecordReader::bytesRead() const {
+    return total;
+}
+
+/******************************************************************************
+ *                  Name: fill
+ *                  Description: Moves the unparsed tail to the front of the buffer,
+ *                               doubles the buffer if the tail fills it, and reads
+ *                               as much as fits
+ *                  Arguments: None
+ *                  Returns: bool - False at the end of the source or on an error
+ *****************************************************************************/
+bool RecordReader::fill() {
+    if (exhausted || failed) {
+        return false;
+    }
+    if (begin > 0) {
+        std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+    }
+    if (end == buffer.size()) {
+        buffer.resize(buffer.size() * 2);
+    }
+    std::ptrdiff_t count = source(buffer.data() + end, std::min(chunkBytes, buffer.size() - end));
+    if (count < 0) {
+        failed = true;
+        return false;
+    }
+    if (count == 0) {
+        exhausted = true;
+        return false;
+    }
+    end += static_cast<std::size_t>(count);
+    total += static_cast<std::uint64_t>(count);
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: parseCsv
+ *                  Description: Parses one CSV row: the app name, then one
+ *                               permission per field
+ *                  Arguments: const char*& cursor - Start of the row; advanced past
+ *                                                   it unless Incomplete
+ *                  Returns: Parse - Record, Skip for a blank line, Malformed or
+ *                           Incomplete
+ *****************************************************************************/
+RecordReader::Parse RecordReader::parseCsv(const char*& cursor) {
+    const char* last = buffer.data() + end;
+    const char* pos = cursor;
+    if (*pos == '\n' || (*pos == '\r' && pos + 1 != last && pos[1] == '\n')) {
+        cursor = pos + (*pos == '\n' ? 1 : 2);
+        return Parse::Skip;
+    }
+    fields.clear();
+    scratch.clear();
+    for (;;) {
+        Field field;
+        bool incomplete = false;
+        if (!parseCsvField(pos, last, field, incomplete)) {
+            return incomplete ? Parse::Incomplete : skipLine(pos, cursor);
+        }
+        fields.push_back(field);
+        if (pos == last) {
+            if (!exhausted) {
+                return Parse::Incomplete;
+            }
+            break;
+        }
+        ++pos;
+        if (pos[-1] == '\n') {
+            break;
+        }
+    }
+    cursor = pos;
+    return Parse::Record;
+}
+
+/******************************************************************************
+ *                  Name: parseCsvField
+ *                  Description: Parses one field and leaves pos on the comma or line
+ *                               end after it, or at the end of the input. Doubled
+ *                               quotes in a quoted field are unescaped into scratch.
+ *                  Arguments: const char*& pos - Start of the field, advanced
+ *                             const char* last - End of the input read so far
+ *                             Field& field - Receives the field
+ *                             bool& incomplete - Set if more input is needed
+ *                  Returns: bool - False if the field is malformed or incomplete
+ *****************************************************************************/
+bool RecordReader::parseCsvField(const char*& pos, const char* last, Field& field, bool& incomplete) {
+    if (pos == last || *pos != '"') {
+        const char* stop = findAny(pos, last, ',', '\n', '\n');
+        field.data = pos;
+        field.length = static_cast<std::size_t>(stop - pos);
+        if (field.length > 0 && (stop == last || *stop == '\n') && stop[-1] == '\r') {
+            --field.length;
+        }
+        pos = stop;
+        return true;
+    }
+
+    const char* start = pos + 1;
+    const char* run = start;
+    bool escaped = false;
+    for (;;) {
+        const char* quote = findAny(run, last, '"', '"', '"');
+        if (quote == last || (quote + 1 == last && !exhausted)) {
+            incomplete = !exhausted;
+            return false;
+        }
+        if (quote + 1 != last && quote[1] == '"') {
+            if (!escaped) {
+                escaped = true;
+                field.offset = scratch.size();
+            }
+            scratch.append(run, quote + 1);
+            run = quote + 2;
+            continue;
+        }
+        if (escaped) {
+            scratch.append(run, quote);
+            field.data = nullptr;
+            field.length = scratch.size() - field.offset;
+        } else {
+            field.data = start;
+            field.length = static_cast<std::size_t>(quote - start);
+        }
+        pos = quote + 1;
+        break;
+    }
+    if (pos != last && *pos == '\r') {
+        if (pos + 1 == last && !exhausted) {
+            incomplete = true;
+            return false;
+        }
+        if (pos + 1 != last && pos[1] == '\n') {
+            ++pos;
+        }
+    }
+    return pos == last || *pos == ',' || *pos == '\n';
+}
+
+/******************************************************************************
+ *                  Name: parseJson
+ *                  Description: Parses one line holding a JSON object with an "app"
+ *                               string and an optional "permissions" array of
+ *                               strings; other members are skipped
+ *                  Arguments: const char*& cursor - Start of the line; advanced past
+ *                                                   it unless Incomplete
+ *                  Returns: Parse - Record, Skip for a blank line, Malformed or
+ *                           Incomplete
+ *****************************************************************************/
+RecordReader::Parse RecordReader::parseJson(const char*& cursor) {
+    const char* last = buffer.data() + end;
+    const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<std::size_t>(last - cursor)));
+    if (lineEnd == nullptr) {
+        if (!exhausted) {
+            return Parse::Incomplete;
+        }
+        lineEnd = last;
+    }
+    const char* pos = cursor;
+    cursor = lineEnd == last ? last : lineEnd + 1;
+
+    skipSpace(pos, lineEnd);
+    if (pos == lineEnd) {
+        return Parse::Skip;
+    }
+    fields.clear();
+    scratch.clear();
+    fields.emplace_back();
+    bool haveApp = false;
+    if (*pos++ != '{') {
+        return Parse::Malformed;
+    }
+    skipSpace(pos, lineEnd);
+    if (at(pos, lineEnd) == '}') {
+        return Parse::Malformed;
+    }
+    for (;;) {
+        Field key;
+        if (!parseJsonString(pos, lineEnd, &key)) {
+            return Parse::Malformed;
+        }
+        std::string_view keyName = key.data != nullptr ? std::string_view(key.data, key.length)
+                                                       : std::string_view(scratch.data() + key.offset, key.length);
+        bool isApp = keyName == "app";
+        bool isPermissions = keyName == "permissions";
+        skipSpace(pos, lineEnd);
+        if (at(pos, lineEnd) != ':') {
+            return Parse::Malformed;
+        }
+        ++pos;
+        skipSpace(pos, lineEnd);
+        if (isApp) {
+            if (!parseJsonString(pos, lineEnd, &fields[0])) {
+                return Parse::Malformed;
+            }
+            haveApp = true;
+        } else if (isPermissions) {
+            if (at(pos, lineEnd) != '[') {
+                return Parse::Malformed;
+            }
+            ++pos;
+            skipSpace(pos, lineEnd);
+            if (at(pos, lineEnd) == ']') {
+                ++pos;
+            } else {
+                for (;;) {
+                    Field permission;
+                    if (!parseJsonString(pos, lineEnd, &permission) || permission.length == 0) {
+                        return Parse::Malformed;
+                    }
+                    fields.push_back(permission);
+                    skipSpace(pos, lineEnd);
+                    int c = at(pos, lineEnd);
+                    if (c != ',' && c != ']') {
+                        return Parse::Malformed;
+                    }
+                    ++pos;
+                    if (c == ']') {
+                        break;
+                    }
+                    skipSpace(pos, lineEnd);
+                }
+            }
+        } else if (!skipJsonValue(pos, lineEnd)) {
+            return Parse::Malformed;
+        }
+        skipSpace(pos, lineEnd);
+        int c = at(pos, lineEnd);
+        if (c != ',' && c != '}') {
+            return Parse::Malformed;
+        }
+        ++pos;
+        if (c == '}') {
+            break;
+        }
+        skipSpace(pos, lineEnd);
+    }
+    skipSpace(pos, lineEnd);
+    return pos == lineEnd && haveApp ? Parse::Record : Parse::Malformed;
+}
+
+/******************************************************************************
+ *                  Name: parseJsonString
+ *                  Description: Parses a JSON string. Runs without escapes are found
+ *                               with findAny; a string with escapes is decoded into
+ *                               scratch, \u escapes and surrogate pairs as UTF-8.
+ *                  Arguments: const char*& pos - Opening quote, advanced past the
+ *                                                closing quote
+ *                             const char* lineEnd - End of the line
+ *                             Field* field - Receives the string, or null to discard
+ *                  Returns: bool - False if the string is malformed
+ *****************************************************************************/
+bool RecordReader::parseJsonString(const char*& pos, const char* lineEnd, Field* field) {
+    if (at(pos, lineEnd) != '"') {
+        return false;
+    }
+    const char* start = pos + 1;
+    const char* run = start;
+    std::size_t offset = scratch.size();
+    bool escaped = false;
+    for (;;) {
+        const char* stop = findAny(run, lineEnd, '"', '\\', '\\');
+        if (stop == lineEnd) {
+            return false;
+        }
+        if (*stop == '"') {
+            if (field == nullptr) {
+                scratch.resize(offset);
+            } else if (escaped) {
+                scratch.append(run, stop);
+                field->data = nullptr;
+                field->offset = offset;
+                field->length = scratch.size() - offset;
+            } else {
+                field->data = start;
+                field->length = static_cast<std::size_t>(stop - start);
+            }
+            pos = stop + 1;
+            return true;
+        }
+        escaped = true;
+        scratch.append(run, stop);
+        if (stop + 1 == lineEnd) {
+            return false;
+        }
+        run = stop + 2;
+        switch (stop[1]) {
+        case '"':  scratch += '"';  break;
+        case '\\': scratch += '\\'; break;
+        case '/':  scratch += '/';  break;
+        case 'b':  scratch += '\b'; break;
+        case 'f':  scratch += '\f'; break;
+        case 'n':  scratch += '\n'; break;
+        case 'r':  scratch += '\r'; break;
+        case 't':  scratch += '\t'; break;
+        case 'u': {
+            std::uint32_t code;
+            if (!parseHex4(run, lineEnd, code)) {
+                return false;
+            }
+            run += 4;
+            if (code >= 0xD800 && code < 0xDC00) {
+                std::uint32_t low;
+                if (lineEnd - run < 6 || run[0] != '\\' || run[1] != 'u' || !parseHex4(run + 2, lineEnd, low) ||
+                    low < 0xDC00 || low >= 0xE000) {
+                    return false;
+                }
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                run += 6;
+            } else if (code >= 0xDC00 && code < 0xE000) {
+                return false;
+            }
+            appendUtf8(scratch, code);
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+}
+
+/******************************************************************************
+ *                  Name: skipJsonValue
+ *                  Description: Skips a member value the reader does not use: a
+ *                               string, a scalar, or a nested object or array
+ *                  Arguments: const char*& pos - Start of the value, advanced
+ *                             const char* lineEnd - End of the line
+ *                  Returns: bool - False if the value is malformed
+ *****************************************************************************/
+bool RecordReader::skipJsonValue(const char*& pos, const char* lineEnd) {
+    int c = at(pos, lineEnd);
+    if (c == '"') {
+        return parseJsonString(pos, lineEnd, nullptr);
+    }
+    if (c == '{' || c == '[') {
+        std::size_t depth = 0;
+        while (pos != lineEnd) {
+            if (*pos == '"') {
+                if (!parseJsonString(pos, lineEnd, nullptr)) {
+                    return false;
+                }
+                continue;
+            }
+            if (*pos == '{' || *pos == '[') {
+                ++depth;
+            } else if ((*pos == '}' || *pos == ']') && --depth == 0) {
+                ++pos;
+                return true;
+            }
+            ++pos;
+        }
+        return false;
+    }
+    const char* start = pos;
+    while (pos != lineEnd && *pos != ',' && *pos != '}' && *pos != ']' && *pos != ' ' && *pos != '\t' &&
+           *pos != '\r') {
+        ++pos;
+    }
+    return pos != start;
+}
+
+/******************************************************************************
+ *                  Name: skipLine
+ *                  Description: Skips the rest of a malformed CSV row up to the next
+ *                               line end
+ *                  Arguments: const char* from - Where the row went wrong
+ *                             const char*& cursor - Advanced past the line end
+ *                  Returns: Parse - Malformed, or Incomplete if no line end has
+ *                           been read yet
+ *****************************************************************************/
+RecordReader::Parse RecordReader::skipLine(const char* from, const char*& cursor) {
+    const char* last = buffer.data() + end;
+    const void* newline = std::memchr(from, '\n', static_cast<std::size_t>(last - from));
+    if (newline == nullptr) {
+        if (!exhausted) {
+            return Parse::Incomplete;
+        }
+        cursor = last;
+    } else {
+        cursor = static_cast<const char*>(newline) + 1;
+    }
+    return Parse::Malformed;
+}
+
+/******************************************************************************
+ *                  Name: finishRecord
+ *                  Description: Turns the parsed fields into views; empty CSV
+ *                               permission fields, such as padding columns, are
+ *                               dropped
+ *                  Arguments: None
+ *                  Returns: bool - False if the app name is empty
+ *****************************************************************************/
+bool RecordReader::finishRecord() {
+    auto view = [&](const Field& field) {
+        return field.data != nullptr ? std::string_view(field.data, field.length)
+                                     : std::string_view(scratch.data() + field.offset, field.length);
+    };
+    app = view(fields[0]);
+    names.clear();
+    for (std::size_t i = 1; i < fields.size(); ++i) {
+        if (fields[i].length > 0) {
+            names.push_back(view(fields[i]));
+        }
+    }
+    return !app.empty();
+}
+
+/******************************************************************************
+ *                  Constructor: RecordWriter
+ *                  Description: Reserves the output buffer
+ *                  Arguments: RecordFormat format - Format of the output
+ *                             Sink sink - Byte sink
+ *                             std::size_t bufferBytes - Bytes buffered per write
+ *                  Returns: None
+ *****************************************************************************/
+RecordWriter::RecordWriter(RecordFormat format, Sink sink, std::size_t bufferBytes)
+    : format(format), sink(std::move(sink)), bufferBytes(std::max(bufferBytes, kMinBufferBytes)) {
+    buffer.reserve(this->bufferBytes);
+}
+
+/******************************************************************************
+ *                  Name: beginRecord
+ *                  Description: Writes the app name field
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: None
+ *****************************************************************************/
+void RecordWriter::beginRecord(std::string_view appName) {
+    if (format == RecordFormat::JsonLines) {
+        buffer += "{\"app\":";
+        appendField(appName);
+        buffer += ",\"permissions\":[";
+    } else {
+        appendField(appName);
+    }
+    first = true;
+}
+
+/******************************************************************************
+ *                  Name: addPermission
+ *                  Description: Writes a separator and the permission field
+ *                  Arguments: std::string_view permission - Permission name
+ *                  Returns: None
+ *****************************************************************************/
+void RecordWriter::addPermission(std::string_view permission) {
+    if (format == RecordFormat::Csv || !first) {
+        buffer += ',';
+    }
+    appendField(permission);
+    first = false;
+}
+
+/******************************************************************************
+ *                  Name: endRecord
+ *                  Description: Terminates the record and flushes a full buffer
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void RecordWriter::endRecord() {
+    buffer += format == RecordFormat::JsonLines ? "]}\n" : "\n";
+    if (buffer.size() >= bufferBytes) {
+        flush();
+    }
+}
+
+/******************************************************************************
+ *                  Name: finish
+ *                  Description: Flushes the buffer
+ *                  Arguments: None
+ *                  Returns: bool - False if any write to the sink failed
+ *****************************************************************************/
+bool RecordWriter::finish() {
+    flush();
+    return !failed;
+}
+
+/******************************************************************************
+ *                  Name: appendField
+ *                  Description: Appends a JSON string with escapes, or a CSV field,
+ *                               quoted only when it holds a delimiter or a quote
+ *                  Arguments: std::string_view text - Field text
+ *                  Returns: None
+ *****************************************************************************/
+void RecordWriter::appendField(std::string_view text) {
+    const char* pos = text.data();
+    const char* stop = pos + text.size();
+    if (format == RecordFormat::JsonLines) {
+        static const char kHex[] = "0123456789abcdef";
+        buffer += '"';
+        const char* run = pos;
+        for (; pos != stop; ++pos) {
+            unsigned char c = static_cast<unsigned char>(*pos);
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                continue;
+            }
+            buffer.append(run, pos);
+            run = pos + 1;
+            switch (c) {
+            case '"':  buffer += "\\\""; break;
+            case '\\': buffer += "\\\\"; break;
+            case '\n': buffer += "\\n";  break;
+            case '\r': buffer += "\\r";  break;
+            case '\t': buffer += "\\t";  break;
+            default:
+                buffer += "\\u00";
+                buffer += kHex[c >> 4];
+                buffer += kHex[c & 0xF];
+                break;
+            }
+        }
+        buffer.append(run, stop);
+        buffer += '"';
+        return;
+    }
+
+    if (findAny(pos, stop, ',', '"', '\n') == stop && std::memchr(pos, '\r', text.size()) == nullptr) {
+        buffer.append(pos, stop);
+        return;
+    }
+    buffer += '"';
+    for (const char* quote; (quote = findAny(pos, stop, '"', '"', '"')) != stop; pos = quote + 1) {
+        buffer.append(pos, quote + 1);
+        buffer += '"';
+    }
+    buffer.append(pos, stop);
+    buffer += '"';
+}
+
+/******************************************************************************
+ *                  Name: flush
+ *                  Description: Hands the buffer to the sink and empties it
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void RecordWriter::flush() {
+    if (!failed && !buffer.empty()) {
+        failed = !sink(buffer.data(), buffer.size());
+    }
+    buffer.clear();
+}
+
+/******************************** End of File ********************************/
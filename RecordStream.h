@@ -0,0 +1,232 @@
+
+/******************************************************************************
+ *                    File Name: RecordStream.h
+ *                    Description: Header file for RecordReader and RecordWriter,
+ *                                 which stream app records in JSON Lines or CSV
+ *                                 for bulk import and export
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __RECORD_STREAM_H__
+#define __RECORD_STREAM_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/******************************************************************************
+ *                  Enum Definition: RecordFormat
+ *                  Description: Text format of an app record stream. Each record is
+ *                               one app and its direct permissions:
+ *                                 JsonLines: {"app":"Maps","permissions":["GPS"]}
+ *                                 Csv:       Maps,GPS
+ *                               CSV fields follow RFC 4180 quoting; JSON strings
+ *                               accept every escape, and other keys are ignored.
+ *****************************************************************************/
+
+enum class RecordFormat : std::uint8_t {
+    JsonLines,
+    Csv
+};
+
+/******************************************************************************
+ *                  Structure Definition: ImportStats
+ *                  Description: Totals of one import
+ *****************************************************************************/
+
+struct ImportStats {
+    std::uint64_t bytes = 0;       // Input bytes read
+    std::uint64_t records = 0;     // Records applied
+    std::uint64_t installed = 0;   // Apps that were not installed before
+    std::uint64_t granted = 0;     // Permissions the apps did not already hold
+    std::uint64_t malformed = 0;   // Records skipped as malformed
+};
+
+/******************************************************************************
+ *                  Class Definition: RecordReader
+ *                  Description: Pull parser over a byte source. Input is read in
+ *                               chunks into one buffer, which only grows when a
+ *                               single record is larger than it; quotes, escapes
+ *                               and delimiters are located 16 or 32 bytes at a
+ *                               time with SSE2 or AVX2. The fields of a record are
+ *                               views into the buffer, or into a scratch string
+ *                               for fields that had escapes, so steady-state
+ *                               parsing allocates nothing.
+ *****************************************************************************/
+
+class RecordReader {
+public:
+    // Reads up to size bytes into buffer; returns the count, 0 at the end or -1 on error
+    using Source = std::function<std::ptrdiff_t(char* buffer, std::size_t size)>;
+
+    static constexpr std::size_t kDefaultChunkBytes = std::size_t(1) << 20;   // Bytes read at a time
+
+    /******************************************************************************
+     *                  Enum Definition: Result
+     *                  Description: Outcome of next()
+     *****************************************************************************/
+    enum class Result : std::uint8_t {
+        Record,      // appName() and permissions() hold a record
+        Malformed,   // A record was skipped; parsing continues after it
+        End,         // The source is exhausted
+        Error        // The source failed
+    };
+
+    /******************************************************************************
+     *                  Name: RecordReader
+     *                  Description: Constructor binding the format and the source
+     *                  Arguments: RecordFormat format - Format of the input
+     *                             Source source - Byte source
+     *                             std::size_t chunkBytes - Bytes read at a time
+     *                  Returns: None
+     *****************************************************************************/
+    RecordReader(RecordFormat format, Source source, std::size_t chunkBytes = kDefaultChunkBytes);
+
+    /******************************************************************************
+     *                  Name: next
+     *                  Description: Parses the next record, skipping blank lines. The
+     *                               views of the previous record become invalid.
+     *                  Arguments: None
+     *                  Returns: Result - Record, Malformed, End or Error
+     *****************************************************************************/
+    Result next();
+
+    /******************************************************************************
+     *                  Name: appName
+     *                  Description: Returns the app name of the current record
+     *                  Arguments: None
+     *                  Returns: std::string_view - Name, valid until next()
+     *****************************************************************************/
+    std::string_view appName() const;
+
+    /******************************************************************************
+     *                  Name: permissions
+     *                  Description: Returns the permissions of the current record
+     *                  Arguments: None
+     *                  Returns: const std::vector<std::string_view>& - Names, valid
+     *                           until next()
+     *****************************************************************************/
+    const std::vector<std::string_view>& permissions() const;
+
+    /******************************************************************************
+     *                  Name: bytesRead
+     *                  Description: Returns the bytes read from the source so far
+     *                  Arguments: None
+     *                  Returns: std::uint64_t - Bytes
+     *****************************************************************************/
+    std::uint64_t bytesRead() const;
+
+private:
+    enum class Parse : std::uint8_t { Record, Skip, Malformed, Incomplete };
+
+    struct Field {
+        const char* data = nullptr;   // Start in the buffer, or null if in scratch
+        std::size_t offset = 0;       // Start in scratch when data is null
+        std::size_t length = 0;       // Bytes
+    };
+
+    bool fill();
+    Parse parseCsv(const char*& cursor);
+    Parse parseJson(const char*& cursor);
+    bool parseCsvField(const char*& pos, const char* end, Field& field, bool& incomplete);
+    bool parseJsonString(const char*& pos, const char* end, Field* field);
+    bool skipJsonValue(const char*& pos, const char* end);
+    Parse skipLine(const char* from, const char*& cursor);
+    bool finishRecord();
+
+    RecordFormat format;                       // Format of the input
+    Source source;                             // Byte source
+    std::size_t chunkBytes;                    // Bytes read at a time
+    std::vector<char> buffer;                  // Unparsed input lives in [begin, end)
+    std::size_t begin = 0;                     // First unparsed byte
+    std::size_t end = 0;                       // One past the last byte read
+    bool exhausted = false;                    // The source returned 0
+    bool failed = false;                       // The source returned an error
+    std::uint64_t total = 0;                   // Bytes read so far
+    std::string scratch;                       // Unescaped fields of the current record
+    std::vector<Field> fields;                 // Fields of the current record, app first
+    std::string_view app;                      // App name of the current record
+    std::vector<std::string_view> names;       // Permissions of the current record
+};
+
+/******************************************************************************
+ *                  Class Definition: RecordWriter
+ *                  Description: Formats app records into a buffer that is handed
+ *                               to the sink whenever it passes bufferBytes, so
+ *                               memory stays bounded however many apps are written.
+ *                               A failed sink write is sticky.
+ *****************************************************************************/
+
+class RecordWriter {
+public:
+    // Writes size bytes; returns false on error
+    using Sink = std::function<bool(const char* data, std::size_t size)>;
+
+    static constexpr std::size_t kDefaultBufferBytes = std::size_t(1) << 20;   // Bytes buffered per write
+
+    /******************************************************************************
+     *                  Name: RecordWriter
+     *                  Description: Constructor binding the format and the sink
+     *                  Arguments: RecordFormat format - Format of the output
+     *                             Sink sink - Byte sink
+     *                             std::size_t bufferBytes - Bytes buffered per write
+     *                  Returns: None
+     *****************************************************************************/
+    RecordWriter(RecordFormat format, Sink sink, std::size_t bufferBytes = kDefaultBufferBytes);
+
+    /******************************************************************************
+     *                  Name: beginRecord
+     *                  Description: Starts the record of an app
+     *                  Arguments: std::string_view appName - Name of the application
+     *                  Returns: None
+     *****************************************************************************/
+    void beginRecord(std::string_view appName);
+
+    /******************************************************************************
+     *                  Name: addPermission
+     *                  Description: Adds a permission to the current record
+     *                  Arguments: std::string_view permission - Permission name
+     *                  Returns: None
+     *****************************************************************************/
+    void addPermission(std::string_view permission);
+
+    /******************************************************************************
+     *                  Name: endRecord
+     *                  Description: Closes the current record, flushing if the buffer
+     *                               is full
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void endRecord();
+
+    /******************************************************************************
+     *                  Name: finish
+     *                  Description: Writes out whatever is buffered
+     *                  Arguments: None
+     *                  Returns: bool - False if any write to the sink failed
+     *****************************************************************************/
+    bool finish();
+
+private:
+    void appendField(std::string_view text);
+    void flush();
+
+    RecordFormat format;       // Format of the output
+    Sink sink;                 // Byte sink
+    std::size_t bufferBytes;   // Flush threshold
+    std::string buffer;        // Formatted, unwritten output
+    bool first = true;         // No permission written yet in the current record
+    bool failed = false;       // A sink write failed
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,164 @@
+
+/******************************************************************************
+ *                    File Name: RingBuffer.h
+ *                    Description: Header file for RingBuffer, a bounded lock-free
+ *                                 multi-producer multi-consumer queue
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __RING_BUFFER_H__
+#define __RING_BUFFER_H__
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/******************************************************************************
+ *                  Class Definition: RingBuffer
+ *                  Description: Fixed-capacity queue where every slot carries a
+ *                               sequence number. Producers and consumers claim
+ *                               slots with a single compare-and-swap on their own
+ *                               cursor and never block; a full push or an empty
+ *                               pop simply fails. Capacity is rounded up to a
+ *                               power of two.
+ *****************************************************************************/
+
+template <typename T>
+class RingBuffer {
+public:
+    /******************************************************************************
+     *                  Name: RingBuffer
+     *                  Description: Constructor allocating the slots
+     *                  Arguments: std::size_t capacity - Minimum number of slots (at least 2)
+     *                  Returns: None
+     *****************************************************************************/
+    explicit RingBuffer(std::size_t capacity) : mask(roundUp(capacity) - 1), slots(new Slot[mask + 1]) {
+        for (std::size_t i = 0; i <= mask; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    /******************************************************************************
+     *                  Name: tryPush
+     *                  Description: Appends a value if a slot is free
+     *                  Arguments: T value - Value to enqueue
+     *                  Returns: bool - False if the buffer was full
+     *****************************************************************************/
+    bool tryPush(T value) {
+        return tryPushWith([&](T& slot) { slot = std::move(value); });
+    }
+
+    /******************************************************************************
+     *                  Name: tryPushWith
+     *                  Description: Claims a free slot and lets fill write the element
+     *                               in place, so large elements are not built and then
+     *                               moved
+     *                  Arguments: Fill&& fill - Called as fill(T&) on the claimed slot
+     *                  Returns: bool - False if the buffer was full
+     *****************************************************************************/
+    template <typename Fill>
+    bool tryPushWith(Fill&& fill) {
+        std::size_t position = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[position & mask];
+            std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t lag = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (lag == 0) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    fill(slot.value);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /******************************************************************************
+     *                  Name: tryPop
+     *                  Description: Removes the oldest value if one is available
+     *                  Arguments: T& value - Receives the dequeued value
+     *                  Returns: bool - False if the buffer was empty
+     *****************************************************************************/
+    bool tryPop(T& value) {
+        return tryPopWith([&](T& slot) { value = std::move(slot); });
+    }
+
+    /******************************************************************************
+     *                  Name: tryPopWith
+     *                  Description: Removes the oldest element, letting consume read it
+     *                               in place before the slot is released
+     *                  Arguments: Consume&& consume - Called as consume(T&) on the slot
+     *                  Returns: bool - False if the buffer was empty
+     *****************************************************************************/
+    template <typename Consume>
+    bool tryPopWith(Consume&& consume) {
+        std::size_t position = head.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[position & mask];
+            std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t lag = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+            if (lag == 0) {
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    consume(slot.value);
+                    slot.sequence.store(position + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;
+            } else {
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /******************************************************************************
+     *                  Name: capacity
+     *                  Description: Returns the number of slots
+     *                  Arguments: None
+     *                  Returns: std::size_t - Slot count
+     *****************************************************************************/
+    std::size_t capacity() const {
+        return mask + 1;
+    }
+
+private:
+    /******************************************************************************
+     *                  Structure Definition: Slot
+     *                  Description: One queue cell and the sequence number that says
+     *                               whether it is ready to be written or read
+     *****************************************************************************/
+    struct Slot {
+        std::atomic<std::size_t> sequence;  // Position this slot expects next
+        T value;                            // Stored element
+    };
+
+    static std::size_t roundUp(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    const std::size_t mask;                              // Slot count minus one
+    std::unique_ptr<Slot[]> slots;                       // Circular slot array
+    alignas(64) std::atomic<std::size_t> tail{0};        // Next position to push
+    alignas(64) std::atomic<std::size_t> head{0};        // Next position to pop
+};
+
+#endif
+
+/******************************** End of File ********************************/
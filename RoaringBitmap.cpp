@@ -0,0 +1,515 @@
+
+/******************************************************************************
+ *                    File Name: RoaringBitmap.cpp
+ *                    Description: Implementation file for the compressed bitmap
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "RoaringBitmap.h"
+#include "BitOps.h"
+#include <algorithm>  // For std::lower_bound, std::set_intersection, std::set_union, std::set_difference
+#include <iterator>   // For std::back_inserter
+#include <utility>    // For std::move
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/******************************************************************************
+ *                  Enum Definition: WordOp
+ *                  Description: Word-wise operation of a bitmap kernel
+ *****************************************************************************/
+enum class WordOp {
+    And,
+    Or,
+    AndNot
+};
+
+/******************************************************************************
+ *                  Name: popcount64
+ *                  Description: Counts the set bits of a word
+ *                  Arguments: std::uint64_t bits - Word to count
+ *                  Returns: std::uint32_t - Set bits
+ *****************************************************************************/
+std::uint32_t popcount64(std::uint64_t bits) {
+    return popCount(bits);
+}
+
+/******************************************************************************
+ *                  Name: combineWords
+ *                  Description: Applies op to two bitmap containers word by word,
+ *                               four words per AVX2 instruction or two per SSE2
+ *                               instruction, then counts the result
+ *                  Arguments: const std::uint64_t* a - Left bitmap
+ *                             const std::uint64_t* b - Right bitmap
+ *                             std::uint64_t* out - Result, may alias neither input
+ *                  Returns: std::uint32_t - Set bits of the result
+ *****************************************************************************/
+template <WordOp op>
+std::uint32_t combineWords(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* out) {
+    std::uint32_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= RoaringBitmap::kBitmapWords; i += 4) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i r;
+        if constexpr (op == WordOp::And) {
+            r = _mm256_and_si256(x, y);
+        } else if constexpr (op == WordOp::Or) {
+            r = _mm256_or_si256(x, y);
+        } else {
+            r = _mm256_andnot_si256(y, x);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= RoaringBitmap::kBitmapWords; i += 2) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        __m128i r;
+        if constexpr (op == WordOp::And) {
+            r = _mm_and_si128(x, y);
+        } else if constexpr (op == WordOp::Or) {
+            r = _mm_or_si128(x, y);
+        } else {
+            r = _mm_andnot_si128(y, x);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), r);
+    }
+#endif
+    for (; i < RoaringBitmap::kBitmapWords; ++i) {
+        if constexpr (op == WordOp::And) {
+            out[i] = a[i] & b[i];
+        } else if constexpr (op == WordOp::Or) {
+            out[i] = a[i] | b[i];
+        } else {
+            out[i] = a[i] & ~b[i];
+        }
+    }
+    std::uint32_t count = 0;
+    for (i = 0; i < RoaringBitmap::kBitmapWords; ++i) {
+        count += popcount64(out[i]);
+    }
+    return count;
+}
+
+/******************************************************************************
+ *                  Name: testBit
+ *                  Description: Tests one bit of a bitmap container
+ *                  Arguments: const std::vector<std::uint64_t>& words - Bitmap
+ *                             std::uint16_t low - Bit number
+ *                  Returns: bool - True if set
+ *****************************************************************************/
+bool testBit(const std::vector<std::uint64_t>& words, std::uint16_t low) {
+    return (words[low >> 6] >> (low & 63)) & 1;
+}
+
+}  // namespace
+
+/******************************************************************************
+ *                  Name: add
+ *                  Description: Inserts into the value's container, creating it or
+ *                               converting it to a bitmap as needed
+ *                  Arguments: std::uint32_t value - Value to insert
+ *                  Returns: bool - False if it was already present
+ *****************************************************************************/
+bool RoaringBitmap::add(std::uint32_t value) {
+    std::uint16_t key = static_cast<std::uint16_t>(value >> 16);
+    std::uint16_t low = static_cast<std::uint16_t>(value);
+    auto it = std::lower_bound(containers.begin(), containers.end(), key,
+                               [](const Container& container, std::uint16_t k) { return container.key < k; });
+    if (it == containers.end() || it->key != key) {
+        it = containers.insert(it, Container());
+        it->key = key;
+    }
+    Container& container = *it;
+    if (!container.words.empty()) {
+        std::uint64_t& word = container.words[low >> 6];
+        std::uint64_t bit = std::uint64_t(1) << (low & 63);
+        if (word & bit) {
+            return false;
+        }
+        word |= bit;
+    } else {
+        auto position = std::lower_bound(container.values.begin(), container.values.end(), low);
+        if (position != container.values.end() && *position == low) {
+            return false;
+        }
+        container.values.insert(position, low);
+        if (container.values.size() > kArrayMax) {
+            toBitmap(container);
+        }
+    }
+    ++container.cardinality;
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: remove
+ *                  Description: Erases from the value's container, converting it back
+ *                               to an array or dropping it as needed
+ *                  Arguments: std::uint32_t value - Value to erase
+ *                  Returns: bool - False if it was not present
+ *****************************************************************************/
+bool RoaringBitmap::remove(std::uint32_t value) {
+    Container* container = find(static_cast<std::uint16_t>(value >> 16));
+    if (container == nullptr) {
+        return false;
+    }
+    std::uint16_t low = static_cast<std::uint16_t>(value);
+    if (!container->words.empty()) {
+        std::uint64_t& word = container->words[low >> 6];
+        std::uint64_t bit = std::uint64_t(1) << (low & 63);
+        if ((word & bit) == 0) {
+            return false;
+        }
+        word &= ~bit;
+        --container->cardinality;
+        normalize(*container);
+    } else {
+        auto position = std::lower_bound(container->values.begin(), container->values.end(), low);
+        if (position == container->values.end() || *position != low) {
+            return false;
+        }
+        container->values.erase(position);
+        --container->cardinality;
+    }
+    if (container->cardinality == 0) {
+        containers.erase(containers.begin() + (container - containers.data()));
+    }
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: contains
+ *                  Description: Tests membership
+ *                  Arguments: std::uint32_t value - Value to test
+ *                  Returns: bool - True if present
+ *****************************************************************************/
+bool RoaringBitmap::contains(std::uint32_t value) const {
+    const Container* container = find(static_cast<std::uint16_t>(value >> 16));
+    if (container == nullptr) {
+        return false;
+    }
+    std::uint16_t low = static_cast<std::uint16_t>(value);
+    if (!container->words.empty()) {
+        return testBit(container->words, low);
+    }
+    return std::binary_search(container->values.begin(), container->values.end(), low);
+}
+
+/******************************************************************************
+ *                  Name: cardinality
+ *                  Description: Sums the container counts
+ *                  Arguments: None
+ *                  Returns: std::uint64_t - Value count
+ *****************************************************************************/
+std::uint64_t RoaringBitmap::cardinality() const {
+    std::uint64_t total = 0;
+    for (const Container& container : containers) {
+        total += container.cardinality;
+    }
+    return total;
+}
+
+/******************************************************************************
+ *                  Name: empty
+ *                  Description: Checks for the empty set
+ *                  Arguments: None
+ *                  Returns: bool - True if no value is present
+ *****************************************************************************/
+bool RoaringBitmap::empty() const {
+    return containers.empty();
+}
+
+/******************************************************************************
+ *                  Name: clear
+ *                  Description: Removes every value
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void RoaringBitmap::clear() {
+    containers.clear();
+}
+
+/******************************************************************************
+ *                  Name: operator&=
+ *                  Description: Intersects the containers whose keys match; the rest
+ *                               are dropped
+ *                  Arguments: const RoaringBitmap& other - Set to intersect with
+ *                  Returns: RoaringBitmap& - This set
+ *****************************************************************************/
+RoaringBitmap& RoaringBitmap::operator&=(const RoaringBitmap& other) {
+    std::vector<Container> result;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < containers.size() && j < other.containers.size()) {
+        if (containers[i].key < other.containers[j].key) {
+            ++i;
+        } else if (other.containers[j].key < containers[i].key) {
+            ++j;
+        } else {
+            Container merged = intersect(containers[i++], other.containers[j++]);
+            if (merged.cardinality != 0) {
+                result.push_back(std::move(merged));
+            }
+        }
+    }
+    containers = std::move(result);
+    return *this;
+}
+
+/******************************************************************************
+ *                  Name: operator|=
+ *                  Description: Unites the containers whose keys match and copies
+ *                               in the other's remaining ones
+ *                  Arguments: const RoaringBitmap& other - Set to unite with
+ *                  Returns: RoaringBitmap& - This set
+ *****************************************************************************/
+RoaringBitmap& RoaringBitmap::operator|=(const RoaringBitmap& other) {
+    std::vector<Container> result;
+    result.reserve(containers.size() + other.containers.size());
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < containers.size() || j < other.containers.size()) {
+        if (j == other.containers.size() || (i < containers.size() && containers[i].key < other.containers[j].key)) {
+            result.push_back(std::move(containers[i++]));
+        } else if (i == containers.size() || other.containers[j].key < containers[i].key) {
+            result.push_back(other.containers[j++]);
+        } else {
+            result.push_back(unite(containers[i++], other.containers[j++]));
+        }
+    }
+    containers = std::move(result);
+    return *this;
+}
+
+/******************************************************************************
+ *                  Name: operator-=
+ *                  Description: Subtracts the other's container from each matching
+ *                               one; unmatched containers are kept as they are
+ *                  Arguments: const RoaringBitmap& other - Set to subtract
+ *                  Returns: RoaringBitmap& - This set
+ *****************************************************************************/
+RoaringBitmap& RoaringBitmap::operator-=(const RoaringBitmap& other) {
+    std::vector<Container> result;
+    result.reserve(containers.size());
+    std::size_t j = 0;
+    for (Container& container : containers) {
+        while (j < other.containers.size() && other.containers[j].key < container.key) {
+            ++j;
+        }
+        if (j == other.containers.size() || other.containers[j].key != container.key) {
+            result.push_back(std::move(container));
+            continue;
+        }
+        Container remaining = subtract(container, other.containers[j]);
+        if (remaining.cardinality != 0) {
+            result.push_back(std::move(remaining));
+        }
+    }
+    containers = std::move(result);
+    return *this;
+}
+
+/******************************************************************************
+ *                  Name: memoryUsage
+ *                  Description: Sums the container table and container payloads
+ *                  Arguments: None
+ *                  Returns: std::size_t - Bytes
+ *****************************************************************************/
+std::size_t RoaringBitmap::memoryUsage() const {
+    std::size_t bytes = containers.capacity() * sizeof(Container);
+    for (const Container& container : containers) {
+        bytes += container.values.capacity() * sizeof(std::uint16_t) + container.words.capacity() * sizeof(std::uint64_t);
+    }
+    return bytes;
+}
+
+/******************************************************************************
+ *                  Name: lowestBit
+ *                  Description: Returns the index of the lowest set bit
+ *                  Arguments: std::uint64_t bits - Non-zero word
+ *                  Returns: std::uint32_t - Bit index
+ *****************************************************************************/
+std::uint32_t RoaringBitmap::lowestBit(std::uint64_t bits) {
+    return countTrailingZeros(bits);
+}
+
+/******************************************************************************
+ *                  Name: intersect
+ *                  Description: AND of two containers with the same key
+ *                  Arguments: const Container& a, const Container& b - Operands
+ *                  Returns: Container - Result, possibly empty
+ *****************************************************************************/
+RoaringBitmap::Container RoaringBitmap::intersect(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+    if (!a.words.empty() && !b.words.empty()) {
+        result.words.resize(kBitmapWords);
+        result.cardinality = combineWords<WordOp::And>(a.words.data(), b.words.data(), result.words.data());
+        normalize(result);
+    } else if (a.words.empty() && b.words.empty()) {
+        std::set_intersection(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                              std::back_inserter(result.values));
+        result.cardinality = static_cast<std::uint32_t>(result.values.size());
+    } else {
+        const Container& array = a.words.empty() ? a : b;
+        const Container& bitmap = a.words.empty() ? b : a;
+        for (std::uint16_t low : array.values) {
+            if (testBit(bitmap.words, low)) {
+                result.values.push_back(low);
+            }
+        }
+        result.cardinality = static_cast<std::uint32_t>(result.values.size());
+    }
+    return result;
+}
+
+/******************************************************************************
+ *                  Name: unite
+ *                  Description: OR of two containers with the same key
+ *                  Arguments: const Container& a, const Container& b - Operands
+ *                  Returns: Container - Result
+ *****************************************************************************/
+RoaringBitmap::Container RoaringBitmap::unite(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+    if (!a.words.empty() && !b.words.empty()) {
+        result.words.resize(kBitmapWords);
+        result.cardinality = combineWords<WordOp::Or>(a.words.data(), b.words.data(), result.words.data());
+    } else if (a.words.empty() && b.words.empty()) {
+        std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                       std::back_inserter(result.values));
+        result.cardinality = static_cast<std::uint32_t>(result.values.size());
+        if (result.cardinality > kArrayMax) {
+            toBitmap(result);
+        }
+    } else {
+        const Container& array = a.words.empty() ? a : b;
+        const Container& bitmap = a.words.empty() ? b : a;
+        result.words = bitmap.words;
+        result.cardinality = bitmap.cardinality;
+        for (std::uint16_t low : array.values) {
+            std::uint64_t bit = std::uint64_t(1) << (low & 63);
+            result.cardinality += (result.words[low >> 6] & bit) == 0;
+            result.words[low >> 6] |= bit;
+        }
+    }
+    return result;
+}
+
+/******************************************************************************
+ *                  Name: subtract
+ *                  Description: ANDNOT of two containers with the same key
+ *                  Arguments: const Container& a - Minuend
+ *                             const Container& b - Subtrahend
+ *                  Returns: Container - Result, possibly empty
+ *****************************************************************************/
+RoaringBitmap::Container RoaringBitmap::subtract(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+    if (!a.words.empty() && !b.words.empty()) {
+        result.words.resize(kBitmapWords);
+        result.cardinality = combineWords<WordOp::AndNot>(a.words.data(), b.words.data(), result.words.data());
+        normalize(result);
+    } else if (!a.words.empty()) {
+        result.words = a.words;
+        result.cardinality = a.cardinality;
+        for (std::uint16_t low : b.values) {
+            std::uint64_t bit = std::uint64_t(1) << (low & 63);
+            result.cardinality -= (result.words[low >> 6] & bit) != 0;
+            result.words[low >> 6] &= ~bit;
+        }
+        normalize(result);
+    } else if (!b.words.empty()) {
+        for (std::uint16_t low : a.values) {
+            if (!testBit(b.words, low)) {
+                result.values.push_back(low);
+            }
+        }
+        result.cardinality = static_cast<std::uint32_t>(result.values.size());
+    } else {
+        std::set_difference(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                            std::back_inserter(result.values));
+        result.cardinality = static_cast<std::uint32_t>(result.values.size());
+    }
+    return result;
+}
+
+/******************************************************************************
+ *                  Name: toArray
+ *                  Description: Converts a bitmap container to a sorted array
+ *                  Arguments: Container& container - Bitmap container
+ *                  Returns: None
+ *****************************************************************************/
+void RoaringBitmap::toArray(Container& container) {
+    container.values.clear();
+    container.values.reserve(container.cardinality);
+    for (std::uint32_t word = 0; word < kBitmapWords; ++word) {
+        for (std::uint64_t bits = container.words[word]; bits != 0; bits &= bits - 1) {
+            container.values.push_back(static_cast<std::uint16_t>((word << 6) | lowestBit(bits)));
+        }
+    }
+    container.words.clear();
+    container.words.shrink_to_fit();
+}
+
+/******************************************************************************
+ *                  Name: toBitmap
+ *                  Description: Converts an array container to a bitmap
+ *                  Arguments: Container& container - Array container
+ *                  Returns: None
+ *****************************************************************************/
+void RoaringBitmap::toBitmap(Container& container) {
+    container.words.assign(kBitmapWords, 0);
+    for (std::uint16_t low : container.values) {
+        container.words[low >> 6] |= std::uint64_t(1) << (low & 63);
+    }
+    container.values.clear();
+    container.values.shrink_to_fit();
+}
+
+/******************************************************************************
+ *                  Name: normalize
+ *                  Description: Converts a bitmap container that has fallen to
+ *                               kArrayMax values or fewer back to an array
+ *                  Arguments: Container& container - Container to check
+ *                  Returns: None
+ *****************************************************************************/
+void RoaringBitmap::normalize(Container& container) {
+    if (!container.words.empty() && container.cardinality <= kArrayMax) {
+        toArray(container);
+    }
+}
+
+/******************************************************************************
+ *                  Name: find
+ *                  Description: Binary-searches the containers for a key
+ *                  Arguments: std::uint16_t key - High 16 bits
+ *                  Returns: Container* - The container, or nullptr
+ *****************************************************************************/
+RoaringBitmap::Container* RoaringBitmap::find(std::uint16_t key) {
+    return const_cast<Container*>(static_cast<const RoaringBitmap*>(this)->find(key));
+}
+
+/******************************************************************************
+ *                  Name: find
+ *                  Description: Binary-searches the containers for a key
+ *                  Arguments: std::uint16_t key - High 16 bits
+ *                  Returns: const Container* - The container, or nullptr
+ *****************************************************************************/
+const RoaringBitmap::Container* RoaringBitmap::find(std::uint16_t key) const {
+    auto it = std::lower_bound(containers.begin(), containers.end(), key,
+                               [](const Container& container, std::uint16_t k) { return container.key < k; });
+    return it != containers.end() && it->key == key ? &*it : nullptr;
+}
+
+/******************************** End of File ********************************/
@@ -0,0 +1,165 @@
+
+/******************************************************************************
+ *                    File Name: RoaringBitmap.h
+ *                    Description: Header file for RoaringBitmap, a compressed set of
+ *                                 32-bit integers with vectorized set operations
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __ROARING_BITMAP_H__
+#define __ROARING_BITMAP_H__
+
+#include <cstdint>
+#include <vector>
+
+/******************************************************************************
+ *                  Class Definition: RoaringBitmap
+ *                  Description: Set of uint32 values split by their high 16 bits
+ *                               into containers, roaring-style. A container with at
+ *                               most kArrayMax values is a sorted array of the low
+ *                               16 bits; a fuller one is a 65536-bit bitmap.
+ *                               Bitmap-with-bitmap AND, OR and ANDNOT run on 256-bit
+ *                               (AVX2) or 128-bit (SSE2) vectors when the compiler
+ *                               targets them, with a portable 64-bit fallback;
+ *                               configure with MOBILEAPP_NATIVE=ON for AVX2. Mixed
+ *                               and array containers use merges and bit probes.
+ *****************************************************************************/
+
+class RoaringBitmap {
+public:
+    static constexpr std::uint32_t kArrayMax = 4096;        // Largest array container
+    static constexpr std::uint32_t kBitmapWords = 1024;     // 64-bit words in a bitmap container
+
+    /******************************************************************************
+     *                  Name: add
+     *                  Description: Inserts a value
+     *                  Arguments: std::uint32_t value - Value to insert
+     *                  Returns: bool - False if it was already present
+     *****************************************************************************/
+    bool add(std::uint32_t value);
+
+    /******************************************************************************
+     *                  Name: remove
+     *                  Description: Erases a value
+     *                  Arguments: std::uint32_t value - Value to erase
+     *                  Returns: bool - False if it was not present
+     *****************************************************************************/
+    bool remove(std::uint32_t value);
+
+    /******************************************************************************
+     *                  Name: contains
+     *                  Description: Tests membership
+     *                  Arguments: std::uint32_t value - Value to test
+     *                  Returns: bool - True if present
+     *****************************************************************************/
+    bool contains(std::uint32_t value) const;
+
+    /******************************************************************************
+     *                  Name: cardinality
+     *                  Description: Returns the number of values
+     *                  Arguments: None
+     *                  Returns: std::uint64_t - Value count
+     *****************************************************************************/
+    std::uint64_t cardinality() const;
+
+    /******************************************************************************
+     *                  Name: empty
+     *                  Description: Checks for the empty set
+     *                  Arguments: None
+     *                  Returns: bool - True if no value is present
+     *****************************************************************************/
+    bool empty() const;
+
+    /******************************************************************************
+     *                  Name: clear
+     *                  Description: Removes every value
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void clear();
+
+    /******************************************************************************
+     *                  Name: operator&=
+     *                  Description: Keeps only values also in other
+     *                  Arguments: const RoaringBitmap& other - Set to intersect with
+     *                  Returns: RoaringBitmap& - This set
+     *****************************************************************************/
+    RoaringBitmap& operator&=(const RoaringBitmap& other);
+
+    /******************************************************************************
+     *                  Name: operator|=
+     *                  Description: Adds every value of other
+     *                  Arguments: const RoaringBitmap& other - Set to unite with
+     *                  Returns: RoaringBitmap& - This set
+     *****************************************************************************/
+    RoaringBitmap& operator|=(const RoaringBitmap& other);
+
+    /******************************************************************************
+     *                  Name: operator-=
+     *                  Description: Removes every value of other (AND NOT)
+     *                  Arguments: const RoaringBitmap& other - Set to subtract
+     *                  Returns: RoaringBitmap& - This set
+     *****************************************************************************/
+    RoaringBitmap& operator-=(const RoaringBitmap& other);
+
+    /******************************************************************************
+     *                  Name: forEach
+     *                  Description: Calls fn(std::uint32_t) with every value, ascending
+     *                  Arguments: Fn fn - Callback invoked per value
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (const Container& container : containers) {
+            std::uint32_t high = std::uint32_t(container.key) << 16;
+            if (container.words.empty()) {
+                for (std::uint16_t low : container.values) {
+                    fn(high | low);
+                }
+                continue;
+            }
+            for (std::uint32_t word = 0; word < kBitmapWords; ++word) {
+                for (std::uint64_t bits = container.words[word]; bits != 0; bits &= bits - 1) {
+                    fn(high | (word << 6) | lowestBit(bits));
+                }
+            }
+        }
+    }
+
+    /******************************************************************************
+     *                  Name: memoryUsage
+     *                  Description: Returns the heap bytes held by the containers
+     *                  Arguments: None
+     *                  Returns: std::size_t - Bytes
+     *****************************************************************************/
+    std::size_t memoryUsage() const;
+
+private:
+    struct Container {
+        std::uint16_t key = 0;                 // High 16 bits shared by the values
+        std::uint32_t cardinality = 0;         // Values in the container
+        std::vector<std::uint16_t> values;     // Sorted low bits; used while words is empty
+        std::vector<std::uint64_t> words;      // kBitmapWords words when a bitmap
+    };
+
+    static std::uint32_t lowestBit(std::uint64_t bits);
+    static Container intersect(const Container& a, const Container& b);
+    static Container unite(const Container& a, const Container& b);
+    static Container subtract(const Container& a, const Container& b);
+    static void toArray(Container& container);
+    static void toBitmap(Container& container);
+    static void normalize(Container& container);
+    Container* find(std::uint16_t key);
+    const Container* find(std::uint16_t key) const;
+
+    std::vector<Container> containers;   // Non-empty containers by ascending key
+};
+
+#endif
+
+/******************************** End of File ********************************/
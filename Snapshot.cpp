@@ -0,0 +1,471 @@
+
+/******************************************************************************
+ *                    File Name: Snapshot.cpp
+ *                    Description: Implementation file for the snapshot writer and
+ *                                 the memory-mapped snapshot reader
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "Snapshot.h"
+#include <cerrno>
+#include <cstdio>     // For std::rename, std::remove
+#include <cstring>    // For std::memcmp, std::memcpy
+#include <fstream>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/******************************************************************************
+ *                  Name: fnv1a
+ *                  Description: 64-bit FNV-1a hash of a byte range
+ *                  Arguments: const char* bytes - Start of the range
+ *                             std::size_t length - Number of bytes
+ *                  Returns: std::uint64_t - Hash value
+ *****************************************************************************/
+std::uint64_t fnv1a(const char* bytes, std::size_t length) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<unsigned char>(bytes[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/******************************************************************************
+ *                  Name: alignTo8
+ *                  Description: Rounds an offset up to a multiple of 8
+ *                  Arguments: std::uint64_t offset - Offset to round
+ *                  Returns: std::uint64_t - Aligned offset
+ *****************************************************************************/
+std::uint64_t alignTo8(std::uint64_t offset) {
+    return (offset + 7) & ~std::uint64_t(7);
+}
+
+/******************************************************************************
+ *                  Name: inBounds
+ *                  Description: Checks that [offset, offset + bytes) lies in the file
+ *                  Arguments: std::uint64_t offset - Section start
+ *                             std::uint64_t bytes - Section length
+ *                             std::uint64_t size - File size
+ *                  Returns: bool - True if the section fits
+ *****************************************************************************/
+bool inBounds(std::uint64_t offset, std::uint64_t bytes, std::uint64_t size) {
+    return offset <= size && bytes <= size - offset;
+}
+
+/******************************************************************************
+ *                  Name: writeSynced
+ *                  Description: Creates or truncates a file, writes the bytes, retrying
+ *                               short and interrupted writes, and syncs the data to
+ *                               stable storage before closing
+ *                  Arguments: const std::string& path - File to write
+ *                             const std::string& bytes - Contents
+ *                  Returns: bool - True if every byte reached the disk
+ *****************************************************************************/
+bool writeSynced(const std::string& path, const std::string& bytes) {
+#ifdef _WIN32
+    int fd = ::_open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, 0644);
+#else
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = true;
+    for (std::size_t written = 0; ok && written < bytes.size();) {
+#ifdef _WIN32
+        int result = ::_write(fd, bytes.data() + written, static_cast<unsigned>(bytes.size() - written));
+#else
+        ssize_t result = ::write(fd, bytes.data() + written, bytes.size() - written);
+#endif
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        ok = result > 0;
+        written += ok ? static_cast<std::size_t>(result) : 0;
+    }
+#ifdef _WIN32
+    ok = ok && ::_commit(fd) == 0;
+    return ::_close(fd) == 0 && ok;
+#else
+    ok = ok && ::fsync(fd) == 0;
+    return ::close(fd) == 0 && ok;
+#endif
+}
+
+/******************************************************************************
+ *                  Name: syncParentDirectory
+ *                  Description: Syncs the directory holding a file so a rename into
+ *                               it survives a power loss. Windows has no directory
+ *                               handles to sync; the rename is left to the OS there.
+ *                  Arguments: const std::string& path - File whose directory to sync
+ *                  Returns: bool - True on success
+ *****************************************************************************/
+bool syncParentDirectory(const std::string& path) {
+#ifdef _WIN32
+    static_cast<void>(path);
+    return true;
+#else
+    std::string::size_type slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    int fd = ::open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = ::fsync(fd) == 0;
+    return ::close(fd) == 0 && ok;
+#endif
+}
+
+}  // namespace
+
+/******************************************************************************
+ *                  Name: addGroup
+ *                  Description: Appends a group's name, permission block and include
+ *                               block
+ *                  Arguments: const std::string& groupName - Group name
+ *                             const PermissionSet& permissions - Permissions it lists
+ *                             const std::vector<std::uint32_t>& includes - Ids of the
+ *                                 groups it includes
+ *                  Returns: None
+ *****************************************************************************/
+void SnapshotWriter::addGroup(const std::string& groupName, const PermissionSet& permissions,
+                              const std::vector<std::uint32_t>& includes) {
+    SnapshotGroup group;
+    group.name = {static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(groupName.size())};
+    group.firstPermission = static_cast<std::uint32_t>(blocks.size());
+    strings.append(groupName);
+    permissions.forEach([&](PermissionId id) { blocks.push_back(localId(id)); });
+    group.permissionCount = static_cast<std::uint32_t>(blocks.size() - group.firstPermission);
+    group.firstInclude = static_cast<std::uint32_t>(groupBlocks.size());
+    group.includeCount = static_cast<std::uint32_t>(includes.size());
+    groupBlocks.insert(groupBlocks.end(), includes.begin(), includes.end());
+    groups.push_back(group);
+}
+
+/******************************************************************************
+ *                  Name: addApp
+ *                  Description: Appends an app's name, permission block and group block
+ *                  Arguments: const std::string& appName - Name of the application
+ *                             const PermissionSet& permissions - Permissions it holds
+ *                             const std::vector<std::uint32_t>& appGroups - Ids of the
+ *                                 groups assigned to it
+ *                  Returns: None
+ *****************************************************************************/
+void SnapshotWriter::addApp(const std::string& appName, const PermissionSet& permissions,
+                            const std::vector<std::uint32_t>& appGroups) {
+    SnapshotApp app;
+    app.name = {static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(appName.size())};
+    app.firstPermission = static_cast<std::uint32_t>(blocks.size());
+    strings.append(appName);
+    permissions.forEach([&](PermissionId id) { blocks.push_back(localId(id)); });
+    app.permissionCount = static_cast<std::uint32_t>(blocks.size() - app.firstPermission);
+    app.firstGroup = static_cast<std::uint32_t>(groupBlocks.size());
+    app.groupCount = static_cast<std::uint32_t>(appGroups.size());
+    groupBlocks.insert(groupBlocks.end(), appGroups.begin(), appGroups.end());
+    apps.push_back(app);
+}
+
+/******************************************************************************
+ *                  Name: localId
+ *                  Description: Returns the permission table index of a process ID,
+ *                               adding the name to the table on first use
+ *                  Arguments: PermissionId id - Process-wide permission ID
+ *                  Returns: std::uint32_t - Permission table index
+ *****************************************************************************/
+std::uint32_t SnapshotWriter::localId(PermissionId id) {
+    auto it = localIds.find(id);
+    if (it != localIds.end()) {
+        return it->second;
+    }
+    const std::string& name = PermissionRegistry::instance().name(id);
+    std::uint32_t local = static_cast<std::uint32_t>(permissionNames.size());
+    permissionNames.push_back({static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(name.size())});
+    strings.append(name);
+    localIds.emplace(id, local);
+    return local;
+}
+
+/******************************************************************************
+ *                  Name: write
+ *                  Description: Lays out the sections, checksums them and writes the
+ *                               file through a temporary path. The temporary file
+ *                               is synced before the rename and the directory after
+ *                               it, so once this returns true the new snapshot is
+ *                               on disk under its final name and a caller may drop
+ *                               whatever it replaces, such as a journal.
+ *                  Arguments: const std::string& path - Destination file
+ *                  Returns: bool - True on success
+ *****************************************************************************/
+bool SnapshotWriter::write(const std::string& path) const {
+    SnapshotHeader header{};
+    std::memcpy(header.magic, kSnapshotMagic, sizeof(header.magic));
+    header.version = kSnapshotVersion;
+    header.byteOrder = kSnapshotByteOrder;
+    header.permissionCount = static_cast<std::uint32_t>(permissionNames.size());
+    header.appCount = apps.size();
+    header.stringsOffset = sizeof(SnapshotHeader);
+    header.stringsSize = strings.size();
+    header.permissionsOffset = alignTo8(header.stringsOffset + header.stringsSize);
+    header.groupCount = groups.size();
+    header.groupsOffset = alignTo8(header.permissionsOffset + permissionNames.size() * sizeof(SnapshotString));
+    header.appsOffset = alignTo8(header.groupsOffset + groups.size() * sizeof(SnapshotGroup));
+    header.blocksOffset = alignTo8(header.appsOffset + apps.size() * sizeof(SnapshotApp));
+    header.blockCount = blocks.size();
+    header.groupBlocksOffset = alignTo8(header.blocksOffset + blocks.size() * sizeof(std::uint32_t));
+    header.groupBlockCount = groupBlocks.size();
+    header.fileSize = alignTo8(header.groupBlocksOffset + groupBlocks.size() * sizeof(std::uint32_t));
+
+    // Empty sections are skipped: memcpy from an empty vector's null data() is undefined
+    std::string image(header.fileSize, '\0');
+    if (!strings.empty()) {
+        std::memcpy(&image[header.stringsOffset], strings.data(), strings.size());
+    }
+    if (!permissionNames.empty()) {
+        std::memcpy(&image[header.permissionsOffset], permissionNames.data(), permissionNames.size() * sizeof(SnapshotString));
+    }
+    if (!groups.empty()) {
+        std::memcpy(&image[header.groupsOffset], groups.data(), groups.size() * sizeof(SnapshotGroup));
+    }
+    if (!apps.empty()) {
+        std::memcpy(&image[header.appsOffset], apps.data(), apps.size() * sizeof(SnapshotApp));
+    }
+    if (!blocks.empty()) {
+        std::memcpy(&image[header.blocksOffset], blocks.data(), blocks.size() * sizeof(std::uint32_t));
+    }
+    if (!groupBlocks.empty()) {
+        std::memcpy(&image[header.groupBlocksOffset], groupBlocks.data(), groupBlocks.size() * sizeof(std::uint32_t));
+    }
+    header.checksum = fnv1a(image.data() + sizeof(SnapshotHeader), image.size() - sizeof(SnapshotHeader));
+    std::memcpy(&image[0], &header, sizeof(SnapshotHeader));
+
+    std::string temporary = path + ".tmp";
+    if (!writeSynced(temporary, image)) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    std::remove(path.c_str());
+#endif
+    return std::rename(temporary.c_str(), path.c_str()) == 0 && syncParentDirectory(path);
+}
+
+/******************************************************************************
+ *                  Destructor: SnapshotView
+ *                  Description: Unmaps the file
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+SnapshotView::~SnapshotView() {
+    close();
+}
+
+/******************************************************************************
+ *                  Name: open
+ *                  Description: Maps the file read-only and checks the header and the
+ *                               bounds of every section. Only the checksum, when
+ *                               requested, reads the whole payload.
+ *                  Arguments: const std::string& path - Snapshot file
+ *                             bool verifyChecksum - Also hash the whole payload
+ *                  Returns: bool - True if the file is a valid snapshot
+ *****************************************************************************/
+bool SnapshotView::open(const std::string& path, bool verifyChecksum) {
+    close();
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(SnapshotHeader))) {
+        ::close(fd);
+        return false;
+    }
+    void* mapping = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    data = static_cast<const char*>(mapping);
+    size = static_cast<std::size_t>(info.st_size);
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in || in.tellg() < static_cast<std::streamoff>(sizeof(SnapshotHeader))) {
+        return false;
+    }
+    fallback.resize(static_cast<std::size_t>(in.tellg()));
+    in.seekg(0);
+    in.read(fallback.data(), static_cast<std::streamsize>(fallback.size()));
+    data = fallback.data();
+    size = fallback.size();
+#endif
+
+    header = reinterpret_cast<const SnapshotHeader*>(data);
+    bool valid = std::memcmp(header->magic, kSnapshotMagic, sizeof(header->magic)) == 0 &&
+                 header->byteOrder == kSnapshotByteOrder && header->version == kSnapshotVersion &&
+                 header->fileSize == size &&
+                 inBounds(header->stringsOffset, header->stringsSize, size) &&
+                 inBounds(header->permissionsOffset, std::uint64_t(header->permissionCount) * sizeof(SnapshotString), size) &&
+                 header->groupCount <= size / sizeof(SnapshotGroup) &&
+                 inBounds(header->groupsOffset, header->groupCount * sizeof(SnapshotGroup), size) &&
+                 header->appCount <= size / sizeof(SnapshotApp) &&
+                 inBounds(header->appsOffset, header->appCount * sizeof(SnapshotApp), size) &&
+                 header->blockCount <= size / sizeof(std::uint32_t) &&
+                 inBounds(header->blocksOffset, header->blockCount * sizeof(std::uint32_t), size) &&
+                 header->groupBlockCount <= size / sizeof(std::uint32_t) &&
+                 inBounds(header->groupBlocksOffset, header->groupBlockCount * sizeof(std::uint32_t), size) &&
+                 header->permissionsOffset % 8 == 0 && header->groupsOffset % 8 == 0 && header->appsOffset % 8 == 0 &&
+                 header->blocksOffset % 8 == 0 && header->groupBlocksOffset % 8 == 0;
+    if (valid && verifyChecksum) {
+        valid = fnv1a(data + sizeof(SnapshotHeader), size - sizeof(SnapshotHeader)) == header->checksum;
+    }
+    if (!valid) {
+        close();
+        return false;
+    }
+    permissions = reinterpret_cast<const SnapshotString*>(data + header->permissionsOffset);
+    groups = reinterpret_cast<const SnapshotGroup*>(data + header->groupsOffset);
+    apps = reinterpret_cast<const SnapshotApp*>(data + header->appsOffset);
+    blocks = reinterpret_cast<const std::uint32_t*>(data + header->blocksOffset);
+    groupBlocks = reinterpret_cast<const std::uint32_t*>(data + header->groupBlocksOffset);
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: close
+ *                  Description: Unmaps the file and resets the view to empty
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void SnapshotView::close() {
+#ifndef _WIN32
+    if (data != nullptr) {
+        ::munmap(const_cast<char*>(data), size);
+    }
+#endif
+    fallback.clear();
+    data = nullptr;
+    size = 0;
+    header = nullptr;
+    permissions = nullptr;
+    groups = nullptr;
+    apps = nullptr;
+    blocks = nullptr;
+    groupBlocks = nullptr;
+}
+
+/******************************************************************************
+ *                  Name: appCount
+ *                  Description: Returns the number of apps in the snapshot
+ *                  Arguments: None
+ *                  Returns: std::size_t - App count
+ *****************************************************************************/
+std::size_t SnapshotView::appCount() const {
+    return header == nullptr ? 0 : static_cast<std::size_t>(header->appCount);
+}
+
+/******************************************************************************
+ *                  Name: appName
+ *                  Description: Returns the name of the app at an index position
+ *                  Arguments: std::size_t index - Position in name order
+ *                  Returns: std::string_view - App name, valid until close()
+ *****************************************************************************/
+std::string_view SnapshotView::appName(std::size_t index) const {
+    return text(apps[index].name);
+}
+
+/******************************************************************************
+ *                  Name: findApp
+ *                  Description: Binary-searches the app index
+ *                  Arguments: std::string_view appName - Name to look up
+ *                             std::size_t& index - Receives the position when found
+ *                  Returns: bool - True if the app is in the snapshot
+ *****************************************************************************/
+bool SnapshotView::findApp(std::string_view appName, std::size_t& index) const {
+    std::size_t low = 0;
+    std::size_t high = appCount();
+    while (low < high) {
+        std::size_t middle = low + (high - low) / 2;
+        int order = text(apps[middle].name).compare(appName);
+        if (order == 0) {
+            index = middle;
+            return true;
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return false;
+}
+
+/******************************************************************************
+ *                  Name: permissionCount
+ *                  Description: Returns the number of distinct permissions stored
+ *                  Arguments: None
+ *                  Returns: std::size_t - Permission table size
+ *****************************************************************************/
+std::size_t SnapshotView::permissionCount() const {
+    return header == nullptr ? 0 : header->permissionCount;
+}
+
+/******************************************************************************
+ *                  Name: permissionName
+ *                  Description: Returns a permission name by table index
+ *                  Arguments: std::uint32_t local - Permission table index
+ *                  Returns: std::string_view - Permission name, valid until close()
+ *****************************************************************************/
+std::string_view SnapshotView::permissionName(std::uint32_t local) const {
+    return local < permissionCount() ? text(permissions[local]) : std::string_view();
+}
+
+/******************************************************************************
+ *                  Name: groupCount
+ *                  Description: Returns the number of groups in the snapshot
+ *                  Arguments: None
+ *                  Returns: std::size_t - Group table size
+ *****************************************************************************/
+std::size_t SnapshotView::groupCount() const {
+    return header == nullptr ? 0 : static_cast<std::size_t>(header->groupCount);
+}
+
+/******************************************************************************
+ *                  Name: groupName
+ *                  Description: Returns a group name by table index
+ *                  Arguments: std::size_t group - Group table index
+ *                  Returns: std::string_view - Group name, valid until close()
+ *****************************************************************************/
+std::string_view SnapshotView::groupName(std::size_t group) const {
+    return group < groupCount() ? text(groups[group].name) : std::string_view();
+}
+
+/******************************************************************************
+ *                  Name: text
+ *                  Description: Resolves a string table reference, yielding an empty
+ *                               view if it points outside the table
+ *                  Arguments: const SnapshotString& ref - String table reference
+ *                  Returns: std::string_view - The referenced bytes
+ *****************************************************************************/
+std::string_view SnapshotView::text(const SnapshotString& ref) const {
+    if (!inBounds(ref.offset, ref.length, header->stringsSize)) {
+        return std::string_view();
+    }
+    return std::string_view(data + header->stringsOffset + ref.offset, ref.length);
+}
+
+/******************************** End of File ********************************/
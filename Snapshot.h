@@ -0,0 +1,342 @@
+
+/******************************************************************************
+ *                    File Name: Snapshot.h
+ *                    Description: Header file for the binary registry snapshot format,
+ *                                 its writer and its memory-mapped reader
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __SNAPSHOT_H__
+#define __SNAPSHOT_H__
+
+#include "PermissionSet.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/******************************************************************************
+ *                  Structure Definition: SnapshotHeader
+ *                  Description: Fixed header at offset 0. All offsets are in bytes
+ *                               from the start of the file and every section is
+ *                               8-byte aligned. Integers are stored in the byte
+ *                               order of the host that wrote the file, and
+ *                               byteOrder records it: a reader whose order differs
+ *                               sees kSnapshotByteOrder reversed and rejects the
+ *                               file instead of misreading it.
+ *
+ *                               Layout after the header:
+ *                                 string table       - names, not NUL terminated
+ *                                 permission table   - SnapshotString per permission
+ *                                 group table        - SnapshotGroup per permission group,
+ *                                                      in definition order
+ *                                 app index          - SnapshotApp per app, sorted by name
+ *                                 permission blocks  - uint32 permission table indexes,
+ *                                                      one contiguous run per group and
+ *                                                      per app
+ *                                 group blocks       - uint32 group table indexes, one
+ *                                                      run per group for its includes
+ *                                                      and per app for its groups
+ *
+ *                               checksum is FNV-1a 64 over every byte after the header.
+ *****************************************************************************/
+
+struct SnapshotHeader {
+    char magic[8];                    // "NOVASNAP"
+    std::uint32_t version;            // kSnapshotVersion
+    std::uint32_t byteOrder;          // kSnapshotByteOrder in the writer's byte order
+    std::uint32_t permissionCount;    // Entries in the permission table
+    std::uint32_t reserved;           // Zero
+    std::uint64_t appCount;           // Entries in the app index
+    std::uint64_t stringsOffset;      // Start of the string table
+    std::uint64_t stringsSize;        // Bytes in the string table
+    std::uint64_t permissionsOffset;  // Start of the permission table
+    std::uint64_t appsOffset;         // Start of the app index
+    std::uint64_t blocksOffset;       // Start of the permission blocks
+    std::uint64_t blockCount;         // uint32 entries in the permission blocks
+    std::uint64_t groupCount;         // Entries in the group table
+    std::uint64_t groupsOffset;       // Start of the group table
+    std::uint64_t groupBlocksOffset;  // Start of the group blocks
+    std::uint64_t groupBlockCount;    // uint32 entries in the group blocks
+    std::uint64_t fileSize;           // Total bytes, header included
+    std::uint64_t checksum;           // FNV-1a 64 of bytes [sizeof(header), fileSize)
+};
+
+/******************************************************************************
+ *                  Structure Definition: SnapshotString
+ *                  Description: A name stored in the string table
+ *****************************************************************************/
+
+struct SnapshotString {
+    std::uint32_t offset;  // Offset into the string table
+    std::uint32_t length;  // Length in bytes
+};
+
+/******************************************************************************
+ *                  Structure Definition: SnapshotGroup
+ *                  Description: One group table entry: the group's own definition,
+ *                               not its compiled mask
+ *****************************************************************************/
+
+struct SnapshotGroup {
+    SnapshotString name;              // Group name
+    std::uint32_t firstPermission;    // Index of its first entry in the permission blocks
+    std::uint32_t permissionCount;    // Number of permissions it lists
+    std::uint32_t firstInclude;       // Index of its first entry in the group blocks
+    std::uint32_t includeCount;       // Number of groups it includes
+};
+
+/******************************************************************************
+ *                  Structure Definition: SnapshotApp
+ *                  Description: One app index entry
+ *****************************************************************************/
+
+struct SnapshotApp {
+    SnapshotString name;              // App name
+    std::uint32_t firstPermission;    // Index of its first entry in the permission blocks
+    std::uint32_t permissionCount;    // Number of permissions it holds
+    std::uint32_t firstGroup;         // Index of its first entry in the group blocks
+    std::uint32_t groupCount;         // Number of groups assigned to it
+};
+
+constexpr char kSnapshotMagic[8] = {'N', 'O', 'V', 'A', 'S', 'N', 'A', 'P'};
+constexpr std::uint32_t kSnapshotVersion = 3;
+constexpr std::uint32_t kSnapshotByteOrder = 0x01020304;
+
+static_assert(sizeof(SnapshotHeader) == 128, "snapshot header layout changed");
+static_assert(sizeof(SnapshotString) == 8, "snapshot string layout changed");
+static_assert(sizeof(SnapshotGroup) == 24, "snapshot group layout changed");
+static_assert(sizeof(SnapshotApp) == 24, "snapshot app layout changed");
+
+/******************************************************************************
+ *                  Class Definition: SnapshotWriter
+ *                  Description: Collects groups in definition order, then apps in
+ *                               ascending name order, and writes them out as one
+ *                               snapshot file. Permission IDs are remapped to
+ *                               snapshot-local indexes because process IDs depend
+ *                               on interning order; group IDs are stored as they
+ *                               are, since they are definition order.
+ *****************************************************************************/
+
+class SnapshotWriter {
+public:
+    /******************************************************************************
+     *                  Name: addGroup
+     *                  Description: Appends a group. Groups must arrive in GroupId order
+     *                               and before any app.
+     *                  Arguments: const std::string& groupName - Group name
+     *                             const PermissionSet& permissions - Permissions it lists
+     *                             const std::vector<std::uint32_t>& includes - Ids of the
+     *                                 groups it includes
+     *                  Returns: None
+     *****************************************************************************/
+    void addGroup(const std::string& groupName, const PermissionSet& permissions,
+                  const std::vector<std::uint32_t>& includes);
+
+    /******************************************************************************
+     *                  Name: addApp
+     *                  Description: Appends an app. Names must arrive in ascending order.
+     *                  Arguments: const std::string& appName - Name of the application
+     *                             const PermissionSet& permissions - Permissions it holds
+     *                             const std::vector<std::uint32_t>& appGroups - Ids of the
+     *                                 groups assigned to it
+     *                  Returns: None
+     *****************************************************************************/
+    void addApp(const std::string& appName, const PermissionSet& permissions,
+                const std::vector<std::uint32_t>& appGroups);
+
+    /******************************************************************************
+     *                  Name: write
+     *                  Description: Writes the snapshot to a temporary file and renames
+     *                               it over path, so readers never see a partial file
+     *                  Arguments: const std::string& path - Destination file
+     *                  Returns: bool - True on success
+     *****************************************************************************/
+    bool write(const std::string& path) const;
+
+private:
+    std::uint32_t localId(PermissionId id);
+
+    std::string strings;                                      // String table being built
+    std::vector<SnapshotString> permissionNames;              // Permission table being built
+    std::unordered_map<PermissionId, std::uint32_t> localIds; // Process ID -> table index
+    std::vector<SnapshotGroup> groups;                        // Group table being built
+    std::vector<SnapshotApp> apps;                            // App index being built
+    std::vector<std::uint32_t> blocks;                        // Permission blocks being built
+    std::vector<std::uint32_t> groupBlocks;                   // Group blocks being built
+};
+
+/******************************************************************************
+ *                  Class Definition: SnapshotView
+ *                  Description: Read-only view of a snapshot file mapped into memory.
+ *                               Opening validates the header and section bounds
+ *                               only; the data is read in place, so cost grows with
+ *                               the pages actually touched.
+ *****************************************************************************/
+
+class SnapshotView {
+public:
+    SnapshotView() = default;
+    ~SnapshotView();
+    SnapshotView(const SnapshotView&) = delete;
+    SnapshotView& operator=(const SnapshotView&) = delete;
+
+    /******************************************************************************
+     *                  Name: open
+     *                  Description: Maps a snapshot file and validates it
+     *                  Arguments: const std::string& path - Snapshot file
+     *                             bool verifyChecksum - Also hash the whole payload
+     *                  Returns: bool - True if the file is a valid snapshot
+     *****************************************************************************/
+    bool open(const std::string& path, bool verifyChecksum = true);
+
+    /******************************************************************************
+     *                  Name: close
+     *                  Description: Unmaps the file
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void close();
+
+    /******************************************************************************
+     *                  Name: appCount
+     *                  Description: Returns the number of apps in the snapshot
+     *                  Arguments: None
+     *                  Returns: std::size_t - App count
+     *****************************************************************************/
+    std::size_t appCount() const;
+
+    /******************************************************************************
+     *                  Name: appName
+     *                  Description: Returns the name of the app at an index position
+     *                  Arguments: std::size_t index - Position in name order
+     *                  Returns: std::string_view - App name, valid until close()
+     *****************************************************************************/
+    std::string_view appName(std::size_t index) const;
+
+    /******************************************************************************
+     *                  Name: findApp
+     *                  Description: Binary-searches the app index
+     *                  Arguments: std::string_view appName - Name to look up
+     *                             std::size_t& index - Receives the position when found
+     *                  Returns: bool - True if the app is in the snapshot
+     *****************************************************************************/
+    bool findApp(std::string_view appName, std::size_t& index) const;
+
+    /******************************************************************************
+     *                  Name: permissionCount
+     *                  Description: Returns the number of distinct permissions stored
+     *                  Arguments: None
+     *                  Returns: std::size_t - Permission table size
+     *****************************************************************************/
+    std::size_t permissionCount() const;
+
+    /******************************************************************************
+     *                  Name: permissionName
+     *                  Description: Returns a permission name by table index
+     *                  Arguments: std::uint32_t local - Permission table index
+     *                  Returns: std::string_view - Permission name, valid until close()
+     *****************************************************************************/
+    std::string_view permissionName(std::uint32_t local) const;
+
+    /******************************************************************************
+     *                  Name: forEachPermission
+     *                  Description: Calls fn(std::uint32_t) with the permission table
+     *                               index of every permission an app holds
+     *                  Arguments: std::size_t index - Position of the app
+     *                             Fn fn - Callback invoked per permission
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEachPermission(std::size_t index, Fn fn) const {
+        forEachIn(blocks, header->blockCount, apps[index].firstPermission, apps[index].permissionCount, fn);
+    }
+
+    /******************************************************************************
+     *                  Name: groupCount
+     *                  Description: Returns the number of groups in the snapshot
+     *                  Arguments: None
+     *                  Returns: std::size_t - Group table size
+     *****************************************************************************/
+    std::size_t groupCount() const;
+
+    /******************************************************************************
+     *                  Name: groupName
+     *                  Description: Returns a group name by table index
+     *                  Arguments: std::size_t group - Group table index
+     *                  Returns: std::string_view - Group name, valid until close()
+     *****************************************************************************/
+    std::string_view groupName(std::size_t group) const;
+
+    /******************************************************************************
+     *                  Name: forEachGroupPermission
+     *                  Description: Calls fn(std::uint32_t) with the permission table
+     *                               index of every permission a group lists
+     *                  Arguments: std::size_t group - Group table index
+     *                             Fn fn - Callback invoked per permission
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEachGroupPermission(std::size_t group, Fn fn) const {
+        forEachIn(blocks, header->blockCount, groups[group].firstPermission, groups[group].permissionCount, fn);
+    }
+
+    /******************************************************************************
+     *                  Name: forEachInclude
+     *                  Description: Calls fn(std::uint32_t) with the group table index of
+     *                               every group a group includes
+     *                  Arguments: std::size_t group - Group table index
+     *                             Fn fn - Callback invoked per included group
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEachInclude(std::size_t group, Fn fn) const {
+        forEachIn(groupBlocks, header->groupBlockCount, groups[group].firstInclude, groups[group].includeCount, fn);
+    }
+
+    /******************************************************************************
+     *                  Name: forEachAppGroup
+     *                  Description: Calls fn(std::uint32_t) with the group table index of
+     *                               every group assigned to an app
+     *                  Arguments: std::size_t index - Position of the app
+     *                             Fn fn - Callback invoked per group
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEachAppGroup(std::size_t index, Fn fn) const {
+        forEachIn(groupBlocks, header->groupBlockCount, apps[index].firstGroup, apps[index].groupCount, fn);
+    }
+
+private:
+    template <typename Fn>
+    static void forEachIn(const std::uint32_t* run, std::uint64_t size, std::uint32_t first, std::uint32_t count, Fn& fn) {
+        if (std::uint64_t(first) + count > size) {
+            return;
+        }
+        for (std::uint32_t i = 0; i < count; ++i) {
+            fn(run[first + i]);
+        }
+    }
+
+    std::string_view text(const SnapshotString& ref) const;
+
+    const char* data = nullptr;                  // Start of the mapping
+    std::size_t size = 0;                        // Bytes mapped
+    const SnapshotHeader* header = nullptr;      // Header at offset 0
+    const SnapshotString* permissions = nullptr; // Permission table
+    const SnapshotGroup* groups = nullptr;       // Group table
+    const SnapshotApp* apps = nullptr;           // App index
+    const std::uint32_t* blocks = nullptr;       // Permission blocks
+    const std::uint32_t* groupBlocks = nullptr;  // Group blocks
+    std::vector<char> fallback;                  // File contents where mmap is unavailable
+};
+
+#endif
+
+/******************************** End of File ********************************/
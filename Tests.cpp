@@ -9,8 +9,26 @@
 /**************************************************************************** **
  *                      Header Files 
  *****************************************************************************/
+#include "AsyncLogSink.h"
+#include "CommandProcessor.h"
+#include "ConcurrentAppManager.h"
+#include "FleetManager.h"
 #include "MobileAppManager.h"
+#include "RoaringBitmap.h"
+#include "RecordStream.h"
+#include "Snapshot.h"
+#include "TimerWheel.h"
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
 #include <gtest/gtest.h>
 
 /******************************************************************************
@@ -334,6 +352,2176 @@ TEST(MobileAppManagerTest, testListPermissionsAssignedToAnApp_4) {
     EXPECT_EQ(permissionsSpotify[0], "Microphone");
 }
 
+/******************************************************************************
+ *                  Test Case: testAssignSamePermissionTwice
+ *                  Description: Test that assigning a permission twice keeps one copy
+ *****************************************************************************/
+TEST(MobileAppManagerTest, testAssignSamePermissionTwice) {
+    MobileAppManager manager;
+    manager.installApp("WhatsApp");
+    manager.assignPermission("WhatsApp", "Camera");
+    manager.assignPermission("WhatsApp", "Camera");
+
+    auto permissions = manager.listAppPermissions("WhatsApp");
+    EXPECT_EQ(permissions.size(), 1);
+    EXPECT_EQ(permissions[0], "Camera");
+}
+
+/******************************************************************************
+ *                  Test Case: testInternReturnsStableIds
+ *                  Description: Test that interning the same name yields the same ID
+ *****************************************************************************/
+TEST(PermissionRegistryTest, testInternReturnsStableIds) {
+    PermissionRegistry& registry = PermissionRegistry::instance();
+    PermissionId camera = registry.intern("Camera");
+    EXPECT_EQ(registry.intern("Camera"), camera);
+    EXPECT_EQ(registry.name(camera), "Camera");
+
+    PermissionId found;
+    EXPECT_TRUE(registry.find("Camera", found));
+    EXPECT_EQ(found, camera);
+    EXPECT_FALSE(registry.find("NeverInternedPermission", found));
+}
+
+/******************************************************************************
+ *                  Test Case: testInlineAndOverflowIds
+ *                  Description: Test add, remove and membership on both the inline
+ *                               bitset and the overflow storage
+ *****************************************************************************/
+TEST(PermissionSetTest, testInlineAndOverflowIds) {
+    PermissionSet permissions;
+    PermissionId overflowId = PermissionSet::kInlineBits + 7;
+
+    EXPECT_TRUE(permissions.insert(3));
+    EXPECT_TRUE(permissions.insert(overflowId));
+    EXPECT_FALSE(permissions.insert(3));
+    EXPECT_EQ(permissions.size(), 2);
+    EXPECT_TRUE(permissions.contains(3));
+    EXPECT_TRUE(permissions.contains(overflowId));
+
+    std::vector<PermissionId> ids;
+    permissions.forEach([&](PermissionId id) { ids.push_back(id); });
+    EXPECT_EQ(ids, (std::vector<PermissionId>{3, overflowId}));
+
+    EXPECT_TRUE(permissions.erase(overflowId));
+    EXPECT_FALSE(permissions.erase(overflowId));
+    EXPECT_TRUE(permissions.erase(3));
+    EXPECT_TRUE(permissions.empty());
+}
+
+/******************************************************************************
+ *                  Test Case: testHasPermission
+ *                  Description: Test permission membership checks on installed,
+ *                               revoked and missing apps
+ *****************************************************************************/
+TEST(MobileAppManagerTest, testHasPermission) {
+    MobileAppManager manager;
+    manager.installApp("WhatsApp");
+    manager.assignPermission("WhatsApp", "Camera");
+
+    EXPECT_TRUE(manager.hasPermission("WhatsApp", "Camera"));
+    EXPECT_FALSE(manager.hasPermission("WhatsApp", "Microphone"));
+    EXPECT_FALSE(manager.hasPermission("FakeApp", "Camera"));
+
+    manager.revokePermission("WhatsApp", "Camera");
+    EXPECT_FALSE(manager.hasPermission("WhatsApp", "Camera"));
+}
+
+/******************************************************************************
+ *                  Test Case: testAppsWithPermission
+ *                  Description: Test that the reverse index follows assign, revoke
+ *                               and uninstall
+ *****************************************************************************/
+TEST(MobileAppManagerTest, testAppsWithPermission) {
+    MobileAppManager manager;
+    manager.installApp("WhatsApp");
+    manager.installApp("Spotify");
+    manager.installApp("Maps");
+    manager.assignPermission("WhatsApp", "Camera");
+    manager.assignPermission("Spotify", "Camera");
+    manager.assignPermission("Maps", "Location");
+
+    EXPECT_EQ(manager.appsWithPermission("Camera"), (std::vector<std::string>{"Spotify", "WhatsApp"}));
+
+    manager.revokePermission("Spotify", "Camera");
+    EXPECT_EQ(manager.appsWithPermission("Camera"), (std::vector<std::string>{"WhatsApp"}));
+
+    manager.uninstallApp("WhatsApp");
+    EXPECT_TRUE(manager.appsWithPermission("Camera").empty());
+    EXPECT_EQ(manager.appsWithPermission("Location"), (std::vector<std::string>{"Maps"}));
+    EXPECT_TRUE(manager.appsWithPermission("NeverInternedPermission").empty());
+}
+
+/******************************************************************************
+ *                  Test Case: testForEachAppWithPermission
+ *                  Description: Test that the visitor reports each holder once,
+ *                               direct or through overlapping groups, and follows
+ *                               the ids of uninstalled and reinstalled apps
+ *****************************************************************************/
+TEST(MobileAppManagerTest, testForEachAppWithPermission) {
+    MobileAppManager manager;
+    manager.definePermissionGroup("Media", {"Camera", "Microphone"});
+    manager.definePermissionGroup("Video", {"Camera"});
+    for (const char* appName : {"WhatsApp", "Spotify", "Maps", "Notes"}) {
+        manager.installApp(appName);
+    }
+    manager.assignPermission("WhatsApp", "Camera");
+    manager.assignGroup("WhatsApp", "Media");
+    manager.assignGroup("Spotify", "Media");
+    manager.assignGroup("Spotify", "Video");
+    manager.assignPermission("Maps", "Location");
+
+    auto visit = [&](std::string_view permission) {
+        std::vector<std::string> holders;
+        manager.forEachAppWithPermission(permission, [&](std::string_view appName) { holders.emplace_back(appName); });
+        std::sort(holders.begin(), holders.end());
+        return holders;
+    };
+    EXPECT_EQ(visit("Camera"), (std::vector<std::string>{"Spotify", "WhatsApp"}));
+    EXPECT_EQ(visit("Camera"), manager.appsWithPermission("Camera"));
+    EXPECT_EQ(visit("Microphone"), (std::vector<std::string>{"Spotify", "WhatsApp"}));
+    EXPECT_TRUE(visit("NeverInternedPermission").empty());
+
+    // A new app takes the uninstalled one's id without inheriting its grants
+    manager.uninstallApp("WhatsApp");
+    manager.installApp("Camera");
+    EXPECT_EQ(visit("Camera"), (std::vector<std::string>{"Spotify"}));
+    manager.assignPermission("Camera", "Camera");
+    manager.revokeGroup("Spotify", "Media");
+    EXPECT_EQ(visit("Camera"), (std::vector<std::string>{"Camera", "Spotify"}));
+    EXPECT_TRUE(visit("Microphone").empty());
+    EXPECT_EQ(visit("Location"), (std::vector<std::string>{"Maps"}));
+}
+
+/******************************************************************************
+ *                  Test Case: testConcurrentBasicOperations
+ *                  Description: Test that the sharded manager behaves like the
+ *                               single-threaded one for simple sequences
+ *****************************************************************************/
+TEST(ConcurrentAppManagerTest, testConcurrentBasicOperations) {
+    ConcurrentAppManager manager(4);
+    manager.installApp("WhatsApp");
+    manager.installApp("Spotify");
+    manager.installApp("WhatsApp");
+    manager.assignPermission("WhatsApp", "Camera");
+    manager.assignPermission("Spotify", "Camera");
+    manager.revokePermission("Spotify", "Camera");
+
+    EXPECT_EQ(manager.listInstalledApps(), (std::vector<std::string>{"Spotify", "WhatsApp"}));
+    EXPECT_TRUE(manager.hasPermission("WhatsApp", "Camera"));
+    EXPECT_EQ(manager.appsWithPermission("Camera"), (std::vector<std::string>{"WhatsApp"}));
+
+    manager.uninstallApp("WhatsApp");
+    EXPECT_EQ(manager.listInstalledApps(), (std::vector<std::string>{"Spotify"}));
+    EXPECT_TRUE(manager.listAppPermissions("WhatsApp").empty());
+}
+
+/******************************************************************************
+ *                  Test Case: testConcurrentStress
+ *                  Description: Writers churn their own apps and grant to one shared
+ *                               app while readers poll it. Grants on the shared app
+ *                               are never revoked, so once a reader observes one it
+ *                               must keep observing it, and the final state must
+ *                               match the sequential outcome exactly.
+ *****************************************************************************/
+TEST(ConcurrentAppManagerTest, testConcurrentStress) {
+    const int writerCount = 8;
+    const int readerCount = 4;
+    const int appsPerWriter = 300;
+
+    ConcurrentAppManager manager(8, std::make_shared<NullLogSink>());
+    manager.installApp("shared");
+
+    std::atomic<bool> writersDone(false);
+    std::atomic<int> monotonicViolations(0);
+    std::vector<std::thread> threads;
+
+    for (int r = 0; r < readerCount; ++r) {
+        threads.emplace_back([&]() {
+            std::vector<bool> seen(writerCount, false);
+            while (!writersDone.load()) {
+                for (int w = 0; w < writerCount; ++w) {
+                    bool held = manager.hasPermission("shared", "perm-" + std::to_string(w));
+                    if (seen[w] && !held) {
+                        ++monotonicViolations;
+                    }
+                    seen[w] = seen[w] || held;
+                }
+            }
+        });
+    }
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < writerCount; ++w) {
+        writers.emplace_back([&, w]() {
+            for (int i = 0; i < appsPerWriter; ++i) {
+                std::string app = "app-" + std::to_string(w) + "-" + std::to_string(i);
+                manager.installApp(app);
+                manager.assignPermission(app, "Camera");
+                manager.assignPermission(app, "Microphone");
+                if (i % 2 == 0) {
+                    manager.revokePermission(app, "Camera");
+                }
+                if (i % 3 == 0) {
+                    manager.uninstallApp(app);
+                }
+            }
+            manager.assignPermission("shared", "perm-" + std::to_string(w));
+        });
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    writersDone = true;
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(monotonicViolations.load(), 0);
+
+    std::vector<std::string> expectedApps{"shared"};
+    std::vector<std::string> expectedCamera;
+    for (int w = 0; w < writerCount; ++w) {
+        EXPECT_TRUE(manager.hasPermission("shared", "perm-" + std::to_string(w)));
+        for (int i = 0; i < appsPerWriter; ++i) {
+            if (i % 3 == 0) {
+                continue;
+            }
+            std::string app = "app-" + std::to_string(w) + "-" + std::to_string(i);
+            expectedApps.push_back(app);
+            if (i % 2 != 0) {
+                expectedCamera.push_back(app);
+            }
+        }
+    }
+    std::sort(expectedApps.begin(), expectedApps.end());
+    std::sort(expectedCamera.begin(), expectedCamera.end());
+
+    EXPECT_EQ(manager.listInstalledApps(), expectedApps);
+    EXPECT_EQ(manager.appsWithPermission("Camera"), expectedCamera);
+    EXPECT_EQ(manager.appsWithPermission("Microphone").size(), expectedApps.size() - 1);
+}
+
+/******************************************************************************
+ *                  Test Case: testApplyBatch
+ *                  Description: Test that a valid batch is applied with per-app
+ *                               ordering preserved across interleaved operations
+ *****************************************************************************/
+TEST(MobileAppManagerTest, testApplyBatch) {
+    MobileAppManager manager;
+    manager.installApp("Spotify");
+
+    AppBatch batch;
+    batch.install("WhatsApp")
+         .grant("Spotify", "Microphone")
+         .grant("WhatsApp", "Camera")
+         .install("Maps")
+         .grant("WhatsApp", "Microphone")
+         .revoke("WhatsApp", "Camera")
+         .uninstall("Spotify")
+         .install("Spotify");
+
+    std::vector<OpStatus> results = manager.applyBatch(batch);
+    EXPECT_EQ(results, std::vector<OpStatus>(batch.size(), OpStatus::Ok));
+    EXPECT_EQ(manager.listInstalledApps(), (std::vector<std::string>{"Maps", "Spotify", "WhatsApp"}));
+    EXPECT_EQ(manager.listAppPermissions("WhatsApp"), (std::vector<std::string>{"Microphone"}));
+    EXPECT_TRUE(manager.listAppPermissions("Spotify").empty());
+    EXPECT_EQ(manager.appsWithPermission("Microphone"), (std::vector<std::string>{"WhatsApp"}));
+}
+
+/******************************************************************************
+ *                  Test Case: testApplyBatchIsAllOrNothing
+ *                  Description: Test that one invalid operation leaves the registry
+ *                               untouched and is reported alongside NotApplied
+ *****************************************************************************/
+TEST(MobileAppManagerTest, testApplyBatchIsAllOrNothing) {
+    MobileAppManager manager;
+    manager.installApp("WhatsApp");
+
+    AppBatch batch;
+    batch.install("Maps").grant("Maps", "Location").install("WhatsApp").grant("FakeApp", "Camera");
+
+    std::vector<OpStatus> results = manager.applyBatch(batch);
+    EXPECT_EQ(results, (std::vector<OpStatus>{OpStatus::NotApplied, OpStatus::NotApplied,
+                                              OpStatus::AppExists, OpStatus::AppNotFound}));
+    EXPECT_EQ(manager.listInstalledApps(), (std::vector<std::string>{"WhatsApp"}));
+    EXPECT_TRUE(manager.appsWithPermission("Location").empty());
+}
+
+/******************************************************************************
+ *                  Test Case: testOperationStatusCodes
+ *                  Description: Test that each operation reports its outcome and
+ *                               logs it to the injected sink
+ *****************************************************************************/
+TEST(MobileAppManagerTest, testOperationStatusCodes) {
+    std::ostringstream out;
+    MobileAppManager manager(std::make_shared<StreamLogSink>(out, LogLevel::Warning));
+
+    EXPECT_EQ(manager.installApp(""), OpStatus::InvalidAppName);
+    EXPECT_EQ(manager.installApp("WhatsApp"), OpStatus::Ok);
+    EXPECT_EQ(manager.installApp("WhatsApp"), OpStatus::AppExists);
+    EXPECT_EQ(manager.assignPermission("WhatsApp", ""), OpStatus::InvalidPermission);
+    EXPECT_EQ(manager.assignPermission("FakeApp", "Camera"), OpStatus::AppNotFound);
+    EXPECT_EQ(manager.assignPermission("WhatsApp", "Camera"), OpStatus::Ok);
+    EXPECT_EQ(manager.revokePermission("FakeApp", "Camera"), OpStatus::AppNotFound);
+    EXPECT_EQ(manager.revokePermission("WhatsApp", "Camera"), OpStatus::Ok);
+    EXPECT_EQ(manager.uninstallApp("WhatsApp"), OpStatus::Ok);
+    EXPECT_EQ(manager.uninstallApp("WhatsApp"), OpStatus::AppNotFound);
+
+    EXPECT_EQ(out.str(), "Invalid app name!\nApp already exists!\nInvalid permission!\n"
+                         "App not found!\nApp not found!\nApp not found!\n");
+}
+
+/******************************************************************************
+ *                  Test Case: testBufferedAndAsyncSinks
+ *                  Description: Test that the buffered sink holds lines until flushed
+ *                               and the async sink delivers every line in order
+ *****************************************************************************/
+TEST(LogSinkTest, testBufferedAndAsyncSinks) {
+    std::ostringstream buffered;
+    BufferedLogSink bufferedSink(buffered);
+    bufferedSink.write(LogLevel::Info, "first");
+    EXPECT_TRUE(buffered.str().empty());
+    bufferedSink.flush();
+    EXPECT_EQ(buffered.str(), "first\n");
+
+    std::ostringstream async;
+    std::string expected;
+    {
+        auto sink = std::make_shared<AsyncLogSink>(std::make_shared<StreamLogSink>(async), 4096);
+        MobileAppManager manager(sink);
+        for (int i = 0; i < 100; ++i) {
+            std::string app = "app-" + std::to_string(i);
+            manager.installApp(app);
+            expected += "App installed: " + app + "\n";
+        }
+        sink->flush();
+        EXPECT_EQ(async.str(), expected);
+        EXPECT_EQ(sink->dropped(), 0);
+        manager.installApp("last");
+        expected += "App installed: last\n";
+    }
+    EXPECT_EQ(async.str(), expected);
+}
+
+/******************************************************************************
+ *                  Test Case: testAsyncSinkTruncatesLongMessages
+ *                  Description: Test that a message longer than a slot is cut to
+ *                               kMaxMessage bytes and counted, and shorter ones pass
+ *                               through whole
+ *****************************************************************************/
+TEST(LogSinkTest, testAsyncSinkTruncatesLongMessages) {
+    std::ostringstream out;
+    std::string longMessage(AsyncLogSink::kMaxMessage + 50, 'x');
+    std::string exact(AsyncLogSink::kMaxMessage, 'y');
+    {
+        AsyncLogSink sink(std::make_shared<StreamLogSink>(out), 16);
+        sink.write(LogLevel::Info, longMessage);
+        sink.write(LogLevel::Info, exact);
+        sink.write(LogLevel::Info, "");
+        sink.flush();
+        EXPECT_EQ(sink.truncated(), 1);
+        EXPECT_EQ(sink.dropped(), 0);
+    }
+    EXPECT_EQ(out.str(), longMessage.substr(0, AsyncLogSink::kMaxMessage) + "\n" + exact + "\n\n");
+}
+
+/******************************************************************************
+ *                  Test Case: testSnapshotRoundTrip
+ *                  Description: Test that a saved snapshot restores the same apps,
+ *                               permissions and reverse index, and can be read in
+ *                               place through SnapshotView
+ *****************************************************************************/
+TEST(SnapshotTest, testSnapshotRoundTrip) {
+    std::string path = ::testing::TempDir() + "round_trip.snap";
+    MobileAppManager original(std::make_shared<NullLogSink>());
+    original.installApp("WhatsApp");
+    original.installApp("Spotify");
+    original.installApp("Maps");
+    original.assignPermission("WhatsApp", "Camera");
+    original.assignPermission("WhatsApp", "Microphone");
+    original.assignPermission("Maps", "Location");
+    ASSERT_TRUE(original.saveSnapshot(path));
+
+    MobileAppManager restored(std::make_shared<NullLogSink>());
+    restored.installApp("Stale");
+    ASSERT_TRUE(restored.loadSnapshot(path));
+    EXPECT_EQ(restored.listInstalledApps(), original.listInstalledApps());
+    for (const std::string& app : original.listInstalledApps()) {
+        EXPECT_EQ(restored.listAppPermissions(app), original.listAppPermissions(app));
+    }
+    EXPECT_EQ(restored.appsWithPermission("Location"), (std::vector<std::string>{"Maps"}));
+
+    SnapshotView view;
+    ASSERT_TRUE(view.open(path, false));
+    std::size_t index;
+    ASSERT_TRUE(view.findApp("WhatsApp", index));
+    std::vector<std::string_view> permissions;
+    view.forEachPermission(index, [&](std::uint32_t local) { permissions.push_back(view.permissionName(local)); });
+    EXPECT_EQ(permissions.size(), 2);
+    EXPECT_FALSE(view.findApp("Stale", index));
+
+    // An empty registry and an app without permissions leave sections empty
+    MobileAppManager empty(std::make_shared<NullLogSink>());
+    ASSERT_TRUE(empty.saveSnapshot(path));
+    ASSERT_TRUE(restored.loadSnapshot(path));
+    EXPECT_TRUE(restored.listInstalledApps().empty());
+    empty.installApp("Bare");
+    ASSERT_TRUE(empty.saveSnapshot(path));
+    ASSERT_TRUE(restored.loadSnapshot(path));
+    EXPECT_EQ(restored.listInstalledApps(), (std::vector<std::string>{"Bare"}));
+    std::remove(path.c_str());
+}
+
+/******************************************************************************
+ *                  Test Case: testSnapshotLoadsLazily
+ *                  Description: Test that loading copies no app out of the snapshot,
+ *                               that lookups and writes copy out only the app they
+ *                               touch, and that a whole-registry read brings in the
+ *                               rest without resurrecting a removed app
+ *****************************************************************************/
+TEST(SnapshotTest, testSnapshotLoadsLazily) {
+    std::string path = ::testing::TempDir() + "lazy.snap";
+    MobileAppManager original(std::make_shared<NullLogSink>());
+    std::vector<std::string> names;
+    for (int i = 0; i < 1000; ++i) {
+        names.push_back("app" + std::to_string(1000 + i));
+        original.installApp(names.back());
+        original.assignPermission(names.back(), i % 2 == 0 ? "Camera" : "Location");
+    }
+    ASSERT_TRUE(original.saveSnapshot(path));
+
+    MobileAppManager restored(std::make_shared<NullLogSink>());
+    ASSERT_TRUE(restored.loadSnapshot(path));
+    EXPECT_EQ(restored.appPoolStats().live, 0);
+    EXPECT_TRUE(restored.hasPermission("app1000", "Camera"));
+    EXPECT_FALSE(restored.hasPermission("missing", "Camera"));
+    EXPECT_EQ(restored.installApp("app1001"), OpStatus::AppExists);
+    EXPECT_EQ(restored.uninstallApp("app1002"), OpStatus::Ok);
+    EXPECT_EQ(restored.assignPermission("app1003", "Camera"), OpStatus::Ok);
+    EXPECT_EQ(restored.appPoolStats().live, 3);
+
+    names.erase(names.begin() + 2);
+    EXPECT_EQ(restored.listInstalledApps(), names);
+    EXPECT_EQ(restored.appPoolStats().live, 999);
+    EXPECT_EQ(restored.appsWithPermission("Camera").size(), 500);
+    EXPECT_TRUE(restored.hasPermission("app1003", "Camera"));
+    EXPECT_TRUE(restored.hasPermission("app1003", "Location"));
+    std::remove(path.c_str());
+}
+
+/******************************************************************************
+ *                  Test Case: testSnapshotRejectsCorruption
+ *                  Description: Test that a damaged or missing snapshot, or one written
+ *                               in the other byte order, is rejected and leaves the
+ *                               registry unchanged
+ *****************************************************************************/
+TEST(SnapshotTest, testSnapshotRejectsCorruption) {
+    std::string path = ::testing::TempDir() + "corrupt.snap";
+    MobileAppManager original(std::make_shared<NullLogSink>());
+    original.installApp("WhatsApp");
+    original.assignPermission("WhatsApp", "Camera");
+    ASSERT_TRUE(original.saveSnapshot(path));
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(sizeof(SnapshotHeader));
+        file.put('X');
+    }
+
+    MobileAppManager restored(std::make_shared<NullLogSink>());
+    restored.installApp("Spotify");
+    EXPECT_FALSE(restored.loadSnapshot(path, true));
+    EXPECT_FALSE(restored.loadSnapshot(path + ".missing"));
+    EXPECT_EQ(restored.listInstalledApps(), (std::vector<std::string>{"Spotify"}));
+
+    // Without the checksum pass a damaged header is still caught
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(0);
+        file.put('X');
+    }
+    EXPECT_FALSE(restored.loadSnapshot(path));
+    EXPECT_EQ(restored.listInstalledApps(), (std::vector<std::string>{"Spotify"}));
+
+    // A file from a host of the other byte order carries the marker reversed
+    ASSERT_TRUE(original.saveSnapshot(path));
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        std::uint32_t swapped = 0x04030201;
+        file.seekp(offsetof(SnapshotHeader, byteOrder));
+        file.write(reinterpret_cast<const char*>(&swapped), sizeof(swapped));
+    }
+    EXPECT_FALSE(restored.loadSnapshot(path));
+    EXPECT_EQ(restored.listInstalledApps(), (std::vector<std::string>{"Spotify"}));
+    std::remove(path.c_str());
+}
+
+/******************************************************************************
+ *                  Test Case: testJournalGroupCommit
+ *                  Description: Test that many journaled mutations share a few syncs
+ *****************************************************************************/
+TEST(JournalTest, testJournalGroupCommit) {
+    std::string path = ::testing::TempDir() + "group_commit.wal";
+    std::remove(path.c_str());
+    auto journal = std::make_shared<Journal>();
+    JournalOptions options;
+    options.maxDelay = std::chrono::milliseconds(50);
+    ASSERT_TRUE(journal->open(path, options));
+
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    manager.attachJournal(journal);
+    for (int i = 0; i < 1000; ++i) {
+        manager.installApp("app-" + std::to_string(i));
+    }
+    ASSERT_TRUE(journal->sync());
+    EXPECT_LT(journal->syncCount(), 10);
+    journal->close();
+
+    EXPECT_EQ(Journal::replay(path, [](const JournalRecord&) {}), 1000);
+
+    // reset() drains unsynced records before truncating, so none outlive it
+    ASSERT_TRUE(journal->open(path, options));
+    for (int i = 0; i < 100; ++i) {
+        journal->append(BatchOpType::Install, "late-" + std::to_string(i), std::string_view());
+    }
+    ASSERT_TRUE(journal->reset());
+    journal->append(BatchOpType::Install, "after", std::string_view());
+    ASSERT_TRUE(journal->sync());
+    journal->close();
+    std::vector<std::string> replayed;
+    Journal::replay(path, [&](const JournalRecord& record) { replayed.push_back(record.appName); });
+    EXPECT_EQ(replayed, std::vector<std::string>{"after"});
+    std::remove(path.c_str());
+}
+
+/******************************************************************************
+ *                  Test Case: testJournalRecovery
+ *                  Description: Test that recovery replays snapshot plus journal, drops
+ *                               a torn tail record and compacts into a fresh snapshot
+ *****************************************************************************/
+TEST(JournalTest, testJournalRecovery) {
+    std::string snapshotPath = ::testing::TempDir() + "recovery.snap";
+    std::string journalPath = ::testing::TempDir() + "recovery.wal";
+    std::remove(snapshotPath.c_str());
+    std::remove(journalPath.c_str());
+    {
+        auto journal = std::make_shared<Journal>();
+        ASSERT_TRUE(journal->open(journalPath));
+        MobileAppManager manager(std::make_shared<NullLogSink>());
+        manager.attachJournal(journal);
+        manager.installApp("WhatsApp");
+        manager.installApp("Maps");
+        manager.assignPermission("WhatsApp", "Camera");
+        ASSERT_TRUE(manager.checkpoint(snapshotPath));
+
+        AppBatch batch;
+        batch.install("Spotify").grant("Spotify", "Microphone").uninstall("Maps");
+        manager.applyBatch(batch);
+        manager.revokePermission("WhatsApp", "Camera");
+        manager.installApp("Failed");  // Torn: its record is cut short below
+        journal->close();
+    }
+    {
+        std::ifstream in(journalPath, std::ios::binary | std::ios::ate);
+        std::streamoff size = in.tellg();
+        in.close();
+        std::string contents(static_cast<std::size_t>(size) - 3, '\0');
+        std::ifstream(journalPath, std::ios::binary).read(&contents[0], static_cast<std::streamsize>(contents.size()));
+        std::ofstream(journalPath, std::ios::binary | std::ios::trunc) << contents;
+    }
+
+    MobileAppManager recovered(std::make_shared<NullLogSink>());
+    ASSERT_TRUE(recovered.recover(snapshotPath, journalPath));
+    EXPECT_EQ(recovered.listInstalledApps(), (std::vector<std::string>{"Spotify", "WhatsApp"}));
+    EXPECT_TRUE(recovered.listAppPermissions("WhatsApp").empty());
+    EXPECT_EQ(recovered.appsWithPermission("Microphone"), (std::vector<std::string>{"Spotify"}));
+    EXPECT_EQ(std::ifstream(journalPath, std::ios::binary | std::ios::ate).tellg(), 0);
+
+    EXPECT_FALSE(std::ifstream(snapshotPath + ".tmp").good());
+
+    MobileAppManager reloaded(std::make_shared<NullLogSink>());
+    ASSERT_TRUE(reloaded.loadSnapshot(snapshotPath));
+    EXPECT_EQ(reloaded.listInstalledApps(), recovered.listInstalledApps());
+    std::remove(journalPath.c_str());
+    MobileAppManager withoutJournal(std::make_shared<NullLogSink>());
+    EXPECT_TRUE(withoutJournal.recover(snapshotPath, journalPath));
+    EXPECT_EQ(withoutJournal.listInstalledApps(), recovered.listInstalledApps());
+    std::remove(snapshotPath.c_str());
+    std::remove(journalPath.c_str());
+}
+
+/******************************************************************************
+ *                  Test Case: testJournalRecoversGroups
+ *                  Description: Test that group definitions and assignments survive a
+ *                               checkpoint, a journal replay and the compacted
+ *                               snapshot
+ *****************************************************************************/
+TEST(JournalTest, testJournalRecoversGroups) {
+    std::string snapshotPath = ::testing::TempDir() + "groups.snap";
+    std::string journalPath = ::testing::TempDir() + "groups.wal";
+    std::remove(snapshotPath.c_str());
+    std::remove(journalPath.c_str());
+    {
+        auto journal = std::make_shared<Journal>();
+        ASSERT_TRUE(journal->open(journalPath));
+        MobileAppManager manager(std::make_shared<NullLogSink>());
+        manager.attachJournal(journal);
+        manager.installApp("a");
+        manager.installApp("b");
+        manager.definePermissionGroup("Media", {"Camera", "Microphone"}, {});
+        manager.assignGroup("a", "Media");
+        ASSERT_TRUE(manager.checkpoint(snapshotPath));
+
+        manager.definePermissionGroup("Location", {"GPS"}, {});
+        manager.defineRole("Navigator", {"Location", "Media"});
+        manager.assignGroup("b", "Navigator");
+        manager.definePermissionGroup("Media", {"Camera"}, {});
+        manager.assignGroup("a", "Location");
+        manager.revokeGroup("a", "Media");
+        ASSERT_TRUE(journal->sync());
+        journal->close();
+    }
+
+    MobileAppManager recovered(std::make_shared<NullLogSink>());
+    ASSERT_TRUE(recovered.recover(snapshotPath, journalPath));
+    EXPECT_EQ(recovered.listAppGroups("a"), std::vector<std::string>{"Location"});
+    EXPECT_EQ(recovered.listAppGroups("b"), std::vector<std::string>{"Navigator"});
+    EXPECT_TRUE(recovered.hasPermission("a", "GPS"));
+    EXPECT_FALSE(recovered.hasPermission("a", "Camera"));
+    EXPECT_TRUE(recovered.hasPermission("b", "Camera"));
+    EXPECT_FALSE(recovered.hasPermission("b", "Microphone"));
+
+    MobileAppManager reloaded(std::make_shared<NullLogSink>());
+    ASSERT_TRUE(reloaded.loadSnapshot(snapshotPath));
+    EXPECT_EQ(reloaded.listAppGroups("b"), std::vector<std::string>{"Navigator"});
+    EXPECT_TRUE(reloaded.hasPermission("b", "GPS"));
+    EXPECT_TRUE(reloaded.hasPermission("b", "Camera"));
+    EXPECT_FALSE(reloaded.hasPermission("b", "Microphone"));
+    EXPECT_EQ(reloaded.assignGroup("a", "Media"), OpStatus::Ok);
+    EXPECT_TRUE(reloaded.hasPermission("a", "Camera"));
+    std::remove(snapshotPath.c_str());
+    std::remove(journalPath.c_str());
+}
+
+/******************************************************************************
+ *                  Test Case: testPaginatedAppViews
+ *                  Description: Test that pages of views cover every app exactly once
+ *                               in sorted order
+ *****************************************************************************/
+TEST(MobileAppManagerTest, testPaginatedAppViews) {
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    for (const char* app : {"Maps", "Spotify", "Camera", "WhatsApp", "Notes"}) {
+        manager.installApp(app);
+    }
+
+    std::vector<std::string> seen;
+    std::string after;
+    for (;;) {
+        std::vector<std::string_view> page = manager.listInstalledApps(after, 2);
+        seen.insert(seen.end(), page.begin(), page.end());
+        if (page.size() < 2) {
+            break;
+        }
+        after = std::string(page.back());
+    }
+    EXPECT_EQ(seen, manager.listInstalledApps());
+
+    std::vector<std::string_view> visited;
+    EXPECT_EQ(manager.forEachInstalledApp("Maps", 10, [&](std::string_view app) { visited.push_back(app); }), 3);
+    EXPECT_EQ(visited, (std::vector<std::string_view>{"Notes", "Spotify", "WhatsApp"}));
+}
+
+/******************************************************************************
+ *                  Test Case: testPermissionViews
+ *                  Description: Test visiting an app's permissions without copying
+ *****************************************************************************/
+TEST(MobileAppManagerTest, testPermissionViews) {
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    manager.installApp("WhatsApp");
+    manager.assignPermission("WhatsApp", "Camera");
+    manager.assignPermission("WhatsApp", "Microphone");
+
+    std::vector<std::string_view> permissions;
+    EXPECT_TRUE(manager.forEachAppPermission("WhatsApp", [&](std::string_view p) { permissions.push_back(p); }));
+    EXPECT_EQ(permissions, (std::vector<std::string_view>{"Camera", "Microphone"}));
+    EXPECT_FALSE(manager.forEachAppPermission("FakeApp", [&](std::string_view) { FAIL(); }));
+}
+
+/******************************************************************************
+ *                  Test Case: testAppPoolReusesSlots
+ *                  Description: Test that install/uninstall churn reuses freed slots
+ *                               and the high-water mark records the peak
+ *****************************************************************************/
+TEST(MobileAppManagerTest, testAppPoolReusesSlots) {
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    for (int i = 0; i < 300; ++i) {
+        manager.installApp("app-" + std::to_string(i));
+    }
+    PoolStats peak = manager.appPoolStats();
+    EXPECT_EQ(peak.live, 300);
+    EXPECT_EQ(peak.highWaterMark, 300);
+
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 300; ++i) {
+            manager.uninstallApp("app-" + std::to_string(i));
+        }
+        for (int i = 0; i < 300; ++i) {
+            manager.installApp("app-" + std::to_string(i));
+        }
+    }
+    PoolStats churned = manager.appPoolStats();
+    EXPECT_EQ(churned.live, 300);
+    EXPECT_EQ(churned.highWaterMark, 300);
+    EXPECT_EQ(churned.slabs, peak.slabs);
+    EXPECT_EQ(churned.bytesReserved, peak.bytesReserved);
+}
+
+/******************************************************************************
+ *                  Test Case: testHashIndexChurn
+ *                  Description: Test that lookups by string_view survive interleaved
+ *                               installs and uninstalls, and listings stay sorted
+ *****************************************************************************/
+TEST(MobileAppManagerTest, testHashIndexChurn) {
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    for (int i = 0; i < 2000; ++i) {
+        manager.installApp("app-" + std::to_string(i));
+    }
+    for (int i = 0; i < 2000; i += 3) {
+        EXPECT_EQ(manager.uninstallApp("app-" + std::to_string(i)), OpStatus::Ok);
+    }
+    for (int i = 0; i < 2000; ++i) {
+        std::string appName = "app-" + std::to_string(i);
+        EXPECT_EQ(manager.assignPermission(std::string_view(appName), "CAMERA"),
+                  i % 3 == 0 ? OpStatus::AppNotFound : OpStatus::Ok);
+    }
+    EXPECT_TRUE(manager.hasPermission("app-1", "CAMERA"));
+    EXPECT_FALSE(manager.hasPermission("app-0", "CAMERA"));
+
+    std::vector<std::string> apps = manager.listInstalledApps();
+    EXPECT_EQ(apps.size(), 1333);
+    EXPECT_TRUE(std::is_sorted(apps.begin(), apps.end()));
+    EXPECT_EQ(manager.appsWithPermission("CAMERA"), apps);
+
+    manager.installApp("app-0");
+    std::vector<std::string_view> page = manager.listInstalledApps("", 2);
+    ASSERT_EQ(page.size(), 2);
+    EXPECT_EQ(page[0], "app-0");
+    EXPECT_EQ(page[1], "app-1");
+}
+
+/******************************************************************************
+ *                  Test Case: testPrefixAndSubstringSearch
+ *                  Description: Test that findApps and searchApps match a brute-force
+ *                               scan through installs, uninstalls and pagination
+ *****************************************************************************/
+TEST(MobileAppManagerTest, testPrefixAndSubstringSearch) {
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    std::set<std::string> expected;
+    const char* vendors[] = {"com.acme.", "com.acme", "com.beta.", "org.acme.", "co"};
+    for (int i = 0; i < 3000; ++i) {
+        std::string appName = std::string(vendors[i % 5]) + "app" + std::to_string(i / 5);
+        manager.installApp(appName);
+        expected.insert(appName);
+    }
+    for (int i = 0; i < 3000; i += 4) {
+        std::string appName = std::string(vendors[i % 5]) + "app" + std::to_string(i / 5);
+        manager.uninstallApp(appName);
+        expected.erase(appName);
+    }
+
+    auto bruteForce = [&](std::string_view text, bool prefixOnly) {
+        std::vector<std::string> matches;
+        for (const std::string& appName : expected) {
+            std::size_t at = appName.find(text);
+            if (prefixOnly ? at == 0 : at != std::string::npos) {
+                matches.push_back(appName);
+            }
+        }
+        return matches;
+    };
+    auto strings = [](const std::vector<std::string_view>& views) {
+        return std::vector<std::string>(views.begin(), views.end());
+    };
+    for (const char* prefix : {"com.acme.", "com.acme", "co", "org.", "com.acme.app1", "x", ""}) {
+        EXPECT_EQ(strings(manager.findApps(prefix)), bruteForce(prefix, true)) << prefix;
+    }
+    for (const char* pattern : {"acme", "app12", "me.a", "p5", "beta.app599", "zzz", "a"}) {
+        EXPECT_EQ(strings(manager.searchApps(pattern)), bruteForce(pattern, false)) << pattern;
+    }
+
+    // Walking pages of 7 returns the same names as one unpaginated query
+    std::vector<std::string> paged;
+    std::vector<std::string_view> page = manager.searchApps("acme", "", 7);
+    while (!page.empty()) {
+        paged.insert(paged.end(), page.begin(), page.end());
+        page = manager.searchApps("acme", paged.back(), 7);
+    }
+    EXPECT_EQ(paged, bruteForce("acme", false));
+    EXPECT_EQ(strings(manager.findApps("com.acme", "com.acme.app100", 2)),
+              (std::vector<std::string>{"com.acme.app101", "com.acme.app102"}));
+}
+
+#if MOBILEAPP_METRICS
+/******************************************************************************
+ *                  Test Case: testOperationMetrics
+ *                  Description: Test that counters split by outcome, histograms
+ *                               bound latencies and the exporter renders both
+ *****************************************************************************/
+TEST(MetricsTest, testOperationMetrics) {
+    LatencyHistogram histogram;
+    for (std::uint64_t nanos = 1; nanos <= 1000; ++nanos) {
+        histogram.record(nanos * 1000);
+    }
+    EXPECT_EQ(histogram.count(), 1000);
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(0.5)), 500000.0, 500000.0 / 16);
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(0.99)), 990000.0, 990000.0 / 16);
+    EXPECT_GE(histogram.percentile(1.0), 1000000);
+
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    EXPECT_EQ(manager.stats()[MetricOp::Install].calls(), 0);
+    manager.attachMetrics(std::make_shared<OperationMetrics>());
+    manager.installApp("Maps");
+    manager.installApp("Maps");
+    manager.assignPermission("Maps", "LOCATION");
+    manager.assignPermission("Ghost", "LOCATION");
+    manager.hasPermission("Maps", "LOCATION");
+
+    MetricsSnapshot stats = manager.stats();
+    EXPECT_EQ(stats[MetricOp::Install].outcomes[static_cast<std::size_t>(OpStatus::Ok)], 1);
+    EXPECT_EQ(stats[MetricOp::Install].outcomes[static_cast<std::size_t>(OpStatus::AppExists)], 1);
+    EXPECT_EQ(stats[MetricOp::Assign].outcomes[static_cast<std::size_t>(OpStatus::AppNotFound)], 1);
+    EXPECT_EQ(stats[MetricOp::Install].latency.count(), 2);
+    EXPECT_EQ(stats[MetricOp::Uninstall].calls(), 0);
+
+    std::string text = toPrometheus(stats);
+    EXPECT_NE(text.find("mobileapp_operations_total{op=\"install\",status=\"app_exists\"} 1"), std::string::npos);
+    EXPECT_NE(text.find("mobileapp_operation_duration_seconds_count{op=\"has_permission\"} 1"), std::string::npos);
+    EXPECT_NE(text.find("le=\"+Inf\"} 2"), std::string::npos);
+    EXPECT_EQ(text.find("op=\"uninstall\""), std::string::npos);
+}
+
+/******************************************************************************
+ *                  Test Case: testConcurrentMetricsMerge
+ *                  Description: Test that per-thread buffers of a shared collector
+ *                               add up to every call made by every thread
+ *****************************************************************************/
+TEST(MetricsTest, testConcurrentMetricsMerge) {
+    ConcurrentAppManager manager(4, std::make_shared<NullLogSink>());
+    manager.attachMetrics(std::make_shared<OperationMetrics>());
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&manager, t] {
+            for (int i = 0; i < 500; ++i) {
+                std::string appName = "app-" + std::to_string(t) + "-" + std::to_string(i);
+                manager.installApp(appName);
+                manager.hasPermission(appName, "CAMERA");
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    MetricsSnapshot stats = manager.stats();
+    EXPECT_EQ(stats[MetricOp::Install].outcomes[static_cast<std::size_t>(OpStatus::Ok)], 2000);
+    EXPECT_EQ(stats[MetricOp::HasPermission].calls(), 2000);
+    EXPECT_EQ(stats[MetricOp::HasPermission].latency.count(), 2000);
+}
+#endif
+
+/******************************************************************************
+ *                  Test Case: testChangeStreamEvents
+ *                  Description: Test that subscribers see each state change once, in
+ *                               order, and that no-op grants and revokes publish nothing
+ *****************************************************************************/
+TEST(ChangeStreamTest, testChangeStreamEvents) {
+    auto stream = std::make_shared<ChangeStream>(64);
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    manager.attachChangeStream(stream);
+    ChangeSubscription first(stream);
+    manager.installApp("Maps");
+    ChangeSubscription second(stream);
+    manager.assignPermission("Maps", "LOCATION");
+    manager.assignPermission("Maps", "LOCATION");
+    manager.revokePermission("Maps", "CAMERA");
+    manager.installApp("Maps");
+    AppBatch batch;
+    batch.grant("Maps", "CAMERA").uninstall("Maps");
+    manager.applyBatch(batch);
+    manager.installApp(std::string(600, 'x'));
+
+    std::vector<std::pair<ChangeType, std::string>> seen;
+    ChangeEvent event;
+    while (first.poll(event)) {
+        EXPECT_EQ(event.sequence, seen.size());
+        seen.emplace_back(event.type, event.appName + "/" + event.permission);
+    }
+    std::vector<std::pair<ChangeType, std::string>> expected = {
+        {ChangeType::Installed, "Maps/"},
+        {ChangeType::PermissionGranted, "Maps/LOCATION"},
+        {ChangeType::PermissionGranted, "Maps/CAMERA"},
+        {ChangeType::Uninstalled, "Maps/"},
+        {ChangeType::Installed, std::string(ChangeStream::kMaxText, 'x') + "/"}};
+    EXPECT_EQ(seen, expected);
+    EXPECT_TRUE(event.truncated);
+    EXPECT_EQ(first.missed(), 0);
+
+    // A later subscriber starts at the head, and an idle wait times out
+    ASSERT_TRUE(second.poll(event));
+    EXPECT_EQ(event.sequence, 1);
+    EXPECT_EQ(event.permission, "LOCATION");
+    EXPECT_FALSE(first.wait(event, std::chrono::milliseconds(5)));
+}
+
+/******************************************************************************
+ *                  Test Case: testChangeStreamOverrun
+ *                  Description: Test that concurrent publishers lose no events for a
+ *                               fast reader, and a lagging reader skips to the oldest
+ *                               retained event and counts what it missed
+ *****************************************************************************/
+TEST(ChangeStreamTest, testChangeStreamOverrun) {
+    auto stream = std::make_shared<ChangeStream>(8);
+    ChangeSubscription lagging(stream);
+    for (int i = 0; i < 20; ++i) {
+        stream->publish(ChangeType::Installed, "app-" + std::to_string(i));
+    }
+    ChangeEvent event;
+    ASSERT_TRUE(lagging.poll(event));
+    EXPECT_EQ(event.sequence, 12);
+    EXPECT_EQ(event.appName, "app-12");
+    EXPECT_EQ(lagging.missed(), 12);
+
+    auto wide = std::make_shared<ChangeStream>(1 << 14);
+    ChangeSubscription reader(wide);
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&wide, t] {
+            for (int i = 0; i < 2000; ++i) {
+                wide->publish(ChangeType::PermissionGranted, "app-" + std::to_string(t), std::to_string(i));
+            }
+        });
+    }
+    std::vector<int> lastSeen(4, -1);
+    std::size_t received = 0;
+    while (received < 8000 && reader.wait(event, std::chrono::milliseconds(2000))) {
+        int writer = event.appName.back() - '0';
+        int index = std::stoi(event.permission);
+        EXPECT_GT(index, lastSeen[writer]);
+        lastSeen[writer] = index;
+        ++received;
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    EXPECT_EQ(received, 8000);
+    EXPECT_EQ(reader.missed(), 0);
+}
+
+/******************************************************************************
+ *                  Test Case: testPermissionGroupsAndRoles
+ *                  Description: Test that groups and roles grant their permissions as
+ *                               a unit and that redefining a group reaches every holder
+ *****************************************************************************/
+TEST(MobileAppManagerTest, testPermissionGroupsAndRoles) {
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    EXPECT_EQ(manager.definePermissionGroup("media", {"CAMERA", "MICROPHONE"}), OpStatus::Ok);
+    EXPECT_EQ(manager.definePermissionGroup("location", {"GPS"}), OpStatus::Ok);
+    EXPECT_EQ(manager.defineRole("navigator", {"media", "location"}), OpStatus::Ok);
+    EXPECT_EQ(manager.defineRole("broken", {"missing"}), OpStatus::GroupNotFound);
+    EXPECT_EQ(manager.definePermissionGroup("media", {"CAMERA"}, {"navigator"}), OpStatus::GroupCycle);
+    EXPECT_EQ(manager.definePermissionGroup("", {"CAMERA"}), OpStatus::InvalidPermission);
+
+    manager.installApp("Camera");
+    manager.installApp("Maps");
+    manager.installApp("Notes");
+    manager.assignPermission("Camera", "STORAGE");
+    EXPECT_EQ(manager.assignGroup("Camera", "media"), OpStatus::Ok);
+    EXPECT_EQ(manager.assignGroup("Maps", "navigator"), OpStatus::Ok);
+    EXPECT_EQ(manager.assignGroup("Ghost", "media"), OpStatus::AppNotFound);
+    EXPECT_EQ(manager.assignGroup("Notes", "missing"), OpStatus::GroupNotFound);
+
+    EXPECT_TRUE(manager.hasPermission("Camera", "MICROPHONE"));
+    EXPECT_TRUE(manager.hasPermission("Maps", "GPS"));
+    EXPECT_FALSE(manager.hasPermission("Notes", "CAMERA"));
+    EXPECT_EQ(manager.listAppPermissions("Camera"), (std::vector<std::string>{"CAMERA", "MICROPHONE", "STORAGE"}));
+    EXPECT_EQ(manager.listAppGroups("Maps"), (std::vector<std::string>{"navigator"}));
+    EXPECT_EQ(manager.appsWithPermission("CAMERA"), (std::vector<std::string>{"Camera", "Maps"}));
+
+    // Redefinition reaches direct holders and holders through a role
+    EXPECT_EQ(manager.definePermissionGroup("media", {"MICROPHONE", "STORAGE"}), OpStatus::Ok);
+    EXPECT_FALSE(manager.hasPermission("Camera", "CAMERA"));
+    EXPECT_FALSE(manager.hasPermission("Maps", "CAMERA"));
+    EXPECT_TRUE(manager.hasPermission("Maps", "STORAGE"));
+    EXPECT_EQ(manager.appsWithPermission("STORAGE"), (std::vector<std::string>{"Camera", "Maps"}));
+
+    // Revoking the group keeps the app's own grant; uninstall drops the holder
+    EXPECT_EQ(manager.revokeGroup("Camera", "media"), OpStatus::Ok);
+    EXPECT_FALSE(manager.hasPermission("Camera", "MICROPHONE"));
+    EXPECT_TRUE(manager.hasPermission("Camera", "STORAGE"));
+    manager.uninstallApp("Maps");
+    EXPECT_EQ(manager.appsWithPermission("GPS"), std::vector<std::string>());
+    manager.installApp("Maps");
+    EXPECT_FALSE(manager.hasPermission("Maps", "GPS"));
+}
+
+/******************************************************************************
+ *                  Test Case: testSnapshotReadsArePointInTime
+ *                  Description: Test that a held snapshot keeps seeing the registry as
+ *                               of when it was taken while the manager moves on
+ *****************************************************************************/
+TEST(SnapshotReadTest, testSnapshotReadsArePointInTime) {
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    manager.installApp("Maps");
+    manager.assignPermission("Maps", "GPS");
+    EXPECT_EQ(manager.readSnapshot().size(), 0);
+    manager.enableSnapshotReads();
+    manager.definePermissionGroup("media", {"CAMERA"});
+    manager.installApp("Camera");
+    manager.assignGroup("Camera", "media");
+
+    auto contents = [](const AppMapSnapshot& snapshot) {
+        std::vector<std::string> rows;
+        snapshot.forEach([&](std::string_view appName, const PermissionSet& permissions) {
+            std::string row(appName);
+            permissions.forEach([&](PermissionId id) { row += " " + PermissionRegistry::instance().name(id); });
+            rows.push_back(row);
+        });
+        return rows;
+    };
+    AppMapSnapshot before = manager.readSnapshot();
+    manager.uninstallApp("Maps");
+    manager.definePermissionGroup("media", {"MICROPHONE"});
+    for (int i = 0; i < 100; ++i) {
+        manager.installApp("app-" + std::to_string(i));
+    }
+    AppMapSnapshot after = manager.readSnapshot();
+
+    EXPECT_EQ(contents(before), (std::vector<std::string>{"Camera CAMERA", "Maps GPS"}));
+    EXPECT_EQ(before.size(), 2);
+    PermissionSet permissions;
+    EXPECT_TRUE(after.find("Camera", permissions));
+    EXPECT_EQ(permissions.size(), 1);
+    EXPECT_TRUE(permissions.contains(PermissionRegistry::instance().intern("MICROPHONE")));
+    EXPECT_FALSE(after.find("Maps", permissions));
+    EXPECT_EQ(after.size(), 101);
+    EXPECT_EQ(contents(after).size(), 101);
+}
+
+/******************************************************************************
+ *                  Test Case: testSnapshotReadsDuringWrites
+ *                  Description: Test that readers iterating snapshots while a writer
+ *                               applies batches only ever see whole batches
+ *****************************************************************************/
+TEST(SnapshotReadTest, testSnapshotReadsDuringWrites) {
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    manager.enableSnapshotReads();
+    PermissionId read = PermissionRegistry::instance().intern("READ");
+    PermissionId write = PermissionRegistry::instance().intern("WRITE");
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                AppMapSnapshot snapshot = manager.readSnapshot();
+                std::size_t visited = 0;
+                snapshot.forEach([&](std::string_view, const PermissionSet& permissions) {
+                    ++visited;
+                    if (permissions.contains(read) != permissions.contains(write)) {
+                        ++torn;
+                    }
+                });
+                if (visited != snapshot.size()) {
+                    ++torn;
+                }
+            }
+        });
+    }
+    std::size_t applied = 0;
+    for (int round = 0; round < 9; ++round) {
+        for (int i = 0; i < 300; ++i) {
+            std::string appName = "app-" + std::to_string(i);
+            AppBatch batch;
+            if (round % 3 == 0) {
+                batch.install(appName).grant(appName, "READ").grant(appName, "WRITE");
+            } else if (round % 3 == 1) {
+                batch.revoke(appName, "READ").revoke(appName, "WRITE");
+            } else {
+                batch.uninstall(appName);
+            }
+            std::vector<OpStatus> results = manager.applyBatch(batch);
+            applied += results[0] == OpStatus::Ok;
+        }
+    }
+    done = true;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(applied, 2700);
+    EXPECT_EQ(torn.load(), 0);
+}
+
+/******************************************************************************
+ *                  Test Case: testCommandStream
+ *                  Description: Test parsing of command lines and replay of a stream
+ *                               with list output, failures and malformed lines
+ *****************************************************************************/
+TEST(CommandProcessorTest, testCommandStream) {
+    Command command;
+    EXPECT_EQ(CommandProcessor::parseLine("  grant\tMaps  GPS\r", command), ParseResult::Command);
+    EXPECT_EQ(command.type, CommandType::Grant);
+    EXPECT_EQ(command.appName, "Maps");
+    EXPECT_EQ(command.permission, "GPS");
+    EXPECT_EQ(CommandProcessor::parseLine("list Maps", command), ParseResult::Command);
+    EXPECT_EQ(command.type, CommandType::ListPermissions);
+    EXPECT_EQ(CommandProcessor::parseLine("   ", command), ParseResult::Skip);
+    EXPECT_EQ(CommandProcessor::parseLine("# install Maps", command), ParseResult::Skip);
+    EXPECT_EQ(CommandProcessor::parseLine("install", command), ParseResult::Malformed);
+    EXPECT_EQ(CommandProcessor::parseLine("install Maps now", command), ParseResult::Malformed);
+    EXPECT_EQ(CommandProcessor::parseLine("launch Maps", command), ParseResult::Malformed);
+
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    std::ostringstream output, errors;
+    CommandOptions options;
+    options.chunkBytes = 8;
+    CommandProcessor processor(manager, output, errors, options);
+    std::istringstream input("install Maps\ninstall Camera\n# comment\ngrant Maps GPS\n"
+                             "grant Ghost GPS\nlaunch Maps\nlist\nlist Maps\nuninstall Camera\nlist");
+    processor.runStream(input);
+
+    EXPECT_EQ(output.str(), "Camera\nMaps\nGPS\nMaps\n");
+    EXPECT_EQ(errors.str(), "line 6: malformed command\n");
+    const CommandStats& stats = processor.stats();
+    EXPECT_EQ(stats.lines, 10);
+    EXPECT_EQ(stats.commands, 8);
+    EXPECT_EQ(stats.failed, 1);
+    EXPECT_EQ(stats.malformed, 1);
+    EXPECT_EQ(stats.bytes, input.str().size());
+}
+
+/******************************************************************************
+ *                  Test Case: testCommandFilePipeline
+ *                  Description: Test that a mapped file cut into many chunks and
+ *                               parsed on several threads applies in input order
+ *****************************************************************************/
+TEST(CommandProcessorTest, testCommandFilePipeline) {
+    const std::string path = "command_pipeline_test.txt";
+    std::string text;
+    for (int i = 0; i < 4000; ++i) {
+        std::string appName = "app-" + std::to_string(i % 97);
+        switch (i % 5) {
+        case 0: text += "install " + appName + "\n"; break;
+        case 1: text += "grant " + appName + " P" + std::to_string(i % 7) + "\n"; break;
+        case 2: text += "revoke " + appName + " P" + std::to_string(i % 3) + "\n"; break;
+        case 3: text += i % 11 == 0 ? "uninstall " + appName + "\n" : "assign " + appName + " Q\n"; break;
+        default: text += "\n"; break;
+        }
+    }
+    std::ofstream(path, std::ios::binary) << text;
+
+    MobileAppManager expected(std::make_shared<NullLogSink>());
+    std::ostringstream unused;
+    CommandProcessor sequential(expected, unused, unused);
+    std::istringstream whole(text);
+    sequential.runStream(whole);
+
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    std::ostringstream output, errors;
+    CommandOptions options;
+    options.parseThreads = 4;
+    options.chunkBytes = 64;
+    options.window = 4;
+    CommandProcessor processor(manager, output, errors, options);
+    ASSERT_TRUE(processor.runFile(path));
+    std::remove(path.c_str());
+
+    EXPECT_EQ(processor.stats().lines, 4000);
+    EXPECT_EQ(processor.stats().commands, 3200);
+    EXPECT_EQ(processor.stats().failed, sequential.stats().failed);
+    EXPECT_EQ(errors.str(), "");
+    auto state = [](const MobileAppManager& target) {
+        std::vector<std::string> rows;
+        target.forEachInstalledApp([&](std::string_view appName) {
+            std::string row(appName);
+            target.forEachAppPermission(appName, [&](std::string_view permission) {
+                row += " " + std::string(permission);
+            });
+            rows.push_back(row);
+        });
+        return rows;
+    };
+    EXPECT_EQ(state(manager), state(expected));
+    EXPECT_FALSE(state(manager).empty());
+    EXPECT_FALSE(processor.runFile("missing_commands.txt"));
+}
+
+/******************************************************************************
+ *                  Test Case: testPermissionHistoryQueries
+ *                  Description: Test that grants, revokes and uninstalls are recorded
+ *                               and answer who held a permission over a time range
+ *****************************************************************************/
+TEST(PermissionHistoryTest, testPermissionHistoryQueries) {
+    std::int64_t now = 1000;
+    auto history = std::make_shared<PermissionHistory>([&] { return now; });
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    manager.attachHistory(history);
+    manager.installApp("Maps");
+    manager.installApp("Camera");
+    manager.installApp("Weather");
+    manager.assignPermission("Maps", "LOCATION");          // t=1000
+    now = 2000;
+    manager.assignPermission("Maps", "LOCATION");          // Already held; not recorded
+    manager.assignPermission("Camera", "CAMERA");
+    now = 3000;
+    manager.revokePermission("Maps", "LOCATION");
+    manager.revokePermission("Weather", "LOCATION");       // Not held; not recorded
+    now = 4000;
+    manager.assignPermission("Weather", "LOCATION");
+    now = 5000;
+    manager.uninstallApp("Weather");                       // Implicit revoke
+
+    EXPECT_EQ(history->size(), 5);
+    EXPECT_EQ(history->heldDuring("LOCATION", 0, 999), std::vector<std::string>{});
+    EXPECT_EQ(history->heldDuring("LOCATION", 1500, 2500), std::vector<std::string>{"Maps"});
+    EXPECT_EQ(history->heldDuring("LOCATION", 2500, 4000), (std::vector<std::string>{"Maps", "Weather"}));
+    EXPECT_EQ(history->heldDuring("LOCATION", 3500, 3900), std::vector<std::string>{});
+    EXPECT_EQ(history->heldDuring("LOCATION", 4500, 9000), std::vector<std::string>{"Weather"});
+    EXPECT_EQ(history->heldDuring("LOCATION", 6000, 9000), std::vector<std::string>{});
+    EXPECT_EQ(history->heldDuring("CAMERA", 9000, 9999), std::vector<std::string>{"Camera"});
+
+    HistoryQuery query;
+    ASSERT_TRUE(history->findApp("Weather", query.app));
+    std::vector<HistoryEvent> events = history->events(query);
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0].timestamp, 4000);
+    EXPECT_EQ(events[0].op, HistoryOp::Grant);
+    EXPECT_EQ(events[1].timestamp, 5000);
+    EXPECT_EQ(events[1].op, HistoryOp::Revoke);
+    EXPECT_EQ(history->appName(events[1].app), "Weather");
+
+    now = 100;                                             // Clock stepped back
+    manager.assignPermission("Camera", "MICROPHONE");
+    query = HistoryQuery();
+    query.from = 5000;
+    events = history->events(query);
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[1].timestamp, 5000);
+}
+
+/******************************************************************************
+ *                  Test Case: testPermissionHistoryBlocks
+ *                  Description: Test that many events stay compact and that range
+ *                               and filtered queries across blocks match a scan
+ *****************************************************************************/
+TEST(PermissionHistoryTest, testPermissionHistoryBlocks) {
+    PermissionHistory history;
+    PermissionRegistry& registry = PermissionRegistry::instance();
+    std::vector<PermissionId> permissions;
+    for (int p = 0; p < 8; ++p) {
+        permissions.push_back(registry.intern("HISTORY_" + std::to_string(p)));
+    }
+    std::vector<HistoryEvent> all;
+    std::int64_t timestamp = 1700000000000000;
+    for (std::uint32_t i = 0; i < 100000; ++i) {
+        timestamp += (i * 7919) % 5000;
+        std::string appName = "app-" + std::to_string(i % 500);
+        HistoryOp op = i % 3 == 0 ? HistoryOp::Revoke : HistoryOp::Grant;
+        history.record(timestamp, appName, permissions[i % 8], op);
+        std::uint32_t app = 0;
+        history.findApp(appName, app);
+        all.push_back(HistoryEvent{timestamp, app, permissions[i % 8], op});
+    }
+    EXPECT_EQ(history.size(), 100000);
+    EXPECT_LT(history.memoryUsage(), 100000 * 6);
+
+    HistoryQuery query;
+    query.from = all[31000].timestamp;
+    query.to = all[72000].timestamp;
+    query.permission = permissions[3];
+    history.findApp("app-123", query.app);
+    std::vector<HistoryEvent> expected;
+    for (const HistoryEvent& event : all) {
+        if (query.matches(event)) {
+            expected.push_back(event);
+        }
+    }
+    std::vector<HistoryEvent> events = history.events(query);
+    ASSERT_EQ(events.size(), expected.size());
+    EXPECT_FALSE(events.empty());
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(events[i].timestamp, expected[i].timestamp);
+        EXPECT_EQ(events[i].app, expected[i].app);
+        EXPECT_EQ(events[i].permission, expected[i].permission);
+        EXPECT_EQ(events[i].op, expected[i].op);
+    }
+    query.app = HistoryQuery::kAny;
+    query.permission = HistoryQuery::kAny;
+    EXPECT_EQ(history.events(query).size(), 41001);
+}
+
+/******************************************************************************
+ *                  Test Case: testRegistryDiffAndApply
+ *                  Description: Test that diff() yields the minimal change set with
+ *                               and without the Merkle index and that applying it
+ *                               converges the registries
+ *****************************************************************************/
+TEST(RegistryDiffTest, testRegistryDiffAndApply) {
+    auto build = [](MobileAppManager& manager, bool production) {
+        AppBatch batch;
+        batch.install("Maps").grant("Maps", "LOCATION").grant("Maps", "NETWORK");
+        batch.install("Camera").grant("Camera", "CAMERA");
+        if (production) {
+            batch.grant("Maps", "CONTACTS").revoke("Maps", "NETWORK");
+            batch.install("Wallet").grant("Wallet", "NFC");
+        } else {
+            batch.install("Legacy").grant("Legacy", "STORAGE");
+        }
+        manager.applyBatch(batch);
+    };
+    MobileAppManager staging(std::make_shared<NullLogSink>());
+    MobileAppManager production(std::make_shared<NullLogSink>());
+    build(staging, false);
+    build(production, true);
+
+    auto render = [](const AppBatch& batch) {
+        std::vector<std::string> lines;
+        for (const BatchOp& op : batch.operations()) {
+            lines.push_back(std::to_string(static_cast<int>(op.type)) + " " + op.appName + " " + op.permission);
+        }
+        std::sort(lines.begin(), lines.end());
+        return lines;
+    };
+    std::vector<std::string> expected{"0 Wallet ", "1 Legacy ", "2 Maps CONTACTS", "2 Wallet NFC", "3 Maps NETWORK"};
+    EXPECT_EQ(render(staging.diff(production)), expected);
+    staging.enableMerkleIndex();
+    EXPECT_EQ(render(staging.diff(production)), expected);
+    production.enableMerkleIndex();
+    EXPECT_EQ(render(staging.diff(production)), expected);
+    EXPECT_TRUE(production.diff(production).operations().empty());
+
+    std::vector<OpStatus> results = staging.applyBatch(staging.diff(production));
+    EXPECT_TRUE(std::all_of(results.begin(), results.end(), [](OpStatus status) { return status == OpStatus::Ok; }));
+    EXPECT_TRUE(staging.diff(production).operations().empty());
+    EXPECT_TRUE(production.diff(staging).operations().empty());
+    EXPECT_EQ(staging.listAppPermissions("Maps"), production.listAppPermissions("Maps"));
+
+    staging.uninstallApp("Camera");
+    staging.revokePermission("Wallet", "NFC");
+    EXPECT_EQ(render(production.diff(staging)), (std::vector<std::string>{"1 Camera ", "3 Wallet NFC"}));
+}
+
+/******************************************************************************
+ *                  Test Case: testMerkleDiffLargeRegistry
+ *                  Description: Test that near-identical large registries diff to
+ *                               exactly their differences and stay in sync through
+ *                               snapshot loads
+ *****************************************************************************/
+TEST(RegistryDiffTest, testMerkleDiffLargeRegistry) {
+    MobileAppManager mirror(std::make_shared<NullLogSink>());
+    MobileAppManager device(std::make_shared<NullLogSink>());
+    mirror.enableMerkleIndex();
+    device.enableMerkleIndex();
+    for (int i = 0; i < 20000; ++i) {
+        std::string appName = "app-" + std::to_string(i);
+        for (MobileAppManager* manager : {&mirror, &device}) {
+            manager->installApp(appName);
+            manager->assignPermission(appName, "P" + std::to_string(i % 5));
+        }
+    }
+    EXPECT_TRUE(mirror.diff(device).operations().empty());
+
+    device.uninstallApp("app-17");
+    device.assignPermission("app-4242", "EXTRA");
+    device.revokePermission("app-9999", "P4");
+    device.installApp("app-new");
+    AppBatch changes = mirror.diff(device);
+    EXPECT_EQ(changes.operations().size(), 4);
+    mirror.applyBatch(changes);
+    EXPECT_TRUE(mirror.diff(device).operations().empty());
+
+    const std::string path = "merkle_diff_test.snap";
+    ASSERT_TRUE(device.saveSnapshot(path));
+    MobileAppManager restored(std::make_shared<NullLogSink>());
+    restored.enableMerkleIndex();
+    restored.installApp("stale");
+    ASSERT_TRUE(restored.loadSnapshot(path));
+    std::remove(path.c_str());
+    EXPECT_TRUE(restored.diff(mirror).operations().empty());
+}
+
+/******************************************************************************
+ *                  Test Case: testFleetDeviceOperations
+ *                  Description: Test per-device operations, statuses and fleet-wide
+ *                               queries, including copy-on-write between devices
+ *                               that share state
+ *****************************************************************************/
+TEST(FleetManagerTest, testFleetDeviceOperations) {
+    FleetManager fleet;
+    EXPECT_EQ(fleet.addDevice("phone-1"), OpStatus::Ok);
+    EXPECT_EQ(fleet.addDevice("phone-1"), OpStatus::DeviceExists);
+    EXPECT_EQ(fleet.installApp("ghost", "Maps"), OpStatus::DeviceNotFound);
+    EXPECT_EQ(fleet.installApp("phone-1", ""), OpStatus::InvalidAppName);
+    EXPECT_EQ(fleet.installApp("phone-1", "Camera"), OpStatus::Ok);
+    EXPECT_EQ(fleet.installApp("phone-1", "Camera"), OpStatus::AppExists);
+    EXPECT_EQ(fleet.assignPermission("phone-1", "Camera", "CAMERA"), OpStatus::Ok);
+    EXPECT_EQ(fleet.assignPermission("phone-1", "Maps", "GPS"), OpStatus::AppNotFound);
+    EXPECT_EQ(fleet.assignPermission("phone-1", "Camera", ""), OpStatus::InvalidPermission);
+
+    MobileAppManager source(std::make_shared<NullLogSink>());
+    source.installApp("Camera");
+    source.assignPermission("Camera", "CAMERA");
+    EXPECT_EQ(fleet.addDevice("phone-2", source), OpStatus::Ok);
+    EXPECT_EQ(fleet.addDevice("phone-3", source), OpStatus::Ok);
+    EXPECT_EQ(fleet.stats().deviceStates, 1);
+    EXPECT_EQ(fleet.stats().appRecords, 1);
+
+    EXPECT_EQ(fleet.revokePermission("phone-3", "Camera", "CAMERA"), OpStatus::Ok);
+    EXPECT_EQ(fleet.installApp("phone-3", "Maps"), OpStatus::Ok);
+    EXPECT_FALSE(fleet.hasPermission("phone-3", "Camera", "CAMERA"));
+    EXPECT_TRUE(fleet.hasPermission("phone-2", "Camera", "CAMERA"));
+    EXPECT_EQ(fleet.listInstalledApps("phone-3"), (std::vector<std::string>{"Camera", "Maps"}));
+    EXPECT_EQ(fleet.listAppPermissions("phone-1", "Camera"), std::vector<std::string>{"CAMERA"});
+    EXPECT_EQ(fleet.devicesWithPermission("Camera", "CAMERA"), (std::vector<std::string>{"phone-1", "phone-2"}));
+    EXPECT_EQ(fleet.devicesWithApp("Maps"), std::vector<std::string>{"phone-3"});
+    EXPECT_EQ(fleet.stats().deviceStates, 2);
+
+    EXPECT_EQ(fleet.uninstallApp("phone-3", "Maps"), OpStatus::Ok);
+    EXPECT_EQ(fleet.uninstallApp("phone-3", "Maps"), OpStatus::AppNotFound);
+    EXPECT_EQ(fleet.assignPermission("phone-3", "Camera", "CAMERA"), OpStatus::Ok);
+    EXPECT_EQ(fleet.stats().deviceStates, 1);
+    EXPECT_EQ(fleet.stats().appRecords, 1);
+    EXPECT_EQ(fleet.removeDevice("phone-2"), OpStatus::Ok);
+    EXPECT_EQ(fleet.removeDevice("phone-2"), OpStatus::DeviceNotFound);
+    EXPECT_EQ(fleet.devicesWithApp("Camera"), (std::vector<std::string>{"phone-1", "phone-3"}));
+    EXPECT_EQ(fleet.addDevice("phone-4"), OpStatus::Ok);
+    EXPECT_EQ(fleet.stats().devices, 3);
+    EXPECT_TRUE(fleet.listInstalledApps("phone-4").empty());
+}
+
+/******************************************************************************
+ *                  Test Case: testFleetSharesState
+ *                  Description: Test that a large fleet of near-identical devices
+ *                               keeps only its distinct states and records
+ *****************************************************************************/
+TEST(FleetManagerTest, testFleetSharesState) {
+    FleetManager fleet;
+    MobileAppManager image(std::make_shared<NullLogSink>());
+    for (int i = 0; i < 40; ++i) {
+        std::string appName = "com.example.app" + std::to_string(i);
+        image.installApp(appName);
+        image.assignPermission(appName, "P" + std::to_string(i % 6));
+    }
+    for (int d = 0; d < 5000; ++d) {
+        std::string device = "device-" + std::to_string(d);
+        ASSERT_EQ(fleet.addDevice(device, image), OpStatus::Ok);
+        if (d % 100 == 0) {
+            fleet.assignPermission(device, "com.example.app7", "CAMERA");
+        }
+    }
+    FleetStats stats = fleet.stats();
+    EXPECT_EQ(stats.devices, 5000);
+    EXPECT_EQ(stats.deviceStates, 2);
+    EXPECT_EQ(stats.appRecords, 41);
+    EXPECT_LT(stats.bytes / stats.devices, 200);
+    EXPECT_EQ(fleet.devicesWithPermission("com.example.app7", "CAMERA").size(), 50);
+    EXPECT_EQ(fleet.devicesWithApp("com.example.app39").size(), 5000);
+}
+
+/******************************************************************************
+ *                  Test Case: testRoaringBitmapOperations
+ *                  Description: Test bitmap set operations against std::set across
+ *                               array and bitmap containers and several high keys
+ *****************************************************************************/
+TEST(PermissionQueryTest, testRoaringBitmapOperations) {
+    std::uint64_t seed = 12345;
+    auto next = [&]() {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<std::uint32_t>(seed >> 33);
+    };
+    auto fill = [&](RoaringBitmap& bitmap, std::set<std::uint32_t>& reference, int count, std::uint32_t range) {
+        for (int i = 0; i < count; ++i) {
+            std::uint32_t value = next() % range;
+            EXPECT_EQ(bitmap.add(value), reference.insert(value).second);
+        }
+    };
+    auto same = [](const RoaringBitmap& bitmap, const std::set<std::uint32_t>& reference) {
+        std::vector<std::uint32_t> values;
+        bitmap.forEach([&](std::uint32_t value) { values.push_back(value); });
+        return bitmap.cardinality() == reference.size() &&
+               values == std::vector<std::uint32_t>(reference.begin(), reference.end());
+    };
+
+    // Dense first container (bitmap), sparse later ones (arrays)
+    RoaringBitmap a, b;
+    std::set<std::uint32_t> ra, rb;
+    fill(a, ra, 30000, 70000);
+    fill(b, rb, 3000, 200000);
+    fill(b, rb, 6000, 65536);
+    ASSERT_TRUE(same(a, ra));
+    ASSERT_TRUE(same(b, rb));
+    EXPECT_TRUE(a.contains(*ra.begin()));
+    EXPECT_FALSE(a.contains(150000));
+
+    std::set<std::uint32_t> expected;
+    RoaringBitmap result = a;
+    result &= b;
+    std::set_intersection(ra.begin(), ra.end(), rb.begin(), rb.end(), std::inserter(expected, expected.end()));
+    EXPECT_TRUE(same(result, expected));
+
+    expected.clear();
+    result = a;
+    result |= b;
+    std::set_union(ra.begin(), ra.end(), rb.begin(), rb.end(), std::inserter(expected, expected.end()));
+    EXPECT_TRUE(same(result, expected));
+
+    expected.clear();
+    result = a;
+    result -= b;
+    std::set_difference(ra.begin(), ra.end(), rb.begin(), rb.end(), std::inserter(expected, expected.end()));
+    EXPECT_TRUE(same(result, expected));
+
+    // Removing values turns bitmap containers back into arrays and drops empty ones
+    for (std::uint32_t value : ra) {
+        if (value % 16 != 0) {
+            EXPECT_TRUE(a.remove(value));
+        }
+    }
+    for (auto it = ra.begin(); it != ra.end();) {
+        it = *it % 16 != 0 ? ra.erase(it) : std::next(it);
+    }
+    EXPECT_FALSE(a.remove(1));
+    EXPECT_TRUE(same(a, ra));
+    result = a;
+    result -= a;
+    EXPECT_TRUE(result.empty());
+    EXPECT_LT(a.memoryUsage(), 2 * RoaringBitmap::kBitmapWords * sizeof(std::uint64_t));
+}
+
+/******************************************************************************
+ *                  Test Case: testPermissionQueries
+ *                  Description: Test boolean queries over direct and group
+ *                               permissions, with and without the bitmap index,
+ *                               across mutations and parse errors
+ *****************************************************************************/
+TEST(PermissionQueryTest, testPermissionQueries) {
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    manager.definePermissionGroup("Messaging", {"SMS", "CONTACTS"});
+    for (int i = 0; i < 300; ++i) {
+        std::string appName = "app" + std::to_string(i);
+        manager.installApp(appName);
+        if (i % 2 == 0) manager.assignPermission(appName, "LOCATION");
+        if (i % 3 == 0) manager.assignPermission(appName, "CAMERA");
+        if (i % 5 == 0) manager.assignPermission(appName, "VERIFIED");
+        if (i % 7 == 0) manager.assignGroup(appName, "Messaging");
+    }
+    auto expected = [](int i) { return (i % 6 == 0 && i % 5 != 0) || i % 7 == 0; };
+    std::size_t matches = 0;
+    for (int i = 0; i < 300; ++i) {
+        matches += expected(i);
+    }
+
+    PermissionQuery query;
+    ASSERT_TRUE(PermissionQuery::parse("LOCATION & CAMERA & !VERIFIED | (SMS | CONTACTS)", query));
+    EXPECT_EQ(manager.queryPermissions(query).count(), matches);   // Temporary index
+    manager.enableBitmapIndex();
+    PermissionQueryResult result = manager.queryPermissions(query);
+    EXPECT_EQ(result.count(), matches);
+    std::vector<std::string> names = result.names();
+    EXPECT_TRUE(std::is_sorted(names.begin(), names.end()));
+    EXPECT_TRUE(std::binary_search(names.begin(), names.end(), "app7"));
+    EXPECT_FALSE(std::binary_search(names.begin(), names.end(), "app30"));
+
+    // Mutations after enabling keep the index current
+    manager.revokeGroup("app7", "Messaging");
+    manager.uninstallApp("app6");
+    manager.assignPermission("app30", "SMS");
+    manager.installApp("late");
+    manager.assignPermission("late", "CONTACTS");
+    EXPECT_EQ(manager.queryPermissions(query).count(), matches - 2 + 2);
+
+    ASSERT_TRUE(PermissionQuery::parse("!LOCATION & !CAMERA", query));
+    std::size_t neither = 0;
+    for (int i = 0; i < 300; ++i) {
+        neither += i % 2 != 0 && i % 3 != 0;
+    }
+    EXPECT_EQ(manager.queryPermissions(query).count(), neither + 1);
+    ASSERT_TRUE(PermissionQuery::parse("NEVER_GRANTED | !(SMS | CONTACTS | LOCATION | CAMERA)", query));
+    std::size_t count = 0;
+    manager.queryPermissions(query).forEach([&](std::string_view name) {
+        EXPECT_NE(name, "late");
+        ++count;
+    });
+    EXPECT_EQ(count, manager.queryPermissions(query).count());
+
+    std::string error;
+    EXPECT_FALSE(PermissionQuery::parse("LOCATION & ", query, &error));
+    EXPECT_NE(error.find("expected a permission"), std::string::npos);
+    EXPECT_FALSE(PermissionQuery::parse("(SMS | CAMERA", query, &error));
+    EXPECT_FALSE(PermissionQuery::parse("SMS CAMERA", query, &error));
+    EXPECT_FALSE(PermissionQuery::parse(std::string(1000, '!') + "SMS", query, &error));
+}
+
+/******************************************************************************
+ *                  Test Case: testFrozenRegistryMatchesManager
+ *                  Description: Test that a frozen registry answers like the manager
+ *                               it was built from, including group permissions, and
+ *                               is unaffected by later changes
+ *****************************************************************************/
+TEST(FrozenRegistryTest, testFrozenRegistryMatchesManager) {
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    FrozenAppRegistry frozen;
+    ASSERT_TRUE(manager.freeze(frozen));
+    EXPECT_EQ(frozen.size(), 0);
+    EXPECT_FALSE(frozen.contains("Maps"));
+    EXPECT_FALSE(frozen.hasPermission("Maps", "GPS"));
+
+    manager.definePermissionGroup("Social", {"CONTACTS", "SMS"});
+    for (int i = 0; i < 500; ++i) {
+        std::string appName = "com.vendor" + std::to_string(i % 7) + ".app" + std::to_string(i);
+        manager.installApp(appName);
+        for (int p = 0; p < i % 5; ++p) {
+            manager.assignPermission(appName, "FROZEN_P" + std::to_string((i + p) % 9));
+        }
+        if (i % 11 == 0) {
+            manager.assignGroup(appName, "Social");
+        }
+    }
+    manager.installApp("Bare");
+    ASSERT_TRUE(manager.freeze(frozen));
+    EXPECT_EQ(frozen.size(), 501);
+    EXPECT_EQ(frozen.listInstalledApps(), manager.listInstalledApps());
+    for (const std::string& appName : manager.listInstalledApps()) {
+        ASSERT_TRUE(frozen.contains(appName));
+        EXPECT_EQ(frozen.listAppPermissions(appName), manager.listAppPermissions(appName)) << appName;
+        for (const char* permission : {"FROZEN_P0", "FROZEN_P4", "SMS", "CAMERA"}) {
+            EXPECT_EQ(frozen.hasPermission(appName, permission), manager.hasPermission(appName, permission));
+        }
+    }
+    EXPECT_TRUE(frozen.listAppPermissions("Bare").empty());
+    EXPECT_FALSE(frozen.contains("com.vendor0.app"));
+    EXPECT_TRUE(frozen.listAppPermissions("Missing").empty());
+    EXPECT_FALSE(frozen.forEachAppPermission("Missing", [](std::string_view) {}));
+
+    manager.uninstallApp("Bare");
+    manager.revokeGroup("com.vendor0.app0", "Social");
+    EXPECT_TRUE(frozen.contains("Bare"));
+    EXPECT_TRUE(frozen.hasPermission("com.vendor0.app0", "CONTACTS"));
+}
+
+/******************************************************************************
+ *                  Test Case: testFrozenRegistryConcurrentReads
+ *                  Description: Test lock-free lookups from several threads on a
+ *                               large frozen registry and its flat memory footprint
+ *****************************************************************************/
+TEST(FrozenRegistryTest, testFrozenRegistryConcurrentReads) {
+    constexpr int kApps = 50000;
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    AppBatch batch;
+    for (int i = 0; i < kApps; ++i) {
+        std::string appName = "com.frozen.app" + std::to_string(i);
+        batch.install(appName);
+        batch.grant(appName, "FROZEN_Q" + std::to_string(i % 13));
+        batch.grant(appName, "FROZEN_R" + std::to_string(i % 3));
+    }
+    manager.applyBatch(batch);
+    FrozenAppRegistry frozen;
+    ASSERT_TRUE(manager.freeze(frozen));
+    ASSERT_EQ(frozen.size(), kApps);
+    EXPECT_LT(frozen.memoryUsage(), std::size_t(kApps) * 40);
+
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&, t]() {
+            for (int i = t; i < kApps; i += 4) {
+                std::string appName = "com.frozen.app" + std::to_string(i);
+                std::size_t count = 0;
+                bool found = frozen.forEachAppPermission(appName, [&](std::string_view) { ++count; });
+                if (!found || count != 2 || !frozen.hasPermission(appName, "FROZEN_Q" + std::to_string(i % 13)) ||
+                    frozen.hasPermission(appName, "FROZEN_Q" + std::to_string((i + 1) % 13)) ||
+                    frozen.contains(appName + "x")) {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(mismatches.load(), 0);
+}
+
+/******************************************************************************
+ *                  Test Case: testMemoryAccounting
+ *                  Description: Test that the memory breakdown follows installs,
+ *                               grants, uninstalls and enabled indexes
+ *****************************************************************************/
+TEST(MemoryBudgetTest, testMemoryAccounting) {
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    MemoryUsage empty = manager.memoryUsage();
+    EXPECT_EQ(empty.records, 0);
+    EXPECT_EQ(empty.spilledApps, 0);
+
+    for (int i = 0; i < 300; ++i) {
+        std::string appName = "com.accounting.application" + std::to_string(i);
+        manager.installApp(appName);
+        for (int p = 0; p < 4; ++p) {
+            manager.assignPermission(appName, "ACCOUNT_P" + std::to_string((i + p) % 10));
+        }
+    }
+    MemoryUsage full = manager.memoryUsage();
+    EXPECT_EQ(full.records, 300 * sizeof(App));
+    EXPECT_GT(full.index, empty.index);
+    EXPECT_GT(full.names, 0);
+    EXPECT_GE(full.permissions, 300 * 4 * sizeof(std::uint16_t));
+    EXPECT_EQ(full.extensions, 0);
+    EXPECT_EQ(full.total(), full.index + full.names + full.records + full.permissions + full.allocator);
+    EXPECT_LE(full.overflow, full.permissions + full.allocator);
+
+    for (int i = 0; i < 150; ++i) {
+        manager.uninstallApp("com.accounting.application" + std::to_string(i));
+    }
+    MemoryUsage half = manager.memoryUsage();
+    EXPECT_EQ(half.records, 150 * sizeof(App));
+    EXPECT_LT(half.names, full.names);
+    EXPECT_LE(half.permissions, full.permissions);
+    EXPECT_GE(half.allocator, 150 * sizeof(App));
+
+    manager.enableMerkleIndex();
+    EXPECT_GT(manager.memoryUsage().extensions, 0);
+}
+
+/******************************************************************************
+ *                  Test Case: testOverflowBudgetSpill
+ *                  Description: Test that a registry under a permission overflow
+ *                               budget evicts cold apps to disk, keeps its resident
+ *                               overflow under the budget and still answers like an
+ *                               unbounded registry
+ *****************************************************************************/
+TEST(MemoryBudgetTest, testOverflowBudgetSpill) {
+    std::string path = ::testing::TempDir() + "budget.spill";
+    MobileAppManager reference(std::make_shared<NullLogSink>());
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    reference.definePermissionGroup("Media", {"SPILL_CAMERA", "SPILL_MIC"});
+    manager.definePermissionGroup("Media", {"SPILL_CAMERA", "SPILL_MIC"});
+    // Only IDs past the inline bitset take heap memory, so push the test's there
+    for (PermissionId id = 0; id < PermissionSet::kInlineBits; ++id) {
+        PermissionRegistry::instance().intern("SPILL_FILL" + std::to_string(id));
+    }
+
+    auto populate = [](MobileAppManager& target, int from, int to) {
+        for (int i = from; i < to; ++i) {
+            std::string appName = "com.spill.application" + std::to_string(i);
+            target.installApp(appName);
+            for (int p = 0; p < 24; ++p) {
+                target.assignPermission(appName, "SPILL_P" + std::to_string((i * 7 + p) % 40));
+            }
+            if (i % 9 == 0) {
+                target.assignGroup(appName, "Media");
+            }
+        }
+    };
+    populate(reference, 0, 1000);
+    MemoryUsage unbounded = reference.memoryUsage();
+    std::size_t budget = unbounded.overflow / 2;
+
+    populate(manager, 0, 500);
+    ASSERT_TRUE(manager.setPermissionOverflowBudget(budget, path));
+    populate(manager, 500, 1000);
+    MemoryUsage bounded = manager.memoryUsage();
+    EXPECT_GT(bounded.spilledApps, 0);
+    EXPECT_GT(bounded.spillFileBytes, 0);
+    EXPECT_LT(bounded.overflow, budget);
+    EXPECT_LT(bounded.total(), unbounded.total() - budget / 2);
+
+    EXPECT_TRUE(manager.diff(reference).operations().empty());
+    EXPECT_TRUE(reference.diff(manager).operations().empty());
+    FrozenAppRegistry frozen;
+    ASSERT_TRUE(manager.freeze(frozen));
+    EXPECT_EQ(frozen.listAppPermissions("com.spill.application3"), reference.listAppPermissions("com.spill.application3"));
+    for (int p = 0; p < 40; p += 3) {
+        std::string permission = "SPILL_P" + std::to_string(p);
+        EXPECT_EQ(manager.appsWithPermission(permission), reference.appsWithPermission(permission)) << permission;
+    }
+    EXPECT_EQ(manager.appsWithPermission("SPILL_MIC"), reference.appsWithPermission("SPILL_MIC"));
+    for (int i = 0; i < 1000; i += 7) {
+        std::string appName = "com.spill.application" + std::to_string(i);
+        EXPECT_EQ(manager.listAppPermissions(appName), reference.listAppPermissions(appName)) << appName;
+        EXPECT_EQ(manager.hasPermission(appName, "SPILL_P5"), reference.hasPermission(appName, "SPILL_P5"));
+    }
+    EXPECT_LT(manager.memoryUsage().overflow, budget);
+
+    for (MobileAppManager* target : {&reference, &manager}) {
+        target->revokePermission("com.spill.application1", "SPILL_P7");
+        target->assignPermission("com.spill.application2", "SPILL_EXTRA");
+        target->uninstallApp("com.spill.application4");
+    }
+    EXPECT_TRUE(manager.diff(reference).operations().empty());
+    EXPECT_EQ(manager.appsWithPermission("SPILL_P7"), reference.appsWithPermission("SPILL_P7"));
+
+    ASSERT_TRUE(manager.setPermissionOverflowBudget(0, ""));
+    EXPECT_EQ(manager.memoryUsage().spilledApps, 0);
+    EXPECT_TRUE(manager.diff(reference).operations().empty());
+    for (int p = 0; p < 40; ++p) {
+        std::string permission = "SPILL_P" + std::to_string(p);
+        EXPECT_EQ(manager.appsWithPermission(permission), reference.appsWithPermission(permission)) << permission;
+    }
+    EXPECT_FALSE(manager.setPermissionOverflowBudget(budget, ::testing::TempDir() + "missing/dir/budget.spill"));
+
+    // Uninstalls give their overflow back, so growing to the same size spills nothing
+    MobileAppManager steady(std::make_shared<NullLogSink>());
+    steady.definePermissionGroup("Media", {"SPILL_CAMERA", "SPILL_MIC"});
+    populate(steady, 0, 200);
+    ASSERT_TRUE(steady.setPermissionOverflowBudget(steady.memoryUsage().overflow + 1, path));
+    for (int i = 0; i < 100; ++i) {
+        steady.uninstallApp("com.spill.application" + std::to_string(i));
+    }
+    populate(steady, 200, 300);
+    EXPECT_EQ(steady.memoryUsage().spilledApps, 0);
+    std::remove(path.c_str());
+}
+
+/******************************************************************************
+ *                  Test Case: testRecordParsing
+ *                  Description: Test JSON Lines and CSV parsing of escapes, quoting,
+ *                               unknown members, blank and malformed lines, with a
+ *                               buffer small enough to split records across reads
+ *****************************************************************************/
+TEST(RecordStreamTest, testRecordParsing) {
+    auto parse = [](RecordFormat format, const std::string& text) {
+        std::istringstream input(text);
+        RecordReader reader(format, [&](char* data, std::size_t size) -> std::ptrdiff_t {
+            input.read(data, static_cast<std::streamsize>(std::min<std::size_t>(size, 7)));
+            return static_cast<std::ptrdiff_t>(input.gcount());
+        }, 64);
+        std::vector<std::string> records;
+        for (RecordReader::Result result; (result = reader.next()) != RecordReader::Result::End;) {
+            std::string record = result == RecordReader::Result::Malformed ? "!" : std::string(reader.appName());
+            for (std::string_view permission : reader.permissions()) {
+                record += result == RecordReader::Result::Malformed ? "" : "|" + std::string(permission);
+            }
+            records.push_back(record);
+        }
+        EXPECT_EQ(reader.bytesRead(), text.size());
+        return records;
+    };
+
+    std::string json =
+        "{\"app\":\"Maps\",\"permissions\":[\"GPS\",\"CAMERA\"]}\n"
+        "\n"
+        "  { \"version\" : 2, \"meta\": {\"tags\": [\"a]\", {}]}, \"app\" : \"Caf\\u00e9 \\\"Q\\\"\" ,"
+        " \"permissions\" : [ \"EMOJI_\\ud83d\\ude00\", \"A\\/B\\\\C\" ] }\r\n"
+        "{\"app\":\"Bare\"}\n"
+        "{\"app\":\"Broken\",\"permissions\":[\"GPS\"\n"
+        "{\"permissions\":[\"GPS\"]}\n"
+        "{\"app\":\"Empty\",\"permissions\":[\"\"]}\n"
+        "{\"app\":\"" + std::string(200, 'x') + "\",\"permissions\":[\"LONG\"]}";
+    std::vector<std::string> expected = {"Maps|GPS|CAMERA", "Caf\xc3\xa9 \"Q\"|EMOJI_\xf0\x9f\x98\x80|A/B\\C", "Bare",
+                                         "!", "!", "!", std::string(200, 'x') + "|LONG"};
+    EXPECT_EQ(parse(RecordFormat::JsonLines, json), expected);
+
+    std::string csv =
+        "Maps,GPS,CAMERA\r\n"
+        "\n"
+        "\"Say \"\"Hi\"\"\",\"MULTI\nLINE\",,PLAIN\n"
+        "Bare\n"
+        "\"Unfinished\"x,GPS\n"
+        ",GPS\n"
+        "\"a,b\",\"\"\n"
+        "Last,END";
+    expected = {"Maps|GPS|CAMERA", "Say \"Hi\"|MULTI\nLINE|PLAIN", "Bare", "!", "!", "a,b", "Last|END"};
+    EXPECT_EQ(parse(RecordFormat::Csv, csv), expected);
+    EXPECT_EQ(parse(RecordFormat::Csv, "\"open,GPS\nNext,GPS\n"), (std::vector<std::string>{"!", "Next|GPS"}));
+}
+
+/******************************************************************************
+ *                  Test Case: testImportExportRoundTrip
+ *                  Description: Test that exports in both formats import into an
+ *                               identical registry, that imports merge into existing
+ *                               apps with full bookkeeping, and file descriptor I/O
+ *****************************************************************************/
+TEST(RecordStreamTest, testImportExportRoundTrip) {
+    MobileAppManager source(std::make_shared<NullLogSink>());
+    source.definePermissionGroup("Media", {"CAMERA"});
+    for (int i = 0; i < 20000; ++i) {
+        std::string appName = "com.export.app" + std::to_string(i);
+        source.installApp(appName);
+        for (int p = 0; p < i % 4; ++p) {
+            source.assignPermission(appName, "EXPORT_P" + std::to_string((i + p) % 11));
+        }
+        if (i % 50 == 0) {
+            source.assignGroup(appName, "Media");
+        }
+    }
+    source.installApp("Odd, \"quoted\"\napp\t\x01");
+    source.assignPermission("Odd, \"quoted\"\napp\t\x01", "WEIRD,\"PERM\"\r");
+
+    for (RecordFormat format : {RecordFormat::JsonLines, RecordFormat::Csv}) {
+        std::stringstream exported;
+        ASSERT_TRUE(source.exportTo(exported, format));
+        MobileAppManager target(std::make_shared<NullLogSink>());
+        ImportStats stats;
+        ASSERT_TRUE(target.importFrom(exported, format, &stats));
+        EXPECT_EQ(stats.records, 20001);
+        EXPECT_EQ(stats.installed, 20001);
+        EXPECT_EQ(stats.malformed, 0);
+        EXPECT_EQ(stats.bytes, exported.str().size());
+        EXPECT_TRUE(source.diff(target).operations().empty());
+        std::stringstream again;
+        ASSERT_TRUE(target.exportTo(again, format));
+        EXPECT_EQ(again.str(), exported.str());
+    }
+
+    MobileAppManager target(std::make_shared<NullLogSink>());
+    target.installApp("Maps");
+    target.assignPermission("Maps", "GPS");
+    target.enableMerkleIndex();
+    target.enableSnapshotReads();
+    std::istringstream input("Maps,GPS,CAMERA\nNew,CAMERA,CAMERA\n,broken\n");
+    ImportStats stats;
+    ASSERT_TRUE(target.importFrom(input, RecordFormat::Csv, &stats));
+    EXPECT_EQ(stats.records, 2);
+    EXPECT_EQ(stats.installed, 1);
+    EXPECT_EQ(stats.granted, 2);
+    EXPECT_EQ(stats.malformed, 1);
+    EXPECT_EQ(target.listAppPermissions("Maps"), (std::vector<std::string>{"CAMERA", "GPS"}));
+    EXPECT_EQ(target.appsWithPermission("CAMERA"), (std::vector<std::string>{"Maps", "New"}));
+    EXPECT_EQ(target.readSnapshot().size(), 2);
+
+    std::string path = ::testing::TempDir() + "export.jsonl";
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    EXPECT_TRUE(source.exportTo(fileno(file), RecordFormat::JsonLines));
+    std::fclose(file);
+    file = std::fopen(path.c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+    MobileAppManager fromFile(std::make_shared<NullLogSink>());
+    EXPECT_TRUE(fromFile.importFrom(fileno(file), RecordFormat::JsonLines, &stats));
+    std::fclose(file);
+    EXPECT_EQ(stats.records, 20001);
+    EXPECT_TRUE(fromFile.diff(source).operations().empty());
+    EXPECT_FALSE(fromFile.importFrom(-1, RecordFormat::Csv));
+    EXPECT_FALSE(source.exportTo(-1, RecordFormat::Csv));
+    std::remove(path.c_str());
+}
+
+/******************************************************************************
+ *                  Test Case: testTimerWheelOrdering
+ *                  Description: Test that timers fire exactly once, never before
+ *                               their deadline and never after the advance that
+ *                               reaches it, across cascades, the overflow list,
+ *                               cancels, reschedules and timers added by callbacks
+ *****************************************************************************/
+TEST(TimerWheelTest, testTimerWheelOrdering) {
+    TimerWheel<int> wheel(1000);
+    EXPECT_EQ(wheel.nextExpiry(), TimerWheel<int>::kNever);
+    EXPECT_EQ(wheel.advance(5000, [](int) {}), 0);
+    EXPECT_EQ(wheel.now(), 5000);
+
+    std::mt19937_64 random(25);
+    std::map<int, std::uint64_t> pending;   // Value -> deadline
+    std::map<int, TimerWheel<int>::TimerId> handles;
+    int nextValue = 0;
+    auto add = [&](std::uint64_t deadline) {
+        handles[nextValue] = wheel.schedule(deadline, nextValue);
+        pending[nextValue++] = deadline;
+    };
+    for (int round = 0; round < 400; ++round) {
+        for (int i = 0; i < 50; ++i) {
+            std::uint64_t spread = std::uint64_t(1) << (random() % 40);
+            add(wheel.now() + random() % spread);
+        }
+        for (int i = 0; i < 10 && !pending.empty(); ++i) {
+            auto it = pending.lower_bound(static_cast<int>(random() % nextValue));
+            if (it == pending.end()) {
+                continue;
+            }
+            if (i % 2 == 0) {
+                EXPECT_TRUE(wheel.cancel(handles[it->first]));
+                EXPECT_FALSE(wheel.cancel(handles[it->first]));
+                pending.erase(it);
+            } else {
+                it->second = wheel.now() + random() % 100000;
+                EXPECT_TRUE(wheel.reschedule(handles[it->first], it->second));
+                EXPECT_EQ(wheel.deadline(handles[it->first]), it->second);
+            }
+        }
+        std::uint64_t earliest = TimerWheel<int>::kNever;
+        for (const auto& entry : pending) {
+            earliest = std::min(earliest, entry.second);
+        }
+        EXPECT_LE(wheel.nextExpiry(), std::max(earliest, wheel.now()));
+
+        std::uint64_t to = wheel.now() + (round % 50 == 49 ? (std::uint64_t(1) << 38) : random() % 200000);
+        wheel.advance(to, [&](int value) {
+            auto it = pending.find(value);
+            ASSERT_NE(it, pending.end());
+            EXPECT_LE(it->second, to);
+            pending.erase(it);
+            EXPECT_EQ(wheel.deadline(handles[value]), TimerWheel<int>::kNever);
+            if (value % 97 == 0) {
+                add(to);   // Due at once, so it fires in this same advance
+            }
+        });
+        EXPECT_EQ(wheel.now(), to);
+        for (const auto& entry : pending) {
+            EXPECT_GT(entry.second, to);
+        }
+        EXPECT_EQ(wheel.size(), pending.size());
+    }
+    EXPECT_GT(wheel.memoryUsage(), 0);
+    wheel.clear();
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_EQ(wheel.nextExpiry(), TimerWheel<int>::kNever);
+    EXPECT_EQ(wheel.deadline(handles.begin()->second), TimerWheel<int>::kNever);
+}
+
+/******************************************************************************
+ *                  Test Case: testTimedGrants
+ *                  Description: Test expiring grants against an injected clock: lazy
+ *                               filtering on point and reverse reads, batched expiry with history and
+ *                               change events, renewal, permanent overrides, cancels
+ *                               on revoke and uninstall, exclusion from snapshots,
+ *                               and the concurrent manager's expiry thread
+ *****************************************************************************/
+TEST(TimedGrantTest, testTimedGrants) {
+    using ExpiryClock = MobileAppManager::ExpiryClock;
+    ExpiryClock::time_point now = ExpiryClock::now();
+    MobileAppManager manager(std::make_shared<NullLogSink>());
+    manager.setExpiryClock([&]() { return now; });
+    auto history = std::make_shared<PermissionHistory>();
+    manager.attachHistory(history);
+    manager.enableBitmapIndex();
+    manager.installApp("Cam");
+    manager.installApp("Other");
+    manager.assignPermission("Other", "GPS");
+    EXPECT_EQ(manager.nextExpiry(), ExpiryClock::time_point::max());
+
+    EXPECT_EQ(manager.assignPermission("Cam", "CAMERA", std::chrono::minutes(15)), OpStatus::Ok);
+    EXPECT_EQ(manager.assignPermission("Cam", "MIC", std::chrono::minutes(5)), OpStatus::Ok);
+    EXPECT_EQ(manager.assignPermission("Missing", "MIC", std::chrono::minutes(5)), OpStatus::AppNotFound);
+    EXPECT_EQ(manager.assignPermission("Cam", "", std::chrono::minutes(5)), OpStatus::InvalidPermission);
+    EXPECT_EQ(manager.pendingExpiries(), 2);
+    EXPECT_LE(manager.nextExpiry(), now + std::chrono::minutes(5));
+    EXPECT_TRUE(manager.hasPermission("Cam", "MIC"));
+    EXPECT_EQ(manager.expireGrants(), 0);
+
+    // Past the deadline, reads drop the grant before anything expires it
+    now += std::chrono::minutes(6);
+    EXPECT_FALSE(manager.hasPermission("Cam", "MIC"));
+    EXPECT_EQ(manager.listAppPermissions("Cam"), (std::vector<std::string>{"CAMERA"}));
+    EXPECT_TRUE(manager.appsWithPermission("MIC").empty());
+    EXPECT_EQ(manager.expireGrants(), 1);
+    EXPECT_TRUE(manager.appsWithPermission("MIC").empty());
+    PermissionQuery query;
+    ASSERT_TRUE(PermissionQuery::parse("MIC | CAMERA", query));
+    EXPECT_EQ(manager.queryPermissions(query).names(), std::vector<std::string>{"Cam"});
+    ASSERT_TRUE(PermissionQuery::parse("MIC", query));
+    EXPECT_EQ(manager.queryPermissions(query).count(), 0);
+    EXPECT_EQ(history->size(), 4);
+
+    // A later timed grant renews; an earlier one does not shorten
+    manager.assignPermission("Cam", "CAMERA", std::chrono::minutes(20));
+    manager.assignPermission("Cam", "CAMERA", std::chrono::minutes(1));
+    now += std::chrono::minutes(15);
+    EXPECT_TRUE(manager.hasPermission("Cam", "CAMERA"));
+
+    // A permanent grant wins over a timed one in either order
+    manager.assignPermission("Other", "GPS", std::chrono::minutes(1));
+    manager.assignPermission("Other", "NFC", std::chrono::minutes(1));
+    manager.assignPermission("Other", "NFC");
+    EXPECT_EQ(manager.pendingExpiries(), 1);
+
+    // Revoke and uninstall cancel pending timers
+    manager.installApp("Temp");
+    manager.assignPermission("Temp", "SMS", std::chrono::minutes(1));
+    manager.assignPermission("Cam", "MIC", std::chrono::minutes(1));
+    manager.revokePermission("Cam", "MIC");
+    EXPECT_EQ(manager.pendingExpiries(), 2);
+    manager.uninstallApp("Temp");
+    EXPECT_EQ(manager.pendingExpiries(), 1);
+
+    // Timed grants are not persisted
+    std::string path = ::testing::TempDir() + "timed.snap";
+    ASSERT_TRUE(manager.saveSnapshot(path));
+    MobileAppManager restored(std::make_shared<NullLogSink>());
+    ASSERT_TRUE(restored.loadSnapshot(path));
+    EXPECT_TRUE(restored.listAppPermissions("Cam").empty());
+    EXPECT_EQ(restored.listAppPermissions("Other"), (std::vector<std::string>{"GPS", "NFC"}));
+    std::stringstream exported;
+    ASSERT_TRUE(manager.exportTo(exported, RecordFormat::Csv));
+    EXPECT_EQ(exported.str(), "Cam\nOther,GPS,NFC\n");
+    std::remove(path.c_str());
+
+    // Mutations expire what is due before they apply
+    now += std::chrono::minutes(10);
+    manager.installApp("Late");
+    EXPECT_EQ(manager.pendingExpiries(), 1);
+    manager.assignPermission("Late", "GPS");
+    EXPECT_EQ(manager.pendingExpiries(), 0);
+    EXPECT_TRUE(manager.listAppPermissions("Cam").empty());
+    EXPECT_EQ(manager.nextExpiry(), ExpiryClock::time_point::max());
+    manager.definePermissionGroup("Radio", {"BLE"});
+    manager.assignPermission("Other", "BLE", std::chrono::minutes(1));
+    now += std::chrono::minutes(2);
+    manager.assignGroup("Late", "Radio");
+    EXPECT_EQ(manager.pendingExpiries(), 0);
+    manager.assignPermission("Other", "BLE", std::chrono::minutes(1));
+    now += std::chrono::minutes(2);
+    manager.revokeGroup("Late", "Radio");
+    EXPECT_EQ(manager.pendingExpiries(), 0);
+
+    // Many pending deadlines far out cost nothing to tick
+    for (int i = 0; i < 20000; ++i) {
+        manager.assignPermission("Cam", "BULK" + std::to_string(i), std::chrono::hours(1 + i % 24));
+    }
+    now += std::chrono::minutes(30);
+    EXPECT_EQ(manager.expireGrants(), 0);
+    now += std::chrono::hours(2);
+    EXPECT_EQ(manager.expireGrants(), 1668);
+    now += std::chrono::hours(24);
+    EXPECT_EQ(manager.expireGrants(), 20000 - 1668);
+    EXPECT_TRUE(manager.listAppPermissions("Cam").empty());
+
+    ConcurrentAppManager concurrent(4, std::make_shared<NullLogSink>());
+    concurrent.installApp("Live");
+    concurrent.startExpiryThread(std::chrono::seconds(30));
+    concurrent.assignPermission("Live", "SLOW", std::chrono::hours(1));
+    concurrent.assignPermission("Live", "FAST", std::chrono::milliseconds(20));
+    EXPECT_TRUE(concurrent.hasPermission("Live", "FAST"));
+    auto stop = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!concurrent.appsWithPermission("FAST").empty() && std::chrono::steady_clock::now() < stop) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_TRUE(concurrent.appsWithPermission("FAST").empty());
+    EXPECT_EQ(concurrent.listAppPermissions("Live"), (std::vector<std::string>{"SLOW"}));
+    concurrent.stopExpiryThread();
+}
+
+/******************************************************************************
+ *                  Test Case: testPermissionListsAreSorted
+ *                  Description: Test that permission lists come back sorted by name
+ *                               whatever order the names were first interned in
+ *****************************************************************************/
+TEST(MobileAppManagerTest, testPermissionListsAreSorted) {
+    MobileAppManager manager;
+    manager.installApp("First");
+    manager.installApp("Second");
+    manager.assignPermission("First", "sorted.Zeta");
+    manager.assignPermission("Second", "sorted.Alpha");
+    manager.assignPermission("Second", "sorted.Zeta");
+    manager.assignPermission("Second", "sorted.Mid");
+
+    std::vector<std::string> expected{"sorted.Alpha", "sorted.Mid", "sorted.Zeta"};
+    EXPECT_EQ(manager.listAppPermissions("Second"), expected);
+    App app("Direct");
+    app.addPermission("sorted.Zeta");
+    app.addPermission("sorted.Alpha");
+    EXPECT_EQ(app.getPermissions(), (std::vector<std::string>{"sorted.Alpha", "sorted.Zeta"}));
+
+    FrozenAppRegistry frozen;
+    ASSERT_TRUE(manager.freeze(frozen));
+    EXPECT_EQ(frozen.listAppPermissions("Second"), expected);
+}
+
 /******************************************************************************
  *                  Main Function
  *                  Description: Entry point to execute all unit tests
@@ -0,0 +1,406 @@
+
+/******************************************************************************
+ *                    File Name: TimerWheel.h
+ *                    Description: Header file for TimerWheel, a hierarchical timing
+ *                                 wheel holding deadlines with O(1) insert and cancel
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __TIMER_WHEEL_H__
+#define __TIMER_WHEEL_H__
+
+#include "BitOps.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/******************************************************************************
+ *                  Class Definition: TimerWheel
+ *                  Description: Timers carrying a T, keyed by a deadline in ticks.
+ *                               The wheel has kLevels levels of kSlots slots; level
+ *                               L slot s holds the timers whose deadline agrees
+ *                               with the current tick above digit L and has digit
+ *                               L equal to s, where a digit is kSlotBits bits of
+ *                               the tick. Deadlines too far out for every level
+ *                               wait on an overflow list. Timers live in one node
+ *                               array threaded into intrusive doubly linked slot
+ *                               lists, so schedule and cancel are O(1) and
+ *                               allocate only when the array grows. A bitmap per
+ *                               level marks its occupied slots, so the next event
+ *                               is found with one count-trailing-zeros per level
+ *                               and an idle advance costs O(kLevels) however many
+ *                               timers are pending; a timer is moved down at most
+ *                               kLevels times before it fires. Not thread-safe.
+ *****************************************************************************/
+
+template <typename T>
+class TimerWheel {
+public:
+    using TimerId = std::uint64_t;   // Generation in the high half, node index in the low half
+
+    static constexpr TimerId kNoTimer = ~TimerId(0);                  // Never returned by schedule
+    static constexpr std::uint64_t kNever = ~std::uint64_t(0);        // Deadline of no timer
+    static constexpr unsigned kSlotBits = 6;                          // Bits of the tick per level
+    static constexpr unsigned kSlots = 1u << kSlotBits;               // Slots per level
+    static constexpr unsigned kLevels = 6;                            // Levels before the overflow list
+
+    /******************************************************************************
+     *                  Name: TimerWheel
+     *                  Description: Constructor creating an empty wheel
+     *                  Arguments: std::uint64_t start - Current tick
+     *                  Returns: None
+     *****************************************************************************/
+    explicit TimerWheel(std::uint64_t start = 0) : current(start) {
+        heads.fill(kNil);
+    }
+
+    /******************************************************************************
+     *                  Name: schedule
+     *                  Description: Adds a timer; a deadline not after the current
+     *                               tick fires on the next advance
+     *                  Arguments: std::uint64_t deadline - Tick to fire at
+     *                             const T& value - Value handed to the callback
+     *                  Returns: TimerId - Handle for cancel and reschedule
+     *****************************************************************************/
+    TimerId schedule(std::uint64_t deadline, const T& value) {
+        std::uint32_t index;
+        if (freeHead != kNil) {
+            index = freeHead;
+            freeHead = nodes[index].next;
+        } else {
+            index = static_cast<std::uint32_t>(nodes.size());
+            nodes.emplace_back();
+        }
+        Node& node = nodes[index];
+        node.deadline = deadline;
+        node.value = value;
+        place(index);
+        ++count;
+        return (TimerId(node.generation) << 32) | index;
+    }
+
+    /******************************************************************************
+     *                  Name: cancel
+     *                  Description: Removes a pending timer
+     *                  Arguments: TimerId id - Handle from schedule
+     *                  Returns: bool - False if the timer already fired or was cancelled
+     *****************************************************************************/
+    bool cancel(TimerId id) {
+        std::uint32_t index;
+        if (!resolve(id, index)) {
+            return false;
+        }
+        unlink(index);
+        release(index);
+        return true;
+    }
+
+    /******************************************************************************
+     *                  Name: reschedule
+     *                  Description: Moves a pending timer to a new deadline, keeping
+     *                               its handle
+     *                  Arguments: TimerId id - Handle from schedule
+     *                             std::uint64_t deadline - New tick to fire at
+     *                  Returns: bool - False if the timer already fired or was cancelled
+     *****************************************************************************/
+    bool reschedule(TimerId id, std::uint64_t deadline) {
+        std::uint32_t index;
+        if (!resolve(id, index)) {
+            return false;
+        }
+        unlink(index);
+        nodes[index].deadline = deadline;
+        place(index);
+        return true;
+    }
+
+    /******************************************************************************
+     *                  Name: deadline
+     *                  Description: Returns the deadline of a pending timer
+     *                  Arguments: TimerId id - Handle from schedule
+     *                  Returns: std::uint64_t - Tick, or kNever if the timer is gone
+     *****************************************************************************/
+    std::uint64_t deadline(TimerId id) const {
+        std::uint32_t index;
+        return resolve(id, index) ? nodes[index].deadline : kNever;
+    }
+
+    /******************************************************************************
+     *                  Name: advance
+     *                  Description: Moves the wheel to tick now and calls
+     *                               fn(const T&) for every timer whose deadline is
+     *                               not after it. Each timer is released before its
+     *                               callback runs, so fn may schedule and cancel;
+     *                               timers it schedules at or before now fire in the
+     *                               same call. Slots between events are skipped
+     *                               without being visited.
+     *                  Arguments: std::uint64_t now - Tick to advance to
+     *                             Fn fn - Callback invoked per expired timer
+     *                  Returns: std::size_t - Timers fired
+     *****************************************************************************/
+    template <typename Fn>
+    std::size_t advance(std::uint64_t now, Fn fn) {
+        std::size_t fired = 0;
+        for (;;) {
+            while (heads[kDueList] != kNil) {
+                std::uint32_t index = heads[kDueList];
+                unlink(index);
+                T value = std::move(nodes[index].value);
+                release(index);
+                fn(static_cast<const T&>(value));
+                ++fired;
+            }
+            std::uint64_t when;
+            std::size_t list;
+            if (!nextSlot(when, list) || when > now) {
+                break;
+            }
+            current = when;
+            std::uint32_t index = heads[list];
+            heads[list] = kNil;
+            if (list < kDueList) {
+                occupied[list / kSlots] &= ~(std::uint64_t(1) << (list % kSlots));
+            }
+            while (index != kNil) {
+                std::uint32_t next = nodes[index].next;
+                place(index);
+                index = next;
+            }
+        }
+        if (now > current) {
+            current = now;
+        }
+        return fired;
+    }
+
+    /******************************************************************************
+     *                  Name: nextExpiry
+     *                  Description: Returns the earliest tick at which advance may
+     *                               fire a timer. It is a lower bound: a far timer
+     *                               is only reached through its slot's start, where
+     *                               advance moves it closer without firing.
+     *                  Arguments: None
+     *                  Returns: std::uint64_t - Tick, or kNever if the wheel is empty
+     *****************************************************************************/
+    std::uint64_t nextExpiry() const {
+        if (heads[kDueList] != kNil) {
+            return current;
+        }
+        std::uint64_t when;
+        std::size_t list;
+        return nextSlot(when, list) ? when : kNever;
+    }
+
+    /******************************************************************************
+     *                  Name: now
+     *                  Description: Returns the tick the wheel has advanced to
+     *                  Arguments: None
+     *                  Returns: std::uint64_t - Current tick
+     *****************************************************************************/
+    std::uint64_t now() const {
+        return current;
+    }
+
+    /******************************************************************************
+     *                  Name: size
+     *                  Description: Returns the number of pending timers
+     *                  Arguments: None
+     *                  Returns: std::size_t - Timers
+     *****************************************************************************/
+    std::size_t size() const {
+        return count;
+    }
+
+    /******************************************************************************
+     *                  Name: empty
+     *                  Description: Checks whether no timer is pending
+     *                  Arguments: None
+     *                  Returns: bool - True if the wheel is empty
+     *****************************************************************************/
+    bool empty() const {
+        return count == 0;
+    }
+
+    /******************************************************************************
+     *                  Name: clear
+     *                  Description: Drops every timer without firing it; the current
+     *                               tick is kept and old handles become invalid
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void clear() {
+        for (std::uint32_t index = 0; index < nodes.size(); ++index) {
+            if (nodes[index].list != kFree) {
+                release(index);
+            }
+        }
+        heads.fill(kNil);
+        occupied.fill(0);
+    }
+
+    /******************************************************************************
+     *                  Name: memoryUsage
+     *                  Description: Returns the heap bytes of the node array
+     *                  Arguments: None
+     *                  Returns: std::size_t - Bytes
+     *****************************************************************************/
+    std::size_t memoryUsage() const {
+        return nodes.capacity() * sizeof(Node);
+    }
+
+private:
+    static constexpr std::uint32_t kNil = ~std::uint32_t(0);          // End of a list
+    static constexpr std::size_t kDueList = kLevels * kSlots;         // Timers at or before the current tick
+    static constexpr std::size_t kOverflowList = kDueList + 1;        // Timers beyond the top level
+    static constexpr std::uint16_t kFree = 0xFFFF;                    // List of a node on the free list
+    static constexpr std::uint16_t kDetached = 0xFFFE;                // List of a node being moved
+
+    struct Node {
+        std::uint64_t deadline = 0;        // Tick to fire at
+        T value{};                         // Value handed to the callback
+        std::uint32_t prev = kNil;         // Previous node in the list
+        std::uint32_t next = kNil;         // Next node in the list, or in the free list
+        std::uint32_t generation = 0;      // Bumped on release so stale handles fail
+        std::uint16_t list = kFree;        // List holding the node
+    };
+
+    /******************************************************************************
+     *                  Name: resolve
+     *                  Description: Maps a handle to its node if the timer is pending
+     *                  Arguments: TimerId id - Handle from schedule
+     *                             std::uint32_t& index - Receives the node index
+     *                  Returns: bool - True if the timer is pending
+     *****************************************************************************/
+    bool resolve(TimerId id, std::uint32_t& index) const {
+        index = static_cast<std::uint32_t>(id);
+        return index < nodes.size() && nodes[index].generation == static_cast<std::uint32_t>(id >> 32) &&
+               nodes[index].list != kFree;
+    }
+
+    /******************************************************************************
+     *                  Name: place
+     *                  Description: Links a node into the list for its deadline: the
+     *                               due list if it is not after the current tick,
+     *                               else the slot of the highest digit in which it
+     *                               differs from the current tick
+     *                  Arguments: std::uint32_t index - Detached node
+     *                  Returns: None
+     *****************************************************************************/
+    void place(std::uint32_t index) {
+        std::uint64_t deadline = nodes[index].deadline;
+        std::size_t list;
+        if (deadline <= current) {
+            list = kDueList;
+        } else {
+            unsigned level = highestSetBit(deadline ^ current) / kSlotBits;
+            if (level >= kLevels) {
+                list = kOverflowList;
+            } else {
+                std::size_t slot = (deadline >> (level * kSlotBits)) & (kSlots - 1);
+                list = level * kSlots + slot;
+                occupied[level] |= std::uint64_t(1) << slot;
+            }
+        }
+        Node& node = nodes[index];
+        node.list = static_cast<std::uint16_t>(list);
+        node.prev = kNil;
+        node.next = heads[list];
+        if (node.next != kNil) {
+            nodes[node.next].prev = index;
+        }
+        heads[list] = index;
+    }
+
+    /******************************************************************************
+     *                  Name: unlink
+     *                  Description: Removes a node from its list, clearing the slot's
+     *                               occupied bit when it empties
+     *                  Arguments: std::uint32_t index - Linked node
+     *                  Returns: None
+     *****************************************************************************/
+    void unlink(std::uint32_t index) {
+        Node& node = nodes[index];
+        if (node.prev != kNil) {
+            nodes[node.prev].next = node.next;
+        } else {
+            heads[node.list] = node.next;
+        }
+        if (node.next != kNil) {
+            nodes[node.next].prev = node.prev;
+        }
+        if (node.list < kDueList && heads[node.list] == kNil) {
+            occupied[node.list / kSlots] &= ~(std::uint64_t(1) << (node.list % kSlots));
+        }
+        node.list = kDetached;
+    }
+
+    /******************************************************************************
+     *                  Name: release
+     *                  Description: Returns an unlinked node to the free list
+     *                  Arguments: std::uint32_t index - Detached node
+     *                  Returns: None
+     *****************************************************************************/
+    void release(std::uint32_t index) {
+        Node& node = nodes[index];
+        node.value = T{};
+        node.list = kFree;
+        ++node.generation;
+        node.next = freeHead;
+        freeHead = index;
+        --count;
+    }
+
+    /******************************************************************************
+     *                  Name: nextSlot
+     *                  Description: Finds the earliest non-empty list past the due
+     *                               list. Occupied slots at a level all have a digit
+     *                               above the current tick's, so the lowest occupied
+     *                               slot of the lowest occupied level is next; the
+     *                               overflow list is reached at the start of the
+     *                               top-level span holding its earliest deadline.
+     *                  Arguments: std::uint64_t& when - Receives the tick it starts at
+     *                             std::size_t& list - Receives the list
+     *                  Returns: bool - False if no timer is pending there
+     *****************************************************************************/
+    bool nextSlot(std::uint64_t& when, std::size_t& list) const {
+        for (unsigned level = 0; level < kLevels; ++level) {
+            if (occupied[level] != 0) {
+                unsigned shift = level * kSlotBits;
+                std::uint64_t slot = countTrailingZeros(occupied[level]);
+                when = ((current >> (shift + kSlotBits)) << (shift + kSlotBits)) | (slot << shift);
+                list = level * kSlots + slot;
+                return true;
+            }
+        }
+        if (heads[kOverflowList] == kNil) {
+            return false;
+        }
+        std::uint64_t earliest = kNever;
+        for (std::uint32_t index = heads[kOverflowList]; index != kNil; index = nodes[index].next) {
+            if (nodes[index].deadline < earliest) {
+                earliest = nodes[index].deadline;
+            }
+        }
+        when = (earliest >> (kLevels * kSlotBits)) << (kLevels * kSlotBits);
+        list = kOverflowList;
+        return true;
+    }
+
+    std::vector<Node> nodes;                                   // Every node, pending or free
+    std::array<std::uint32_t, kOverflowList + 1> heads;        // First node of each slot, due and overflow list
+    std::array<std::uint64_t, kLevels> occupied{};             // Bit s of level L: slot s is non-empty
+    std::uint32_t freeHead = kNil;                             // First free node
+    std::uint64_t current;                                     // Tick the wheel has advanced to
+    std::size_t count = 0;                                     // Pending timers
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,539 @@
+
+/******************************************************************************
+ *                    File Name: VersionedAppMap.cpp
+ *                    Description: Implementation file for the multi-version app map
+ *                                 and its snapshots
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#include "VersionedAppMap.h"
+#include <functional>  // For std::hash
+#include <thread>      // For std::this_thread
+#include <utility>     // For std::move, std::exchange
+
+namespace {
+
+/******************************************************************************
+ *                  Name: priorityOf
+ *                  Description: Derives a node's heap priority from its name, so the
+ *                               tree shape depends only on the set of names
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: std::uint64_t - Priority
+ *****************************************************************************/
+std::uint64_t priorityOf(std::string_view appName) {
+    return static_cast<std::uint64_t>(std::hash<std::string_view>{}(appName)) * 0x9E3779B97F4A7C15ULL;
+}
+
+}  // namespace
+
+/******************************************************************************
+ *                  Constructor: VersionedAppMap
+ *                  Description: Publishes an empty version with no group masks
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+VersionedAppMap::VersionedAppMap() : stagedMasks(std::make_shared<const std::vector<PermissionSet>>()) {
+    current.store(new Version{nullptr, 0, stagedMasks});
+}
+
+/******************************************************************************
+ *                  Destructor: VersionedAppMap
+ *                  Description: Frees the retired objects, the nodes dropped since the
+ *                               last publish, the staged tree and the current version
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+VersionedAppMap::~VersionedAppMap() {
+    for (Retired& retired : limbo) {
+        delete retired.version;
+        for (Node* node : retired.nodes) {
+            delete node;
+        }
+    }
+    for (Node* node : replaced) {
+        delete node;
+    }
+    destroyTree(staged);
+    delete current.load();
+}
+
+/******************************************************************************
+ *                  Name: put
+ *                  Description: Builds a fresh node and splices it in, replacing the
+ *                               node of the same name or inserting a new one
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             const PermissionSet& permissions - The app's own permissions
+ *                             const std::vector<GroupId>& groups - The app's groups
+ *                  Returns: None
+ *****************************************************************************/
+void VersionedAppMap::put(std::string_view appName, const PermissionSet& permissions,
+                          const std::vector<GroupId>& groups) {
+    Node* node = new Node{std::string(appName), permissions, groups, priorityOf(appName), generation};
+    const Node* probe = staged;
+    while (probe != nullptr && probe->name != appName) {
+        probe = appName < probe->name ? probe->left : probe->right;
+    }
+    if (probe != nullptr) {
+        staged = replace(staged, node);
+    } else {
+        staged = insert(staged, node);
+        ++stagedSize;
+    }
+    dirty = true;
+}
+
+/******************************************************************************
+ *                  Name: erase
+ *                  Description: Removes an app from the staged tree if present
+ *                  Arguments: std::string_view appName - Name of the application
+ *                  Returns: None
+ *****************************************************************************/
+void VersionedAppMap::erase(std::string_view appName) {
+    const Node* probe = staged;
+    while (probe != nullptr && probe->name != appName) {
+        probe = appName < probe->name ? probe->left : probe->right;
+    }
+    if (probe == nullptr) {
+        return;
+    }
+    staged = remove(staged, appName);
+    --stagedSize;
+    dirty = true;
+}
+
+/******************************************************************************
+ *                  Name: clear
+ *                  Description: Drops the whole staged tree
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void VersionedAppMap::clear() {
+    std::vector<Node*> pending;
+    if (staged != nullptr) {
+        pending.push_back(staged);
+    }
+    while (!pending.empty()) {
+        Node* node = pending.back();
+        pending.pop_back();
+        if (node->left != nullptr) {
+            pending.push_back(node->left);
+        }
+        if (node->right != nullptr) {
+            pending.push_back(node->right);
+        }
+        dispose(node);
+    }
+    staged = nullptr;
+    stagedSize = 0;
+    dirty = true;
+}
+
+/******************************************************************************
+ *                  Name: setGroupMasks
+ *                  Description: Stages a new group mask table
+ *                  Arguments: std::vector<PermissionSet> masks - Group masks by GroupId
+ *                  Returns: None
+ *****************************************************************************/
+void VersionedAppMap::setGroupMasks(std::vector<PermissionSet> masks) {
+    stagedMasks = std::make_shared<const std::vector<PermissionSet>>(std::move(masks));
+    dirty = true;
+}
+
+/******************************************************************************
+ *                  Name: publish
+ *                  Description: Swaps in a version of the staged tree, retires the
+ *                               previous version and the nodes it alone used under
+ *                               the epoch that is then closed, and freezes the staged
+ *                               nodes by starting a new generation
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void VersionedAppMap::publish() {
+    if (!dirty) {
+        return;
+    }
+    const Version* previous = current.exchange(new Version{staged, stagedSize, stagedMasks});
+    std::uint64_t retiredIn = epoch.fetch_add(1);
+    limbo.push_back(Retired{retiredIn, previous, std::move(replaced)});
+    replaced.clear();
+    ++generation;
+    dirty = false;
+    reclaim();
+}
+
+/******************************************************************************
+ *                  Name: snapshot
+ *                  Description: Pins a reader slot, then loads the current version
+ *                  Arguments: None
+ *                  Returns: AppMapSnapshot - Point-in-time view
+ *****************************************************************************/
+AppMapSnapshot VersionedAppMap::snapshot() const {
+    std::size_t slot = pin();
+    return AppMapSnapshot(this, current.load(), slot);
+}
+
+/******************************************************************************
+ *                  Name: pendingReclaim
+ *                  Description: Returns the number of retired versions not yet freed
+ *                  Arguments: None
+ *                  Returns: std::size_t - Versions awaiting reclamation
+ *****************************************************************************/
+std::size_t VersionedAppMap::pendingReclaim() const {
+    return limbo.size();
+}
+
+/******************************************************************************
+ *                  Name: writable
+ *                  Description: Returns a node the writer may modify: the node itself
+ *                               if it is unpublished, otherwise a copy, the original
+ *                               being retired with the next publish
+ *                  Arguments: Node* node - Node on a path being changed
+ *                  Returns: Node* - Modifiable node
+ *****************************************************************************/
+VersionedAppMap::Node* VersionedAppMap::writable(Node* node) {
+    if (node->generation == generation) {
+        return node;
+    }
+    Node* copy = new Node(*node);
+    copy->generation = generation;
+    replaced.push_back(node);
+    return copy;
+}
+
+/******************************************************************************
+ *                  Name: dispose
+ *                  Description: Drops a node from the staged tree: frees it if it was
+ *                               never published, otherwise retires it
+ *                  Arguments: Node* node - Node no longer referenced by the staged tree
+ *                  Returns: None
+ *****************************************************************************/
+void VersionedAppMap::dispose(Node* node) {
+    if (node->generation == generation) {
+        delete node;
+    } else {
+        replaced.push_back(node);
+    }
+}
+
+/******************************************************************************
+ *                  Name: insert
+ *                  Description: Descends by name until the new node outranks the
+ *                               subtree root, then splits that subtree under it
+ *                  Arguments: Node* tree - Subtree root, may be nullptr
+ *                             Node* node - New node whose name is not in the tree
+ *                  Returns: Node* - New subtree root
+ *****************************************************************************/
+VersionedAppMap::Node* VersionedAppMap::insert(Node* tree, Node* node) {
+    if (tree == nullptr) {
+        return node;
+    }
+    if (node->priority > tree->priority) {
+        split(tree, node->name, node->left, node->right);
+        return node;
+    }
+    tree = writable(tree);
+    if (node->name < tree->name) {
+        tree->left = insert(tree->left, node);
+    } else {
+        tree->right = insert(tree->right, node);
+    }
+    return tree;
+}
+
+/******************************************************************************
+ *                  Name: replace
+ *                  Description: Copies the path to the node of the same name and puts
+ *                               the new node in its place
+ *                  Arguments: Node* tree - Subtree root containing the name
+ *                             Node* node - Replacement node
+ *                  Returns: Node* - New subtree root
+ *****************************************************************************/
+VersionedAppMap::Node* VersionedAppMap::replace(Node* tree, Node* node) {
+    if (node->name == tree->name) {
+        node->left = tree->left;
+        node->right = tree->right;
+        dispose(tree);
+        return node;
+    }
+    tree = writable(tree);
+    if (node->name < tree->name) {
+        tree->left = replace(tree->left, node);
+    } else {
+        tree->right = replace(tree->right, node);
+    }
+    return tree;
+}
+
+/******************************************************************************
+ *                  Name: remove
+ *                  Description: Copies the path to a name and merges its children in
+ *                               its place
+ *                  Arguments: Node* tree - Subtree root containing the name
+ *                             std::string_view appName - Name to remove
+ *                  Returns: Node* - New subtree root
+ *****************************************************************************/
+VersionedAppMap::Node* VersionedAppMap::remove(Node* tree, std::string_view appName) {
+    if (appName == tree->name) {
+        Node* joined = merge(tree->left, tree->right);
+        dispose(tree);
+        return joined;
+    }
+    tree = writable(tree);
+    if (appName < tree->name) {
+        tree->left = remove(tree->left, appName);
+    } else {
+        tree->right = remove(tree->right, appName);
+    }
+    return tree;
+}
+
+/******************************************************************************
+ *                  Name: merge
+ *                  Description: Joins two subtrees whose names are all ordered left
+ *                               before right, keeping heap order
+ *                  Arguments: Node* left - Lower subtree
+ *                             Node* right - Higher subtree
+ *                  Returns: Node* - Joined subtree root
+ *****************************************************************************/
+VersionedAppMap::Node* VersionedAppMap::merge(Node* left, Node* right) {
+    if (left == nullptr) {
+        return right;
+    }
+    if (right == nullptr) {
+        return left;
+    }
+    if (left->priority > right->priority) {
+        left = writable(left);
+        left->right = merge(left->right, right);
+        return left;
+    }
+    right = writable(right);
+    right->left = merge(left, right->left);
+    return right;
+}
+
+/******************************************************************************
+ *                  Name: split
+ *                  Description: Splits a subtree into the names ordered before and
+ *                               after a name that is not in it
+ *                  Arguments: Node* tree - Subtree root, may be nullptr
+ *                             std::string_view appName - Split point
+ *                             Node*& left - Receives the lower part
+ *                             Node*& right - Receives the higher part
+ *                  Returns: None
+ *****************************************************************************/
+void VersionedAppMap::split(Node* tree, std::string_view appName, Node*& left, Node*& right) {
+    if (tree == nullptr) {
+        left = right = nullptr;
+        return;
+    }
+    tree = writable(tree);
+    if (tree->name < appName) {
+        split(tree->right, appName, tree->right, right);
+        left = tree;
+    } else {
+        split(tree->left, appName, left, tree->left);
+        right = tree;
+    }
+}
+
+/******************************************************************************
+ *                  Name: pin
+ *                  Description: Claims a free reader slot with the current epoch and
+ *                               re-reads the epoch until it is stable, so a version
+ *                               retired after the pin is always seen by reclaim.
+ *                               Yields while all slots are taken.
+ *                  Arguments: None
+ *                  Returns: std::size_t - Claimed slot
+ *****************************************************************************/
+std::size_t VersionedAppMap::pin() const {
+    std::size_t start = std::hash<std::thread::id>{}(std::this_thread::get_id()) % kMaxReaders;
+    for (;;) {
+        for (std::size_t i = 0; i < kMaxReaders; ++i) {
+            std::size_t slot = (start + i) % kMaxReaders;
+            std::uint64_t pinned = epoch.load();
+            std::uint64_t free = 0;
+            if (readers[slot].epoch.load(std::memory_order_relaxed) != 0 ||
+                !readers[slot].epoch.compare_exchange_strong(free, pinned)) {
+                continue;
+            }
+            for (std::uint64_t now = epoch.load(); now != pinned; now = epoch.load()) {
+                pinned = now;
+                readers[slot].epoch.store(pinned);
+            }
+            return slot;
+        }
+        std::this_thread::yield();
+    }
+}
+
+/******************************************************************************
+ *                  Name: unpin
+ *                  Description: Frees a reader slot
+ *                  Arguments: std::size_t slot - Slot returned by pin
+ *                  Returns: None
+ *****************************************************************************/
+void VersionedAppMap::unpin(std::size_t slot) const {
+    readers[slot].epoch.store(0, std::memory_order_release);
+}
+
+/******************************************************************************
+ *                  Name: reclaim
+ *                  Description: Frees every retired batch from an epoch before the
+ *                               oldest one still pinned
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void VersionedAppMap::reclaim() {
+    std::uint64_t oldest = epoch.load();
+    for (const ReaderSlot& reader : readers) {
+        std::uint64_t pinned = reader.epoch.load();
+        if (pinned != 0 && pinned < oldest) {
+            oldest = pinned;
+        }
+    }
+    while (!limbo.empty() && limbo.front().epoch < oldest) {
+        delete limbo.front().version;
+        for (Node* node : limbo.front().nodes) {
+            delete node;
+        }
+        limbo.pop_front();
+    }
+}
+
+/******************************************************************************
+ *                  Name: destroyTree
+ *                  Description: Frees every node of a tree
+ *                  Arguments: Node* tree - Root, may be nullptr
+ *                  Returns: None
+ *****************************************************************************/
+void VersionedAppMap::destroyTree(Node* tree) {
+    std::vector<Node*> pending;
+    if (tree != nullptr) {
+        pending.push_back(tree);
+    }
+    while (!pending.empty()) {
+        Node* node = pending.back();
+        pending.pop_back();
+        if (node->left != nullptr) {
+            pending.push_back(node->left);
+        }
+        if (node->right != nullptr) {
+            pending.push_back(node->right);
+        }
+        delete node;
+    }
+}
+
+/******************************************************************************
+ *                  Constructor: AppMapSnapshot
+ *                  Description: Takes over a pinned slot and its version
+ *                  Arguments: const VersionedAppMap* map - Owner of the slot
+ *                             const VersionedAppMap::Version* version - Pinned version
+ *                             std::size_t slot - Reader slot
+ *                  Returns: None
+ *****************************************************************************/
+AppMapSnapshot::AppMapSnapshot(const VersionedAppMap* owner, const VersionedAppMap::Version* pinned,
+                               std::size_t readerSlot)
+    : map(owner), version(pinned), slot(readerSlot) {}
+
+/******************************************************************************
+ *                  Constructor: AppMapSnapshot
+ *                  Description: Move constructor taking over the pin
+ *                  Arguments: AppMapSnapshot&& other - Snapshot to move from
+ *                  Returns: None
+ *****************************************************************************/
+AppMapSnapshot::AppMapSnapshot(AppMapSnapshot&& other) noexcept
+    : map(std::exchange(other.map, nullptr)), version(std::exchange(other.version, nullptr)), slot(other.slot) {}
+
+/******************************************************************************
+ *                  Name: operator=
+ *                  Description: Releases the current pin and takes over another
+ *                  Arguments: AppMapSnapshot&& other - Snapshot to move from
+ *                  Returns: AppMapSnapshot& - This snapshot
+ *****************************************************************************/
+AppMapSnapshot& AppMapSnapshot::operator=(AppMapSnapshot&& other) noexcept {
+    if (this != &other) {
+        unpin();
+        map = std::exchange(other.map, nullptr);
+        version = std::exchange(other.version, nullptr);
+        slot = other.slot;
+    }
+    return *this;
+}
+
+/******************************************************************************
+ *                  Destructor: AppMapSnapshot
+ *                  Description: Releases the pin
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+AppMapSnapshot::~AppMapSnapshot() {
+    unpin();
+}
+
+/******************************************************************************
+ *                  Name: size
+ *                  Description: Returns the number of apps in the version
+ *                  Arguments: None
+ *                  Returns: std::size_t - App count; 0 for an empty snapshot
+ *****************************************************************************/
+std::size_t AppMapSnapshot::size() const {
+    return version != nullptr ? version->size : 0;
+}
+
+/******************************************************************************
+ *                  Name: find
+ *                  Description: Binary-searches the pinned tree
+ *                  Arguments: std::string_view appName - Name of the application
+ *                             PermissionSet& permissions - Receives the permissions
+ *                  Returns: bool - False if the app was not installed
+ *****************************************************************************/
+bool AppMapSnapshot::find(std::string_view appName, PermissionSet& permissions) const {
+    const VersionedAppMap::Node* node = version != nullptr ? version->root : nullptr;
+    while (node != nullptr && node->name != appName) {
+        node = appName < node->name ? node->left : node->right;
+    }
+    if (node == nullptr) {
+        return false;
+    }
+    permissions = effective(*node);
+    return true;
+}
+
+/******************************************************************************
+ *                  Name: effective
+ *                  Description: ORs a node's groups' masks into its own permissions
+ *                  Arguments: const VersionedAppMap::Node& node - App node
+ *                  Returns: PermissionSet - Effective permissions
+ *****************************************************************************/
+PermissionSet AppMapSnapshot::effective(const VersionedAppMap::Node& node) const {
+    PermissionSet permissions = node.permissions;
+    for (GroupId group : node.groups) {
+        if (group < version->masks->size()) {
+            permissions |= (*version->masks)[group];
+        }
+    }
+    return permissions;
+}
+
+/******************************************************************************
+ *                  Name: unpin
+ *                  Description: Releases the reader slot, if held
+ *                  Arguments: None
+ *                  Returns: None
+ *****************************************************************************/
+void AppMapSnapshot::unpin() {
+    if (map != nullptr) {
+        map->unpin(slot);
+        map = nullptr;
+        version = nullptr;
+    }
+}
+
+/******************************** End of File ********************************/
@@ -0,0 +1,280 @@
+
+/******************************************************************************
+ *                    File Name: VersionedAppMap.h
+ *                    Description: Header file for VersionedAppMap, a multi-version
+ *                                 copy of the registry that readers snapshot and
+ *                                 iterate without locks
+ *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+ *                    Created Date: 17/10/2026
+ *****************************************************************************/
+
+/**************************************************************************** **
+ *	                    Header Files
+ ***************************************************************************** */
+
+#ifndef __VERSIONED_APP_MAP_H__
+#define __VERSIONED_APP_MAP_H__
+
+#include "PermissionGroups.h"
+#include "PermissionSet.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class AppMapSnapshot;
+
+/******************************************************************************
+ *                  Class Definition: VersionedAppMap
+ *                  Description: Persistent (path-copying) treap from app name to
+ *                               the app's permissions and groups. The writer stages
+ *                               changes on a private root, copying only the nodes
+ *                               on each changed path, and publish() makes them
+ *                               visible with one atomic pointer store; unchanged
+ *                               subtrees are shared by all versions. A reader pins
+ *                               the current epoch and loads the current version;
+ *                               nodes replaced by later versions are freed only
+ *                               once every reader pinned at or before the epoch of
+ *                               their replacement has let go (epoch-based
+ *                               reclamation). One writer at a time; any number of
+ *                               concurrent readers.
+ *****************************************************************************/
+
+class VersionedAppMap {
+public:
+    static constexpr std::size_t kMaxReaders = 128;   // Snapshots that can be held at once
+
+    /******************************************************************************
+     *                  Name: VersionedAppMap
+     *                  Description: Constructor publishing an empty version
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    VersionedAppMap();
+
+    /******************************************************************************
+     *                  Name: ~VersionedAppMap
+     *                  Description: Destructor freeing every version; no snapshot may
+     *                               outlive the map
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    ~VersionedAppMap();
+
+    VersionedAppMap(const VersionedAppMap&) = delete;
+    VersionedAppMap& operator=(const VersionedAppMap&) = delete;
+
+    /******************************************************************************
+     *                  Name: put
+     *                  Description: Stages an app's current state, replacing any
+     *                               earlier one under the same name
+     *                  Arguments: std::string_view appName - Name of the application
+     *                             const PermissionSet& permissions - The app's own permissions
+     *                             const std::vector<GroupId>& groups - The app's groups
+     *                  Returns: None
+     *****************************************************************************/
+    void put(std::string_view appName, const PermissionSet& permissions, const std::vector<GroupId>& groups);
+
+    /******************************************************************************
+     *                  Name: erase
+     *                  Description: Stages the removal of an app
+     *                  Arguments: std::string_view appName - Name of the application
+     *                  Returns: None
+     *****************************************************************************/
+    void erase(std::string_view appName);
+
+    /******************************************************************************
+     *                  Name: clear
+     *                  Description: Stages the removal of every app
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void clear();
+
+    /******************************************************************************
+     *                  Name: setGroupMasks
+     *                  Description: Stages the compiled mask of every group, indexed by
+     *                               GroupId, used to resolve app groups on read
+     *                  Arguments: std::vector<PermissionSet> masks - Group masks
+     *                  Returns: None
+     *****************************************************************************/
+    void setGroupMasks(std::vector<PermissionSet> masks);
+
+    /******************************************************************************
+     *                  Name: publish
+     *                  Description: Makes the staged changes visible to new snapshots
+     *                               as one version, then frees what no reader can
+     *                               still see
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    void publish();
+
+    /******************************************************************************
+     *                  Name: snapshot
+     *                  Description: Pins the latest published version. Safe to call
+     *                               from any thread, concurrently with the writer.
+     *                  Arguments: None
+     *                  Returns: AppMapSnapshot - Point-in-time view
+     *****************************************************************************/
+    AppMapSnapshot snapshot() const;
+
+    /******************************************************************************
+     *                  Name: pendingReclaim
+     *                  Description: Returns the number of retired versions still
+     *                               waiting for readers to let go
+     *                  Arguments: None
+     *                  Returns: std::size_t - Versions awaiting reclamation
+     *****************************************************************************/
+    std::size_t pendingReclaim() const;
+
+private:
+    friend class AppMapSnapshot;
+
+    struct Node {
+        std::string name;                  // App name, the key
+        PermissionSet permissions;         // The app's own permissions
+        std::vector<GroupId> groups;       // The app's groups, ascending
+        std::uint64_t priority;            // Heap order, a hash of the name
+        std::uint64_t generation;          // Staging generation that created the node
+        Node* left = nullptr;              // Names ordered before this one
+        Node* right = nullptr;             // Names ordered after this one
+    };
+
+    struct Version {
+        const Node* root;                                     // Tree of this version
+        std::size_t size;                                     // Apps in the tree
+        std::shared_ptr<const std::vector<PermissionSet>> masks;   // Group masks by GroupId
+    };
+
+    struct Retired {
+        std::uint64_t epoch;               // Epoch the objects were retired in
+        const Version* version;            // Replaced version
+        std::vector<Node*> nodes;          // Nodes the new version no longer references
+    };
+
+    struct alignas(64) ReaderSlot {
+        std::atomic<std::uint64_t> epoch{0};   // Pinned epoch; 0 when free
+    };
+
+    Node* writable(Node* node);
+    void dispose(Node* node);
+    Node* insert(Node* tree, Node* node);
+    Node* replace(Node* tree, Node* node);
+    Node* remove(Node* tree, std::string_view appName);
+    Node* merge(Node* left, Node* right);
+    void split(Node* tree, std::string_view appName, Node*& left, Node*& right);
+    std::size_t pin() const;
+    void unpin(std::size_t slot) const;
+    void reclaim();
+    static void destroyTree(Node* tree);
+
+    // Writer state
+    Node* staged = nullptr;                                   // Root being built
+    std::size_t stagedSize = 0;                               // Apps in the staged tree
+    std::shared_ptr<const std::vector<PermissionSet>> stagedMasks;   // Staged group masks
+    std::uint64_t generation = 1;                             // Nodes of this generation are unpublished
+    std::vector<Node*> replaced;                              // Published nodes dropped since the last publish
+    bool dirty = false;                                       // Staged state differs from the published one
+    std::deque<Retired> limbo;                                // Retired objects by ascending epoch
+
+    // Shared with readers
+    std::atomic<const Version*> current;                      // Latest published version
+    mutable std::atomic<std::uint64_t> epoch{1};              // Global epoch
+    mutable ReaderSlot readers[kMaxReaders];                  // Epochs pinned by snapshots
+};
+
+/******************************************************************************
+ *                  Class Definition: AppMapSnapshot
+ *                  Description: A pinned, immutable version of a VersionedAppMap.
+ *                               Reads take no locks and see the registry exactly as
+ *                               of one publish, however long they run; the writer
+ *                               keeps publishing meanwhile. Release it promptly:
+ *                               while it is held, versions retired after it was
+ *                               taken cannot be freed. Move-only; used by one thread
+ *                               at a time.
+ *****************************************************************************/
+
+class AppMapSnapshot {
+public:
+    AppMapSnapshot() = default;
+    AppMapSnapshot(AppMapSnapshot&& other) noexcept;
+    AppMapSnapshot& operator=(AppMapSnapshot&& other) noexcept;
+    AppMapSnapshot(const AppMapSnapshot&) = delete;
+    AppMapSnapshot& operator=(const AppMapSnapshot&) = delete;
+
+    /******************************************************************************
+     *                  Name: ~AppMapSnapshot
+     *                  Description: Destructor unpinning the version
+     *                  Arguments: None
+     *                  Returns: None
+     *****************************************************************************/
+    ~AppMapSnapshot();
+
+    /******************************************************************************
+     *                  Name: size
+     *                  Description: Returns the number of apps in the version
+     *                  Arguments: None
+     *                  Returns: std::size_t - App count
+     *****************************************************************************/
+    std::size_t size() const;
+
+    /******************************************************************************
+     *                  Name: find
+     *                  Description: Looks up an app's effective permissions, its own
+     *                               plus those of its groups
+     *                  Arguments: std::string_view appName - Name of the application
+     *                             PermissionSet& permissions - Receives the permissions
+     *                  Returns: bool - False if the app was not installed
+     *****************************************************************************/
+    bool find(std::string_view appName, PermissionSet& permissions) const;
+
+    /******************************************************************************
+     *                  Name: forEach
+     *                  Description: Calls fn(std::string_view, const PermissionSet&) with
+     *                               every app and its effective permissions, in name
+     *                               order
+     *                  Arguments: Fn fn - Callback invoked per app
+     *                  Returns: None
+     *****************************************************************************/
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        if (version == nullptr) {
+            return;
+        }
+        std::vector<const VersionedAppMap::Node*> path;
+        const VersionedAppMap::Node* node = version->root;
+        while (node != nullptr || !path.empty()) {
+            while (node != nullptr) {
+                path.push_back(node);
+                node = node->left;
+            }
+            node = path.back();
+            path.pop_back();
+            if (node->groups.empty()) {
+                fn(std::string_view(node->name), node->permissions);
+            } else {
+                fn(std::string_view(node->name), effective(*node));
+            }
+            node = node->right;
+        }
+    }
+
+private:
+    friend class VersionedAppMap;
+
+    AppMapSnapshot(const VersionedAppMap* map, const VersionedAppMap::Version* version, std::size_t slot);
+    PermissionSet effective(const VersionedAppMap::Node& node) const;
+    void unpin();
+
+    const VersionedAppMap* map = nullptr;                     // Owner of the pinned slot
+    const VersionedAppMap::Version* version = nullptr;        // Pinned version
+    std::size_t slot = 0;                                     // Reader slot holding the pin
+};
+
+#endif
+
+/******************************** End of File ********************************/
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+#/******************************************************************************
+# *                    File Name: compare_benchmarks.py
+# *                    Description: Compares a Google Benchmark JSON result against a
+# *                                 stored baseline and exits non-zero when any
+# *                                 benchmark got slower than the allowed threshold
+# *                    Created By: Nikitha, Karthikeya, Snigdha, Swetha
+# *                    Created Date: 17/10/2026
+# *****************************************************************************/
+#
+# Usage:
+#   ./build/benchBenchmarks --benchmark_out=current.json --benchmark_out_format=json
+#   python3 compare_benchmarks.py baseline.json current.json [--threshold 0.10]
+#
+# Exit status: 0 if nothing regressed, 1 if a benchmark regressed, 2 on bad input.
+
+import argparse
+import json
+import sys
+
+
+#/******************************************************************************
+# *                  Name: load_times
+# *                  Description: Reads per-benchmark times from a JSON result. With
+# *                               repetitions the median aggregate is used; without
+# *                               them the single iteration result is.
+# *                  Arguments: path - JSON file written by --benchmark_out
+# *                             metric - "real_time" or "cpu_time"
+# *                  Returns: dict - Benchmark name -> time in nanoseconds
+# *****************************************************************************/
+def load_times(path, metric):
+    scale = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+    with open(path) as f:
+        data = json.load(f)
+    medians = {}
+    singles = {}
+    for bench in data.get("benchmarks", []):
+        if bench.get("error_occurred"):
+            continue
+        time = bench[metric] * scale[bench.get("time_unit", "ns")]
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") == "median":
+                medians[bench["run_name"]] = time
+        else:
+            singles.setdefault(bench.get("run_name", bench["name"]), time)
+    singles.update(medians)
+    return singles
+
+
+#/******************************************************************************
+# *                  Name: format_time
+# *                  Description: Renders nanoseconds with a readable unit
+# *                  Arguments: ns - Time in nanoseconds
+# *                  Returns: str - Formatted time
+# *****************************************************************************/
+def format_time(ns):
+    for unit, factor in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= factor:
+            return "%.2f %s" % (ns / factor, unit)
+    return "%.1f ns" % ns
+
+
+#/******************************************************************************
+# *                  Name: main
+# *                  Description: Prints a comparison table and returns the exit status
+# *                  Arguments: None
+# *                  Returns: int - Process exit status
+# *****************************************************************************/
+def main():
+    parser = argparse.ArgumentParser(description="Fail when benchmarks regress against a baseline")
+    parser.add_argument("baseline", help="baseline JSON from benchBenchmarks")
+    parser.add_argument("current", help="current JSON from benchBenchmarks")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="allowed slowdown as a fraction (default 0.10 = 10%%)")
+    parser.add_argument("--metric", choices=("real_time", "cpu_time"), default="real_time",
+                        help="time field to compare (default real_time)")
+    parser.add_argument("--filter", default="",
+                        help="only compare benchmarks whose name contains this text")
+    args = parser.parse_args()
+
+    try:
+        baseline = load_times(args.baseline, args.metric)
+        current = load_times(args.current, args.metric)
+    except (OSError, ValueError, KeyError) as error:
+        print("error: %s" % error, file=sys.stderr)
+        return 2
+
+    regressions = []
+    width = max((len(name) for name in current), default=10)
+    print("%-*s %12s %12s %8s" % (width, "Benchmark", "Baseline", "Current", "Change"))
+    for name in sorted(current):
+        if args.filter not in name:
+            continue
+        if name not in baseline:
+            print("%-*s %12s %12s %8s" % (width, name, "-", format_time(current[name]), "new"))
+            continue
+        change = current[name] / baseline[name] - 1.0 if baseline[name] > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            regressions.append(name)
+            flag = "  REGRESSED"
+        print("%-*s %12s %12s %+7.1f%%%s" % (width, name, format_time(baseline[name]),
+                                               format_time(current[name]), change * 100, flag))
+    for name in sorted(set(baseline) - set(current)):
+        if args.filter in name:
+            print("%-*s %12s %12s %8s" % (width, name, format_time(baseline[name]), "-", "missing"))
+
+    if regressions:
+        print("\n%d benchmark(s) regressed by more than %.0f%%" % (len(regressions), args.threshold * 100))
+        return 1
+    print("\nNo regressions beyond %.0f%%" % (args.threshold * 100))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
+
+#/******************************** End of File ********************************/